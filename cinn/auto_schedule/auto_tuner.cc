@@ -35,8 +35,9 @@ AutoTuner::AutoTuner(const common::Target& target, hlir::framework::Graph* graph
 void AutoTuner::Initialize(const Config& config, hlir::framework::GraphCompiler* graph_compiler) {
   // create builder, runner, and schedule measurer
   builder_           = std::make_unique<SimpleBuilder>(graph_compiler);
-  runner_            = std::make_unique<SimpleRunner>(config.runner_repeat_times);
-  schedule_measurer_ = std::make_unique<ScheduleMeasurer>(builder_.get(), runner_.get());
+  runner_            = std::make_unique<SimpleRunner>(config.runner_config);
+  schedule_measurer_ = std::make_unique<ScheduleMeasurer>(builder_.get(), runner_.get(), config.measurer_config);
+  database_          = Database::Make(config.database_config);
 
   // create tasks
   TaskCreator task_creator;
@@ -49,7 +50,7 @@ void AutoTuner::Initialize(const Config& config, hlir::framework::GraphCompiler*
   // create task optimizers
   task_optimizers_.resize(tasks_.size());
   std::transform(tasks_.begin(), tasks_.end(), task_optimizers_.begin(), [&](const TuneTask& task) {
-    return std::make_unique<TaskOptimizer>(task, schedule_measurer_.get());
+    return std::make_unique<TaskOptimizer>(task, schedule_measurer_.get(), database_.get());
   });
 
   // create task scheduler
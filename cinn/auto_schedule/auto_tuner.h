@@ -18,7 +18,9 @@
 #include <string>
 #include <vector>
 
+#include "cinn/auto_schedule/database/database.h"
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
+#include "cinn/auto_schedule/measure/simple_runner.h"
 #include "cinn/auto_schedule/task/task_optimizer.h"
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/task_scheduler/task_scheduler.h"
@@ -41,7 +43,13 @@ class AutoTuner {
   struct Config {
     std::string task_schedule_strategy = "round_robin";
     TaskScheduler::Config task_schedule_config;
-    int runner_repeat_times = 1;
+    // how to run the measured schedules and collect their costs
+    SimpleRunner::Config runner_config;
+    // how to build and run the measured schedules concurrently
+    ScheduleMeasurer::Config measurer_config;
+    // the database of the tuning records, set its record file to reuse
+    // the schedules tuned by previous runs
+    DatabaseConfig database_config;
   };
 
   AutoTuner(const common::Target& target, hlir::framework::Graph* graph);
@@ -67,6 +75,9 @@ class AutoTuner {
   std::unique_ptr<ScheduleBuilder> builder_;
   std::unique_ptr<ScheduleRunner> runner_;
   std::unique_ptr<ScheduleMeasurer> schedule_measurer_;
+
+  // The records of the measured schedules shared by all tasks
+  std::unique_ptr<Database> database_;
 };
 
 }  // namespace auto_schedule
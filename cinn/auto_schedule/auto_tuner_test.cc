@@ -16,8 +16,11 @@
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include <cstdio>
 #include <iostream>
+#include <string>
 
 #include "cinn/common/target.h"
 #include "cinn/frontend/net_builder.h"
@@ -127,5 +130,27 @@ TEST_F(TestAutoTuner, NonZeroMeasure) {
   ApplyTunedAndRun(result);
 }
 
+TEST_F(TestAutoTuner, ReuseTuningRecords) {
+  std::string record_file = "./test_auto_tuner_records_" + std::to_string(getpid()) + ".json";
+  std::remove(record_file.c_str());
+
+  AutoTuner::Config tuning_config;
+  tuning_config.task_schedule_strategy           = "round_robin";
+  tuning_config.database_config.record_file_path = record_file;
+
+  TuningOptions tuning_options;
+  tuning_options.num_measure_trials        = 4;
+  tuning_options.num_samples_per_iteration = 2;
+  InitializeAndTune(tuning_config, tuning_options);
+
+  // a new tuner picks the best schedules from the records without measurement
+  tuner                             = std::make_unique<AutoTuner>(target, graph.get());
+  tuning_options.num_measure_trials = 0;
+  auto result                       = InitializeAndTune(tuning_config, tuning_options);
+  BasicCheckResult(result);
+  ApplyTunedAndRun(result);
+  std::remove(record_file.c_str());
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
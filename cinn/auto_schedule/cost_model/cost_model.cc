@@ -14,110 +14,268 @@
 
 #include "cinn/auto_schedule/cost_model/cost_model.h"
 
-#include <dirent.h>
-#include <pybind11/embed.h>
-#include <pybind11/numpy.h>
-#include <pybind11/pybind11.h>
-#include <pybind11/stl.h>
-
-#include <cassert>
-#include <cstring>
-#include <iostream>
-#include <mutex>
-#include <regex>
-#include <string>
-#include <vector>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <utility>
 
 namespace cinn {
 namespace auto_schedule {
 
-std::once_flag CostModel::init_once_flag_;
+namespace {
+// The format and version written at the head of a saved model
+constexpr char kModelMagic[] = "cinn_gbdt_cost_model";
+constexpr int kModelVersion  = 1;
+
+// Choose the split points of a feature, a value goes to the first bin whose threshold is not less than it
+std::vector<float> ComputeBinThresholds(const std::vector<std::vector<float>>& samples, int feature, int max_bins) {
+  std::vector<float> values(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    values[i] = samples[i][feature];
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+
+  std::vector<float> thresholds;
+  if (values.size() <= max_bins) {
+    for (size_t i = 0; i + 1 < values.size(); ++i) {
+      thresholds.push_back((values[i] + values[i + 1]) / 2);
+    }
+  } else {
+    // split the distinct values evenly
+    for (int b = 1; b < max_bins; ++b) {
+      size_t i        = values.size() * b / max_bins;
+      float threshold = (values[i - 1] + values[i]) / 2;
+      if (thresholds.empty() || thresholds.back() < threshold) {
+        thresholds.push_back(threshold);
+      }
+    }
+  }
+  thresholds.push_back(std::numeric_limits<float>::max());
+  return thresholds;
+}
+}  // namespace
+
+CostModel::CostModel() : CostModel(Config()) {}
 
-// Convert 1D vector to py numpy
-template <typename Dtype>
-pybind11::array VectorToNumpy(const std::vector<Dtype>& vec) {
-  return pybind11::array(pybind11::cast(vec));
+CostModel::CostModel(const Config& config) : config_(config) {
+  CHECK_GT(config_.num_trees, 0) << "num_trees of CostModel should be positive";
+  CHECK_GT(config_.max_depth, 0) << "max_depth of CostModel should be positive";
+  CHECK(config_.max_bins > 1 && config_.max_bins <= 256) << "max_bins of CostModel should be in (1, 256]";
 }
 
-// Convert 2D vector to py numpy
-template <typename Dtype>
-pybind11::array VectorToNumpy(const std::vector<std::vector<Dtype>>& vec) {
-  if (vec.size() == 0) {
-    return pybind11::array(pybind11::dtype::of<Dtype>(), {0, 0});
+void CostModel::Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) {
+  CHECK_EQ(samples.size(), labels.size()) << "The number of samples and labels should be equal";
+  train_samples_ = samples;
+  train_labels_  = labels;
+  trees_.clear();
+  if (samples.empty()) {
+    return;
+  }
+  num_features_ = samples[0].size();
+  for (auto& sample : samples) {
+    CHECK_EQ(sample.size(), num_features_) << "All the samples should have the same number of features";
   }
 
-  std::vector<size_t> shape{vec.size(), vec[0].size()};
-  pybind11::array ret(pybind11::dtype::of<Dtype>(), shape);
+  // quantize the features into histogram bins
+  std::vector<std::vector<float>> bin_thresholds(num_features_);
+  std::vector<std::vector<uint8_t>> sample_bins(num_features_, std::vector<uint8_t>(samples.size()));
+  for (int f = 0; f < num_features_; ++f) {
+    bin_thresholds[f] = ComputeBinThresholds(samples, f, config_.max_bins);
+    for (size_t i = 0; i < samples.size(); ++i) {
+      auto it           = std::lower_bound(bin_thresholds[f].begin(), bin_thresholds[f].end(), samples[i][f]);
+      sample_bins[f][i] = it - bin_thresholds[f].begin();
+    }
+  }
 
-  Dtype* py_data = static_cast<Dtype*>(ret.mutable_data());
-  for (size_t i = 0; i < vec.size(); ++i) {
-    assert(vec[i].size() == shape[1] && "Sub vectors must have same size in VectorToNumpy");
-    memcpy(py_data + (shape[1] * i), vec[i].data(), shape[1] * sizeof(Dtype));
+  double label_sum = 0;
+  for (float label : labels) {
+    label_sum += label;
   }
-  return ret;
-}
+  base_score_ = label_sum / labels.size();
 
-// the Pybind default Python interpreter doesn't contain some paths in
-// sys.path, so we have to add it.
-//
-// Note: the Pybind default Python interpreter only uses default Python.
-// Something may be wrong when users use virtual Python environment.
-void AddDistPkgToPythonSysPath() {
-  pybind11::module sys_py_mod = pybind11::module::import("sys");
-  // short version such as "3.7", "3.8", ...
-  std::string py_short_version = sys_py_mod.attr("version").cast<std::string>().substr(0, 3);
-
-  std::string site_pkg_str = "/usr/local/lib/python" + py_short_version + "/dist-packages";
-  sys_py_mod.attr("path").attr("append")(site_pkg_str);
-
-  // TODO(zhhsplendid): warning to users if setuptools hasn't been installed
-  DIR* site_pkg_dir = opendir(site_pkg_str.c_str());
-  if (site_pkg_dir != nullptr) {
-    std::regex setuptool_regex("setuptools-.*-py" + py_short_version + "\\.egg");
-    struct dirent* entry = nullptr;
-    while ((entry = readdir(site_pkg_dir)) != nullptr) {
-      if (std::regex_match(entry->d_name, setuptool_regex)) {
-        sys_py_mod.attr("path").attr("append")(site_pkg_str + "/" + entry->d_name);
+  std::vector<float> predictions(samples.size(), base_score_);
+  std::vector<float> gradients(samples.size());
+  std::vector<int> indices(samples.size());
+  for (int t = 0; t < config_.num_trees; ++t) {
+    // the gradients of the squared error, whose hessians are all ones
+    for (size_t i = 0; i < samples.size(); ++i) {
+      gradients[i] = predictions[i] - labels[i];
+      indices[i]   = i;
+    }
+    Tree tree;
+    BuildNode(bin_thresholds, sample_bins, gradients, &indices, 0, &tree);
+    trees_.push_back(std::move(tree));
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const Tree& last = trees_.back();
+      int node         = 0;
+      while (last[node].feature >= 0) {
+        node = samples[i][last[node].feature] <= last[node].threshold ? last[node].left : last[node].right;
       }
+      predictions[i] += last[node].value;
     }
-    closedir(site_pkg_dir);
   }
+  VLOG(4) << "CostModel trained " << trees_.size() << " trees on " << samples.size() << " samples";
 }
 
-CostModel::CostModel() {
-  std::call_once(init_once_flag_, AddDistPkgToPythonSysPath);
-  pybind11::module cost_model_py_mod = pybind11::module::import("cinn.auto_schedule.cost_model");
-  python_member_                     = cost_model_py_mod.attr("CostModel")();
-}
+int CostModel::BuildNode(const std::vector<std::vector<float>>& bin_thresholds,
+                         const std::vector<std::vector<uint8_t>>& sample_bins,
+                         const std::vector<float>& gradients,
+                         std::vector<int>* indices,
+                         int depth,
+                         Tree* tree) const {
+  int node_index = tree->size();
+  tree->emplace_back();
+  const double lambda = config_.l2_regularization;
+  const int num       = indices->size();
 
-CostModel::~CostModel() {
-  // Do nothing, python_member_ will be destructed after CostModel destructor
-}
+  double grad_sum = 0;
+  for (int i : *indices) {
+    grad_sum += gradients[i];
+  }
+  // the optimal value of a leaf minimizing the regularized squared error
+  tree->at(node_index).value = -grad_sum / (num + lambda) * config_.learning_rate;
+  if (depth >= config_.max_depth || num < 2 * config_.min_samples_in_leaf) {
+    return node_index;
+  }
 
-void CostModel::Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) {
-  pybind11::array np_samples = VectorToNumpy<float>(samples);
-  pybind11::array np_labels  = VectorToNumpy<float>(labels);
+  // find the split with the largest gain on the histograms
+  const double parent_score = grad_sum * grad_sum / (num + lambda);
+  double best_gain          = 1e-6;
+  int best_feature          = -1;
+  int best_bin              = -1;
+  std::vector<double> bin_grads;
+  std::vector<int> bin_counts;
+  for (int f = 0; f < num_features_; ++f) {
+    int num_bins = bin_thresholds[f].size();
+    if (num_bins < 2) continue;
+    bin_grads.assign(num_bins, 0);
+    bin_counts.assign(num_bins, 0);
+    for (int i : *indices) {
+      bin_grads[sample_bins[f][i]] += gradients[i];
+      ++bin_counts[sample_bins[f][i]];
+    }
+    double left_grad = 0;
+    int left_count   = 0;
+    for (int b = 0; b + 1 < num_bins; ++b) {
+      left_grad += bin_grads[b];
+      left_count += bin_counts[b];
+      int right_count = num - left_count;
+      if (left_count < config_.min_samples_in_leaf) continue;
+      if (right_count < config_.min_samples_in_leaf) break;
+      double right_grad  = grad_sum - left_grad;
+      double left_score  = left_grad * left_grad / (left_count + lambda);
+      double right_score = right_grad * right_grad / (right_count + lambda);
+      double gain        = left_score + right_score - parent_score;
+      if (gain > best_gain) {
+        best_gain    = gain;
+        best_feature = f;
+        best_bin     = b;
+      }
+    }
+  }
+  if (best_feature < 0) {
+    return node_index;
+  }
+
+  auto mid =
+      std::partition(indices->begin(), indices->end(), [&](int i) { return sample_bins[best_feature][i] <= best_bin; });
+  std::vector<int> left_indices(indices->begin(), mid);
+  std::vector<int> right_indices(mid, indices->end());
+  int left  = BuildNode(bin_thresholds, sample_bins, gradients, &left_indices, depth + 1, tree);
+  int right = BuildNode(bin_thresholds, sample_bins, gradients, &right_indices, depth + 1, tree);
 
-  python_member_.attr("train")(np_samples, np_labels);
+  TreeNode& node = tree->at(node_index);
+  node.feature   = best_feature;
+  node.threshold = bin_thresholds[best_feature][best_bin];
+  node.left      = left;
+  node.right     = right;
+  return node_index;
 }
 
-std::vector<float> CostModel::Predict(const std::vector<std::vector<float>>& samples) {
-  pybind11::array np_samples = VectorToNumpy<float>(samples);
+float CostModel::PredictOne(const std::vector<float>& sample) const {
+  float result = base_score_;
+  for (const Tree& tree : trees_) {
+    int node = 0;
+    while (tree[node].feature >= 0) {
+      node = sample[tree[node].feature] <= tree[node].threshold ? tree[node].left : tree[node].right;
+    }
+    result += tree[node].value;
+  }
+  return result;
+}
 
-  pybind11::array py_result = python_member_.attr("predict")(np_samples);
-  return py_result.cast<std::vector<float>>();
+std::vector<float> CostModel::Predict(const std::vector<std::vector<float>>& samples) const {
+  std::vector<float> result(samples.size(), 0);
+  if (!IsTrained()) {
+    return result;
+  }
+  for (size_t i = 0; i < samples.size(); ++i) {
+    CHECK_EQ(samples[i].size(), num_features_) << "The sample has a different number of features from the model";
+    result[i] = PredictOne(samples[i]);
+  }
+  return result;
 }
 
 void CostModel::Update(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels) {
-  pybind11::array np_samples = VectorToNumpy<float>(samples);
-  pybind11::array np_labels  = VectorToNumpy<float>(labels);
+  CHECK_EQ(samples.size(), labels.size()) << "The number of samples and labels should be equal";
+  std::vector<std::vector<float>> all_samples(std::move(train_samples_));
+  std::vector<float> all_labels(std::move(train_labels_));
+  all_samples.insert(all_samples.end(), samples.begin(), samples.end());
+  all_labels.insert(all_labels.end(), labels.begin(), labels.end());
+  Train(all_samples, all_labels);
+}
 
-  python_member_.attr("update")(np_samples, np_labels);
+void CostModel::Save(const std::string& path) const {
+  std::ofstream ofs(path);
+  CHECK(ofs.is_open()) << "Failed to open " << path << " to save the CostModel";
+  ofs.precision(std::numeric_limits<float>::max_digits10);
+  ofs << kModelMagic << " " << kModelVersion << "\n";
+  ofs << num_features_ << " " << base_score_ << " " << trees_.size() << "\n";
+  for (const Tree& tree : trees_) {
+    ofs << tree.size() << "\n";
+    for (const TreeNode& node : tree) {
+      ofs << node.feature << " " << node.threshold << " " << node.left << " " << node.right << " " << node.value
+          << "\n";
+    }
+  }
+  CHECK(ofs.good()) << "Failed to save the CostModel to " << path;
 }
 
-void CostModel::Save(const std::string& path) { python_member_.attr("save")(pybind11::str(path)); }
+void CostModel::Load(const std::string& path) {
+  std::ifstream ifs(path);
+  CHECK(ifs.is_open()) << "Failed to open " << path << " to load the CostModel";
+  std::string magic;
+  int version = 0;
+  ifs >> magic >> version;
+  CHECK(magic == kModelMagic && version == kModelVersion) << path << " is not a CostModel of version " << kModelVersion;
 
-void CostModel::Load(const std::string& path) { python_member_.attr("load")(pybind11::str(path)); }
+  size_t num_trees = 0;
+  ifs >> num_features_ >> base_score_ >> num_trees;
+  trees_.assign(num_trees, Tree());
+  for (Tree& tree : trees_) {
+    size_t num_nodes = 0;
+    ifs >> num_nodes;
+    CHECK(!ifs.fail() && num_nodes > 0) << "Invalid tree in " << path;
+    tree.resize(num_nodes);
+    for (int i = 0; i < tree.size(); ++i) {
+      TreeNode& node = tree[i];
+      ifs >> node.feature >> node.threshold >> node.left >> node.right >> node.value;
+      CHECK(!ifs.fail() && node.feature < num_features_) << "Invalid tree node in " << path;
+      if (node.feature < 0) continue;
+      // the children are built after their parent, so a valid tree has no cycles
+      CHECK(node.left > i && node.left < static_cast<int>(num_nodes) && node.right > i &&
+            node.right < static_cast<int>(num_nodes))
+          << "Invalid children " << node.left << ", " << node.right << " of the tree node " << i << " in " << path;
+    }
+  }
+  CHECK(!ifs.fail()) << "Failed to load the CostModel from " << path;
+  // the samples are not saved, so Update trains on the new samples only
+  train_samples_.clear();
+  train_labels_.clear();
+}
 
 }  // namespace auto_schedule
 }  // namespace cinn
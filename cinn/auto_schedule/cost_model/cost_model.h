@@ -14,9 +14,7 @@
 
 #pragma once
 
-#include <pybind11/embed.h>
-
-#include <mutex>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -24,37 +22,80 @@ namespace cinn {
 namespace auto_schedule {
 
 /**
- * A C++ cost model which calls Python cost model via pybind
- *
- * Note: this class doesn't handle Python interpreter lifttime, users should
- * manage scoped_interpreter/initialize_interpreter/finalize_interpreter by
- * themselves. For pybind interpreter lifetime management, see:
+ * A native cost model of gradient boosted regression trees, which predicts
+ * the costs of the schedules from their features, see FeatureExtractor.
  *
- *   https://pybind11.readthedocs.io/en/stable/advanced/embedding.html#interpreter-lifetime
- *   https://pybind11.readthedocs.io/en/stable/reference.html#_CPPv422initialize_interpreterbiPPCKcb
+ * The trees are fitted to the squared error of the labels on histograms of
+ * the features, so training on thousands of samples takes milliseconds and
+ * predicting a sample takes a walk down each tree. Predict is thread-safe,
+ * the other methods should not be called concurrently with it.
  */
 class CostModel {
-  // TODO(zhhsplendid): add CostModelType for C++ interface
  public:
+  struct Config {
+    // The number of boosting rounds, one tree is fitted in each round
+    int num_trees = 64;
+    // The maximum depth of a tree
+    int max_depth = 6;
+    // The shrinkage of the values of the leaves
+    float learning_rate = 0.2f;
+    // The minimum number of samples of a leaf
+    int min_samples_in_leaf = 2;
+    // The L2 regularization on the values of the leaves
+    float l2_regularization = 1.0f;
+    // The maximum number of bins of the histogram of a feature
+    int max_bins = 64;
+  };
+
   CostModel();
-  ~CostModel();
 
+  explicit CostModel(const Config& config);
+
+  // Train the model from scratch with the samples and labels
   void Train(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels);
 
-  std::vector<float> Predict(const std::vector<std::vector<float>>& samples);
+  // Predict the labels of the samples, returns zeros if the model is not trained
+  std::vector<float> Predict(const std::vector<std::vector<float>>& samples) const;
 
+  // Add the samples to the ones trained before and retrain the model
   void Update(const std::vector<std::vector<float>>& samples, const std::vector<float>& labels);
 
-  void Save(const std::string& path);
+  void Save(const std::string& path) const;
 
   void Load(const std::string& path);
 
+  bool IsTrained() const { return !trees_.empty(); }
+
  private:
-  // Object points to Python CostModel
-  pybind11::object python_member_;
+  // A node of a tree, it is a leaf if the feature is negative, otherwise
+  // the samples whose feature is not greater than the threshold go left
+  struct TreeNode {
+    int feature     = -1;
+    float threshold = 0;
+    int left        = -1;
+    int right       = -1;
+    float value     = 0;
+  };
+  using Tree = std::vector<TreeNode>;
+
+  float PredictOne(const std::vector<float>& sample) const;
+
+  // Fit a tree to the gradients of the samples in indices and return the index of its root
+  int BuildNode(const std::vector<std::vector<float>>& bin_thresholds,
+                const std::vector<std::vector<uint8_t>>& sample_bins,
+                const std::vector<float>& gradients,
+                std::vector<int>* indices,
+                int depth,
+                Tree* tree) const;
+
+  Config config_;
+  int num_features_ = 0;
+  float base_score_ = 0;
+  std::vector<Tree> trees_;
 
-  // Flag to call_once on python inititalization function
-  static std::once_flag init_once_flag_;
+  // The samples trained so far, they are trained again by Update
+  std::vector<std::vector<float>> train_samples_;
+  std::vector<float> train_labels_;
 };
 
 }  // namespace auto_schedule
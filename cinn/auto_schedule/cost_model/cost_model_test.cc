@@ -15,41 +15,72 @@
 #include "cinn/auto_schedule/cost_model/cost_model.h"
 
 #include <gtest/gtest.h>
-#include <pybind11/embed.h>
 
+#include <cmath>
 #include <cstdio>
-#include <cstdlib>
-#include <ctime>
+#include <fstream>
+#include <random>
 #include <vector>
 
 namespace cinn {
 namespace auto_schedule {
 
-TEST(CostModel, Basic) {
-  pybind11::scoped_interpreter guard{};
-  CostModel cost_model;
-
-  srand(time(NULL));
+// A label depending on some of the features non-linearly
+static float TargetFunction(const std::vector<float>& sample) {
+  return 2.0f * sample[0] + (sample[1] > 5 ? 3.0f : 0.0f) - sample[2] * sample[3] / 10.0f;
+}
 
-  int batch_size   = 16;
-  int feature_size = 8;
-  std::vector<float> labels(batch_size, 1.0);
-  std::vector<std::vector<float>> samples(batch_size, std::vector<float>(feature_size));
-  for (int i = 0; i < batch_size; ++i) {
-    for (int j = 0; j < feature_size; ++j) {
-      samples[i][j] = rand() % 10;
+static void GenerateSamples(int num,
+                            int feature_size,
+                            std::vector<std::vector<float>>* samples,
+                            std::vector<float>* labels) {
+  std::default_random_engine engine(num);
+  std::uniform_real_distribution<float> dist(0.0f, 10.0f);
+  for (int i = 0; i < num; ++i) {
+    std::vector<float> sample(feature_size);
+    for (float& value : sample) {
+      value = dist(engine);
     }
+    labels->push_back(TargetFunction(sample));
+    samples->push_back(std::move(sample));
   }
+}
 
+TEST(CostModel, Basic) {
+  int feature_size = 8;
+  std::vector<std::vector<float>> samples;
+  std::vector<float> labels;
+  GenerateSamples(512, feature_size, &samples, &labels);
+
+  CostModel cost_model;
+  ASSERT_FALSE(cost_model.IsTrained());
   cost_model.Train(samples, labels);
-  std::vector<float> pred = cost_model.Predict(samples);
+  ASSERT_TRUE(cost_model.IsTrained());
+
+  // the model should fit the unseen samples much better than the mean
+  std::vector<std::vector<float>> test_samples;
+  std::vector<float> test_labels;
+  GenerateSamples(128, feature_size, &test_samples, &test_labels);
+  std::vector<float> pred = cost_model.Predict(test_samples);
+  ASSERT_EQ(pred.size(), test_samples.size());
+  double mean = 0;
+  for (float label : test_labels) {
+    mean += label / test_labels.size();
+  }
+  double model_error = 0;
+  double mean_error  = 0;
+  for (size_t i = 0; i < pred.size(); ++i) {
+    model_error += (pred[i] - test_labels[i]) * (pred[i] - test_labels[i]);
+    mean_error += (mean - test_labels[i]) * (mean - test_labels[i]);
+  }
+  EXPECT_LT(model_error, 0.2 * mean_error);
 
   std::string path = "./test_cost_model.cpp_save_model";
   cost_model.Save(path);
 
   CostModel load_cost_model;
   load_cost_model.Load(path);
-  std::vector<float> load_pred = cost_model.Predict(samples);
+  std::vector<float> load_pred = load_cost_model.Predict(test_samples);
 
   ASSERT_EQ(pred.size(), load_pred.size());
   for (size_t i = 0; i < pred.size(); ++i) {
@@ -58,5 +89,56 @@ TEST(CostModel, Basic) {
   std::remove(path.c_str());
 }
 
+TEST(CostModel, Update) {
+  int feature_size = 4;
+  std::vector<std::vector<float>> samples;
+  std::vector<float> labels;
+  GenerateSamples(64, feature_size, &samples, &labels);
+
+  CostModel::Config config;
+  config.num_trees = 16;
+  CostModel cost_model(config);
+  // an untrained model predicts zeros
+  for (float pred : cost_model.Predict(samples)) {
+    ASSERT_EQ(pred, 0.0f);
+  }
+  std::vector<std::vector<float>> first_half(samples.begin(), samples.begin() + 32);
+  std::vector<std::vector<float>> second_half(samples.begin() + 32, samples.end());
+  cost_model.Update(first_half, std::vector<float>(labels.begin(), labels.begin() + 32));
+  cost_model.Update(second_half, std::vector<float>(labels.begin() + 32, labels.end()));
+
+  // updating with two halves is the same as training with all of them
+  CostModel all_cost_model(config);
+  all_cost_model.Train(samples, labels);
+  std::vector<float> pred     = cost_model.Predict(samples);
+  std::vector<float> all_pred = all_cost_model.Predict(samples);
+  for (size_t i = 0; i < pred.size(); ++i) {
+    ASSERT_FLOAT_EQ(pred[i], all_pred[i]);
+  }
+}
+
+TEST(CostModel, LoadInvalidTree) {
+  std::string path = "./test_cost_model.cpp_invalid_model";
+  auto write_model = [&path](const std::string& nodes) {
+    std::ofstream ofs(path);
+    ofs << "cinn_gbdt_cost_model 1\n2 0.5 1\n3\n" << nodes;
+  };
+  CostModel cost_model;
+  // a child out of the tree
+  write_model("0 1.5 1 3 0\n-1 0 -1 -1 0.25\n-1 0 -1 -1 -0.25\n");
+  ASSERT_DEATH(cost_model.Load(path), "");
+  // a child referring to its parent forms a cycle
+  write_model("0 1.5 1 0 0\n-1 0 -1 -1 0.25\n-1 0 -1 -1 -0.25\n");
+  ASSERT_DEATH(cost_model.Load(path), "");
+
+  write_model("0 1.5 1 2 0\n-1 0 -1 -1 0.25\n-1 0 -1 -1 -0.25\n");
+  cost_model.Load(path);
+  std::vector<float> pred = cost_model.Predict({{1, 0}, {2, 0}});
+  ASSERT_EQ(pred.size(), 2UL);
+  EXPECT_FLOAT_EQ(pred[0], 0.75f);
+  EXPECT_FLOAT_EQ(pred[1], 0.25f);
+  std::remove(path.c_str());
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
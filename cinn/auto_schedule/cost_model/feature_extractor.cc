@@ -0,0 +1,357 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/feature_extractor.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_mutator.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/optim/count_float_ops.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+namespace {
+
+struct LoopInfo {
+  std::string var_name;
+  double extent;
+  bool is_parallel;
+  bool is_unrolled;
+  bool is_binded;
+};
+
+// Collects the raw statistics of the exprs, they are normalized in Extract
+class FeatureCollector : public ir::IRMutator<const Expr*> {
+ public:
+  FeatureCollector() : raw_(FeatureExtractor::kNumFeatures, 0.0) {}
+
+  void Collect(const Expr* expr) {
+    raw_[FeatureExtractor::kFloatOps] += optim::CountFloatOps(*expr);
+    Visit(expr, expr);
+  }
+
+  // Fill the ratios and the derived features, then normalize the counts
+  std::vector<float> Finalize() const {
+    std::vector<double> raw(raw_);
+    double num_accesses = raw[FeatureExtractor::kLoads] + raw[FeatureExtractor::kStores];
+    if (num_accesses > 0) {
+      raw[FeatureExtractor::kStrideZeroRatio] /= num_accesses;
+      raw[FeatureExtractor::kStrideOneRatio] /= num_accesses;
+      raw[FeatureExtractor::kStrideLargeRatio] /= num_accesses;
+      raw[FeatureExtractor::kStrideUnknownRatio] /= num_accesses;
+      raw[FeatureExtractor::kAvgStrideBytes] /= num_accesses;
+    }
+    for (auto& item : tensor_footprints_) {
+      raw[FeatureExtractor::kFootprintBytes] += item.second;
+    }
+    double arith_ops = raw[FeatureExtractor::kFloatOps] + raw[FeatureExtractor::kIntOps];
+    raw[FeatureExtractor::kArithmeticIntensity] = arith_ops / std::max(raw[FeatureExtractor::kFootprintBytes], 1.0);
+
+    std::vector<float> features(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+      bool is_ratio = i >= FeatureExtractor::kStrideZeroRatio && i <= FeatureExtractor::kStrideUnknownRatio;
+      features[i]   = is_ratio ? raw[i] : std::log2(1.0 + raw[i]);
+    }
+    return features;
+  }
+
+ private:
+  void Visit(const Expr* expr, const Expr* op) override { IRMutator::Visit(expr, op); }
+
+  void Visit(const ir::For* expr, const Expr* op) override {
+    double extent = expr->extent.is_constant() ? std::max(expr->extent.get_constant(), 1.0) : 1.0;
+    loops_.push_back({expr->loop_var->name, extent, expr->is_parallel(), expr->is_unrolled(), expr->is_binded()});
+    raw_[FeatureExtractor::kNumLoops] += 1;
+    raw_[FeatureExtractor::kMaxLoopDepth] =
+        std::max(raw_[FeatureExtractor::kMaxLoopDepth], static_cast<double>(loops_.size()));
+    if (expr->is_vectorized()) {
+      raw_[FeatureExtractor::kVectorizedExtent] = std::max(raw_[FeatureExtractor::kVectorizedExtent], extent);
+    }
+    Visit(&expr->body, &expr->body);
+    loops_.pop_back();
+  }
+
+  void Visit(const ir::ScheduleBlockRealize* expr, const Expr* op) override {
+    auto* block = expr->schedule_block.As<ir::ScheduleBlock>();
+    CHECK(block) << "The schedule_block of ScheduleBlockRealize should be a ScheduleBlock";
+    for (size_t i = 0; i < block->iter_vars.size() && i < expr->iter_values.size(); ++i) {
+      iter_bindings_[block->iter_vars[i]->name] = expr->iter_values[i];
+    }
+    raw_[FeatureExtractor::kNumBlocks] += 1;
+    // the buffer regions of the block are not executed
+    Visit(&block->body, &block->body);
+  }
+
+  void Visit(const ir::Store* expr, const Expr* op) override {
+    double iterations = Iterations();
+    raw_[FeatureExtractor::kIterations] += iterations;
+    raw_[FeatureExtractor::kStores] += iterations;
+    RecordLoopAnnotations();
+    RecordAccess(expr->tensor, expr->indices, iterations);
+    // the index arithmetic is usually simplified by the compiler, so only the value is counted
+    Visit(&expr->value, &expr->value);
+  }
+
+  void Visit(const ir::Load* expr, const Expr* op) override {
+    double iterations = Iterations();
+    raw_[FeatureExtractor::kLoads] += iterations;
+    RecordAccess(expr->tensor, expr->indices, iterations);
+  }
+
+  void Visit(const ir::Call* expr, const Expr* op) override {
+    raw_[FeatureExtractor::kCallOps] += Iterations();
+    IRMutator::Visit(expr, op);
+  }
+
+  void Visit(const ir::Select* expr, const Expr* op) override {
+    raw_[FeatureExtractor::kCompareOps] += Iterations();
+    IRMutator::Visit(expr, op);
+  }
+
+#define __(op__)                                                 \
+  void Visit(const ir::op__* expr, const Expr* op) override {    \
+    AddArithOp(expr->type());                                    \
+    IRMutator::Visit(expr, op);                                  \
+  }
+  __(Add)
+  __(Sub)
+  __(Mul)
+  __(Div)
+  __(Mod)
+  __(Min)
+  __(Max)
+  __(Minus)
+#undef __
+
+#define __(op__)                                                 \
+  void Visit(const ir::op__* expr, const Expr* op) override {    \
+    raw_[FeatureExtractor::kCompareOps] += Iterations();         \
+    IRMutator::Visit(expr, op);                                  \
+  }
+  __(EQ)
+  __(NE)
+  __(LT)
+  __(LE)
+  __(GT)
+  __(GE)
+  __(And)
+  __(Or)
+  __(Not)
+#undef __
+
+  double Iterations() const {
+    double iterations = 1.0;
+    for (auto& loop : loops_) {
+      iterations *= loop.extent;
+    }
+    return iterations;
+  }
+
+  // Update the extents of the annotated loops around the current statement
+  void RecordLoopAnnotations() {
+    double parallel_extent = 1.0;
+    double unrolled_extent = 1.0;
+    double bind_extent     = 1.0;
+    for (auto& loop : loops_) {
+      parallel_extent *= loop.is_parallel ? loop.extent : 1.0;
+      unrolled_extent *= loop.is_unrolled ? loop.extent : 1.0;
+      bind_extent *= loop.is_binded ? loop.extent : 1.0;
+    }
+    raw_[FeatureExtractor::kParallelExtent] = std::max(raw_[FeatureExtractor::kParallelExtent], parallel_extent);
+    raw_[FeatureExtractor::kUnrolledExtent] = std::max(raw_[FeatureExtractor::kUnrolledExtent], unrolled_extent);
+    raw_[FeatureExtractor::kGpuBindExtent]  = std::max(raw_[FeatureExtractor::kGpuBindExtent], bind_extent);
+  }
+
+  // the float operations are counted by optim::CountFloatOps
+  void AddArithOp(const common::Type& type) {
+    if (!type.is_float()) {
+      raw_[FeatureExtractor::kIntOps] += Iterations() * std::max(type.lanes(), 1);
+    }
+  }
+
+  // Get the coefficient of a loop variable in an index expression,
+  // returns false if the expression is not linear to it
+  bool Coefficient(const Expr& expr, const std::string& var_name, double* coef) const {
+    if (expr.is_constant()) {
+      *coef = 0;
+      return true;
+    }
+    if (auto* var = expr.As<ir::_Var_>()) {
+      if (var->name == var_name) {
+        *coef = 1;
+        return true;
+      }
+      auto it = iter_bindings_.find(var->name);
+      if (it != iter_bindings_.end()) {
+        return Coefficient(it->second, var_name, coef);
+      }
+      // another loop variable
+      *coef = 0;
+      return true;
+    }
+    if (auto* cast = expr.As<ir::Cast>()) {
+      return Coefficient(cast->v(), var_name, coef);
+    }
+    double lhs = 0;
+    double rhs = 0;
+    if (auto* add = expr.As<ir::Add>()) {
+      if (!Coefficient(add->a(), var_name, &lhs) || !Coefficient(add->b(), var_name, &rhs)) return false;
+      *coef = lhs + rhs;
+      return true;
+    }
+    if (auto* sub = expr.As<ir::Sub>()) {
+      if (!Coefficient(sub->a(), var_name, &lhs) || !Coefficient(sub->b(), var_name, &rhs)) return false;
+      *coef = lhs - rhs;
+      return true;
+    }
+    if (auto* mul = expr.As<ir::Mul>()) {
+      if (mul->b().is_constant() && Coefficient(mul->a(), var_name, &lhs)) {
+        *coef = lhs * mul->b().get_constant();
+        return true;
+      }
+      if (mul->a().is_constant() && Coefficient(mul->b(), var_name, &rhs)) {
+        *coef = rhs * mul->a().get_constant();
+        return true;
+      }
+      if (Coefficient(mul->a(), var_name, &lhs) && Coefficient(mul->b(), var_name, &rhs) && lhs == 0 && rhs == 0) {
+        *coef = 0;
+        return true;
+      }
+      return false;
+    }
+    if (auto* div = expr.As<ir::Div>()) {
+      if (Coefficient(div->a(), var_name, &lhs) && Coefficient(div->b(), var_name, &rhs) && lhs == 0 && rhs == 0) {
+        *coef = 0;
+        return true;
+      }
+      return false;
+    }
+    if (auto* mod = expr.As<ir::Mod>()) {
+      if (Coefficient(mod->a(), var_name, &lhs) && Coefficient(mod->b(), var_name, &rhs) && lhs == 0 && rhs == 0) {
+        *coef = 0;
+        return true;
+      }
+      return false;
+    }
+    return false;
+  }
+
+  void RecordAccess(const Expr& tensor_expr, const std::vector<Expr>& indices, double iterations) {
+    auto* tensor = tensor_expr.As<ir::_Tensor_>();
+    if (!tensor) return;
+    double bytes = std::max((tensor->type().bits() + 7) / 8, 1) * std::max(tensor->type().lanes(), 1);
+    raw_[FeatureExtractor::kBytesAccessed] += bytes * iterations;
+
+    // the stride of each index in the flattened buffer
+    std::vector<double> dim_strides(indices.size(), 1.0);
+    for (int i = static_cast<int>(indices.size()) - 2; i >= 0; --i) {
+      double dim = i + 1 < tensor->shape.size() && tensor->shape[i + 1].is_constant()
+                       ? tensor->shape[i + 1].get_constant()
+                       : 1.0;
+      dim_strides[i] = dim_strides[i + 1] * dim;
+    }
+    // the stride of a loop variable in the flattened buffer, returns false if it is unknown
+    auto loop_stride = [&](const std::string& var_name, double* stride) {
+      *stride = 0;
+      for (size_t i = 0; i < indices.size(); ++i) {
+        double coef = 0;
+        if (!Coefficient(indices[i], var_name, &coef)) return false;
+        *stride += coef * dim_strides[i];
+      }
+      return true;
+    };
+
+    double footprint = bytes;
+    for (size_t i = 0; i < loops_.size(); ++i) {
+      double stride = 0;
+      bool known    = loop_stride(loops_[i].var_name, &stride);
+      if (!known || stride != 0) {
+        footprint *= loops_[i].extent;
+      }
+      if (i + 1 != loops_.size()) continue;
+      // the innermost loop
+      if (!known) {
+        raw_[FeatureExtractor::kStrideUnknownRatio] += iterations;
+      } else if (stride == 0) {
+        raw_[FeatureExtractor::kStrideZeroRatio] += iterations;
+      } else if (std::abs(stride) == 1) {
+        raw_[FeatureExtractor::kStrideOneRatio] += iterations;
+      } else {
+        raw_[FeatureExtractor::kStrideLargeRatio] += iterations;
+      }
+      raw_[FeatureExtractor::kAvgStrideBytes] += (known ? std::abs(stride) : 1.0) * bytes * iterations;
+    }
+    if (loops_.empty()) {
+      raw_[FeatureExtractor::kStrideZeroRatio] += iterations;
+    } else {
+      raw_[FeatureExtractor::kInnermostExtent] =
+          std::max(raw_[FeatureExtractor::kInnermostExtent], loops_.back().extent);
+    }
+    double& tensor_footprint = tensor_footprints_[tensor->name];
+    tensor_footprint         = std::max(tensor_footprint, footprint);
+  }
+
+  std::vector<double> raw_;
+  std::vector<LoopInfo> loops_;
+  std::unordered_map<std::string, Expr> iter_bindings_;
+  std::unordered_map<std::string, double> tensor_footprints_;
+};
+
+}  // namespace
+
+std::vector<float> FeatureExtractor::Extract(const ir::ModuleExpr& mod_expr) {
+  FeatureCollector collector;
+  for (const Expr& expr : mod_expr.GetExprs()) {
+    collector.Collect(&expr);
+  }
+  return collector.Finalize();
+}
+
+std::string FeatureExtractor::FeatureName(int index) {
+  static const char* names[kNumFeatures] = {"float_ops",
+                                            "int_ops",
+                                            "call_ops",
+                                            "compare_ops",
+                                            "loads",
+                                            "stores",
+                                            "iterations",
+                                            "num_loops",
+                                            "max_loop_depth",
+                                            "innermost_extent",
+                                            "parallel_extent",
+                                            "vectorized_extent",
+                                            "unrolled_extent",
+                                            "gpu_bind_extent",
+                                            "stride_zero_ratio",
+                                            "stride_one_ratio",
+                                            "stride_large_ratio",
+                                            "stride_unknown_ratio",
+                                            "avg_stride_bytes",
+                                            "bytes_accessed",
+                                            "footprint_bytes",
+                                            "arithmetic_intensity",
+                                            "num_blocks"};
+  CHECK(index >= 0 && index < kNumFeatures) << "Invalid feature index " << index;
+  return names[index];
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,72 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+/**
+ * Extract a fixed length feature vector from a ModuleExpr for the cost model.
+ *
+ * The features describe the loops (extents, depth, parallel, vectorized and
+ * unrolled annotations), the computation (arithmetic operations weighted by
+ * the iterations they run) and the memory accesses (strides of the innermost
+ * loop, bytes accessed, footprint and arithmetic intensity). The counts are
+ * taken as log2(1 + x) to keep the features in a small range.
+ */
+class FeatureExtractor {
+ public:
+  enum FeatureIndex {
+    kFloatOps = 0,         // float arithmetic operations
+    kIntOps,               // integer arithmetic operations
+    kCallOps,              // calls of math functions, such as exp
+    kCompareOps,           // comparisons and select operations
+    kLoads,                // executed loads
+    kStores,               // executed stores
+    kIterations,           // executed iterations of the statements
+    kNumLoops,             // number of loops
+    kMaxLoopDepth,         // max depth of the loop nests
+    kInnermostExtent,      // max extent of the innermost loops
+    kParallelExtent,       // max product of the parallel loop extents
+    kVectorizedExtent,     // max extent of the vectorized loops
+    kUnrolledExtent,       // max product of the unrolled loop extents
+    kGpuBindExtent,        // max product of the loop extents bound to gpu
+    kStrideZeroRatio,      // ratio of the accesses invariant to the innermost loop
+    kStrideOneRatio,       // ratio of the contiguous accesses
+    kStrideLargeRatio,     // ratio of the accesses with a constant stride larger than one
+    kStrideUnknownRatio,   // ratio of the accesses with an unknown stride
+    kAvgStrideBytes,       // average stride in bytes of the innermost loop
+    kBytesAccessed,        // executed bytes of loads and stores
+    kFootprintBytes,       // distinct bytes touched by the accesses
+    kArithmeticIntensity,  // arithmetic operations per footprint byte
+    kNumBlocks,            // number of the schedule blocks
+    kNumFeatures
+  };
+
+  // Extract the feature of all the exprs of the ModuleExpr
+  static std::vector<float> Extract(const ir::ModuleExpr& mod_expr);
+
+  // Return the readable name of a feature, used for logging
+  static std::string FeatureName(int index);
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
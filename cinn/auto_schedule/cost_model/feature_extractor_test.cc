@@ -0,0 +1,81 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/feature_extractor.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/lang/compute.h"
+#include "cinn/lang/lower.h"
+#include "cinn/optim/ir_copy.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+TEST(FeatureExtractor, SimpleLoops) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+
+  Expr M(32);
+  Expr N(128);
+
+  Placeholder<float> A("A", {M});
+  Placeholder<float> B("B", {N});
+
+  ir::Tensor C = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i) + B(j); }, "C");
+
+  poly::StageMap stages = CreateStages({C});
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestFeatureExtractor_SimpleLoops", stages, {C}, {}, {}, nullptr, target, true);
+
+  ir::ModuleExpr mod_expr(std::vector<ir::Expr>{optim::IRCopy(funcs[0]->body)});
+  std::vector<float> features = FeatureExtractor::Extract(mod_expr);
+  ASSERT_EQ(features.size(), FeatureExtractor::kNumFeatures);
+
+  const float log_iterations = std::log2(1.0f + 32 * 128);
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kFloatOps], log_iterations);
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kStores], log_iterations);
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kLoads], std::log2(1.0f + 2 * 32 * 128));
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kMaxLoopDepth], std::log2(3.0f));
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kInnermostExtent], std::log2(129.0f));
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kParallelExtent], 1.0f);
+  // A(i) is invariant to the innermost loop, B(j) and C(i, j) are contiguous
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kStrideZeroRatio], 1.0f / 3);
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kStrideOneRatio], 2.0f / 3);
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kStrideUnknownRatio], 0.0f);
+  // A, B and C are touched entirely
+  EXPECT_FLOAT_EQ(features[FeatureExtractor::kFootprintBytes], std::log2(1.0f + 4 * (32 + 128 + 32 * 128)));
+
+  // parallelize the outer loop of a copy
+  ir::IRSchedule ir_sch(ir::ModuleExpr(std::vector<ir::Expr>{optim::IRCopy(funcs[0]->body)}));
+  std::vector<ir::Expr> loops = ir_sch.GetLoops("C");
+  ASSERT_EQ(loops.size(), 2UL);
+  ir_sch.Parallel(loops[0]);
+  std::vector<float> parallel_features = FeatureExtractor::Extract(ir_sch.GetModule());
+  EXPECT_FLOAT_EQ(parallel_features[FeatureExtractor::kParallelExtent], std::log2(33.0f));
+  EXPECT_FLOAT_EQ(parallel_features[FeatureExtractor::kFloatOps], features[FeatureExtractor::kFloatOps]);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,213 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/database/database.h"
+
+#include <glog/logging.h>
+#include <google/protobuf/util/json_util.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+#include "cinn/auto_schedule/database/tuning_record.pb.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+Database::Database(int capacity_per_task) : capacity_per_task_(capacity_per_task) {
+  CHECK_GT(capacity_per_task_, 0) << "The capacity of a task in the database should be positive";
+}
+
+std::unique_ptr<Database> Database::Make(const DatabaseConfig& config) {
+  if (config.record_file_path.empty()) {
+    return std::make_unique<Database>(config.capacity_per_task);
+  }
+  return std::make_unique<JSONFileDatabase>(config.capacity_per_task, config.record_file_path);
+}
+
+bool Database::AddRecordInMemory(const TuningRecord& record) {
+  auto iter = key2records_.find(record.task_key);
+  if (iter == key2records_.end()) {
+    utils::SizedMultiSet<TuningRecord, TuningRecord::Compare> records(capacity_per_task_);
+    iter = key2records_.emplace(record.task_key, std::move(records)).first;
+  }
+  auto& records = iter->second;
+  if (records.Size() >= static_cast<size_t>(capacity_per_task_) &&
+      record.result.execution_cost >= records.MaxValue().result.execution_cost) {
+    return false;
+  }
+  records.Push(record);
+  return true;
+}
+
+bool Database::AddRecord(const TuningRecord& record) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!AddRecordInMemory(record)) {
+    return false;
+  }
+  Commit(record);
+  return true;
+}
+
+std::vector<TuningRecord> Database::GetTopK(const std::string& task_key, int k) const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto iter = key2records_.find(task_key);
+  if (iter == key2records_.end()) {
+    return {};
+  }
+  auto records = iter->second.ReturnAsContainer<std::vector<TuningRecord>>();
+  if (records.size() > std::max(k, 0)) {
+    records.resize(std::max(k, 0));
+  }
+  return records;
+}
+
+std::vector<TuningRecord> Database::GetAllRecords() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  std::vector<TuningRecord> res;
+  for (auto& item : key2records_) {
+    auto records = item.second.ReturnAsContainer<std::vector<TuningRecord>>();
+    res.insert(res.end(), records.begin(), records.end());
+  }
+  return res;
+}
+
+size_t Database::Size(const std::string& task_key) const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto iter = key2records_.find(task_key);
+  return iter == key2records_.end() ? 0 : iter->second.Size();
+}
+
+namespace {
+void ToProto(const ScheduleTrace& trace, proto::ScheduleTrace* proto_trace) {
+  for (const ScheduleStep& step : trace) {
+    auto* proto_step = proto_trace->add_steps();
+    proto_step->set_rule_name(step.rule_name);
+    proto_step->set_apply_index(step.apply_index);
+    for (int bit : step.cross_over_mask) {
+      proto_step->add_cross_over_mask(bit);
+    }
+    if (step.other_parent) {
+      ToProto(*step.other_parent, proto_step->mutable_other_parent());
+    }
+  }
+}
+
+void FromProto(const proto::ScheduleTrace& proto_trace, ScheduleTrace* trace) {
+  for (const auto& proto_step : proto_trace.steps()) {
+    ScheduleStep step;
+    step.rule_name   = proto_step.rule_name();
+    step.apply_index = proto_step.apply_index();
+    step.cross_over_mask.assign(proto_step.cross_over_mask().begin(), proto_step.cross_over_mask().end());
+    if (proto_step.has_other_parent()) {
+      auto other_trace = std::make_shared<ScheduleTrace>();
+      FromProto(proto_step.other_parent(), other_trace.get());
+      step.other_parent = std::move(other_trace);
+    }
+    trace->push_back(std::move(step));
+  }
+}
+}  // namespace
+
+JSONFileDatabase::JSONFileDatabase(int capacity_per_task, const std::string& record_file_path)
+    : Database(capacity_per_task), record_file_path_(record_file_path) {
+  std::ifstream ifs(record_file_path_);
+  if (!ifs.is_open()) {
+    VLOG(3) << "The tuning record file " << record_file_path_ << " doesn't exist, start with an empty database";
+    return;
+  }
+  int num_records = 0;
+  int num_invalid = 0;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.empty()) continue;
+    TuningRecord record;
+    if (!JSONToRecord(line, &record)) {
+      ++num_invalid;
+      continue;
+    }
+    AddRecordInMemory(record);
+    ++num_records;
+  }
+  ifs.close();
+  if (num_invalid > 0) {
+    LOG(WARNING) << "Skip " << num_invalid << " invalid lines in the tuning record file " << record_file_path_;
+  }
+  VLOG(3) << "Load " << num_records << " tuning records from " << record_file_path_;
+
+  // the file is appended by every tuning run, rewrite it with the kept records only
+  if (GetAllRecords().size() < static_cast<size_t>(num_records) || num_invalid > 0) {
+    Compact();
+  }
+}
+
+void JSONFileDatabase::Compact() {
+  std::string tmp_path = record_file_path_ + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::trunc);
+    if (!ofs.is_open()) {
+      LOG(WARNING) << "Failed to compact the tuning record file " << record_file_path_;
+      return;
+    }
+    for (auto& record : GetAllRecords()) {
+      ofs << RecordToJSON(record) << "\n";
+    }
+  }
+  if (std::rename(tmp_path.c_str(), record_file_path_.c_str()) != 0) {
+    LOG(WARNING) << "Failed to compact the tuning record file " << record_file_path_;
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  VLOG(3) << "Compact the tuning record file " << record_file_path_;
+}
+
+std::string JSONFileDatabase::RecordToJSON(const TuningRecord& record) {
+  proto::TuningRecord proto_record;
+  proto_record.set_task_key(record.task_key);
+  proto_record.set_execution_cost(record.result.execution_cost);
+  proto_record.set_elapsed_time(record.result.elapsed_time);
+  ToProto(record.trace, proto_record.mutable_trace());
+
+  std::string json;
+  auto status = google::protobuf::util::MessageToJsonString(proto_record, &json);
+  CHECK(status.ok()) << "Failed to serialize the tuning record: " << status.ToString();
+  return json;
+}
+
+bool JSONFileDatabase::JSONToRecord(const std::string& json, TuningRecord* record) {
+  proto::TuningRecord proto_record;
+  if (!google::protobuf::util::JsonStringToMessage(json, &proto_record).ok()) {
+    return false;
+  }
+  record->task_key              = proto_record.task_key();
+  record->result.execution_cost = proto_record.execution_cost();
+  record->result.elapsed_time   = proto_record.elapsed_time();
+  record->trace.clear();
+  FromProto(proto_record.trace(), &record->trace);
+  return true;
+}
+
+void JSONFileDatabase::Commit(const TuningRecord& record) {
+  std::ofstream ofs(record_file_path_, std::ios::app);
+  if (!ofs.is_open()) {
+    LOG(WARNING) << "Failed to open the tuning record file " << record_file_path_;
+    return;
+  }
+  ofs << RecordToJSON(record) << "\n";
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
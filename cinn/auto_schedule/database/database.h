@@ -0,0 +1,118 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cinn/auto_schedule/measure/measure.h"
+#include "cinn/auto_schedule/search_space/search_state.h"
+#include "cinn/utils/sized_multi_set.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// A measured schedule of a task
+struct TuningRecord {
+  // TuneTask::serialized_key of the task, which includes the target
+  std::string task_key;
+  // the schedule applied to the un-optimized task
+  ScheduleTrace trace;
+  // the measured cost of the schedule
+  MeasureResult result;
+
+  // records with lower execution cost are better
+  struct Compare {
+    bool operator()(const TuningRecord& lhs, const TuningRecord& rhs) const {
+      return lhs.result.execution_cost < rhs.result.execution_cost;
+    }
+  };
+};
+
+// Options to create a Database
+struct DatabaseConfig {
+  // The maximum number of records kept for a task, only the best ones are kept.
+  int capacity_per_task = 16;
+  // The JSON-lines file the records are loaded from and appended to,
+  // the records are only kept in memory if it is empty.
+  std::string record_file_path = "";
+};
+
+// The database of the measured schedules of tasks. It keeps the best records of
+// every task in memory, and returns them to the search and the compilation of
+// the tasks with the same structure later. It is thread-safe.
+class Database {
+ public:
+  explicit Database(int capacity_per_task);
+  virtual ~Database() = default;
+
+  // Create an in-memory database, or a persistent one if the record file is set.
+  static std::unique_ptr<Database> Make(const DatabaseConfig& config);
+
+  // Add a record, returns true if it is among the best records of its task
+  bool AddRecord(const TuningRecord& record);
+
+  // Return the best k records of a task, sorted by the execution cost
+  std::vector<TuningRecord> GetTopK(const std::string& task_key, int k) const;
+
+  // Return the number of records of a task
+  size_t Size(const std::string& task_key) const;
+
+ protected:
+  // Called after a record is added into the memory, under the lock
+  virtual void Commit(const TuningRecord& record) {}
+
+  // Add a record into the memory without committing it, returns true if it is kept
+  bool AddRecordInMemory(const TuningRecord& record);
+
+  // Return the records of all the tasks kept in the memory
+  std::vector<TuningRecord> GetAllRecords() const;
+
+ private:
+  int capacity_per_task_;
+  mutable std::mutex mtx_;
+  std::unordered_map<std::string, utils::SizedMultiSet<TuningRecord, TuningRecord::Compare>> key2records_;
+};
+
+// A database that persists the records to a JSON-lines file, one record per
+// line in the JSON mapping of proto::TuningRecord. The file is loaded on
+// construction, and the new records among the best ones are appended to it,
+// so it can be shared by later tuning runs. The file is compacted to the kept
+// records on load, so it doesn't grow with the number of runs.
+class JSONFileDatabase : public Database {
+ public:
+  JSONFileDatabase(int capacity_per_task, const std::string& record_file_path);
+
+  // Serialize a record to a line of JSON without the line break
+  static std::string RecordToJSON(const TuningRecord& record);
+
+  // Parse a line of JSON to a record, returns false if the line is invalid
+  static bool JSONToRecord(const std::string& json, TuningRecord* record);
+
+ protected:
+  void Commit(const TuningRecord& record) override;
+
+ private:
+  // Rewrite the record file with the records kept in the memory
+  void Compact();
+
+  std::string record_file_path_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,130 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/database/database.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace cinn {
+namespace auto_schedule {
+
+TuningRecord MakeRecord(const std::string& task_key, double cost) {
+  TuningRecord record;
+  record.task_key              = task_key;
+  record.result.execution_cost = cost;
+  record.result.elapsed_time   = cost * 10;
+  ScheduleStep step;
+  step.rule_name   = "MultiLevelTiling";
+  step.apply_index = static_cast<int>(cost);
+  record.trace.push_back(step);
+  return record;
+}
+
+TEST(Database, KeepBestRecords) {
+  Database database(2);
+  EXPECT_TRUE(database.AddRecord(MakeRecord("task0", 3)));
+  EXPECT_TRUE(database.AddRecord(MakeRecord("task0", 1)));
+  // worse than all the kept records
+  EXPECT_FALSE(database.AddRecord(MakeRecord("task0", 5)));
+  EXPECT_TRUE(database.AddRecord(MakeRecord("task0", 2)));
+  EXPECT_TRUE(database.AddRecord(MakeRecord("task1", 7)));
+
+  ASSERT_EQ(database.Size("task0"), 2UL);
+  auto top = database.GetTopK("task0", 3);
+  ASSERT_EQ(top.size(), 2UL);
+  EXPECT_EQ(top[0].result.execution_cost, 1);
+  EXPECT_EQ(top[1].result.execution_cost, 2);
+  EXPECT_EQ(database.GetTopK("task0", 1).size(), 1UL);
+  EXPECT_EQ(database.GetTopK("task1", 1)[0].trace[0].apply_index, 7);
+  EXPECT_TRUE(database.GetTopK("task2", 1).empty());
+}
+
+TEST(JSONFileDatabase, Serialize) {
+  TuningRecord record = MakeRecord("target:x86\n{\"a\"\t\\b}", 0.125);
+  ScheduleStep cross_over;
+  cross_over.cross_over_mask = {0, 1};
+  cross_over.other_parent    = std::make_shared<ScheduleTrace>(record.trace);
+  record.trace.push_back(cross_over);
+
+  std::string json = JSONFileDatabase::RecordToJSON(record);
+  EXPECT_EQ(json.find('\n'), std::string::npos);
+  TuningRecord parsed;
+  ASSERT_TRUE(JSONFileDatabase::JSONToRecord(json, &parsed));
+  EXPECT_EQ(parsed.task_key, record.task_key);
+  EXPECT_EQ(parsed.result.execution_cost, 0.125);
+  EXPECT_EQ(parsed.result.elapsed_time, 1.25);
+  ASSERT_EQ(parsed.trace.size(), 2UL);
+  EXPECT_EQ(parsed.trace[0].rule_name, "MultiLevelTiling");
+  EXPECT_EQ(parsed.trace[1].cross_over_mask, std::vector<int>({0, 1}));
+  ASSERT_TRUE(parsed.trace[1].other_parent);
+  EXPECT_EQ(parsed.trace[1].other_parent->size(), 1UL);
+
+  EXPECT_FALSE(JSONFileDatabase::JSONToRecord("{\"task_key\":\"t\"", &parsed));
+  EXPECT_FALSE(JSONFileDatabase::JSONToRecord("{\"task_key\":\"t\",\"trace\":3}", &parsed));
+}
+
+TEST(JSONFileDatabase, Persist) {
+  std::string path = "./test_database_" + std::to_string(getpid()) + ".json";
+  std::remove(path.c_str());
+  {
+    DatabaseConfig config;
+    config.capacity_per_task = 2;
+    config.record_file_path  = path;
+    auto database            = Database::Make(config);
+    database->AddRecord(MakeRecord("task0", 3));
+    database->AddRecord(MakeRecord("task0", 1));
+    database->AddRecord(MakeRecord("task1", 2));
+  }
+  JSONFileDatabase database(2, path);
+  EXPECT_EQ(database.Size("task0"), 2UL);
+  EXPECT_EQ(database.Size("task1"), 1UL);
+  EXPECT_EQ(database.GetTopK("task0", 1)[0].result.execution_cost, 1);
+  std::remove(path.c_str());
+}
+
+TEST(JSONFileDatabase, CompactOnLoad) {
+  std::string path = "./test_database_compact_" + std::to_string(getpid()) + ".json";
+  {
+    std::ofstream ofs(path, std::ios::trunc);
+    for (int cost = 1; cost <= 4; ++cost) {
+      ofs << JSONFileDatabase::RecordToJSON(MakeRecord("task0", cost)) << "\n";
+    }
+    ofs << "invalid\n";
+  }
+  JSONFileDatabase database(2, path);
+  EXPECT_EQ(database.Size("task0"), 2UL);
+
+  // only the best records of the task are left in the file
+  std::ifstream ifs(path);
+  std::vector<TuningRecord> records;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    TuningRecord record;
+    ASSERT_TRUE(JSONFileDatabase::JSONToRecord(line, &record));
+    records.push_back(record);
+  }
+  ASSERT_EQ(records.size(), 2UL);
+  EXPECT_EQ(records[0].result.execution_cost, 1);
+  EXPECT_EQ(records[1].result.execution_cost, 2);
+  std::remove(path.c_str());
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -39,18 +39,30 @@ struct MeasureInput {
 
 // The result of a measurement
 struct MeasureResult {
-  // The time cost of execution in average of running
-  // with a specific repeated times.
+  // The time cost of execution, it is the median of
+  // the repeated runs.
   double execution_cost;  // unit: us
+  // The statistics of the execution cost of the repeated runs
+  double min_execution_cost    = 0;  // unit: us
+  double median_execution_cost = 0;  // unit: us
+  double stddev_execution_cost = 0;  // unit: us
+  int repeat_times             = 0;
   // The time cost of the whole measurement process including
   // building and running
   double elapsed_time;  // unit: us
+  // The time cost of building
+  double build_time = 0;  // unit: us
+  // The time cost of running including the preparation of arguments
+  double run_time = 0;  // unit: us
 };
 
 // The result of building with input schedule
 struct BuildResult {
   // The scope that owns detail compilation infos of parameters in the runtime program
   const hlir::framework::Scope* compiled_scope;
+  // The compiler owns the compiled code of the runtime program, it can be null
+  // if the builder keeps the code alive in other ways
+  std::unique_ptr<hlir::framework::GraphCompiler> graph_compiler;
   // The executable program
   std::unique_ptr<hlir::framework::Program> runtime_program;
 };
@@ -71,6 +71,19 @@ TEST(ScheduleMeasurer, Basic) {
   auto measurer                      = std::make_unique<ScheduleMeasurer>(builder.get(), runner.get());
   std::vector<MeasureResult> results = measurer->Measure(inputs);
   ASSERT_EQ(inputs.size(), results.size());
+
+  // build concurrently, and run after all the inputs are built
+  ScheduleMeasurer::Config config;
+  config.num_build_threads     = 2;
+  config.overlap_build_and_run = false;
+  config.run_cpu_id            = 0;
+  measurer                     = std::make_unique<ScheduleMeasurer>(builder.get(), runner.get(), config);
+  results                      = measurer->Measure(inputs);
+  ASSERT_EQ(inputs.size(), results.size());
+  for (auto& result : results) {
+    EXPECT_GT(result.build_time, 0);
+    EXPECT_GE(result.elapsed_time, result.build_time + result.run_time);
+  }
 }
 
 }  // namespace auto_schedule
@@ -14,24 +14,139 @@
 
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "cinn/utils/thread_pool.h"
+
 namespace cinn {
 namespace auto_schedule {
 
-ScheduleMeasurer::ScheduleMeasurer(ScheduleBuilder* builder, ScheduleRunner* runner)
-    : builder_(builder), runner_(runner) {}
+namespace {
+double MicrosecondsSince(const std::chrono::steady_clock::time_point& start) {
+  auto time_span = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  return static_cast<double>(time_span.count());
+}
+
+// Restrict the calling thread to the cpu \p cpu_id, or to all the cpus except it if \p exclude is true
+void SetCurrentThreadAffinity(int cpu_id, bool exclude) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (exclude) {
+    int num_cpus = std::thread::hardware_concurrency();
+    for (int i = 0; i < num_cpus && i < CPU_SETSIZE; ++i) {
+      if (i != cpu_id) CPU_SET(i, &cpu_set);
+    }
+  } else {
+    CPU_SET(cpu_id, &cpu_set);
+  }
+  if (CPU_COUNT(&cpu_set) == 0 || pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+    LOG(WARNING) << "Failed to set the cpu affinity of the measurement thread";
+  }
+}
+
+// Pin the calling thread to a cpu during the lifetime of this object
+class ScopedCpuPinning {
+ public:
+  explicit ScopedCpuPinning(int cpu_id) : pinned_(cpu_id >= 0) {
+    if (!pinned_) return;
+    pthread_getaffinity_np(pthread_self(), sizeof(origin_), &origin_);
+    SetCurrentThreadAffinity(cpu_id, false);
+  }
+
+  ~ScopedCpuPinning() {
+    if (pinned_) pthread_setaffinity_np(pthread_self(), sizeof(origin_), &origin_);
+  }
+
+ private:
+  bool pinned_;
+  cpu_set_t origin_;
+};
+}  // namespace
+
+ScheduleMeasurer::ScheduleMeasurer(ScheduleBuilder* builder, ScheduleRunner* runner, const Config& config)
+    : builder_(builder), runner_(runner), config_(config) {}
 
 std::vector<MeasureResult> ScheduleMeasurer::Measure(const std::vector<MeasureInput>& inputs) {
+  int num_threads = config_.num_build_threads > 0 ? config_.num_build_threads
+                                                  : std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  num_threads     = std::min(num_threads, static_cast<int>(inputs.size()));
+  if (num_threads <= 1) {
+    return MeasureSerially(inputs);
+  }
+
+  std::vector<MeasureResult> results(inputs.size());
+  std::vector<BuildResult> build_results(inputs.size());
+  std::mutex mtx;
+  std::condition_variable built_cv;
+  std::vector<int> built(inputs.size(), 0);
+
+  utils::ThreadPool pool(num_threads);
+  for (int i = 0; i < inputs.size(); ++i) {
+    pool.Submit([&, i] {
+      if (config_.run_cpu_id >= 0) {
+        SetCurrentThreadAffinity(config_.run_cpu_id, true);
+      }
+      auto build_start      = std::chrono::steady_clock::now();
+      build_results[i]      = builder_->Build(inputs[i]);
+      results[i].build_time = MicrosecondsSince(build_start);
+      VLOG(5) << "Measurement-" << i << " build cost " << results[i].build_time << "us";
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        built[i] = 1;
+      }
+      built_cv.notify_all();
+    });
+  }
+  if (!config_.overlap_build_and_run) {
+    pool.Wait();
+  }
+
+  ScopedCpuPinning pinning(config_.run_cpu_id);
+  for (int i = 0; i < inputs.size(); ++i) {
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      built_cv.wait(lock, [&] { return built[i] != 0; });
+    }
+    auto run_start    = std::chrono::steady_clock::now();
+    double build_time = results[i].build_time;
+    results[i]        = runner_->Run(inputs[i], build_results[i]);
+    // use the time span counted in measurer
+    results[i].build_time   = build_time;
+    results[i].run_time     = MicrosecondsSince(run_start);
+    results[i].elapsed_time = results[i].build_time + results[i].run_time;
+    VLOG(5) << "Measurement-" << i << " cost " << results[i].elapsed_time << "us";
+    // release the compiled code as early as possible
+    build_results[i] = BuildResult();
+  }
+  pool.Wait();
+
+  VLOG(4) << "Measure " << inputs.size() << " tests with " << num_threads << " build threads";
+  return results;
+}
+
+std::vector<MeasureResult> ScheduleMeasurer::MeasureSerially(const std::vector<MeasureInput>& inputs) {
   std::vector<MeasureResult> results;
+  ScopedCpuPinning pinning(config_.run_cpu_id);
   for (auto i = 0; i < inputs.size(); ++i) {
     auto m_start = std::chrono::steady_clock::now();
     auto&& input = inputs.at(i);
 
     BuildResult build_res = builder_->Build(input);
+    double build_time     = MicrosecondsSince(m_start);
+    auto run_start        = std::chrono::steady_clock::now();
     MeasureResult res     = runner_->Run(input, build_res);
 
-    auto time_span = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
     // use the time span counted in measurer
-    res.elapsed_time = static_cast<double>(time_span.count());
+    res.build_time   = build_time;
+    res.run_time     = MicrosecondsSince(run_start);
+    res.elapsed_time = MicrosecondsSince(m_start);
     VLOG(5) << "Measurement-" << i << " cost " << res.elapsed_time << "us";
     results.emplace_back(std::move(res));
   }
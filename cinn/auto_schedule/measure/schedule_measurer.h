@@ -23,18 +23,40 @@ namespace auto_schedule {
 
 // Entrance of schedule measurement, it mainly includes two processes:
 // which are building the input schedules and running the generated codes.
+//
+// The inputs are built concurrently by a pool of threads, and each of them
+// runs on the calling thread in order as soon as it is built, so the runs
+// never overlap with each other. The builder should be thread-safe, it may
+// serialize the parts of the builds sharing states.
 class ScheduleMeasurer {
  public:
-  ScheduleMeasurer(ScheduleBuilder* builder, ScheduleRunner* runner);
+  struct Config {
+    // The number of threads building the inputs concurrently,
+    // 0 means the number of hardware threads
+    int num_build_threads = 1;
+    // Whether to run an input while the others are still building, it
+    // shortens the measurement but the builds may disturb the timing
+    bool overlap_build_and_run = true;
+    // The cpu core to pin the runs to, and the builds are kept off it.
+    // A negative value disables the pinning.
+    int run_cpu_id = -1;
+  };
+
+  ScheduleMeasurer(ScheduleBuilder* builder, ScheduleRunner* runner, const Config& config = Config());
 
   // Measure a batch of inputs and return all results once.
   std::vector<MeasureResult> Measure(const std::vector<MeasureInput>& inputs);
 
  private:
+  // Build and run the inputs one by one on the calling thread
+  std::vector<MeasureResult> MeasureSerially(const std::vector<MeasureInput>& inputs);
+
   // The handle to implemented ScheduleBuilder
   ScheduleBuilder* builder_;
   // The handle to implemented ScheduleRunner
   ScheduleRunner* runner_;
+
+  Config config_;
 };
 
 }  // namespace auto_schedule
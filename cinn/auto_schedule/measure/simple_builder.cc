@@ -29,10 +29,23 @@ BuildResult SimpleBuilder::Build(const MeasureInput& input) {
   compile_options.remove_unused_variables = false;
   VLOG(5) << "call GraphCompiler to Build with " << compile_options.groups.size() << " groups, "
           << compile_options.lowered_funcs.size() << " lowered_funcs";
-  GraphCompiler::CompilationResult compiled_result = graph_compiler_->Build(compile_options);
+  // the GraphCompiler keeps the states of a build and the compiled code, and the program of a build refers
+  // to the variables of its scope, so new ones are used for every build. The GraphCompiler locks the shared
+  // graph only while it reads the graph, so the codegen of the builds runs concurrently.
+  const auto& target  = graph_compiler_->GetTarget();
+  const auto& graph   = graph_compiler_->GetGraph();
+  std::shared_ptr<hlir::framework::Scope> scope;
+  {
+    std::lock_guard<std::mutex> lock(graph->mutex());
+    scope = hlir::framework::BuildScope(target, graph);
+  }
+  auto graph_compiler = std::make_unique<GraphCompiler>(target, scope, graph);
+  GraphCompiler::CompilationResult compiled_result = graph_compiler->Build(compile_options);
 
   BuildResult build_result;
-  build_result.compiled_scope  = graph_compiler_->GetScope().get();
+  // the scope is kept alive by the program
+  build_result.compiled_scope  = scope.get();
+  build_result.graph_compiler  = std::move(graph_compiler);
   build_result.runtime_program = std::move(compiled_result.runtime_program);
   return build_result;
 }
@@ -21,7 +21,11 @@ namespace cinn {
 namespace auto_schedule {
 
 // This class utilize the GraphCompiler bound to the graph to build
-// the input schedule as executable objects
+// the input schedule as executable objects. Every build creates a
+// GraphCompiler and a scope of its own, so a built program can run
+// while the others are building. The builds share the graph, which
+// is locked by the GraphCompiler only while it's read, so the codegen
+// of the builds runs concurrently.
 class SimpleBuilder : public ScheduleBuilder {
  public:
   SimpleBuilder(hlir::framework::GraphCompiler* graph_compiler);
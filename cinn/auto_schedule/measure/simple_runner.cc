@@ -14,17 +14,26 @@
 
 #include "cinn/auto_schedule/measure/simple_runner.h"
 
+#include <unistd.h>
+
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <random>
+#include <sstream>
 
 #include "cinn/common/target.h"
 #include "cinn/hlir/framework/buffer.h"
 #include "cinn/hlir/framework/scope.h"
 #include "cinn/hlir/framework/tensor.h"
+#include "cinn/utils/string.h"
+#ifdef CINN_WITH_CUDA
+#include "cinn/backends/cuda_util.h"
+#endif
 
 namespace cinn {
 namespace auto_schedule {
@@ -33,10 +42,11 @@ using hlir::framework::Buffer;
 using hlir::framework::Shape;
 using hlir::framework::Tensor;
 
-// Generate random value and populate them to the output address of memeory
+// Generate random value and populate them to the output address of memeory,
+// the values are kept in a small range so that the kernels run on normal
+// numbers, and a fixed seed makes the measurements reproducible.
 static void PopulateRandomValue(const common::Type& type, const int numel, void* raw_ptr) {
-  std::random_device seed;
-  std::default_random_engine engine(seed());
+  std::default_random_engine engine(numel);
 
   if (type == common::Bool()) {
     auto* fmt_ptr = reinterpret_cast<bool*>(raw_ptr);
@@ -44,14 +54,31 @@ static void PopulateRandomValue(const common::Type& type, const int numel, void*
     std::generate_n(fmt_ptr, numel, [&engine, &dist]() { return dist(engine); });
   } else if (type == common::I32()) {
     auto* fmt_ptr = reinterpret_cast<int*>(raw_ptr);
-    std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    std::uniform_int_distribution<int> dist(-128, 127);
+    std::generate_n(fmt_ptr, numel, [&engine, &dist]() { return dist(engine); });
+  } else if (type == common::I64()) {
+    auto* fmt_ptr = reinterpret_cast<int64_t*>(raw_ptr);
+    std::uniform_int_distribution<int64_t> dist(-128, 127);
     std::generate_n(fmt_ptr, numel, [&engine, &dist]() { return dist(engine); });
   } else if (type == common::F32()) {
     auto* fmt_ptr = reinterpret_cast<float*>(raw_ptr);
-    std::uniform_real_distribution<float> dist(std::numeric_limits<float>::min(), std::numeric_limits<float>::max());
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
     std::generate_n(fmt_ptr, numel, [&engine, &dist]() { return dist(engine); });
+  } else if (type == common::F64()) {
+    auto* fmt_ptr = reinterpret_cast<double*>(raw_ptr);
+    std::uniform_real_distribution<double> dist(-1., 1.);
+    std::generate_n(fmt_ptr, numel, [&engine, &dist]() { return dist(engine); });
+  } else if (type == common::F16()) {
+    auto* fmt_ptr = reinterpret_cast<common::float16*>(raw_ptr);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::generate_n(fmt_ptr, numel, [&engine, &dist]() { return common::float16(dist(engine)); });
+  } else if (type == common::BF16()) {
+    auto* fmt_ptr = reinterpret_cast<common::bfloat16*>(raw_ptr);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::generate_n(fmt_ptr, numel, [&engine, &dist]() { return common::bfloat16(dist(engine)); });
   } else {
-    LOG(FATAL) << "Unsupported type:" << type;
+    VLOG(6) << "Fill zero for the unsupported type:" << type;
+    std::memset(raw_ptr, 0, numel * ((type.bits() + 7) / 8));
   }
 }
 
@@ -63,13 +90,17 @@ static std::shared_ptr<Buffer> AllocBuffer(const common::Target& target,
   static constexpr int default_alignment = 1024;
   auto buffer                            = std::make_shared<Buffer>(target);
 
-  const uint32_t bytes_of_ele = static_cast<uint32_t>(std::floor(static_cast<float>(type.bits() + 1) / 8.0));
+  const uint32_t bytes_of_ele = (type.bits() + 7) / 8;
   CHECK_GT(bytes_of_ele, 0) << "The number bytes of each element is invalid";
   VLOG(6) << "AllocBuffer-target:" << target << ",type:" << type << ",numel:" << shape.numel()
           << ",fill_random_value:" << fill_random_value;
 
   if (target == common::DefaultHostTarget()) {
     buffer->ResizeLazy(default_alignment, shape.numel() * bytes_of_ele);
+    // only the host memory can be written directly
+    if (fill_random_value) {
+      PopulateRandomValue(type, shape.numel(), buffer->data()->memory);
+    }
   } else {
     buffer->ResizeLazy(shape.numel() * bytes_of_ele);
   }
@@ -77,16 +108,33 @@ static std::shared_ptr<Buffer> AllocBuffer(const common::Target& target,
   return buffer;
 }
 
-SimpleRunner::SimpleRunner(int repeat_times) : repeat_times_(repeat_times) {
-  CHECK_GT(repeat_times_, 0) << "repeat_times can't less than 0";
+// The size of the last level cache, it is used as the size of the flushing buffer
+static size_t LastLevelCacheSize() {
+  static constexpr size_t default_size = 32 * 1024 * 1024;
+  long size                            = -1;  // NOLINT
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+  return size > 0 ? static_cast<size_t>(size) : default_size;
+}
+
+SimpleRunner::SimpleRunner(int repeat_times) : SimpleRunner(Config{repeat_times}) {}
+
+SimpleRunner::SimpleRunner(const Config& config) : config_(config) {
+  CHECK_GT(config_.repeat_times, 0) << "repeat_times can't less than 0";
+  CHECK_GE(config_.warmup_times, 0) << "warmup_times can't less than 0";
+  CHECK_GT(config_.target_relative_ci, 0) << "target_relative_ci should be positive";
+  if (config_.flush_cache) {
+    flush_buffer_.resize(LastLevelCacheSize());
+  }
 }
 
 // Prepare execution arguments of all instructions to run, a argument
 // may be obtained from the input of measurement or allocating new buffer
-// with random value.
+// with random value. The allocated buffers are kept in the cached scope
+// and reused while the next programs need the same arguments.
 std::map<std::string, cinn_pod_value_t> SimpleRunner::PrepareArgs(const MeasureInput& input,
-                                                                  const BuildResult& build_result,
-                                                                  hlir::framework::Scope* temp_scope) {
+                                                                  const BuildResult& build_result) {
   std::map<std::string, cinn_pod_value_t> result;
 
   const auto& target         = input.task->target;
@@ -94,77 +142,134 @@ std::map<std::string, cinn_pod_value_t> SimpleRunner::PrepareArgs(const MeasureI
   const auto* compiled_scope = build_result.compiled_scope;
   const auto& instructions   = build_result.runtime_program->GetRunInstructions();
 
-  auto fill_arg_fn = [&](const std::string& param) {
-    // the argument is duplicated and has been prepared.
-    if (result.count(param)) {
+  // collect the arguments to be allocated in order and their signature
+  std::vector<std::string> alloc_params;
+  std::stringstream signature;
+  signature << target << ";";
+  auto collect_fn = [&](const std::string& param) {
+    // the argument is duplicated or specified by the input of measurement
+    if (result.count(param) || std::count(alloc_params.begin(), alloc_params.end(), param)) {
       return;
     }
-
-    // if the input of measurement specifies this argument,
-    // we should use it firstly.
     if (input_args && input_args->count(param)) {
       VLOG(6) << "Argument[" << param << "] use input value";
       result.emplace(param, input_args->at(param));
       return;
     }
-
-    if (temp_scope->FindVar(param)) {
-      auto temp_tensor = temp_scope->GetTensor(param);
-      result.emplace(param, temp_tensor->buffer());
-      return;
-    }
-
-    // allocate a new buffer for this argument and store it in
-    // the temporary scope to be released at proper time.
     auto compiled_tensor = compiled_scope->GetTensor(param);
-    auto buffer          = AllocBuffer(target, compiled_tensor->type(), compiled_tensor->shape());
-    temp_scope->Var<Tensor>(param);
-    auto temp_tensor = temp_scope->GetTensor(param);
-    temp_tensor->set_buffer(buffer);
-    result.emplace(param, temp_tensor->buffer());
+    signature << param << ":" << compiled_tensor->type() << "[" << utils::Join(compiled_tensor->shape().data(), ",")
+              << "];";
+    alloc_params.push_back(param);
   };
 
   for (auto&& instr : instructions) {
     for (auto&& args : instr->GetInArgs()) {
-      std::for_each(args.begin(), args.end(), fill_arg_fn);
+      std::for_each(args.begin(), args.end(), collect_fn);
     }
 
     for (auto&& args : instr->GetOutArgs()) {
-      std::for_each(args.begin(), args.end(), fill_arg_fn);
+      std::for_each(args.begin(), args.end(), collect_fn);
+    }
+  }
+
+  if (!cached_args_scope_ || cached_args_signature_ != signature.str()) {
+    // allocate new buffers for these arguments and store them in
+    // the cached scope to be released when the arguments change.
+    VLOG(5) << "SimpleRunner allocate " << alloc_params.size() << " arguments";
+    cached_args_signature_ = signature.str();
+    cached_args_scope_     = std::make_unique<hlir::framework::Scope>();
+    for (const auto& param : alloc_params) {
+      auto compiled_tensor = compiled_scope->GetTensor(param);
+      auto buffer          = AllocBuffer(target, compiled_tensor->type(), compiled_tensor->shape());
+      cached_args_scope_->Var<Tensor>(param);
+      cached_args_scope_->GetTensor(param)->set_buffer(buffer);
     }
   }
+  for (const auto& param : alloc_params) {
+    result.emplace(param, cached_args_scope_->GetTensor(param)->buffer());
+  }
   return result;
 }
 
+void SimpleRunner::FlushCache() {
+  static constexpr size_t cache_line_size = 64;
+  volatile char* data                     = flush_buffer_.data();
+  for (size_t i = 0; i < flush_buffer_.size(); i += cache_line_size) {
+    data[i] = data[i] + 1;
+  }
+}
+
+// Run all instructions once, returns the time cost in us
+static double RunOnce(const std::vector<std::unique_ptr<hlir::framework::Instruction>>& instructions,
+                      std::map<std::string, cinn_pod_value_t>* execution_args) {
+  auto run_start = std::chrono::steady_clock::now();
+  for (auto ct = 0; ct < instructions.size(); ++ct) {
+    VLOG(6) << "Start running instruction-" << ct;
+    instructions.at(ct)->Run(execution_args);
+  }
+#ifdef CINN_WITH_CUDA
+  if (!instructions.empty() && instructions.front()->target_.arch == common::Target::Arch::NVGPU) {
+    CUDA_CALL(cudaDeviceSynchronize());
+  }
+#endif
+  auto time_span = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - run_start);
+  return static_cast<double>(time_span.count()) / 1000.0;
+}
+
 MeasureResult SimpleRunner::Run(const MeasureInput& input, const BuildResult& build_result) {
   MeasureResult result;
   auto t_start = std::chrono::steady_clock::now();
   // prepare execution arguments
   VLOG(4) << "SimpleRunner prepare execution arguments";
-  hlir::framework::Scope temp_scope;  // used for store temporary allocated data
-  auto execution_args = PrepareArgs(input, build_result, &temp_scope);
+  auto execution_args = PrepareArgs(input, build_result);
 
-  // Execute each instruction repeatedly and take the average as cost.
-  result.execution_cost    = 0;
   const auto& instructions = build_result.runtime_program->GetRunInstructions();
-  for (auto ct = 0; ct < instructions.size(); ++ct) {
-    auto&& instr = instructions.at(ct);
-    VLOG(5) << "Start running instruction-" << ct;
-    auto run_start = std::chrono::steady_clock::now();
-    for (int i = 0; i < repeat_times_; ++i) {
-      instr->Run(&execution_args);
+  // the first runs warm up the instruction cache, the lazy initialization and so on
+  for (int i = 0; i < config_.warmup_times; ++i) {
+    RunOnce(instructions, &execution_args);
+  }
+
+  // Execute all instructions repeatedly until the mean cost is stable enough
+  const int max_repeat_times = std::max(config_.repeat_times, config_.max_repeat_times);
+  std::vector<double> costs;
+  double sum    = 0;
+  double sq_sum = 0;
+  while (costs.size() < max_repeat_times) {
+    if (config_.flush_cache) {
+      FlushCache();
+    }
+    double cost = RunOnce(instructions, &execution_args);
+    costs.push_back(cost);
+    sum += cost;
+    sq_sum += cost * cost;
+
+    if (costs.size() >= config_.repeat_times && costs.size() >= 2) {
+      double n        = static_cast<double>(costs.size());
+      double mean     = sum / n;
+      double variance = std::max(sq_sum / n - mean * mean, 0.0) * n / (n - 1);
+      // the half width of the 95% confidence interval of the mean
+      if (1.96 * std::sqrt(variance / n) <= config_.target_relative_ci * mean) {
+        break;
+      }
     }
-    auto time_span =
-        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - run_start);
-    auto cost_avg = static_cast<double>(time_span.count()) / repeat_times_;
-    result.execution_cost += cost_avg;
   }
 
+  const double n    = static_cast<double>(costs.size());
+  const double mean = sum / n;
+  std::sort(costs.begin(), costs.end());
+  size_t mid                   = costs.size() / 2;
+  result.median_execution_cost = costs.size() % 2 ? costs[mid] : (costs[mid - 1] + costs[mid]) / 2;
+  result.min_execution_cost    = costs.front();
+  result.stddev_execution_cost = n > 1 ? std::sqrt(std::max(sq_sum / n - mean * mean, 0.0) * n / (n - 1)) : 0;
+  result.execution_cost        = result.median_execution_cost;
+  result.repeat_times          = costs.size();
+
   auto time_span = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start);
   result.elapsed_time = static_cast<double>(time_span.count());
 
-  VLOG(4) << "A measurement done:repeat_times[" << repeat_times_ << "]total_elapsed_time[" << result.elapsed_time
-          << "]us,execution_cost[" << result.execution_cost << "]us";
+  VLOG(4) << "A measurement done:repeat_times[" << result.repeat_times << "]total_elapsed_time["
+          << result.elapsed_time << "]us,execution_cost[" << result.execution_cost << "]us,min["
+          << result.min_execution_cost << "]us,stddev[" << result.stddev_execution_cost << "]us";
   return result;
 }
 
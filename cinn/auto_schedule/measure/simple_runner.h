@@ -14,29 +14,67 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "cinn/auto_schedule/measure/measure.h"
 #include "cinn/hlir/framework/instruction.h"
+#include "cinn/hlir/framework/scope.h"
 
 namespace cinn {
 namespace auto_schedule {
 
 // This class utilize the built instructions to execute the generated
 // kernels and count the elapsed time as the measurement of performance
+//
+// The program is run for several warmup times first, and then repeatedly
+// until the confidence interval of the mean cost is narrow enough or the
+// maximum repeat times is reached. The execution cost is the median of the
+// repeats. The randomly filled arguments are kept and reused by the next
+// program with the same arguments, such as another candidate of the task.
 class SimpleRunner : public ScheduleRunner {
  public:
-  SimpleRunner(int repeat_times);
+  struct Config {
+    // The minimum repeat times of running the program
+    int repeat_times = 1;
+    // The times of running the program before measurement
+    int warmup_times = 1;
+    // The maximum repeat times, the repeats stop at repeat_times if it is not
+    // larger than repeat_times
+    int max_repeat_times = 0;
+    // The repeats stop when the half width of the 95% confidence interval of
+    // the mean cost is below this fraction of the mean
+    double target_relative_ci = 0.02;
+    // Whether to flush the last level cache of cpu before every repeat
+    bool flush_cache = false;
+  };
+
+  explicit SimpleRunner(int repeat_times);
+
+  explicit SimpleRunner(const Config& config);
 
   MeasureResult Run(const MeasureInput& input, const BuildResult& build_result) override;
 
  private:
   std::map<std::string, cinn_pod_value_t> PrepareArgs(const MeasureInput& input,
-                                                      const BuildResult& build_result,
-                                                      hlir::framework::Scope* temp_scope);
+                                                      const BuildResult& build_result);
+
+  // Evict the data of the last run from the cpu cache
+  void FlushCache();
 
  private:
-  // The repeat times of running instructions,
-  // this runner will return the average time
-  const int repeat_times_;
+  const Config config_;
+
+  // The arguments allocated for the last program and their signature,
+  // they are reused if the next program has the same signature.
+  // So this runner should be used by one thread at a time
+  std::string cached_args_signature_;
+  std::unique_ptr<hlir::framework::Scope> cached_args_scope_;
+
+  // The buffer written to evict the cache
+  std::vector<char> flush_buffer_;
 };
 
 }  // namespace auto_schedule
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 
@@ -128,5 +129,42 @@ TEST_F(TestSimpleRunner, TimeMeasured) {
   ASSERT_GE(measure_result.elapsed_time, 200);
 }
 
+TEST_F(TestSimpleRunner, RepeatUntilStable) {
+  // set up a BuildResult object with one instruction counting the calls
+  static std::atomic<int> num_calls(0);
+  auto sleep_fn = [](void*, int32_t) {
+    ++num_calls;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  };
+  BuildResult build_result;
+  build_result.compiled_scope = nullptr;
+  std::vector<std::unique_ptr<Instruction>> instructions;
+  instructions.emplace_back(new Instruction(target, nullptr, {}, {"empty_placeholder"}, "sleep_fn"));
+  instructions.back()->SetLoweredFunc(sleep_fn);
+  instructions.back()->Finalize();
+  build_result.runtime_program.reset(new hlir::framework::Program(nullptr, std::move(instructions)));
+
+  std::map<std::string, cinn_pod_value_t> preset_args;
+  preset_args.emplace("empty_placeholder", cinn_pod_value_t());
+  input.execution_args = &preset_args;
+
+  SimpleRunner::Config config;
+  config.repeat_times     = 3;
+  config.warmup_times     = 2;
+  config.max_repeat_times = 20;
+  config.flush_cache      = true;
+  auto runner             = std::make_unique<SimpleRunner>(config);
+  MeasureResult result    = runner->Run(input, build_result);
+  // the repeats stop between the minimum and maximum repeat times,
+  // and the warmup runs are not measured
+  ASSERT_GE(result.repeat_times, 3);
+  ASSERT_LE(result.repeat_times, 20);
+  ASSERT_EQ(num_calls.load(), result.repeat_times + 2);
+  ASSERT_GE(result.min_execution_cost, 100);
+  ASSERT_LE(result.min_execution_cost, result.median_execution_cost);
+  ASSERT_EQ(result.execution_cost, result.median_execution_cost);
+  ASSERT_GE(result.stddev_execution_cost, 0);
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
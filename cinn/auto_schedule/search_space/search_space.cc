@@ -16,7 +16,9 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -86,8 +88,11 @@ SearchState SearchSpace::RandomScheduleMutate(const SearchState& state) {
     VLOG(6) << "Rule name = " << rule->GetRuleName();
     RuleApplyType apply_type = rule->Init(ret.mod_expr);
     if (apply_type != RuleApplyType::kCannotApply) {
-      weight_to_rule[cur_weight] = rule;
-      cur_weight += rule->NumberApplicable();
+      // the rule owns the sample indices [cur_weight, cur_weight + NumberApplicable())
+      if (rule->NumberApplicable() > 0) {
+        weight_to_rule[cur_weight] = rule;
+        cur_weight += rule->NumberApplicable();
+      }
       if (apply_type == RuleApplyType::kApplyAndSkipThisRule) {
         iter = ret.applicable_rules.erase(iter);
         continue;
@@ -107,14 +112,69 @@ SearchState SearchSpace::RandomScheduleMutate(const SearchState& state) {
 
   // 3. Sample a schedule on the distribution
   int sample_index                         = rand() % cur_weight;
-  auto iter                                = weight_to_rule.lower_bound(sample_index);
+  // the rule of the greatest start index not greater than the sample
+  auto iter                                = std::prev(weight_to_rule.upper_bound(sample_index));
   std::shared_ptr<AutoGenRule> sample_rule = iter->second;
   VLOG(6) << "Sample AutoGenRule " << sample_rule->GetRuleName();
 
   // 4. Apply the schedule change
-  ret.mod_expr = sample_rule->Apply(sample_index - iter->first);
+  ScheduleStep step;
+  step.rule_name   = sample_rule->GetRuleName();
+  step.apply_index = sample_index - iter->first;
+  ret.mod_expr     = sample_rule->Apply(step.apply_index);
+  ret.trace.push_back(std::move(step));
   return ret;
 }
 
+bool SearchSpace::Replay(const ScheduleTrace& trace, SearchState* state) const {
+  std::vector<ir::Expr> copy_exprs;
+  for (const ir::Expr& e : tune_task_.GetLoweredFuncBodyExprs()) {
+    copy_exprs.push_back(optim::IRCopy(e));
+  }
+  SearchState ret(ir::ModuleExpr(std::move(copy_exprs)));
+  ret.InitAutoGenRules(tune_task_.target, tune_task_.output_names);
+
+  for (const ScheduleStep& step : trace) {
+    if (step.other_parent) {
+      SearchState other((ir::ModuleExpr()));
+      if (!Replay(*step.other_parent, &other)) {
+        return false;
+      }
+      std::vector<ir::Expr> exprs       = ret.mod_expr.GetExprs();
+      std::vector<ir::Expr> other_exprs = other.mod_expr.GetExprs();
+      if (exprs.size() != step.cross_over_mask.size() || other_exprs.size() != exprs.size()) {
+        VLOG(4) << "The cross over in the trace doesn't match the task";
+        return false;
+      }
+      for (size_t i = 0; i < exprs.size(); ++i) {
+        exprs[i] = optim::IRCopy(step.cross_over_mask[i] ? other_exprs[i] : exprs[i]);
+      }
+      // the same as EvolutionarySearch::CrossOver, the child doesn't keep the rules
+      ret = SearchState(ir::ModuleExpr(exprs));
+      continue;
+    }
+
+    auto iter = std::find_if(
+        ret.applicable_rules.begin(), ret.applicable_rules.end(), [&](const std::shared_ptr<AutoGenRule>& rule) {
+          return rule->GetRuleName() == step.rule_name;
+        });
+    if (iter == ret.applicable_rules.end()) {
+      VLOG(4) << "The AutoGenRule " << step.rule_name << " in the trace is not applicable";
+      return false;
+    }
+    std::shared_ptr<AutoGenRule> rule = *iter;
+    if (rule->Init(ret.mod_expr) == RuleApplyType::kCannotApply || step.apply_index < 0 ||
+        step.apply_index >= rule->NumberApplicable()) {
+      VLOG(4) << "The AutoGenRule " << step.rule_name << " in the trace can't be applied with index "
+              << step.apply_index;
+      return false;
+    }
+    ret.mod_expr = rule->Apply(step.apply_index);
+  }
+  ret.trace = trace;
+  *state    = std::move(ret);
+  return true;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
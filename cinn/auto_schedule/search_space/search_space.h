@@ -50,6 +50,10 @@ class SearchSpace {
   // Evolutionary search mutate, returns the mutated ModuleExpr and estimited cost
   virtual SearchState GetScheduleMutate(const SearchState& state, const CostModel& cost_model);
 
+  // Reproduce a state by applying the trace to the un-optimized exprs of the task,
+  // returns false if the trace can't be applied to this task
+  bool Replay(const ScheduleTrace& trace, SearchState* state) const;
+
  private:
   // TODO(zhhsplendid): mutate by manual schedule.
   SearchState ManualScheduleMutate(const SearchState& state);
@@ -16,6 +16,49 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <vector>
+
+#include "cinn/auto_schedule/search_space/search_state.h"
+#include "cinn/auto_schedule/task/task_creator.h"
+#include "cinn/auto_schedule/task/tune_task.h"
+#include "cinn/common/context.h"
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/scope.h"
+
 namespace cinn {
-namespace auto_schedule {}  // namespace auto_schedule
+namespace auto_schedule {
+
+TEST(SearchSpace, ReplayRandomSketches) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  frontend::NetBuilder builder("net_builder");
+  auto a      = builder.CreateInput(Float(32), {32, 24}, "A");
+  auto b      = builder.CreateInput(Float(32), {32, 24}, "B");
+  auto c      = builder.Add(a, b);
+  auto d      = builder.Add(a, c);
+  auto graph  = std::make_shared<hlir::framework::Graph>(builder.Build(), target);
+  auto scope  = hlir::framework::BuildScope(target, graph);
+  auto tasks  = TaskCreator().CreateTuneTaskOpLevel(graph.get());
+  hlir::framework::GraphCompiler graph_compiler(target, scope, graph);
+  ASSERT_FALSE(tasks.empty());
+  TuneTask& task = tasks[0];
+  task.SetGraphCompiler(&graph_compiler);
+  task.TaskGraphToUnoptLoweredFunc();
+
+  // the sampled indices are within the applicable range of the sampled rules, so every sketch can be replayed
+  SearchSpace search_space(task);
+  for (const SearchState& state : search_space.GetRandomInitialSketch(32)) {
+    for (const ScheduleStep& step : state.trace) {
+      EXPECT_GE(step.apply_index, 0) << "The rule " << step.rule_name << " is sampled with a negative index";
+    }
+    SearchState replayed((ir::ModuleExpr()));
+    EXPECT_TRUE(search_space.Replay(state.trace, &replayed));
+  }
+}
+
+}  // namespace auto_schedule
 }  // namespace cinn
@@ -37,6 +37,7 @@ SearchState::SearchState(ir::ModuleExpr&& mod_expr) { this->mod_expr = std::move
 SearchState::SearchState(const SearchState& state) {
   mod_expr       = state.mod_expr;
   predicted_cost = state.predicted_cost;
+  trace          = state.trace;
   for (const std::shared_ptr<AutoGenRule>& rule : state.applicable_rules) {
     applicable_rules.emplace_back(std::shared_ptr<AutoGenRule>(rule->NewPointer()));
   }
@@ -45,6 +46,7 @@ SearchState::SearchState(const SearchState& state) {
 SearchState& SearchState::operator=(const SearchState& src) {
   this->mod_expr       = src.mod_expr;
   this->predicted_cost = src.predicted_cost;
+  this->trace          = src.trace;
   this->applicable_rules.clear();
   for (const std::shared_ptr<AutoGenRule>& rule : src.applicable_rules) {
     this->applicable_rules.emplace_back(std::shared_ptr<AutoGenRule>(rule->NewPointer()));
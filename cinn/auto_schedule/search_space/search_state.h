@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -27,6 +28,23 @@
 namespace cinn {
 namespace auto_schedule {
 
+/**
+ * A step of the schedule trace, which reproduces a SearchState from the un-optimized exprs of its task.
+ * It is either an AutoGenRule applied with an index, or a cross over with another state.
+ */
+struct ScheduleStep {
+  // name of the applied AutoGenRule, empty for a cross over
+  std::string rule_name;
+  // the index passed to AutoGenRule::Apply
+  int apply_index = -1;
+  // for a cross over, whether the i-th expr is taken from the other parent
+  std::vector<int> cross_over_mask;
+  // for a cross over, the trace of the other parent
+  std::shared_ptr<const std::vector<ScheduleStep>> other_parent;
+};
+
+using ScheduleTrace = std::vector<ScheduleStep>;
+
 /**
  * Class to store immediate states during search
  */
@@ -42,6 +60,9 @@ class SearchState {
   // Cost model predicted cost
   float predicted_cost = NOT_INIT_COST;
 
+  // The steps applied to the un-optimized exprs to get this state
+  ScheduleTrace trace;
+
   // Negative constant standing for a cost not being initialized
   static constexpr float NOT_INIT_COST = -1.0;
 
@@ -22,6 +22,7 @@
 #include <memory>
 #include <utility>
 
+#include "cinn/auto_schedule/cost_model/feature_extractor.h"
 #include "cinn/auto_schedule/search_space/search_space.h"
 #include "cinn/auto_schedule/search_space/search_state.h"
 #include "cinn/auto_schedule/task/tune_task.h"
@@ -32,8 +33,13 @@
 namespace cinn {
 namespace auto_schedule {
 
-EvolutionarySearch::EvolutionarySearch(const TuneTask& tune_task) : tune_task_(tune_task) {
+EvolutionarySearch::EvolutionarySearch(const TuneTask& tune_task, Database* database, CostModel* cost_model)
+    : tune_task_(tune_task), cost_model_(cost_model), database_(database) {
   search_space_ = std::make_unique<SearchSpace>(tune_task);
+  if (cost_model_ == nullptr) {
+    default_cost_model_ = std::make_unique<CostModel>();
+    cost_model_         = default_cost_model_.get();
+  }
 }
 
 EvolutionarySearch::~EvolutionarySearch() {}
@@ -70,8 +76,17 @@ std::vector<SearchState> EvolutionarySearch::SearchModuleExprEpsGreedy(const Tun
 }
 
 std::vector<SearchState> EvolutionarySearch::GetTopKCandidatesFromDatabase(int topk) {
-  // TODO(zhhsplendid): implement it after we have the database
-  return std::vector<SearchState>();
+  std::vector<SearchState> results;
+  if (database_ == nullptr || topk <= 0) {
+    return results;
+  }
+  for (const TuningRecord& record : database_->GetTopK(tune_task_.serialized_key, topk)) {
+    SearchState state((ir::ModuleExpr()));
+    if (search_space_->Replay(record.trace, &state)) {
+      results.emplace_back(std::move(state));
+    }
+  }
+  return results;
 }
 
 std::vector<SearchState> EvolutionarySearch::RandomInitSketch(int num) {
@@ -86,14 +101,37 @@ SearchState EvolutionarySearch::CrossOver(const SearchState& state1, const Searc
   CHECK_EQ(father_exprs.size(), mother_exprs.size())
       << "CrossOver ModuleExpr in EvolutionarySearch must have same number of AST";
 
+  ScheduleStep step;
   for (size_t i = 0; i < father_exprs.size(); ++i) {
     if (rand() % 2 == 0) {
       cross_over_exprs.push_back(optim::IRCopy(father_exprs[i]));
+      step.cross_over_mask.push_back(0);
     } else {
       cross_over_exprs.push_back(optim::IRCopy(mother_exprs[i]));
+      step.cross_over_mask.push_back(1);
     }
   }
-  return SearchState(ir::ModuleExpr(cross_over_exprs));
+  step.other_parent = std::make_shared<ScheduleTrace>(state2.trace);
+
+  SearchState child((ir::ModuleExpr(cross_over_exprs)));
+  child.trace = state1.trace;
+  child.trace.push_back(std::move(step));
+  return child;
+}
+
+void EvolutionarySearch::PredictCosts(std::vector<SearchState>* states) const {
+  if (!cost_model_->IsTrained()) {
+    return;
+  }
+  std::vector<std::vector<float>> features;
+  features.reserve(states->size());
+  for (const SearchState& state : *states) {
+    features.push_back(FeatureExtractor::Extract(state.mod_expr));
+  }
+  std::vector<float> costs = cost_model_->Predict(features);
+  for (size_t i = 0; i < states->size(); ++i) {
+    states->at(i).predicted_cost = costs[i];
+  }
 }
 
 std::vector<SearchState> EvolutionarySearch::Evolve(const std::vector<SearchState>& population,
@@ -114,9 +152,15 @@ std::vector<SearchState> EvolutionarySearch::Evolve(const std::vector<SearchStat
     evolution.push_back(CrossOver(population[first_rand_idx], population[second_rand_idx]));
   }
 
-  utils::SizedMultiSet<SearchState> evolution_with_cost(ret_num);
+  std::vector<SearchState> mutated;
   for (size_t i = 0; i < evolution.size(); ++i) {
-    evolution_with_cost.Push(search_space_->GetScheduleMutate(evolution[i], *cost_model_));
+    mutated.push_back(search_space_->GetScheduleMutate(evolution[i], *cost_model_));
+  }
+  PredictCosts(&mutated);
+
+  utils::SizedMultiSet<SearchState> evolution_with_cost(ret_num);
+  for (SearchState& state : mutated) {
+    evolution_with_cost.Push(std::move(state));
   }
 
   return evolution_with_cost.ReturnAsContainer<std::vector<SearchState>>();
@@ -17,6 +17,8 @@
 #include <memory>
 #include <vector>
 
+#include "cinn/auto_schedule/cost_model/cost_model.h"
+#include "cinn/auto_schedule/database/database.h"
 #include "cinn/auto_schedule/search_space/search_space.h"
 #include "cinn/auto_schedule/search_space/search_state.h"
 #include "cinn/auto_schedule/task/tune_task.h"
@@ -36,8 +38,14 @@ class EvolutionarySearch {
    *
    * @param tune_task: the TuneTask this class works on. This class doesn't
    *     take ownership of the pointer.
+   * @param database: the database of the tuning records to pick the
+   *     initial population from, it can be null. This class doesn't take
+   *     ownership of the pointer.
+   * @param cost_model: the cost model to pick the evolved states predicted
+   *     to be fast, it can be null and an untrained one is used. This class
+   *     doesn't take ownership of the pointer.
    */
-  EvolutionarySearch(const TuneTask& tune_task);
+  EvolutionarySearch(const TuneTask& tune_task, Database* database = nullptr, CostModel* cost_model = nullptr);
 
   /**
    * Destructor
@@ -89,6 +97,9 @@ class EvolutionarySearch {
 
   SearchState CrossOver(const SearchState& state1, const SearchState& state2);
 
+  // Set the predicted costs of the states if the cost model is trained
+  void PredictCosts(std::vector<SearchState>* states) const;
+
   std::vector<SearchState> Evolve(const std::vector<SearchState>& population, int cross_over_num, int ret_num);
 
   std::vector<SearchState> PickNextGenerationEpsGreedy(const std::vector<SearchState>& population,
@@ -101,6 +112,11 @@ class EvolutionarySearch {
   const TuneTask& tune_task_;
 
   CostModel* cost_model_;  // not owned
+
+  // used if no cost model is given
+  std::unique_ptr<CostModel> default_cost_model_;
+
+  Database* database_;  // not owned
 };
 
 }  // namespace auto_schedule
@@ -16,9 +16,12 @@
 
 #include <glog/logging.h>
 
+#include <cmath>
 #include <limits>
 
+#include "cinn/auto_schedule/cost_model/feature_extractor.h"
 #include "cinn/auto_schedule/measure/measure.h"
+#include "cinn/auto_schedule/search_space/search_space.h"
 #include "cinn/auto_schedule/search_strategy/evolutionary_search.h"
 #include "cinn/optim/ir_copy.h"
 
@@ -44,72 +47,105 @@ TuningResult::OptimizedComputeExpr TaskOptimizer::OptimizeByEvolution(const Tuni
   if (evolutionary_search_ == nullptr) {
     // TODO(zhhsplendid): check whether the options is same as previous,
     // if not, we should create new EvolutionarySearch
-    evolutionary_search_ = std::make_unique<EvolutionarySearch>(*task_);
+    evolutionary_search_ = std::make_unique<EvolutionarySearch>(*task_, database_, &cost_model_);
   }
 
+  // the best schedule measured before, which the new ones have to beat
+  SearchState best_state((ir::ModuleExpr()));
+  double min_exec_time     = std::numeric_limits<double>().max();
+  bool found_from_database = LoadBestFromDatabase(&best_state, &min_exec_time);
+
   if (options.num_measure_trials == 0) {
-    std::vector<SearchState> states = evolutionary_search_->SearchModuleExprEpsGreedy(options);
-    VLOG(4) << "TaskOptimizer run EvolutionarySearch with return size = " << states.size();
-    TuningResult::OptimizedComputeExpr result;
+    if (!found_from_database) {
+      std::vector<SearchState> states = evolutionary_search_->SearchModuleExprEpsGreedy(options);
+      VLOG(4) << "TaskOptimizer run EvolutionarySearch with return size = " << states.size();
+      best_state = states[0];
+    }
     // TODO(zhhsplendid): current a task only contains one Op or one Fused Op,
     // so we can take only first std::vector<ir::LoweredFunc>. Support the
     // lowered_funcs to be std::vector<std::vector<ir::LoweredFunc>>
     // in the future.
-
-    result.lowered_funcs.emplace_back(optim::IRCopy(task_->lowered_funcs));
-
-    std::vector<ir::Expr> best_exprs = states[0].mod_expr.GetExprs();
-    CHECK_EQ(best_exprs.size(), result.lowered_funcs[0].size())
-        << "RuntimeError: Expr size is not equal to LoweredFunc size in TaskOptimizer";
-    for (size_t i = 0; i < best_exprs.size(); ++i) {
-      result.lowered_funcs[0][i]->body = best_exprs[i];
-      if (task_->target == common::DefaultNVGPUTarget()) {
-        result.lowered_funcs[0][i]->PrepareCudaAxisInfoFromBody();
-      }
-    }
+    TuningResult::OptimizedComputeExpr result;
+    result.lowered_funcs.emplace_back(ApplyStateToLoweredFuncs(best_state));
     return result;
   }
 
-  int measured_count   = 0;
-  double min_exec_time = std::numeric_limits<double>().max();
+  int measured_count = 0;
   TuningResult::OptimizedComputeExpr result;
-  result.lowered_funcs.push_back(optim::IRCopy(task_->lowered_funcs));
+  if (found_from_database) {
+    result.lowered_funcs.push_back(ApplyStateToLoweredFuncs(best_state));
+  } else {
+    result.lowered_funcs.push_back(optim::IRCopy(task_->lowered_funcs));
+  }
 
   while (measured_count < options.num_measure_trials) {
     std::vector<SearchState> states = evolutionary_search_->SearchModuleExprEpsGreedy(options);
     VLOG(4) << "TaskOptimizer run EvolutionarySearch with return size = " << states.size();
     std::vector<MeasureInput> measure_inputs(states.size());
     for (size_t i = 0; i < states.size(); ++i) {
-      measure_inputs[i].task           = task_;
-      std::vector<ir::Expr> best_exprs = states[i].mod_expr.GetExprs();
-      CHECK_EQ(best_exprs.size(), task_->lowered_funcs.size())
-          << "RuntimeError: Expr size is not equal to LoweredFunc size in TaskOptimizer";
-
-      measure_inputs[i].lowered_funcs.emplace_back(optim::IRCopy(task_->lowered_funcs));
-      for (size_t j = 0; j < best_exprs.size(); ++j) {
-        measure_inputs[i].lowered_funcs.front().at(j)->body = best_exprs[j];
-        if (task_->target == common::DefaultNVGPUTarget()) {
-          measure_inputs[i].lowered_funcs.front().at(j)->PrepareCudaAxisInfoFromBody();
-        }
-      }
+      measure_inputs[i].task = task_;
+      measure_inputs[i].lowered_funcs.emplace_back(ApplyStateToLoweredFuncs(states[i]));
     }
     std::vector<MeasureResult> measure_outputs = schedule_measurer_->Measure(measure_inputs);
     CHECK_EQ(measure_outputs.size(), states.size())
         << "ScheduleMeasurer didn't output same number of MeasureOutput of states in TaskOptimizer";
 
-    // TODO(zhhsplendid): write measure record into cache.
-
+    std::vector<std::vector<float>> features;
+    std::vector<float> labels;
     for (size_t i = 0; i < measure_outputs.size(); ++i) {
+      // the cost model learns the log of the costs, which keeps their order
+      if (measure_outputs[i].execution_cost > 0 && std::isfinite(measure_outputs[i].execution_cost)) {
+        features.push_back(FeatureExtractor::Extract(states[i].mod_expr));
+        labels.push_back(std::log(measure_outputs[i].execution_cost));
+      }
+      if (database_ != nullptr) {
+        TuningRecord record;
+        record.task_key = task_->serialized_key;
+        record.trace    = states[i].trace;
+        record.result   = measure_outputs[i];
+        database_->AddRecord(record);
+      }
       if (measure_outputs[i].execution_cost < min_exec_time) {
         min_exec_time        = measure_outputs[i].execution_cost;
         result.lowered_funcs = measure_inputs[i].lowered_funcs;
       }
     }
 
+    cost_model_.Update(features, labels);
+
     measured_count += states.size();
   }
   return result;
 }
 
+std::vector<ir::LoweredFunc> TaskOptimizer::ApplyStateToLoweredFuncs(const SearchState& state) const {
+  std::vector<ir::Expr> best_exprs = state.mod_expr.GetExprs();
+  CHECK_EQ(best_exprs.size(), task_->lowered_funcs.size())
+      << "RuntimeError: Expr size is not equal to LoweredFunc size in TaskOptimizer";
+  std::vector<ir::LoweredFunc> lowered_funcs = optim::IRCopy(task_->lowered_funcs);
+  for (size_t i = 0; i < best_exprs.size(); ++i) {
+    lowered_funcs[i]->body = best_exprs[i];
+    if (task_->target == common::DefaultNVGPUTarget()) {
+      lowered_funcs[i]->PrepareCudaAxisInfoFromBody();
+    }
+  }
+  return lowered_funcs;
+}
+
+bool TaskOptimizer::LoadBestFromDatabase(SearchState* state, double* execution_cost) const {
+  if (database_ == nullptr) {
+    return false;
+  }
+  SearchSpace search_space(*task_);
+  for (const TuningRecord& record : database_->GetTopK(task_->serialized_key, 1)) {
+    if (search_space.Replay(record.trace, state)) {
+      VLOG(4) << "TaskOptimizer found a schedule of cost " << record.result.execution_cost << " in the database";
+      *execution_cost = record.result.execution_cost;
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
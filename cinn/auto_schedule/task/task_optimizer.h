@@ -15,7 +15,10 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
+#include "cinn/auto_schedule/cost_model/cost_model.h"
+#include "cinn/auto_schedule/database/database.h"
 #include "cinn/auto_schedule/measure/schedule_measurer.h"
 #include "cinn/auto_schedule/search_strategy/evolutionary_search.h"
 #include "cinn/auto_schedule/task/tune_task.h"
@@ -29,18 +32,32 @@ namespace auto_schedule {
 // optimal schedule for the task.
 class TaskOptimizer {
  public:
-  TaskOptimizer(const TuneTask& task, ScheduleMeasurer* schedule_measurer)
-      : task_(&task), schedule_measurer_(schedule_measurer) {}
+  // The measured schedules are recorded into the database if it is not null,
+  // and the best one recorded before is the start point of the tuning.
+  TaskOptimizer(const TuneTask& task, ScheduleMeasurer* schedule_measurer, Database* database = nullptr)
+      : task_(&task), schedule_measurer_(schedule_measurer), database_(database) {}
 
   TuningResult::OptimizedComputeExpr Optimize(const TuningOptions& options);
 
  private:
   TuningResult::OptimizedComputeExpr OptimizeByEvolution(const TuningOptions& options);
 
+  // Copy the LoweredFuncs of the task with the bodies of the state
+  std::vector<ir::LoweredFunc> ApplyStateToLoweredFuncs(const SearchState& state) const;
+
+  // Replay the best record of the task in the database, returns false if none
+  bool LoadBestFromDatabase(SearchState* state, double* execution_cost) const;
+
   const TuneTask* task_;
 
   ScheduleMeasurer* schedule_measurer_;
 
+  // not owned, it can be null
+  Database* database_;
+
+  // learns the measured costs of the task to guide the search
+  CostModel cost_model_;
+
   std::unique_ptr<EvolutionarySearch> evolutionary_search_ = nullptr;
 };
 
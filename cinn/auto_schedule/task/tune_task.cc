@@ -16,11 +16,17 @@
 
 #include <glog/logging.h>
 
+#include <cctype>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "cinn/auto_schedule/analysis/analyze_ir.h"
 #include "cinn/hlir/framework/graph_compiler.h"
 #include "cinn/hlir/framework/node.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir_base.h"
 #include "cinn/ir/ir_schedule.h"
 #include "cinn/ir/lowered_func.h"
@@ -47,9 +53,72 @@ void TuneTask::SetLoweredFuncBodyExprs(const std::vector<ir::Expr>& exprs) {
   }
 }
 
+namespace {
+// Print the functions with the names of the functions, tensors, buffers and
+// variables replaced by the order they first appear
+std::string SerializeWithoutNames(const std::vector<ir::LoweredFunc>& lowered_funcs) {
+  std::unordered_set<std::string> names;
+  for (const ir::LoweredFunc& func : lowered_funcs) {
+    names.insert(func->name);
+    for (const ir::Argument& arg : func->args) {
+      names.insert(arg.name());
+    }
+    for (const ir::Buffer& buf : func->temp_bufs) {
+      names.insert(buf->name);
+    }
+    ir::CollectIRNodes(func->body, [&](const Expr* x) {
+      if (x->as_var()) {
+        names.insert(x->as_var()->name);
+      } else if (x->as_tensor()) {
+        names.insert(x->as_tensor()->name);
+        if (x->as_tensor()->buffer.defined()) names.insert(x->as_tensor()->buffer->name);
+      } else if (x->as_buffer()) {
+        names.insert(x->as_buffer()->name);
+      } else if (x->As<ir::ScheduleBlock>()) {
+        names.insert(x->As<ir::ScheduleBlock>()->name);
+      }
+      return false;
+    });
+  }
+
+  std::stringstream ss;
+  for (const ir::LoweredFunc& func : lowered_funcs) {
+    ss << func << "\n";
+  }
+  std::string text = ss.str();
+
+  std::unordered_map<std::string, int> name_index;
+  std::string result;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    if (!std::isalpha(static_cast<unsigned char>(text[pos])) && text[pos] != '_') {
+      result.push_back(text[pos++]);
+      continue;
+    }
+    size_t end = pos;
+    while (end < text.size() && (std::isalnum(static_cast<unsigned char>(text[end])) || text[end] == '_')) {
+      ++end;
+    }
+    std::string token = text.substr(pos, end - pos);
+    if (names.count(token)) {
+      auto iter = name_index.emplace(token, name_index.size()).first;
+      result += "$" + std::to_string(iter->second);
+    } else {
+      result += token;
+    }
+    pos = end;
+  }
+  return result;
+}
+}  // namespace
+
 void TuneTask::SetLoweredFuncsAndAnalyzeOutput(const std::vector<ir::LoweredFunc>& lowered_funcs) {
   this->lowered_funcs = lowered_funcs;
   this->output_names  = GetOutputNamesFromLoweredFunc(this->lowered_funcs);
+
+  std::stringstream ss;
+  ss << "target:" << target << "\n" << SerializeWithoutNames(this->lowered_funcs);
+  this->serialized_key = ss.str();
 }
 
 void TuneTask::TaskGraphToUnoptLoweredFunc() {
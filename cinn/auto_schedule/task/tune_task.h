@@ -55,6 +55,10 @@ class TuneTask {
   std::vector<ir::LoweredFunc> lowered_funcs;
   // names of the output arguments of lowered_funcs_
   std::unordered_set<std::string> output_names;
+  // the target and the structure of lowered_funcs without the names of the
+  // functions and variables, so the tasks lowered to the same functions
+  // except the names have the same key
+  std::string serialized_key;
 
  private:
   // Not owned
@@ -17,6 +17,13 @@
 namespace cinn {
 namespace backends {
 
+CodeGenCX86::Feature CodeGenCX86::FeatureOf(const Target &target) {
+  if (target.has_cpu_feature(Target::CpuFeature::AVX512F)) return Feature::AVX512;
+  if (target.has_cpu_feature(Target::CpuFeature::AVX)) return Feature::AVX256;
+  if (target.has_cpu_feature(Target::CpuFeature::SSE4_2)) return Feature::SSE;
+  return Feature::None;
+}
+
 void CodeGenCX86::Visit(const ir::Add *op) { VisitBinaryOp(op, op->a(), op->b(), "add"); }
 void CodeGenCX86::Visit(const ir::Sub *op) { VisitBinaryOp(op, op->a(), op->b(), "sub"); }
 void CodeGenCX86::Visit(const ir::Mul *op) { VisitBinaryOp(op, op->a(), op->b(), "mul"); }
@@ -46,6 +46,9 @@ class CodeGenCX86 : public CodeGenC {
    */
   CodeGenCX86(Target target, Feature feature) : CodeGenC(target), feature(feature) {}
 
+  //! The widest instruction set among the features that the cpu of the target supports.
+  static Feature FeatureOf(const Target &target);
+
  protected:
   void Visit(const ir::Add *op) override;
   void Visit(const ir::Sub *op) override;
@@ -44,6 +44,16 @@ void Compiler::Build(const Module& module, const std::string& code, void* stream
   }
 }
 
+void Compiler::Build(const std::vector<ir::Module>& modules) {
+  if (target_.arch == Target::Arch::X86) {
+    engine_->Link<CodeGenX86>(modules);
+  } else {
+    // the device modules are compiled into a single cuda module
+    CHECK_EQ(modules.size(), 1UL) << "Only the host modules can be compiled separately";
+    Build(modules.front());
+  }
+}
+
 std::string Compiler::GetSourceCode(const ir::Module& module) {
   if (target_.arch == Target::Arch::NVGPU) {
 #ifdef CINN_WITH_CUDA
@@ -135,6 +145,8 @@ void Compiler::CompileX86Module(const Module& module) { engine_->Link<CodeGenX86
 
 void Compiler::ExportObject(const std::string& path) { engine_->ExportObject(path); }
 
+void Compiler::ExportSharedLibrary(const std::string& path) { engine_->ExportSharedLibrary(path); }
+
 lower_func_ptr_t Compiler::Lookup(absl::string_view fn_name) {
   CHECK(engine_);
   if (engine_->Lookup(fn_name) != nullptr) {
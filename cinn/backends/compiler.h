@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cinn/backends/llvm/codegen_llvm.h"
 #include "cinn/backends/llvm/execution_engine.h"
@@ -32,8 +33,8 @@ namespace backends {
 
 class Compiler final {
  public:
-  static std::unique_ptr<Compiler> Create(const Target& target) {
-    return std::unique_ptr<Compiler>(new Compiler(target));
+  static std::unique_ptr<Compiler> Create(const Target& target, const ExecutionOptions& options = ExecutionOptions()) {
+    return std::unique_ptr<Compiler>(new Compiler(target, options));
   }
 
   /**
@@ -41,8 +42,17 @@ class Compiler final {
    */
   void Build(const ir::Module& module, const std::string& code = "", void* stream = nullptr);
 
+  /**
+   * Compile and link several CINN modules, the host modules are compiled concurrently with
+   * ExecutionOptions::num_compile_threads threads.
+   */
+  void Build(const std::vector<ir::Module>& modules);
+
   void ExportObject(const std::string& path);
 
+  //! Link the compiled host kernels into a shared library at \p path.
+  void ExportSharedLibrary(const std::string& path);
+
   std::string GetSourceCode(const ir::Module& module);
 
   void BuildDefault(const ir::Module& module);
@@ -58,7 +68,8 @@ class Compiler final {
 
   void CompileX86Module(const ir::Module& module);
 
-  explicit Compiler(const Target& target) : target_(target), engine_(ExecutionEngine::Create(ExecutionOptions())) {}
+  Compiler(const Target& target, const ExecutionOptions& options)
+      : target_(target), engine_(ExecutionEngine::Create(options)) {}
 
   CINN_DISALLOW_COPY_AND_ASSIGN(Compiler);
 
@@ -20,6 +20,7 @@
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/IntrinsicsX86.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Metadata.h>
 #include <llvm/Support/TargetSelect.h>
@@ -71,6 +72,14 @@ bool is_integral_type(common::Type t) { return t.is_int() || t.is_uint(); }
 
 bool is_floating_type(common::Type t) { return t.is_float(); }
 
+// bfloat16 is lowered to i16 as a storage type only, the integer instructions on its bits would be silently wrong
+template <typename T>
+void CheckNotBFloat16(const T *node, common::Type t) {
+  CHECK(!t.is_bfloat16()) << "The arithmetic on bfloat16 is not supported, cast the operands to float32 first, such "
+                             "as by the pass MixedPrecision: "
+                          << NodeToExpr(node);
+}
+
 llvm::Value *EmitComparison(llvm::CmpInst::Predicate predicate,
                             llvm::Value *lhs,
                             llvm::Value *rhs,
@@ -96,6 +105,29 @@ int NextPowerOfTwo(int x) {
   return 0;
 }
 
+// The largest power of 2 dividing every value of an index, 0 if the index is always 0.
+int64_t PowerOfTwoFactor(const Expr &index) {
+  constexpr int64_t kMaxFactor = 1 << 20;
+  auto gcd                     = [](int64_t a, int64_t b) { return a == 0 ? b : (b == 0 ? a : std::min(a, b)); };
+  if (auto *imm = index.As<ir::IntImm>()) {
+    int64_t value = std::abs(imm->value);
+    return std::min(value & -value, kMaxFactor);
+  } else if (auto *add = index.As<ir::Add>()) {
+    return gcd(PowerOfTwoFactor(add->a()), PowerOfTwoFactor(add->b()));
+  } else if (auto *sub = index.As<ir::Sub>()) {
+    return gcd(PowerOfTwoFactor(sub->a()), PowerOfTwoFactor(sub->b()));
+  } else if (auto *mul = index.As<ir::Mul>()) {
+    int64_t a = PowerOfTwoFactor(mul->a());
+    int64_t b = PowerOfTwoFactor(mul->b());
+    return (a == 0 || b == 0) ? 0 : std::min(a * b, kMaxFactor);
+  } else if (auto *ramp = index.As<ir::Ramp>()) {
+    return PowerOfTwoFactor(ramp->base);
+  } else if (auto *cast = index.As<ir::Cast>()) {
+    return PowerOfTwoFactor(cast->v());
+  }
+  return 1;
+}
+
 }  // namespace
 
 CodeGenLLVM::CodeGenLLVM(llvm::Module *m,
@@ -232,35 +264,49 @@ llvm::Value *CodeGenLLVM::Visit(const ir::UIntImm *op) {
   return llvm::ConstantInt::get(type, op->value, false);
 }
 
-llvm::Value *CodeGenLLVM::Visit(const ir::FloatImm *op) { return llvm::ConstantFP::get(b_->getFloatTy(), op->value); }
+llvm::Value *CodeGenLLVM::Visit(const ir::FloatImm *op) {
+  if (op->type().is_bfloat16()) {
+    return llvm::ConstantInt::get(b_->getInt16Ty(), common::FloatToBFloat16Bits(op->value));
+  }
+  if (op->type().is_float(16)) {
+    return llvm::ConstantFP::get(b_->getHalfTy(), op->value);
+  }
+  return llvm::ConstantFP::get(b_->getFloatTy(), op->value);
+}
 
 llvm::Value *CodeGenLLVM::LLVMGenGlobalStringVar(const std::string &data) { return b_->CreateGlobalStringPtr(data); }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::StringImm *op) { return LLVMGenGlobalStringVar(op->value); }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Add *op) {
+  CheckNotBFloat16(op, op->type());
   return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '+', is_integral_type(op->type()));
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Sub *op) {
+  CheckNotBFloat16(op, op->type());
   return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '-', is_integral_type(op->type()));
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Mul *op) {
+  CheckNotBFloat16(op, op->type());
   auto *lhs = Visit(&op->a());
   auto *rhs = Visit(&op->b());
   return EmitBinaryOp(lhs, rhs, '*', is_integral_type(op->type()));
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Div *op) {
+  CheckNotBFloat16(op, op->type());
   return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '/', is_integral_type(op->type()));
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Mod *op) {
+  CheckNotBFloat16(op, op->type());
   return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '%', is_integral_type(op->type()));
 }
 
 #define __IR_EMITTER_DEFINE_CMP_VISITOR(__sop, __uop, __fop) \
+  CheckNotBFloat16(op, op->a().type());                      \
   auto *lhs = Visit(&op->a());                               \
   auto *rhs = Visit(&op->b());                               \
   CHECK(op->a().type() == op->b().type());                   \
@@ -293,6 +339,7 @@ llvm::Value *CodeGenLLVM::Visit(const ir::And *op) { return And(Visit(&op->a()),
 llvm::Value *CodeGenLLVM::Visit(const ir::Or *op) { return Or(Visit(&op->a()), Visit(&op->b())); }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Min *op) {
+  CheckNotBFloat16(op, op->type());
   auto *lhs = Visit(&op->a());
   auto *rhs = Visit(&op->b());
 
@@ -309,6 +356,7 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Min *op) {
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Max *op) {
+  CheckNotBFloat16(op, op->type());
   auto *lhs = Visit(&op->a());
   auto *rhs = Visit(&op->b());
 
@@ -325,6 +373,7 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Max *op) {
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Minus *op) {
+  CheckNotBFloat16(op, op->type());
   auto *v = Visit(&op->v());
   return (op->type().is_int() || op->type().is_uint()) ? Neg(v) : FNeg(v);
 }
@@ -371,6 +420,19 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Cast *op) {
     return Call(callee, std::vector<llvm::Value *>({value}), "pod_value_cast");
   }
 
+  // bfloat16 is cast through float
+  if (from.is_bfloat16() && to.is_bfloat16()) return value;
+  if (from.is_bfloat16()) {
+    value  = BFloat16ToFloat(value);
+    from   = common::Float(32, from.lanes());
+    source = CinnTypeToLLVMType(from, m_);
+  }
+  bool to_bfloat16 = to.is_bfloat16();
+  if (to_bfloat16) {
+    to     = common::Float(32, to.lanes());
+    target = CinnTypeToLLVMType(to, m_);
+  }
+
   do {
     if (value->getType() == target) break;
 
@@ -422,9 +484,44 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Cast *op) {
     value = FPCast(value, target);
   } while (false);
 
+  if (to_bfloat16) value = FloatToBFloat16(value);
   return value;
 }
 
+llvm::Value *CodeGenLLVM::BFloat16ToFloat(llvm::Value *value) {
+  llvm::Type *i32 = b_->getInt32Ty();
+  llvm::Type *f32 = b_->getFloatTy();
+  if (auto *vec_type = llvm::dyn_cast<llvm::FixedVectorType>(value->getType())) {
+    i32 = llvm::FixedVectorType::get(i32, vec_type->getNumElements());
+    f32 = llvm::FixedVectorType::get(f32, vec_type->getNumElements());
+  }
+  auto *bits = b_->CreateShl(b_->CreateZExt(value, i32), llvm::ConstantInt::get(i32, 16));
+  return b_->CreateBitCast(bits, f32);
+}
+
+llvm::Value *CodeGenLLVM::FloatToBFloat16(llvm::Value *value) {
+  llvm::Type *i16 = b_->getInt16Ty();
+  llvm::Type *i32 = b_->getInt32Ty();
+  if (auto *vec_type = llvm::dyn_cast<llvm::FixedVectorType>(value->getType())) {
+    int lanes = vec_type->getNumElements();
+    i16       = llvm::FixedVectorType::get(i16, lanes);
+    i32       = llvm::FixedVectorType::get(i32, lanes);
+    if (lanes == 16 && target_.has_cpu_feature(common::Target::CpuFeature::AVX512_BF16)) {
+      // vcvtneps2bf16 rounds to the nearest even the same as below
+      auto *cvt = llvm::Intrinsic::getDeclaration(m_, llvm::Intrinsic::x86_avx512bf16_cvtneps2bf16_512);
+      return b_->CreateBitCast(b_->CreateCall(cvt, {value}), i16);
+    }
+  }
+  auto *bits    = b_->CreateBitCast(value, i32);
+  auto *high    = b_->CreateLShr(bits, llvm::ConstantInt::get(i32, 16));
+  auto *lsb     = b_->CreateAnd(high, llvm::ConstantInt::get(i32, 1));
+  auto *rounded = b_->CreateAdd(bits, b_->CreateAdd(lsb, llvm::ConstantInt::get(i32, 0x7fff)));
+  auto *result  = b_->CreateTrunc(b_->CreateLShr(rounded, llvm::ConstantInt::get(i32, 16)), i16);
+  // a nan keeps a quiet bit instead of rounding to inf
+  auto *nan = b_->CreateOr(b_->CreateTrunc(high, i16), llvm::ConstantInt::get(i16, 0x40));
+  return b_->CreateSelect(b_->CreateFCmpUNO(value, value), nan, result);
+}
+
 llvm::Value *CodeGenLLVM::CreateSerialFor(const ir::For *op, int stride) {
   SymbolTableGuard symbol_table_guard(*symbol_table_);
 
@@ -524,37 +621,7 @@ llvm::Value *CodeGenLLVM::CreateSerialFor(const ir::For *op, int stride) {
   Store(indvar_inc, loop_var);
   llvm::BranchInst *back_branch = Br(header_bb);
 
-  // Add loop metadata
-  decltype(auto) ctx = b_->getContext();
-  std::vector<llvm::Metadata *> loop_metadata;
-  auto temp_node = llvm::MDNode::getTemporary(ctx, llvm::None);
-  loop_metadata.push_back(temp_node.get());
-
-  // TODO(fc500110): Loop vectorize
-  // auto *vectorization = op->metadata.vectorization ? b_->getTrue() : b_->getFalse();
-  // loop_metadata.push_back(llvm::MDNode::get(
-  //        ctx, {llvm::MDString::get(ctx, "llvm.loop.vectorize.enable"),
-  //        llvm::ConstantAsMetadata::get(b_->getFalse())}));
-
-  // Loop unroll
-  std::string llvm_unroll_metadata{"llvm.loop.unroll."};
-  switch (op->metadata.unroll_mode) {
-    case ir::LLVMForLoopMeta::FullyUnroll:
-      llvm_unroll_metadata += "full";
-      break;
-    case ir::LLVMForLoopMeta::NoUnroll:
-      llvm_unroll_metadata += "disable";
-      break;
-    default:
-      llvm_unroll_metadata += "enable";
-  }
-
-  /*
-  loop_metadata.push_back(llvm::MDNode::get(ctx, {llvm::MDString::get(ctx, llvm_unroll_metadata)}));
-  auto loop_id = llvm::MDNode::get(ctx, loop_metadata);
-  loop_id->replaceOperandWith(0, loop_id);
-  back_branch->setMetadata(llvm::LLVMContext::MD_loop, loop_id);
-  */
+  AddLoopMetadata(op, back_branch);
 
   if (old_var) {
     SetVar(op->loop_var->name, old_var);
@@ -750,13 +817,8 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Load *op) {
     if (auto *load_tensor = op->tensor.as_tensor()) {
       AddTbaaMetadata(load_inst, load_tensor->name, op->index());
     }
-
-    {
-      int alignment = op->type().bits();
-      alignment     = 8;
-      CHECK_GT(alignment, 0);
-      load_inst->setAlignment(llvm::Align(std::min(alignment, 8)));
-    }
+    AddAliasScopeMetadata(load_inst, op->tensor);
+    load_inst->setAlignment(llvm::Align(BufferAccessAlignment(op->tensor, index, op->type())));
 
     // TODO(fc500110): tbaa AliasAnalysis
     // auto md_tbaa_root      = md_builder_->createTBAARoot("cinn-tbaa");
@@ -782,6 +844,7 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Load *op) {
       if (auto *load_tensor = op->tensor.as_tensor()) {
         AddTbaaMetadata(load_inst, load_tensor->name, op->index());
       }
+      AddAliasScopeMetadata(load_inst, op->tensor);
     };
     Scalarize(op->index(), flambda);
     return ret;
@@ -813,18 +876,14 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Store *op) {
       store_inst->setMetadata("tbaa", md_builder_->createTBAAStructTagNode(meta, meta, 0));
     }
      */
-    {
-      int alignment = op->type().bits();
-      alignment     = 8;
-      CHECK_GT(alignment, 0);
-      store_inst->setAlignment(llvm::Align(std::min(alignment, 8)));
-    }
+    store_inst->setAlignment(llvm::Align(BufferAccessAlignment(op->tensor, index, op->type())));
     // TODO(fc500110): tbaa AliasAnalysis
     // auto md_tbaa_root      = md_builder_->createTBAARoot("cinn-tbaa");
     // auto md_tbaa_alias_set = md_builder_->createTBAANode("cinn-alias", md_tbaa_root);
     // llvm::MDNode *meta     = md_tbaa_alias_set;
     // store_inst->setMetadata("tbaa", md_builder_->createTBAAStructTagNode(meta, meta, 0));
     AddTbaaMetadata(store_inst, op->tensor.as_tensor()->name, op->index());
+    AddAliasScopeMetadata(store_inst, op->tensor);
     return store_inst;
   } else {  // vector store
     Expr dense_strided_ramp = detail::StridedRampBase(op->index(), 1);
@@ -846,10 +905,11 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Store *op) {
         auto *vtype = llvm::VectorType::get(CinnTypeToLLVMType(op->type().ElementOf(), m_, true),
                                             llvm::ElementCount(lanes, false /*Scalable*/))
                           ->getPointerTo();
-        int alignment = std::max(op->type().ElementOf().bits() / 8, 1);
+        int alignment = BufferAccessAlignment(op->tensor, base, op->type().ElementOf());
         llvm::StoreInst *inst =
             b_->CreateAlignedStore(CreateVecSlice(value, offset, lanes), b_->CreatePointerCast(ptr, vtype), alignment);
         AddTbaaMetadata(inst, op->tensor.as_tensor()->name, base);
+        AddAliasScopeMetadata(inst, op->tensor);
         return inst;
       }
     }
@@ -865,6 +925,7 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Store *op) {
       if (auto *store_tensor = op->tensor.as_tensor()) {
         AddTbaaMetadata(store_inst, store_tensor->name, op->index());
       }
+      AddAliasScopeMetadata(store_inst, op->tensor);
     };
     Scalarize(op->index(), flambda);
     return ret;
@@ -912,6 +973,7 @@ void appendBody(std::vector<Expr> &new_body, T &&v) {
 llvm::Value *CodeGenLLVM::Visit(const ir::_LoweredFunc_ *op) {
   auto init_function_state = [this]() { alias_vars_.clear(); };
   init_function_state();
+  InitAliasScopes(op);
 
   CHECK_EQ(op->alloc_output_buffer_exprs.size(), op->dealloc_output_buffer_exprs.size())
       << "the count of allocation and deallocaton expressions is not match";
@@ -1155,10 +1217,11 @@ llvm::Value *CodeGenLLVM::DenseVectorLoad(const ir::Load *op) {
     llvm::Value *elt_ptr = CreateBufferPtr(op->type().ElementOf(), buffer, Visit(&slice_base));
     llvm::Value *vec_ptr = b_->CreatePointerCast(elt_ptr, slice_type->getPointerTo(), "get_vec_ptr");
 
-    int alignment = std::max(op->type().ElementOf().bits() / 8, 1);
+    int alignment = BufferAccessAlignment(op->tensor, slice_base, op->type().ElementOf());
 
     llvm::Instruction *load_inst = b_->CreateAlignedLoad(vec_ptr, llvm::Align(alignment), "load_vec");
     AddTbaaMetadata(load_inst, op->tensor.as_tensor()->name, op->index());
+    AddAliasScopeMetadata(load_inst, op->tensor);
 
     slices.push_back(load_inst);
   }
@@ -1214,7 +1277,7 @@ void CodeGenLLVM::InitTarget(const Target &target) {
       if (target.bits == Target::Bit::k32) {
         naive_vec_alignment_ = 256;
       } else if (target.bits == Target::Bit::k64) {
-        naive_vec_alignment_ = 512;
+        naive_vec_alignment_ = target.native_vector_bits();
       } else {
         LOG(FATAL) << "get unknown bits";
       }
@@ -1286,6 +1349,92 @@ void CodeGenLLVM::AddTbaaMetadata(llvm::Instruction *inst, absl::string_view buf
   inst->setMetadata("tbaa", tbaa);
 }
 
+void CodeGenLLVM::AddLoopMetadata(const ir::For *op, llvm::Instruction *back_branch) {
+  auto &ctx = b_->getContext();
+  std::vector<llvm::Metadata *> hints;
+  auto add_hint = [&](const char *name, llvm::Metadata *value = nullptr) {
+    std::vector<llvm::Metadata *> operands({llvm::MDString::get(ctx, name)});
+    if (value) operands.push_back(value);
+    hints.push_back(llvm::MDNode::get(ctx, operands));
+  };
+  auto int_hint  = [&](int v) { return llvm::ConstantAsMetadata::get(b_->getInt32(v)); };
+  auto bool_hint = [&](bool v) { return llvm::ConstantAsMetadata::get(b_->getInt1(v)); };
+
+  // the loops vectorized by CINN are already replaced by ramps, only the abandoned ones are hinted
+  if (!op->metadata.vectorization) {
+    add_hint("llvm.loop.vectorize.enable", bool_hint(false));
+  } else if (op->metadata.vectorize_width > 1) {
+    add_hint("llvm.loop.vectorize.enable", bool_hint(true));
+    add_hint("llvm.loop.vectorize.width", int_hint(op->metadata.vectorize_width));
+  }
+
+  if (op->metadata.unroll_mode == ir::LLVMForLoopMeta::FullyUnroll) {
+    add_hint("llvm.loop.unroll.full");
+  } else if (op->metadata.unroll_mode == ir::LLVMForLoopMeta::NoUnroll) {
+    add_hint("llvm.loop.unroll.disable");
+  } else if (op->is_unrolled()) {
+    add_hint("llvm.loop.unroll.enable");
+  }
+  if (hints.empty()) return;
+
+  // a loop id refers to itself as the first operand
+  auto temp = llvm::MDNode::getTemporary(ctx, llvm::None);
+  hints.insert(hints.begin(), temp.get());
+  llvm::MDNode *loop_id = llvm::MDNode::getDistinct(ctx, hints);
+  loop_id->replaceOperandWith(0, loop_id);
+  back_branch->setMetadata(llvm::LLVMContext::MD_loop, loop_id);
+}
+
+void CodeGenLLVM::InitAliasScopes(const ir::_LoweredFunc_ *op) {
+  buffer_alias_scopes_.clear();
+  std::vector<std::string> buffers;
+  // the caller may pass overlapping buffers, unless the function says otherwise
+  if (op->distinct_buffer_args) {
+    for (auto &arg : op->args) {
+      if (arg.is_buffer()) buffers.push_back(arg.buffer_arg()->name);
+    }
+  }
+  for (auto &buffer : op->temp_bufs) {
+    buffers.push_back(buffer->name);
+  }
+  std::sort(buffers.begin(), buffers.end());
+  buffers.erase(std::unique(buffers.begin(), buffers.end()), buffers.end());
+  if (buffers.size() < 2) return;
+
+  llvm::MDNode *domain = md_builder_->createAnonymousAliasScopeDomain(op->name);
+  std::vector<llvm::Metadata *> scopes;
+  for (auto &buffer : buffers) {
+    scopes.push_back(md_builder_->createAnonymousAliasScope(domain, buffer));
+  }
+  auto &ctx = b_->getContext();
+  for (int i = 0; i < buffers.size(); ++i) {
+    std::vector<llvm::Metadata *> others(scopes.begin(), scopes.begin() + i);
+    others.insert(others.end(), scopes.begin() + i + 1, scopes.end());
+    buffer_alias_scopes_[buffers[i]] = {llvm::MDNode::get(ctx, {scopes[i]}), llvm::MDNode::get(ctx, others)};
+  }
+}
+
+void CodeGenLLVM::AddAliasScopeMetadata(llvm::Instruction *inst, const Expr &tensor) {
+  auto *tensor_node = tensor.as_tensor();
+  if (!tensor_node || !tensor_node->buffer.defined()) return;
+  auto it = buffer_alias_scopes_.find(tensor_node->buffer->name);
+  if (it == buffer_alias_scopes_.end()) return;
+  inst->setMetadata(llvm::LLVMContext::MD_alias_scope, it->second.first);
+  inst->setMetadata(llvm::LLVMContext::MD_noalias, it->second.second);
+}
+
+int CodeGenLLVM::BufferAccessAlignment(const Expr &tensor, const Expr &index, Type element_type) {
+  int alignment     = std::max(element_type.bits() / 8, 1);
+  auto *tensor_node = tensor.as_tensor();
+  if (!tensor_node || !tensor_node->buffer.defined() || tensor_node->buffer->data_alignment <= alignment) {
+    return alignment;
+  }
+  int64_t data_alignment = tensor_node->buffer->data_alignment;
+  int64_t factor         = PowerOfTwoFactor(index);
+  if (factor == 0) return data_alignment;
+  return std::max<int64_t>(alignment, std::min(data_alignment, alignment * factor));
+}
+
 llvm::Value *CodeGenLLVM::Visit(const ir::IntrinsicOp *op) {
   switch (op->getKind()) {
 #define __(op__)                   \
@@ -1296,16 +1445,24 @@ llvm::Value *CodeGenLLVM::Visit(const ir::IntrinsicOp *op) {
   }
 }
 
+llvm::Value *CodeGenLLVM::EmitDataAlignmentAssumption(llvm::Value *data, const Expr &buffer) {
+  auto *buffer_node = buffer.as_buffer();
+  if (buffer_node && buffer_node->data_alignment > 0) {
+    b_->CreateAlignmentAssumption(m_->getDataLayout(), data, buffer_node->data_alignment);
+  }
+  return data;
+}
+
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferGetDataHandle *op) {
   std::vector<llvm::Value *> args({Visit(&op->buffer)});
   auto *callee = m_->getFunction("cinn_buffer_get_data_handle");
-  return Call(callee, std::move(args));
+  return EmitDataAlignmentAssumption(Call(callee, std::move(args)), op->buffer);
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferGetDataConstHandle *op) {
   std::vector<llvm::Value *> args({Visit(&op->buffer)});
   auto *callee = m_->getFunction("cinn_buffer_get_data_const_handle");
-  return Call(callee, std::move(args));
+  return EmitDataAlignmentAssumption(Call(callee, std::move(args)), op->buffer);
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferCreate *op) {
@@ -207,10 +207,30 @@ class CodeGenLLVM : public LLVMIRVisitor, public IrBuilderMixin<CodeGenLLVM> {
    */
   void AddTbaaMetadata(llvm::Instruction *inst, absl::string_view buffer, Expr index);
 
+  //! Attach the unroll and vectorize hints of a loop to its back branch as `llvm.loop` metadata.
+  void AddLoopMetadata(const ir::For *op, llvm::Instruction *back_branch);
+
+  /**
+   * Create an alias scope for each buffer of a function, so a load or store of one buffer is marked as not aliasing
+   * the others, which lets LLVM vectorize without runtime alias checks. The temporary buffers never overlap, while
+   * the argument buffers are included only if the function is marked with distinct_buffer_args.
+   */
+  void InitAliasScopes(const ir::_LoweredFunc_ *op);
+  void AddAliasScopeMetadata(llvm::Instruction *inst, const Expr &tensor);
+
+  //! The alignment in bytes of accessing a buffer at the index, derived from the data alignment of the buffer.
+  int BufferAccessAlignment(const Expr &tensor, const Expr &index, Type element_type);
+  //! Tell LLVM the data pointer of a buffer is aligned to its data alignment.
+  llvm::Value *EmitDataAlignmentAssumption(llvm::Value *data, const Expr &buffer);
+
   void InitTarget(const Target &target);
 
   void Scalarize(const Expr &e, std::function<void(int i, llvm::Value *v)> flambda);
 
+  //! The bfloat16 values are stored as i16, which are converted through the bits of float.
+  llvm::Value *BFloat16ToFloat(llvm::Value *value);
+  llvm::Value *FloatToBFloat16(llvm::Value *value);
+
   llvm::Module *m_;
   llvm::IRBuilder<> *b_;
   // Current function
@@ -224,6 +244,8 @@ class CodeGenLLVM : public LLVMIRVisitor, public IrBuilderMixin<CodeGenLLVM> {
 
   llvm::MDNode *md_tbaa_root_{nullptr};
   llvm::MDNode *md_tbaa_alias_set_{nullptr};
+  // buffer name -> (the alias scope list of the buffer, the scope list of the other buffers)
+  absl::flat_hash_map<std::string, std::pair<llvm::MDNode *, llvm::MDNode *>> buffer_alias_scopes_;
 
   int naive_vec_alignment_{0};
   Target target_;
@@ -492,6 +492,17 @@ TEST(CodeGenLLVM, LowerFunc) {
   } while (false);
 }
 
+TEST(CodeGenLLVM, RejectBFloat16Arithmetic) {
+  auto context = std::make_unique<llvm::LLVMContext>();
+  auto b       = std::make_unique<llvm::IRBuilder<>>(*context);
+  auto m       = std::make_unique<llvm::Module>("test_bfloat16", *context);
+  auto emitter = std::make_unique<CodeGenLLVM>(m.get(), b.get());
+
+  // bfloat16 is lowered to i16, which the integer add would compute silently wrong
+  auto op = CreateBinaryOp<ir::Add, ir::FloatImm, float>(common::BFloat16(), 1.5f, 2.5f);
+  ASSERT_DEATH(emitter->Visit(op.get()), "bfloat16");
+}
+
 TEST(SymbolTable, test) {
   SymbolTable table;
   ASSERT_EQ(table.num_scopes(), 0UL);
@@ -21,10 +21,14 @@
 #include <utility>
 
 #include "cinn/backends/llvm/codegen_llvm.h"
+#include "cinn/common/cas.h"
 #include "cinn/common/target.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/optim/collect_undefined_vars.h"
+#include "cinn/optim/ir_copy.h"
+#include "cinn/optim/replace_var_with_expr.h"
 #include "cinn/runtime/intrinsic.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/IRBuilder.h"
@@ -81,6 +85,19 @@ void CodeGenX86::CreateParallelLaunch(Expr body, int num_task) {
   llvm::Function* f =
       llvm::Function::Create(ftype_parallel_lambda, llvm::Function::PrivateLinkage, "__parallel_lambda", m_);
   std::vector<std::string> vars = optim::CollectUndefinedVars(&body);
+  // the tasks of a dynamic or guided loop take the chunks from a counter on the stack of the launching function
+  std::string counter_name;
+  auto* for_node = body.As<ir::For>();
+  if (for_node && for_node->parallel_info().is_dynamic()) {
+    counter_name      = common::UniqName("chunk_counter");
+    auto insert_point = b_->saveIP();
+    b_->SetInsertPoint(&f_->getEntryBlock(), f_->getEntryBlock().getFirstInsertionPt());
+    llvm::Value* counter = Alloca(b_->getInt64Ty(), nullptr, counter_name);
+    b_->restoreIP(insert_point);
+    Store(llvm::ConstantInt::get(b_->getInt64Ty(), 0), counter);
+    SetVar(counter_name, counter);
+    vars.push_back(counter_name);
+  }
   uint64_t nbytes;
   auto* data = PackVars(vars, &nbytes);
 
@@ -109,6 +126,9 @@ void CodeGenX86::CreateParallelLaunch(Expr body, int num_task) {
   SetVar(task_id_name, task_id);
   SetVar(num_task_name, penv);
   par_env.penv = penv;
+  if (!counter_name.empty()) {
+    par_env.counter = GetVar(counter_name);
+  }
   std::swap(f_, f);
   std::swap(parallel_env_, par_env);
   this->Visit(&body);
@@ -119,23 +139,142 @@ void CodeGenX86::CreateParallelLaunch(Expr body, int num_task) {
   std::swap(parallel_env_, par_env);
   std::swap(f_, f);
   CHECK_NE(par_env.parallel_loop_count, 0) << "find no parallel loop within parallel launch";
+  if (!counter_name.empty()) {
+    symbol_table_->Erase(counter_name);
+  }
   b_->SetInsertPoint(launch_end);
 }
 
+Expr CodeGenX86::CollapseParallelLoops(const ir::For* op) {
+  Expr body   = op->body;
+  auto* block = body.As<ir::Block>();
+  if (block && block->stmts.size() == 1U) {
+    body = block->stmts[0];
+  }
+  auto* inner = body.As<ir::For>();
+
+  auto use_outer_var = [&](const Expr& expr) {
+    auto outer_vars = ir::CollectIRNodes(
+        expr, [&](const Expr* x) { return x->as_var() && x->as_var()->name == op->loop_var->name; });
+    return !outer_vars.empty();
+  };
+  if (!inner || !inner->is_parallel() || use_outer_var(inner->min) || use_outer_var(inner->extent)) {
+    return ir::For::Make(op->loop_var,
+                         op->min,
+                         op->extent,
+                         op->for_type(),
+                         op->device_api,
+                         op->body,
+                         op->vectorize_info(),
+                         ir::BindInfo(),
+                         op->parallel_info());
+  }
+
+  Expr inner_extent = common::AutoSimplify(inner->extent - inner->min);
+  Expr fused_extent = common::AutoSimplify((op->extent - op->min) * inner_extent);
+  Var fused_var(common::UniqName(op->loop_var->name + "_" + inner->loop_var->name + "_fused"), op->loop_var->type());
+  Expr fused_body = optim::IRCopy(inner->body);
+  optim::ReplaceVarWithExpr(&fused_body, op->loop_var, op->min + fused_var / inner_extent);
+  optim::ReplaceVarWithExpr(&fused_body, inner->loop_var, inner->min + fused_var % inner_extent);
+  // the chunk size is counted in the fused iterations, the schedule of the outer loop is preferred
+  auto& parallel_info = op->parallel_info().is_dynamic() ? op->parallel_info() : inner->parallel_info();
+  VLOG(3) << "collapse the nested parallel loops " << op->loop_var->name << " and " << inner->loop_var->name;
+  auto fused = ir::For::Make(fused_var,
+                             Expr(0),
+                             fused_extent,
+                             ir::ForType::Parallel,
+                             op->device_api,
+                             fused_body,
+                             ir::VectorizeInfo(),
+                             ir::BindInfo(),
+                             parallel_info);
+  return CollapseParallelLoops(fused.As<ir::For>());
+}
+
+void CodeGenX86::CreateDynamicParallelFor(const ir::For* op) {
+  CHECK(parallel_env_.counter) << "The dynamic parallel loop should be the outermost loop of the parallel launch";
+  auto ftype_next_chunk = llvm::FunctionType::get(ll_int32_ty(),
+                                                  {b_->getInt64Ty()->getPointerTo(),
+                                                   ll_int32_ty(),
+                                                   ll_int32_ty(),
+                                                   ll_int32_ty(),
+                                                   ll_int32_ty(),
+                                                   ll_int32_ty()->getPointerTo()},
+                                                  false);
+  auto* next_chunk_callee = llvm::dyn_cast<llvm::Function>(
+      m_->getOrInsertFunction(runtime::intrinsic::parallel_next_chunk, ftype_next_chunk).getCallee());
+  next_chunk_callee->setCallingConv(llvm::CallingConv::C);
+
+  auto insert_point = b_->saveIP();
+  b_->SetInsertPoint(&f_->getEntryBlock(), f_->getEntryBlock().getFirstInsertionPt());
+  llvm::Value* chunk_end_ptr = Alloca(ll_int32_ty(), nullptr, "chunk_end");
+  b_->restoreIP(insert_point);
+
+  Expr num_iters                 = common::AutoSimplify(op->extent - op->min);
+  llvm::Value* extent            = Visit(&num_iters);
+  llvm::Value* num_task          = Visit(&parallel_env_.num_task);
+  const ir::ParallelInfo& info   = op->parallel_info();
+  llvm::Value* chunk_size        = llvm_int32_constant(info.chunk_size);
+  llvm::Value* guided            = llvm_int32_constant(info.schedule == ir::ParallelInfo::Schedule::Guided);
+  llvm::BasicBlock* preheader_bb = b_->GetInsertBlock();
+  llvm::BasicBlock* exit_bb      = nullptr;
+  if (b_->GetInsertPoint() == preheader_bb->end()) {
+    exit_bb = llvm::BasicBlock::Create(b_->getContext(), "chunk_exit", f_, nullptr);
+  } else {
+    exit_bb = preheader_bb->splitBasicBlock(b_->GetInsertPoint(), "chunk_exit");
+    preheader_bb->getTerminator()->eraseFromParent();
+    b_->SetInsertPoint(preheader_bb);
+  }
+  llvm::BasicBlock* header_bb = llvm::BasicBlock::Create(b_->getContext(), "chunk_header", f_, nullptr);
+  llvm::BasicBlock* body_bb   = llvm::BasicBlock::Create(b_->getContext(), "chunk_body", f_, nullptr);
+  Br(header_bb);
+
+  // chunk_header: take the next chunk until all the iterations are taken
+  b_->SetInsertPoint(header_bb);
+  llvm::Value* chunk_begin = b_->CreateCall(
+      next_chunk_callee, {parallel_env_.counter, extent, num_task, chunk_size, guided, chunk_end_ptr}, "chunk_begin");
+  CondBr(ICmpSLT(chunk_begin, extent), body_bb, exit_bb);
+
+  // chunk_body: run the iterations of the chunk serially
+  b_->SetInsertPoint(body_bb);
+  auto begin_name = common::UniqName("chunk_begin");
+  auto end_name   = common::UniqName("chunk_end");
+  SetVar(begin_name, chunk_begin);
+  SetVar(end_name, Load(chunk_end_ptr, "chunk_end"));
+  auto new_for = ir::For::Make(op->loop_var,
+                               op->min + ir::Var(begin_name, Int(32)),
+                               op->min + ir::Var(end_name, Int(32)),
+                               op->for_type(),
+                               op->device_api,
+                               op->body,
+                               op->vectorize_info());
+  auto for_node = new_for.As<ir::For>();
+  CHECK(for_node);
+  CreateSerialFor(for_node);
+  Br(header_bb);
+  symbol_table_->Erase(begin_name);
+  symbol_table_->Erase(end_name);
+
+  b_->SetInsertPoint(exit_bb);
+}
+
 llvm::Value* CodeGenX86::Visit(const ir::For* op) {
   if (op->is_parallel()) {
     VLOG(3) << "parallel forloop";
     if (parallel_env_.penv == nullptr) {
-      CreateParallelLaunch(
-          ir::For::Make(
-              op->loop_var, op->min, op->extent, op->for_type(), op->device_api, op->body, op->vectorize_info()),
-          0);
+      CreateParallelLaunch(CollapseParallelLoops(op), 0);
+    } else if (parallel_env_.in_parallel_loop) {
+      // a parallel loop not perfectly nested in the outer one can't be collapsed, it runs serially in the task
+      VLOG(3) << "run the nested parallel loop " << op->loop_var->name << " serially";
+      CreateSerialFor(op);
     } else {
       Expr num_task = parallel_env_.num_task;
       Expr task_id  = parallel_env_.task_id;
-      CHECK(!parallel_env_.in_parallel_loop) << "Nested parallel loop is not supported, try to fuse them instead";
+
       parallel_env_.in_parallel_loop = true;
-      if (parallel_env_.stride_pattern) {
+      if (op->parallel_info().is_dynamic()) {
+        CreateDynamicParallelFor(op);
+      } else if (parallel_env_.stride_pattern) {
         auto new_for = ir::For::Make(
             op->loop_var, task_id, op->extent, op->for_type(), op->device_api, op->body, op->vectorize_info());
         auto for_node = new_for.As<ir::For>();
@@ -43,11 +43,17 @@ class CodeGenX86 : public CodeGenLLVM {
     bool in_parallel_loop{false};
     int parallel_loop_count{0};
     llvm::Value* penv{nullptr};
+    // the shared counter of the iterations taken by the dynamic or guided parallel loop
+    llvm::Value* counter{nullptr};
   };
 
   llvm::Value* ParallelLaunch();
   // Create parallel launch
   void CreateParallelLaunch(Expr body, int num_task);
+  // Fuse the perfectly nested parallel loops into one, so the iterations of all of them are distributed
+  Expr CollapseParallelLoops(const ir::For* op);
+  // Create the loop taking the chunks of a dynamic or guided parallel loop from the shared counter
+  void CreateDynamicParallelFor(const ir::For* op);
 
   llvm::Value* PackVars(const std::vector<std::string>& vars, uint64_t* num_bytes);
   void UnpackVars(const std::vector<std::string>& vars, llvm::Value* data);
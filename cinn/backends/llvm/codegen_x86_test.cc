@@ -15,10 +15,19 @@
 #include "cinn/backends/llvm/codegen_x86.h"
 
 #include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/Support/SourceMgr.h>
 
+#include <functional>
+#include <string>
+
+#include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
+#include "cinn/backends/llvm/llvm_util.h"
 #include "cinn/backends/llvm/simple_jit.h"
 #include "cinn/cinn.h"
 #include "cinn/common/test_helper.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/lang/lower.h"
 #include "cinn/runtime/cinn_runtime.h"
 
 namespace cinn {
@@ -68,5 +77,102 @@ TEST(Vectorize, basic) {
   }
 }
 
+TEST(CodeGenX86, AliasAlignmentAndLoopMetadata) {
+  Context::Global().ResetNameId();
+  // the extent is not a multiple of the vectorize factor, the loop is left to LLVM with the factor as a hint
+  Expr M(1001);
+  Placeholder<float> A("A", {M});
+  Placeholder<float> B("B", {M});
+
+  auto C      = Compute({M}, [&](Expr i) { return A(i) + B(i); }, "C");
+  auto stages = CreateStages({C});
+  stages[C]->Vectorize(0, 8);
+
+  auto fn = Lower("fn_metadata", stages, {A, B, C});
+  for (auto& arg : fn->args) {
+    if (arg.is_buffer()) arg.buffer_arg()->data_alignment = 64;
+  }
+  fn->distinct_buffer_args = true;
+  Module::Builder builder("module_metadata", common::DefaultHostTarget());
+  builder.AddFunction(fn);
+
+  llvm::SMDiagnostic error;
+  llvm::LLVMContext context;
+  auto m = llvm::parseAssemblyString(AsStringRef(kRuntimeLlvmIr), error, context);
+  ASSERT_TRUE(m);
+  llvm::IRBuilder<> b(context);
+  CodeGenX86 codegen(m.get(), &b);
+  codegen.Compile(builder.Build());
+  std::string ir = DumpToString(*m->getFunction("fn_metadata"));
+  LOG(INFO) << "The LLVM IR is: \n" << ir;
+
+  EXPECT_NE(ir.find("!alias.scope"), std::string::npos);
+  EXPECT_NE(ir.find("!noalias"), std::string::npos);
+  EXPECT_NE(ir.find("llvm.assume"), std::string::npos);
+  EXPECT_NE(ir.find("!llvm.loop"), std::string::npos);
+  std::string module_ir;
+  llvm::raw_string_ostream os(module_ir);
+  m->print(os, nullptr);
+  EXPECT_NE(os.str().find("!\"llvm.loop.vectorize.width\", i32 8}"), std::string::npos);
+}
+
+// Run B = A * 2 with the loops scheduled by the given function on the JIT, and check the result
+void TestParallelSchedule(const std::string& name, const std::function<void(ir::IRSchedule*)>& schedule) {
+  Context::Global().ResetNameId();
+  Expr M(67);
+  Expr N(13);
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) * 2.f; }, "B");
+
+  auto stages = CreateStages({A, B});
+  auto funcs  = lang::LowerVec(name, stages, {A, B}, {}, {}, nullptr, target, true);
+  CHECK(!funcs.empty());
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  schedule(&ir_sch);
+  LOG(INFO) << "After schedule, IR is : \n" << ir_sch.GetModule().GetExprs().at(0);
+
+  Module::Builder builder("module_" + name, target);
+  builder.AddFunction(funcs[0]);
+  auto jit = SimpleJIT::Create();
+  jit->Link(builder.Build());
+  auto* fn_ptr = reinterpret_cast<lower_func_ptr_t>(jit->Lookup(name));
+  CHECK(fn_ptr);
+
+  auto* A_buf = common::BufferBuilder(Float(32), {67, 13}).set_random().Build();
+  auto* B_buf = common::BufferBuilder(Float(32), {67, 13}).set_zero().Build();
+  auto args   = common::ArgsBuilder().Add(A_buf).Add(B_buf).Build();
+  fn_ptr(reinterpret_cast<void**>(args.data()), args.size());
+
+  auto* A_data = reinterpret_cast<float*>(A_buf->memory);
+  auto* B_data = reinterpret_cast<float*>(B_buf->memory);
+  for (int i = 0; i < B_buf->num_elements(); i++) {
+    ASSERT_NEAR(A_data[i] * 2.f, B_data[i], 1e-5) << "The element " << i << " of " << name << " is wrong";
+  }
+}
+
+TEST(CodeGenX86, DynamicParallel) {
+  TestParallelSchedule("fn_dynamic", [](ir::IRSchedule* ir_sch) {
+    ir_sch->Parallel(ir_sch->GetLoops("B")[0], ir::ParallelInfo::Schedule::Dynamic, 3);
+  });
+  TestParallelSchedule("fn_guided", [](ir::IRSchedule* ir_sch) {
+    ir_sch->Parallel(ir_sch->GetLoops("B")[0], ir::ParallelInfo::Schedule::Guided, 2);
+  });
+}
+
+TEST(CodeGenX86, CollapseNestedParallel) {
+  // the nested parallel loops are fused into one loop of 67 * 13 iterations
+  TestParallelSchedule("fn_nested_static", [](ir::IRSchedule* ir_sch) {
+    ir_sch->Parallel(ir_sch->GetLoops("B")[0]);
+    ir_sch->Parallel(ir_sch->GetLoops("B")[1]);
+  });
+  TestParallelSchedule("fn_nested_guided", [](ir::IRSchedule* ir_sch) {
+    ir_sch->Parallel(ir_sch->GetLoops("B")[0]);
+    ir_sch->Parallel(ir_sch->GetLoops("B")[1], ir::ParallelInfo::Schedule::Guided, 4);
+  });
+}
+
 }  // namespace backends
 }  // namespace cinn
@@ -0,0 +1,203 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/backends/llvm/disk_object_cache.h"
+
+#include <dirent.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+DECLARE_string(cinn_compile_cache_dir);
+DECLARE_int32(cinn_compile_cache_capacity_mb);
+
+namespace cinn::backends {
+
+namespace {
+constexpr char kMagic[8]       = {'C', 'I', 'N', 'N', 'O', 'B', 'J', '\0'};
+constexpr char kObjectSuffix[] = ".o";
+
+// The header is followed by the key and the payload
+struct ObjectHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t key_size;
+  uint64_t payload_size;
+};
+
+uint64_t Fnv1a64(const std::string& content, uint64_t seed) {
+  uint64_t hash = seed;
+  for (unsigned char c : content) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void MakeDirs(const std::string& path) {
+  for (size_t pos = path.find('/', 1);; pos = path.find('/', pos + 1)) {
+    std::string sub = path.substr(0, pos);
+    if (mkdir(sub.c_str(), 0755) != 0 && errno != EEXIST) {
+      LOG(WARNING) << "Failed to create the directory " << sub << " of the object cache: " << strerror(errno);
+      return;
+    }
+    if (pos == std::string::npos) break;
+  }
+}
+}  // namespace
+
+DiskObjectCache* DiskObjectCache::Global() {
+  if (FLAGS_cinn_compile_cache_dir.empty()) return nullptr;
+  static DiskObjectCache cache(FLAGS_cinn_compile_cache_dir,
+                               static_cast<int64_t>(FLAGS_cinn_compile_cache_capacity_mb) << 20);
+  return &cache;
+}
+
+DiskObjectCache::DiskObjectCache(const std::string& dir, int64_t capacity_bytes)
+    : dir_(dir + "/v" + std::to_string(kVersion)), capacity_bytes_(capacity_bytes) {
+  MakeDirs(dir_);
+}
+
+std::string DiskObjectCache::Fingerprint(const std::string& content) {
+  char buf[33];
+  snprintf(buf,
+           sizeof(buf),
+           "%016llx%016llx",
+           static_cast<unsigned long long>(Fnv1a64(content, 0xcbf29ce484222325ULL)),  // NOLINT
+           static_cast<unsigned long long>(Fnv1a64(content, 0x84222325cbf29ce4ULL)));  // NOLINT
+  return buf;
+}
+
+std::string DiskObjectCache::PathOf(const std::string& key) const {
+  return dir_ + "/" + Fingerprint(key) + kObjectSuffix;
+}
+
+bool DiskObjectCache::Load(const std::string& key, std::string* object) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto path = PathOf(key);
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs.is_open()) {
+    VLOG(3) << "Object " << path << " is not in the cache";
+    return false;
+  }
+  ObjectHeader header;
+  ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!ifs || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+    LOG(WARNING) << "Remove the invalid cached object " << path;
+    ifs.close();
+    std::remove(path.c_str());
+    return false;
+  }
+  // a different key of the same fingerprint is a miss, the file is replaced by the next store
+  std::string stored_key(key.size(), '\0');
+  if (header.key_size == key.size()) {
+    ifs.read(&stored_key[0], key.size());
+  }
+  if (header.key_size != key.size() || !ifs || stored_key != key) {
+    VLOG(3) << "Object " << path << " is stored for another key";
+    return false;
+  }
+  object->resize(header.payload_size);
+  ifs.read(&(*object)[0], header.payload_size);
+  if (!ifs || ifs.gcount() != static_cast<std::streamsize>(header.payload_size)) {
+    LOG(WARNING) << "Remove the truncated cached object " << path;
+    ifs.close();
+    std::remove(path.c_str());
+    return false;
+  }
+  // refresh the modification time, which is the order of eviction
+  utime(path.c_str(), nullptr);
+  VLOG(3) << "Object " << path << " is loaded from the cache, size " << header.payload_size;
+  return true;
+}
+
+void DiskObjectCache::Store(const std::string& key, const std::string& object) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto path     = PathOf(key);
+    auto tmp_path = path + ".tmp." + std::to_string(getpid());
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      LOG(WARNING) << "Failed to write the object cache file " << tmp_path;
+      return;
+    }
+    ObjectHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version      = kVersion;
+    header.reserved     = 0;
+    header.key_size     = key.size();
+    header.payload_size = object.size();
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(key.data(), key.size());
+    ofs.write(object.data(), object.size());
+    ofs.close();
+    if (!ofs || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      LOG(WARNING) << "Failed to write the object cache file " << path;
+      std::remove(tmp_path.c_str());
+      return;
+    }
+    VLOG(3) << "Object " << path << " is stored into the cache, size " << object.size();
+  }
+  Evict();
+}
+
+void DiskObjectCache::Evict() {
+  if (capacity_bytes_ <= 0) return;
+  std::lock_guard<std::mutex> lock(mu_);
+  struct Entry {
+    std::string path;
+    int64_t size;
+    time_t mtime;
+  };
+  std::vector<Entry> entries;
+  int64_t total_size = 0;
+
+  std::unique_ptr<DIR, int (*)(DIR*)> dir(opendir(dir_.c_str()), closedir);
+  if (!dir) return;
+  while (auto* ent = readdir(dir.get())) {
+    std::string name = ent->d_name;
+    if (name.size() <= sizeof(kObjectSuffix) - 1 ||
+        name.compare(name.size() - sizeof(kObjectSuffix) + 1, std::string::npos, kObjectSuffix) != 0) {
+      continue;
+    }
+    std::string path = dir_ + "/" + name;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) continue;
+    entries.push_back({path, static_cast<int64_t>(st.st_size), st.st_mtime});
+    total_size += st.st_size;
+  }
+  if (total_size <= capacity_bytes_) return;
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+  for (auto& entry : entries) {
+    if (total_size <= capacity_bytes_) break;
+    if (std::remove(entry.path.c_str()) == 0) {
+      total_size -= entry.size;
+      VLOG(3) << "Evict the cached object " << entry.path;
+    }
+  }
+}
+
+}  // namespace cinn::backends
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <string>
+
+namespace cinn::backends {
+
+/**
+ * A persistent cache of compiled object files, which lets a restarted process skip the codegen and the LLVM
+ * optimization of the modules it has compiled before.
+ *
+ * Every object is stored in a file named by the fingerprint of its key under `<dir>/v<kVersion>/`, with a header
+ * holding the version stamp, the full key and the payload size, so files written by an incompatible version or for
+ * another key of the same fingerprint are ignored. Files are
+ * written to a temporary name and renamed, so several processes can share one directory. When the total
+ * size exceeds the capacity, the least recently used objects are evicted.
+ */
+class DiskObjectCache {
+ public:
+  //! Bump it whenever the codegen changes the generated code for the same IR.
+  static constexpr uint32_t kVersion = 4;
+
+  /**
+   * Get the cache configured by FLAGS_cinn_compile_cache_dir and FLAGS_cinn_compile_cache_capacity_mb.
+   * @return nullptr if the directory flag is empty, which disables the cache.
+   */
+  static DiskObjectCache* Global();
+
+  /**
+   * Constructor.
+   * @param dir The root directory of the cache, it will be created if not exists.
+   * @param capacity_bytes The maximum total size of the cached objects, 0 means unlimited.
+   */
+  DiskObjectCache(const std::string& dir, int64_t capacity_bytes);
+
+  //! Compute a 128-bit fingerprint in hex of the canonical description of a module, used as the file name.
+  static std::string Fingerprint(const std::string& content);
+
+  //! Load the object of \p key, the canonical description of a module, into \p object, return false if it is not
+  //! cached, broken or stored for another key.
+  bool Load(const std::string& key, std::string* object);
+
+  //! Store the object of \p key, and evict the old objects if the capacity is exceeded.
+  void Store(const std::string& key, const std::string& object);
+
+  //! Remove the least recently used objects until the total size is not larger than the capacity.
+  void Evict();
+
+  const std::string& dir() const { return dir_; }
+
+ private:
+  std::string PathOf(const std::string& key) const;
+
+  std::string dir_;
+  int64_t capacity_bytes_;
+  std::mutex mu_;
+};
+
+}  // namespace cinn::backends
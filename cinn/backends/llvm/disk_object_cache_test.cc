@@ -0,0 +1,110 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/backends/llvm/disk_object_cache.h"
+
+#include <dirent.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace cinn::backends {
+
+namespace {
+// A temporary root directory of a cache, which is removed with the objects at the end of the test
+class TestCacheDir {
+ public:
+  TestCacheDir() {
+    char dir_template[] = "/tmp/disk_object_cache_test_XXXXXX";
+    CHECK(mkdtemp(dir_template));
+    root_ = dir_template;
+  }
+  ~TestCacheDir() {
+    std::string dir = root_ + "/v" + std::to_string(DiskObjectCache::kVersion);
+    if (DIR* d = opendir(dir.c_str())) {
+      while (auto* entry = readdir(d)) {
+        std::remove((dir + "/" + entry->d_name).c_str());
+      }
+      closedir(d);
+    }
+    rmdir(dir.c_str());
+    rmdir(root_.c_str());
+  }
+  const std::string& root() const { return root_; }
+
+ private:
+  std::string root_;
+};
+
+std::string ObjectPath(const DiskObjectCache& cache, const std::string& key) {
+  return cache.dir() + "/" + DiskObjectCache::Fingerprint(key) + ".o";
+}
+}  // namespace
+
+TEST(DiskObjectCache, Fingerprint) {
+  auto key0 = DiskObjectCache::Fingerprint("function fn_add_0 (A, B, C)");
+  auto key1 = DiskObjectCache::Fingerprint("function fn_add_0 (A, B, C)");
+  auto key2 = DiskObjectCache::Fingerprint("function fn_add_0 (A, C, B)");
+  EXPECT_EQ(key0.size(), 32UL);
+  EXPECT_EQ(key0, key1);
+  EXPECT_NE(key0, key2);
+}
+
+TEST(DiskObjectCache, StoreAndLoad) {
+  TestCacheDir root;
+  DiskObjectCache cache(root.root(), 0);
+  std::string object;
+  EXPECT_FALSE(cache.Load("key0", &object));
+
+  std::string expected("\x7f" "ELF object\0with zero", 21);
+  cache.Store("key0", expected);
+  ASSERT_TRUE(cache.Load("key0", &object));
+  EXPECT_EQ(object, expected);
+
+  // a broken file is treated as a miss and removed
+  std::ofstream(ObjectPath(cache, "key1")) << "not an object";
+  EXPECT_FALSE(cache.Load("key1", &object));
+  EXPECT_FALSE(std::ifstream(ObjectPath(cache, "key1")).is_open());
+
+  // an object stored for another key of the same file name is a miss
+  ASSERT_EQ(std::rename(ObjectPath(cache, "key0").c_str(), ObjectPath(cache, "key2").c_str()), 0);
+  EXPECT_FALSE(cache.Load("key2", &object));
+  cache.Store("key2", "object2");
+  ASSERT_TRUE(cache.Load("key2", &object));
+  EXPECT_EQ(object, "object2");
+}
+
+TEST(DiskObjectCache, EvictLeastRecentlyUsed) {
+  TestCacheDir root;
+  DiskObjectCache cache(root.root(), 1500);
+  std::string payload(600, 'x');
+  cache.Store("old", payload);
+  cache.Store("new", payload);
+  // make the first object older than the second one
+  struct utimbuf old_time = {1, 1};
+  utime(ObjectPath(cache, "old").c_str(), &old_time);
+
+  cache.Store("newest", payload);
+  std::string object;
+  EXPECT_FALSE(cache.Load("old", &object));
+  EXPECT_TRUE(cache.Load("new", &object));
+  EXPECT_TRUE(cache.Load("newest", &object));
+}
+
+}  // namespace cinn::backends
@@ -15,6 +15,7 @@
 #include "cinn/backends/llvm/execution_engine.h"
 
 #include <absl/strings/string_view.h>
+#include <gflags/gflags.h>
 #include <llvm/ADT/Triple.h>
 #include <llvm/AsmParser/Parser.h>
 #include <llvm/Config/llvm-config.h>
@@ -47,22 +48,40 @@
 #include <llvm/Transforms/Scalar/NewGVN.h>
 #include <llvm/Transforms/Scalar/Reassociate.h>
 #include <llvm/Transforms/Scalar/SimplifyCFG.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <sstream>
 #include <string>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include "cinn/backends/codegen_cuda_host.h"
 #include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
 #include "cinn/backends/llvm/codegen_llvm.h"
 #include "cinn/backends/llvm/codegen_x86.h"
+#include "cinn/backends/llvm/disk_object_cache.h"
 #include "cinn/backends/llvm/llvm_optimizer.h"
 #include "cinn/backends/llvm/llvm_util.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/runtime/intrinsic.h"
+#include "cinn/utils/string.h"
+#include "cinn/utils/thread_pool.h"
+
+DECLARE_string(cinn_x86_isa_variants);
+DECLARE_string(cinn_aot_linker);
 
 namespace cinn::backends {
 namespace {
@@ -85,6 +104,112 @@ void InitializeLLVMPasses() {
   // llvm::initializeTarget(registry);
   // llvm::initializeCodeGenPreparePass(registry);
 }
+
+// The optimization level used to compile the linked modules.
+constexpr int kLinkOptLevel = 3;
+
+// The LLVM names of the cpu features of common::Target::CpuFeature, in the same order.
+const char *kLLVMCpuFeatures[] = {"+sse4.2",
+                                  "+avx",
+                                  "+avx2",
+                                  "+fma",
+                                  "+avx512f",
+                                  "+avx512dq",
+                                  "+avx512bw",
+                                  "+avx512vl",
+                                  "+avx512vnni",
+                                  "+avx512bf16",
+                                  nullptr,  // avxvnni is only known by LLVM 12+, it is never needed with avx512vnni
+                                  "+amx-tile",
+                                  "+amx-int8",
+                                  "+amx-bf16"};
+
+// Create the target machine of the cpu features, or of the host cpu if the features are 0.
+std::unique_ptr<llvm::TargetMachine> CreateTargetMachine(uint64_t cpu_features) {
+  auto jtmb = llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost());
+  // the position independent objects can also be exported into a shared library
+  jtmb.setRelocationModel(llvm::Reloc::PIC_);
+  if (cpu_features) {
+    // a generic cpu with exactly the features, so the code runs on every cpu having them
+    jtmb.setCPU("x86-64");
+    jtmb.getFeatures() = llvm::SubtargetFeatures();
+    for (int i = 0; i < sizeof(kLLVMCpuFeatures) / sizeof(kLLVMCpuFeatures[0]); ++i) {
+      if ((cpu_features & (uint64_t{1} << i)) && kLLVMCpuFeatures[i]) {
+        jtmb.getFeatures().AddFeature(kLLVMCpuFeatures[i]);
+      }
+    }
+  }
+  return llvm::cantFail(jtmb.createTargetMachine());
+}
+
+// The cpu features of the instruction set levels in FLAGS_cinn_x86_isa_variants, empty if it is not set.
+std::vector<uint64_t> IsaVariants(const common::Target &target) {
+  std::vector<uint64_t> variants;
+  if (target.arch != common::Target::Arch::X86 || FLAGS_cinn_x86_isa_variants.empty()) return variants;
+  for (auto &isa : utils::Split(FLAGS_cinn_x86_isa_variants, ",")) {
+    if (!isa.empty()) variants.push_back(common::CpuFeaturesOfIsa(isa));
+  }
+  return variants;
+}
+
+// Choose the variant with the most features that the host cpu supports.
+uint64_t SelectIsaVariant(const std::vector<uint64_t> &variants) {
+  uint64_t host     = common::HostCpuFeatures();
+  uint64_t selected = 0;
+  bool found        = false;
+  for (uint64_t variant : variants) {
+    if ((host & variant) != variant) continue;
+    if (!found || __builtin_popcountll(variant) > __builtin_popcountll(selected)) selected = variant;
+    found = true;
+  }
+  CHECK(found) << "None of the instruction set variants " << FLAGS_cinn_x86_isa_variants
+               << " is supported by the host cpu with " << common::CpuFeaturesToString(host);
+  return selected;
+}
+
+// Describe everything that decides the object code of a module: the version stamps, the machine, the codegen,
+// the target and the lowered functions with the types of their arguments and buffers. It's the key of the cache.
+template <typename CodeGenT>
+std::string ObjectCacheKey(const ir::Module &module, uint64_t cpu_features) {
+  std::stringstream ss;
+  ss << "cache_version " << DiskObjectCache::kVersion << "\n";
+  ss << "llvm " << LLVM_VERSION_STRING << "\n";
+  if (cpu_features) {
+    ss << "isa " << common::CpuFeaturesToString(cpu_features) << "\n";
+  } else {
+    ss << "cpu " << llvm::sys::getHostCPUName().str() << "\n";
+    llvm::StringMap<bool> features;
+    if (llvm::sys::getHostCPUFeatures(features)) {
+      std::vector<std::string> enabled;
+      for (auto &feature : features) {
+        if (feature.getValue()) enabled.push_back(feature.getKey().str());
+      }
+      std::sort(enabled.begin(), enabled.end());
+      ss << "features " << utils::Join(enabled, ",") << "\n";
+    }
+  }
+  ss << "codegen " << typeid(CodeGenT).name() << "\n";
+  ss << "target " << module.target() << "\n";
+  ss << "opt_level " << kLinkOptLevel << "\n";
+  for (auto &buffer : module.buffers()) {
+    ss << "buffer " << buffer->name << " " << buffer->dtype << " " << buffer->shape << "\n";
+  }
+  for (auto &fn : module.functions()) {
+    for (auto &arg : fn->args) {
+      ss << "arg " << arg.human_readable() << " " << arg.type();
+      if (arg.is_buffer()) {
+        auto buffer = arg.buffer_arg();
+        ss << " " << buffer->dtype << " " << buffer->shape << " " << buffer->data_alignment;
+      }
+      ss << "\n";
+    }
+    for (auto &buffer : fn->temp_bufs) {
+      ss << "temp_buf " << buffer->name << " " << buffer->dtype << " " << buffer->shape << "\n";
+    }
+    ss << ir::Expr(fn) << "\n";
+  }
+  return ss.str();
+}
 }  // namespace
 void NaiveObjectCache::notifyObjectCompiled(const llvm::Module *m, llvm::MemoryBufferRef obj_buffer) {
   cached_objects_[m->getModuleIdentifier()] =
@@ -111,7 +236,8 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
   llvm::InitializeNativeTargetAsmPrinter();
   InitializeLLVMPasses();
 
-  auto engine = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true);
+  auto engine      = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true);
+  engine->options_ = config;
 
   auto compile_layer_creator = [&engine](llvm::orc::JITTargetMachineBuilder jtmb)
       -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
@@ -148,43 +274,138 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
   return engine;
 }
 
+namespace {
+// Generate, optimize and emit the object code of a module for the cpu features, 0 means the host cpu.
 template <typename CodeGenT>
-void ExecutionEngine::Link(const ir::Module &module) {
+std::string CompileObject(const ir::Module &module, uint64_t cpu_features) {
   llvm::SMDiagnostic error;
-  auto ctx        = std::make_unique<llvm::LLVMContext>();
-  auto m          = llvm::parseAssemblyString(AsStringRef(backends::kRuntimeLlvmIr), error, *ctx);
+  auto ctx = std::make_unique<llvm::LLVMContext>();
+  auto m   = llvm::parseAssemblyString(AsStringRef(backends::kRuntimeLlvmIr), error, *ctx);
+  // the runtime functions are linked into every module, keep them private so that several modules
+  // can be linked into one engine, and the unused ones can be removed by the optimizer
+  std::vector<llvm::GlobalValue *> runtime_definitions;
+  for (auto &f : *m) {
+    if (!f.isDeclaration()) runtime_definitions.push_back(&f);
+  }
+  for (auto &g : m->globals()) {
+    if (!g.isDeclaration()) runtime_definitions.push_back(&g);
+  }
+
   auto b          = std::make_unique<llvm::IRBuilder<>>(*ctx);
   auto ir_emitter = std::make_unique<CodeGenT>(m.get(), b.get());
   VLOG(3) << "ir_emitter->Compile(module) Begin";
   ir_emitter->Compile(module);
   VLOG(3) << "ir_emitter->Compile(module) Succeed!";
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid module found";
+  for (auto *value : runtime_definitions) {
+    value->setLinkage(llvm::GlobalValue::InternalLinkage);
+  }
 
-  auto machine =
-      std::move(llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine()));
-  LLVMModuleOptimizer optimize(machine.get(), 3, {}, true);
+  auto machine = CreateTargetMachine(cpu_features);
+  LLVMModuleOptimizer optimize(machine.get(), kLinkOptLevel, {}, true);
   optimize(m.get());
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid optimized module detected";
   for (auto &f : *m) {
     VLOG(5) << "function: " << DumpToString(f);
   }
 
-  llvm::raw_svector_ostream rawstream(buffer_);
+  // emit the object once, and link it into the jit directly instead of compiling the module again
+  llvm::SmallString<0> object;
+  llvm::raw_svector_ostream rawstream(object);
   llvm::legacy::PassManager pass_manager;
   machine->addPassesToEmitFile(pass_manager, rawstream, nullptr, llvm::CGFT_ObjectFile);
   pass_manager.run(*m);
+  return std::string(object.data(), object.size());
+}
 
-  CHECK(AddModule(std::move(m), std::move(ctx)));
+// Load the object of a module for the cpu features from the disk cache, or compile it and store it in the cache.
+template <typename CodeGenT>
+std::string LoadOrCompileObject(const ir::Module &module, uint64_t cpu_features) {
+  auto *disk_cache = DiskObjectCache::Global();
+  std::string cache_key;
+  if (disk_cache) {
+    cache_key = ObjectCacheKey<CodeGenT>(module, cpu_features);
+    std::string object;
+    if (disk_cache->Load(cache_key, &object)) {
+      // skip the codegen and the optimization, use the cached object directly
+      VLOG(3) << "Load the cached object of module " << module.name();
+      return object;
+    }
+  }
 
-  decltype(auto) es = jit_->getExecutionSession();
-  if (false) {
-    VLOG(3) << "======= dump jit execution session ======";
-    std::string buffer;
-    llvm::raw_string_ostream os(buffer);
-    es.dump(os);
-    os.flush();
-    VLOG(3) << buffer;
+  std::string object = CompileObject<CodeGenT>(module, cpu_features);
+  if (disk_cache) {
+    disk_cache->Store(cache_key, object);
+  }
+  return object;
+}
+
+// The path of the library of an isa variant, the level is inserted before the extension of \p path, such as
+// kernels.avx2.so for kernels.so. The tiny runtime looks the libraries of a package up by the same names.
+std::string IsaVariantPath(const std::string &path, const std::string &isa) {
+  auto dot   = path.rfind('.');
+  auto slash = path.rfind('/');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + "." + isa;
+  return path.substr(0, dot) + "." + isa + path.substr(dot);
+}
+
+// Write the objects to the files next to \p path, and link them into \p path by FLAGS_cinn_aot_linker with the
+// options. The linker is spawned with the arguments directly, so the paths are not interpreted by a shell.
+void LinkObjects(const std::vector<std::string> &objects,
+                 const std::vector<std::string> &options,
+                 const std::string &path) {
+  std::vector<std::string> object_paths;
+  for (int i = 0; i < objects.size(); ++i) {
+    object_paths.push_back(path + "." + std::to_string(i) + ".o");
+    std::ofstream(object_paths.back(), std::ios::binary) << objects[i];
+  }
+  std::vector<std::string> args = {FLAGS_cinn_aot_linker};
+  args.insert(args.end(), options.begin(), options.end());
+  args.push_back("-o");
+  args.push_back(path);
+  args.insert(args.end(), object_paths.begin(), object_paths.end());
+  std::vector<char *> argv;
+  for (auto &arg : args) {
+    argv.push_back(const_cast<char *>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+  VLOG(3) << "Link the objects: " << utils::Join(args, " ");
+
+  pid_t pid;
+  int error  = posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ);
+  int status = 0;
+  if (!error) {
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+  }
+  for (auto &object_path : object_paths) {
+    std::remove(object_path.c_str());
+  }
+  CHECK_EQ(error, 0) << "Failed to run the linker " << FLAGS_cinn_aot_linker << ": " << std::strerror(error);
+  CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0)
+      << "Failed to link " << path << " by: " << utils::Join(args, " ") << ", the wait status is " << status;
+}
+}  // namespace
+
+template <typename CodeGenT>
+void ExecutionEngine::Link(const ir::Module &module) {
+  // compile for the isa variant fitting the host best if the variants are set, or for the target otherwise
+  auto variants         = IsaVariants(module.target());
+  uint64_t cpu_features = variants.empty() ? module.target().cpu_features : SelectIsaVariant(variants);
+  if (!variants.empty()) {
+    // the other variants are only compiled when the kernels are exported
+    std::lock_guard<std::mutex> lock(mu_);
+    variant_compilers_.push_back(
+        [module](uint64_t features) { return LoadOrCompileObject<CodeGenT>(module, features); });
   }
+  CHECK(AddObject(LoadOrCompileObject<CodeGenT>(module, cpu_features), module.name()));
+}
+
+template <typename CodeGenT>
+void ExecutionEngine::Link(const std::vector<ir::Module> &modules) {
+  // every module is compiled in its own llvm context, so they can run concurrently
+  utils::ParallelFor(
+      0, modules.size(), [&](int i) { Link<CodeGenT>(modules[i]); }, options_.num_compile_threads);
 }
 
 bool ExecutionEngine::AddModule(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context) {
@@ -204,10 +425,46 @@ bool ExecutionEngine::AddModule(std::unique_ptr<llvm::Module> module, std::uniqu
   return true;
 }
 
+bool ExecutionEngine::AddObject(const std::string &object, const std::string &name) {
+  std::lock_guard<std::mutex> lock(mu_);
+  objects_.push_back(object);
+  auto buffer = llvm::MemoryBuffer::getMemBufferCopy(object, name);
+  if (auto err = jit_->addObjectFile(std::move(buffer))) {
+    LOG(ERROR) << "Failed to add object of " << name << ": " << llvm::toString(std::move(err));
+    return false;
+  }
+  return true;
+}
+
 void ExecutionEngine::ExportObject(const std::string &path) {
-  FILE *of = fopen(path.c_str(), "w");
-  fwrite(buffer_.data(), 1, buffer_.size(), of);
-  fclose(of);
+  std::lock_guard<std::mutex> lock(mu_);
+  CHECK(!objects_.empty()) << "No object is linked to export";
+  if (objects_.size() == 1UL) {
+    std::ofstream(path, std::ios::binary) << objects_[0];
+    return;
+  }
+  // the objects of several modules are combined into one relocatable object
+  LinkObjects(objects_, {"-r", "-nostdlib"}, path);
+}
+
+void ExecutionEngine::ExportSharedLibrary(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mu_);
+  CHECK(!objects_.empty()) << "No object is linked to export";
+  // the runtime functions are internal in every object, the undefined ones are resolved by the loading process
+  LinkObjects(objects_, {"-shared"}, path);
+  if (variant_compilers_.empty()) return;
+
+  // one more library for every isa variant, the loader chooses the best one the running cpu supports
+  CHECK_EQ(variant_compilers_.size(), objects_.size())
+      << "The objects added directly can't be compiled for the isa variants " << FLAGS_cinn_x86_isa_variants;
+  for (auto &isa : utils::Split(FLAGS_cinn_x86_isa_variants, ",")) {
+    if (isa.empty()) continue;
+    uint64_t features = common::CpuFeaturesOfIsa(isa);
+    std::vector<std::string> objects(variant_compilers_.size());
+    utils::ParallelFor(
+        0, objects.size(), [&](int i) { objects[i] = variant_compilers_[i](features); }, options_.num_compile_threads);
+    LinkObjects(objects, {"-shared"}, IsaVariantPath(path, isa));
+  }
 }
 
 void *ExecutionEngine::Lookup(absl::string_view name) {
@@ -234,5 +491,6 @@ void ExecutionEngine::RegisterRuntimeSymbols() {
 template void ExecutionEngine::Link<CodeGenLLVM>(const ir::Module &module);
 template void ExecutionEngine::Link<CodeGenX86>(const ir::Module &module);
 template void ExecutionEngine::Link<CodeGenCUDA_Host>(const ir::Module &module);
+template void ExecutionEngine::Link<CodeGenX86>(const std::vector<ir::Module> &modules);
 
 }  // namespace cinn::backends
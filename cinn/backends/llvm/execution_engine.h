@@ -61,8 +61,9 @@ class NaiveObjectCache : public llvm::ObjectCache {
 struct ExecutionOptions {
   int opt_level{3};
   bool enable_debug_info{false};
+  // the number of threads to compile the modules linked together
+  int num_compile_threads{1};
   // TODO(fc500110)
-  // int num_compile_threads{1};
   // bool enable_fast_math;
 };
 
@@ -75,10 +76,28 @@ class ExecutionEngine {
   template <typename CodeGenT = CodeGenLLVM>
   void Link(const ir::Module &module);
 
+  /**
+   * Compile the modules concurrently with ExecutionOptions::num_compile_threads threads and link all of them.
+   * The modules should not define the same function.
+   */
+  template <typename CodeGenT = CodeGenLLVM>
+  void Link(const std::vector<ir::Module> &modules);
+
+  //! Write the linked objects to \p path, the objects of several modules are combined by FLAGS_cinn_aot_linker.
   void ExportObject(const std::string &path);
 
+  /**
+   * Link all the linked objects into a shared library at \p path by FLAGS_cinn_aot_linker. If the modules are linked
+   * with FLAGS_cinn_x86_isa_variants, they are also compiled for every level, and linked into a library with the
+   * level inserted before the extension of \p path, such as kernels.avx2.so for kernels.so.
+   */
+  void ExportSharedLibrary(const std::string &path);
+
   bool AddModule(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context);
 
+  //! Link a compiled object file, such as the one exported by ExportObject.
+  bool AddObject(const std::string &object, const std::string &name);
+
  protected:
   explicit ExecutionEngine(bool enable_object_cache) : cache_(std::make_unique<NaiveObjectCache>()) {}
 
@@ -90,7 +109,11 @@ class ExecutionEngine {
 
  private:
   mutable std::mutex mu_;
-  llvm::SmallString<0> buffer_;
+  ExecutionOptions options_;
+  // the objects linked into the jit, kept for exporting
+  std::vector<std::string> objects_;
+  // compile every linked module again for the cpu features of an isa variant, empty if the variants are not set
+  std::vector<std::function<std::string(uint64_t)>> variant_compilers_;
   std::unique_ptr<llvm::orc::LLJIT> jit_;
   std::unique_ptr<NaiveObjectCache> cache_;
 };
@@ -14,9 +14,13 @@
 
 #include "cinn/backends/llvm/execution_engine.h"
 
+#include <dirent.h>
+#include <dlfcn.h>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <glog/raw_logging.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include <llvm/AsmParser/Parser.h>
 #include <llvm/IR/Argument.h>
 #include <llvm/IR/BasicBlock.h>
@@ -29,6 +33,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <iomanip>
 #include <memory>
 #include <random>
@@ -38,6 +43,7 @@
 
 #include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
 #include "cinn/backends/llvm/codegen_llvm.h"
+#include "cinn/backends/llvm/disk_object_cache.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/cinn.h"
 #include "cinn/ir/ir.h"
@@ -49,6 +55,10 @@
 #include "cinn/optim/optimize.h"
 #include "cinn/runtime/cpu/host_intrinsics.h"
 #include "cinn/runtime/cpu/use_extern_funcs.h"
+#include "cinn/utils/string.h"
+
+DECLARE_string(cinn_compile_cache_dir);
+DECLARE_string(cinn_x86_isa_variants);
 
 namespace cinn {
 namespace backends {
@@ -325,5 +335,116 @@ TEST(ExecutionEngine, call_extern) {
   }
 }
 
+// Link an elementwise add of the target into a new engine, and check its result
+void TestLinkElementwiseAdd(const common::Target &target) {
+  ir::Expr M(kM);
+  ir::Expr N(kN);
+  Placeholder<float> x("x", {M, N});
+  Placeholder<float> y("y", {M, N});
+  auto res    = Compute(
+      {M, N}, [=](Var i, Var j) { return x(i, j) + y(i, j); }, "res");
+  auto stages = CreateStages({res});
+  auto func   = Lower("isa_add", stages, {x, y, res});
+
+  Module::Builder builder("module_isa_add", target);
+  builder.AddFunction(func);
+  auto engine = backends::ExecutionEngine::Create({1});
+  engine->Link(builder.Build());
+
+  auto _ab_bb_cb_ = CreateTestBuffer();  // NOLINT
+  auto &ab        = std::get<0>(_ab_bb_cb_);
+  auto &bb        = std::get<1>(_ab_bb_cb_);
+  auto &cb        = std::get<2>(_ab_bb_cb_);
+  auto comp       = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("isa_add"));
+  ASSERT_TRUE(comp);
+  cinn_pod_value_t args[3] = {cinn_pod_value_t(ab), cinn_pod_value_t(bb), cinn_pod_value_t(cb)};
+  comp(args, 3);
+
+  auto *ad = reinterpret_cast<float *>(ab->memory);
+  auto *bd = reinterpret_cast<float *>(bb->memory);
+  auto *cd = reinterpret_cast<float *>(cb->memory);
+  for (int i = 0; i < kM * kN; i++) {
+    ASSERT_NEAR(cd[i], ad[i] + bd[i], 1e-5);
+  }
+}
+
+TEST(ExecutionEngine, isa_variants) {
+  // compile for a lower instruction set level than the host explicitly
+  common::Target target = common::DefaultHostTarget();
+  target.cpu_features   = common::CpuFeaturesOfIsa("sse4.2");
+  if ((common::HostCpuFeatures() & target.cpu_features) != target.cpu_features) {
+    LOG(INFO) << "The host cpu doesn't support sse4.2, skip the test";
+    return;
+  }
+  TestLinkElementwiseAdd(target);
+
+  // only the best variant for the host is compiled and stored in the cache
+  char dir_template[] = "/tmp/execution_engine_test_isa_XXXXXX";
+  ASSERT_TRUE(mkdtemp(dir_template));
+  std::string cache_dir        = dir_template;
+  FLAGS_cinn_compile_cache_dir = cache_dir;
+  FLAGS_cinn_x86_isa_variants  = "sse4.2,avx2";
+  if ((common::HostCpuFeatures() & common::CpuFeaturesOfIsa("avx2")) != common::CpuFeaturesOfIsa("avx2")) {
+    FLAGS_cinn_x86_isa_variants = "sse4.2";
+  }
+  TestLinkElementwiseAdd(common::DefaultHostTarget());
+  // linking again loads the object from the cache
+  TestLinkElementwiseAdd(common::DefaultHostTarget());
+
+  std::string object_dir = DiskObjectCache::Global()->dir();
+  int num_objects        = 0;
+  DIR *dir               = opendir(object_dir.c_str());
+  ASSERT_TRUE(dir);
+  while (auto *entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name == "." || name == "..") continue;
+    num_objects += name.find(".o") != std::string::npos;
+    std::remove((object_dir + "/" + name).c_str());
+  }
+  closedir(dir);
+  rmdir(object_dir.c_str());
+  rmdir(cache_dir.c_str());
+  EXPECT_EQ(num_objects, 1);
+
+  FLAGS_cinn_compile_cache_dir = "";
+  FLAGS_cinn_x86_isa_variants  = "";
+}
+
+TEST(ExecutionEngine, export_isa_variants) {
+  if ((common::HostCpuFeatures() & common::CpuFeaturesOfIsa("sse4.2")) != common::CpuFeaturesOfIsa("sse4.2")) {
+    LOG(INFO) << "The host cpu doesn't support sse4.2, skip the test";
+    return;
+  }
+  ir::Expr M(kM);
+  ir::Expr N(kN);
+  Placeholder<float> x("x", {M, N});
+  Placeholder<float> y("y", {M, N});
+  auto res    = Compute(
+      {M, N}, [=](Var i, Var j) { return x(i, j) + y(i, j); }, "res");
+  auto stages = CreateStages({res});
+  auto func   = Lower("isa_add", stages, {x, y, res});
+  Module::Builder builder("module_isa_add", common::DefaultHostTarget());
+  builder.AddFunction(func);
+
+  // every variant is exported, including the ones the host cpu doesn't support
+  FLAGS_cinn_x86_isa_variants = "sse4.2,avx512";
+  auto engine                 = backends::ExecutionEngine::Create({1});
+  engine->Link(builder.Build());
+  char dir_template[] = "/tmp/execution_engine_test_export_XXXXXX";
+  ASSERT_TRUE(mkdtemp(dir_template));
+  std::string dir = dir_template;
+  engine->ExportSharedLibrary(dir + "/kernels.so");
+  FLAGS_cinn_x86_isa_variants = "";
+
+  for (auto *name : {"/kernels.so", "/kernels.sse4.2.so", "/kernels.avx512.so"}) {
+    void *library = dlopen((dir + name).c_str(), RTLD_LAZY | RTLD_LOCAL);
+    ASSERT_TRUE(library) << dlerror();
+    EXPECT_TRUE(dlsym(library, "isa_add")) << "The kernel is not exported in " << name;
+    dlclose(library);
+    std::remove((dir + name).c_str());
+  }
+  rmdir(dir.c_str());
+}
+
 }  // namespace backends
 }  // namespace cinn
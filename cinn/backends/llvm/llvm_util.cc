@@ -36,6 +36,8 @@ llvm::Type *CinnTypeToLLVMType(common::Type type, llvm::Module *m, bool is_vec)
   llvm::Type *i32 = llvm::Type::getInt32Ty(m->getContext());
   llvm::Type *i64 = llvm::Type::getInt64Ty(m->getContext());
   llvm::Type *u32 = llvm::Type::getInt32Ty(m->getContext());
+  llvm::Type *i16 = llvm::Type::getInt16Ty(m->getContext());
+  llvm::Type *f16 = llvm::Type::getHalfTy(m->getContext());
   llvm::Type *f32 = llvm::Type::getFloatTy(m->getContext());
   llvm::Type *f64 = llvm::Type::getDoubleTy(m->getContext());
   if (type.is_void() && type.is_cpp_handle()) {
@@ -53,6 +55,11 @@ llvm::Type *CinnTypeToLLVMType(common::Type type, llvm::Module *m, bool is_vec)
     ir_type = i64;
   } else if (type.is_bool()) {
     ir_type = i1;
+  } else if (type.is_bfloat16()) {
+    // bfloat16 is stored as the high 16 bits of float
+    ir_type = i16;
+  } else if (type.is_float(16)) {
+    ir_type = f16;
   } else if (type.is_float(32)) {
     ir_type = f32;
   } else if (type.is_float(64)) {
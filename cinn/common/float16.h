@@ -0,0 +1,122 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+//! \file This file defines the 16-bit float storage types of the host, which are converted to float to compute.
+
+#include <cstdint>
+#include <cstring>
+
+namespace cinn {
+namespace common {
+
+//! Convert the bits of an IEEE half to float.
+inline float HalfBitsToFloat(uint16_t h) {
+  uint32_t sign     = static_cast<uint32_t>(h & 0x8000) << 16;
+  uint32_t exponent = (h >> 10) & 0x1f;
+  uint32_t mantissa = h & 0x3ff;
+  uint32_t bits;
+  if (exponent == 0x1f) {
+    // inf or nan
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // normalize the subnormal half
+    exponent = 113;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+//! Convert a float to the bits of an IEEE half, rounding to the nearest even.
+inline uint16_t FloatToHalfBits(float f) {
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  uint32_t abs_bits = bits & 0x7fffffff;
+  if (abs_bits >= 0x7f800000) {
+    // inf or nan, a nan keeps a quiet bit
+    return sign | 0x7c00 | (abs_bits > 0x7f800000 ? 0x200 : 0);
+  }
+  if (abs_bits >= 0x477ff000) {
+    // overflow to inf
+    return sign | 0x7c00;
+  }
+  if (abs_bits < 0x38800000) {
+    // subnormal or zero, shift the mantissa with the implicit bit into the 10 bits
+    if (abs_bits < 0x33000000) return sign;
+    uint32_t exponent = abs_bits >> 23;
+    uint32_t mantissa = (abs_bits & 0x7fffff) | 0x800000;
+    uint32_t shift    = 126 - exponent;
+    uint32_t half     = mantissa >> shift;
+    uint32_t rest     = mantissa & ((1u << shift) - 1);
+    uint32_t midpoint = 1u << (shift - 1);
+    if (rest > midpoint || (rest == midpoint && (half & 1))) ++half;
+    return sign | static_cast<uint16_t>(half);
+  }
+  uint32_t half = abs_bits - 0x38000000;
+  // round the 13 dropped bits to the nearest even
+  half += 0xfff + ((half >> 13) & 1);
+  return sign | static_cast<uint16_t>(half >> 13);
+}
+
+//! Convert the bits of a bfloat16 to float, which are the high 16 bits of the float.
+inline float BFloat16BitsToFloat(uint16_t h) {
+  uint32_t bits = static_cast<uint32_t>(h) << 16;
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+//! Convert a float to the bits of a bfloat16, rounding to the nearest even.
+inline uint16_t FloatToBFloat16Bits(float f) {
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    // keep a quiet nan
+    return static_cast<uint16_t>((bits >> 16) | 0x40);
+  }
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+//! The IEEE half of the host, common::Float(16).
+struct float16 {
+  uint16_t x{0};
+
+  float16() = default;
+  explicit float16(float value) : x(FloatToHalfBits(value)) {}
+  explicit operator float() const { return HalfBitsToFloat(x); }
+};
+
+//! The bfloat16 of the host, common::BFloat16().
+struct bfloat16 {
+  uint16_t x{0};
+
+  bfloat16() = default;
+  explicit bfloat16(float value) : x(FloatToBFloat16Bits(value)) {}
+  explicit operator float() const { return BFloat16BitsToFloat(x); }
+};
+
+}  // namespace common
+}  // namespace cinn
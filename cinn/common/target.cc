@@ -16,6 +16,10 @@
 
 #include <glog/logging.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
 #include <sstream>
 
 #include "cinn/runtime/cinn_runtime.h"
@@ -30,6 +34,12 @@ bool Target::operator==(const Target &other) const {
          features == other.features;
 }
 
+bool Target::same_cpu_features(const Target &other) const {
+  if (arch != Arch::X86 || other.arch != Arch::X86) return arch == other.arch;
+  return (cpu_features ? cpu_features : HostCpuFeatures()) ==
+         (other.cpu_features ? other.cpu_features : HostCpuFeatures());
+}
+
 int Target::runtime_arch() const {
   switch (arch) {
     case Arch::Unk:
@@ -71,6 +81,127 @@ std::string Target::arch_str() const {
   return oss.str();
 }
 
+bool Target::has_cpu_feature(CpuFeature feature) const {
+  if (arch != Arch::X86) return false;
+  uint64_t resolved = cpu_features ? cpu_features : HostCpuFeatures();
+  return resolved & CpuFeatureBit(feature);
+}
+
+int Target::native_vector_bits() const {
+  CHECK(arch == Arch::X86) << "The native vector width is only known for the x86 target";
+  if (has_cpu_feature(CpuFeature::AVX512F)) return 512;
+  if (has_cpu_feature(CpuFeature::AVX)) return 256;
+  return 128;
+}
+
+std::string Target::isa_str() const {
+  uint64_t resolved = cpu_features ? cpu_features : HostCpuFeatures();
+  for (const char *isa : {"amx", "avx512_vnni", "avx512", "avx2", "sse4.2"}) {
+    uint64_t required = CpuFeaturesOfIsa(isa);
+    if ((resolved & required) == required) return isa;
+  }
+  return "generic";
+}
+
+namespace {
+#if defined(__x86_64__) || defined(__i386__)
+uint64_t DetectCpuFeatures() {
+  using F = Target::CpuFeature;
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return 0;
+  uint64_t features = 0;
+  if (ecx & (1 << 20)) features |= CpuFeatureBit(F::SSE4_2);
+
+  // the vector registers are only usable if the OS saves them on context switches
+  bool osxsave  = ecx & (1 << 27);
+  uint64_t xcr0 = 0;
+  if (osxsave) {
+    unsigned xcr0_lo, xcr0_hi;
+    __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    xcr0 = (static_cast<uint64_t>(xcr0_hi) << 32) | xcr0_lo;
+  }
+  bool os_avx    = (xcr0 & 0x6) == 0x6;
+  bool os_avx512 = os_avx && (xcr0 & 0xe0) == 0xe0;
+  bool os_amx    = (xcr0 & 0x60000) == 0x60000;
+  if (os_avx && (ecx & (1 << 28))) features |= CpuFeatureBit(F::AVX);
+  if (os_avx && (ecx & (1 << 12))) features |= CpuFeatureBit(F::FMA);
+
+  if (__get_cpuid_max(0, nullptr) < 7) return features;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  unsigned max_subleaf = eax;
+  if (os_avx && (ebx & (1 << 5))) features |= CpuFeatureBit(F::AVX2);
+  if (os_avx512) {
+    if (ebx & (1 << 16)) features |= CpuFeatureBit(F::AVX512F);
+    if (ebx & (1 << 17)) features |= CpuFeatureBit(F::AVX512DQ);
+    if (ebx & (1u << 30)) features |= CpuFeatureBit(F::AVX512BW);
+    if (ebx & (1u << 31)) features |= CpuFeatureBit(F::AVX512VL);
+    if (ecx & (1 << 11)) features |= CpuFeatureBit(F::AVX512_VNNI);
+  }
+  if (os_amx) {
+    if (edx & (1 << 22)) features |= CpuFeatureBit(F::AMX_BF16);
+    if (edx & (1 << 24)) features |= CpuFeatureBit(F::AMX_TILE);
+    if (edx & (1 << 25)) features |= CpuFeatureBit(F::AMX_INT8);
+  }
+  if (max_subleaf >= 1) {
+    __cpuid_count(7, 1, eax, ebx, ecx, edx);
+    if (os_avx && (eax & (1 << 4))) features |= CpuFeatureBit(F::AVX_VNNI);
+    if (os_avx512 && (eax & (1 << 5))) features |= CpuFeatureBit(F::AVX512_BF16);
+  }
+  return features;
+}
+#else
+uint64_t DetectCpuFeatures() { return 0; }
+#endif
+}  // namespace
+
+uint64_t HostCpuFeatures() {
+  static const uint64_t features = DetectCpuFeatures();
+  return features;
+}
+
+uint64_t CpuFeaturesOfIsa(const std::string &isa) {
+  using F = Target::CpuFeature;
+
+  const uint64_t sse42       = CpuFeatureBit(F::SSE4_2);
+  const uint64_t avx2        = sse42 | CpuFeatureBit(F::AVX) | CpuFeatureBit(F::AVX2) | CpuFeatureBit(F::FMA);
+  const uint64_t avx512      = avx2 | CpuFeatureBit(F::AVX512F) | CpuFeatureBit(F::AVX512DQ) |
+                               CpuFeatureBit(F::AVX512BW) | CpuFeatureBit(F::AVX512VL);
+  const uint64_t avx512_vnni = avx512 | CpuFeatureBit(F::AVX512_VNNI);
+  const uint64_t amx         = avx512_vnni | CpuFeatureBit(F::AVX512_BF16) | CpuFeatureBit(F::AMX_TILE) |
+                               CpuFeatureBit(F::AMX_INT8) | CpuFeatureBit(F::AMX_BF16);
+  if (isa == "sse4.2") return sse42;
+  if (isa == "avx2") return avx2;
+  if (isa == "avx512") return avx512;
+  if (isa == "avx512_vnni") return avx512_vnni;
+  if (isa == "amx") return amx;
+  LOG(FATAL) << "Unknown x86 instruction set level: " << isa;
+  return 0;
+}
+
+std::string CpuFeaturesToString(uint64_t features) {
+  static const char *kNames[] = {"sse4.2",
+                                 "avx",
+                                 "avx2",
+                                 "fma",
+                                 "avx512f",
+                                 "avx512dq",
+                                 "avx512bw",
+                                 "avx512vl",
+                                 "avx512_vnni",
+                                 "avx512_bf16",
+                                 "avx_vnni",
+                                 "amx_tile",
+                                 "amx_int8",
+                                 "amx_bf16"};
+  std::string names;
+  for (int i = 0; i < sizeof(kNames) / sizeof(kNames[0]); ++i) {
+    if (!(features & (uint64_t{1} << i))) continue;
+    if (!names.empty()) names += ",";
+    names += kNames[i];
+  }
+  return names;
+}
+
 std::ostream &operator<<(std::ostream &os, const Target &target) {
   os << "Target<";
   switch (target.os) {
@@ -114,6 +245,9 @@ std::ostream &operator<<(std::ostream &os, const Target &target) {
       os << "unk";
       break;
   }
+  if (target.cpu_features) {
+    os << "," << CpuFeaturesToString(target.cpu_features);
+  }
   os << ">";
 
   return os;
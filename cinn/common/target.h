@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -66,6 +67,28 @@ struct Target {
   std::vector<Feature> features;
   std::vector<Lib> libs;
 
+  /**
+   * The instruction set extensions of an x86 cpu.
+   */
+  enum class CpuFeature : int {
+    SSE4_2 = 0,
+    AVX,
+    AVX2,
+    FMA,
+    AVX512F,
+    AVX512DQ,
+    AVX512BW,
+    AVX512VL,
+    AVX512_VNNI,
+    AVX512_BF16,
+    AVX_VNNI,
+    AMX_TILE,
+    AMX_INT8,
+    AMX_BF16,
+  };
+  //! The bitmask of the CpuFeatures the kernels can use, 0 means all those of the host cpu.
+  uint64_t cpu_features{0};
+
   explicit Target(OS o                                 = OS::Linux,
                   Arch a                               = Arch::Unk,
                   Bit b                                = Bit::Unk,
@@ -86,6 +109,19 @@ struct Target {
 
   std::string arch_str() const;
 
+  //! Whether the kernels of the x86 target can use a cpu feature, the host cpu is queried if none is set.
+  bool has_cpu_feature(CpuFeature feature) const;
+
+  //! The width in bits of the widest vector registers of the x86 target.
+  int native_vector_bits() const;
+
+  //! The name of the x86 instruction set level of the target, such as avx2 or avx512.
+  std::string isa_str() const;
+
+  //! Whether the kernels of the two x86 targets can use the same cpu features, the host cpu is queried if none is set.
+  bool same_cpu_features(const Target& other) const;
+
+  //! Compare the os, arch, bits and features, the cpu features are compared by same_cpu_features only.
   bool operator==(const Target& other) const;
   bool operator!=(const Target& other) const { return !(*this == other); }
   friend std::ostream& operator<<(std::ostream& os, const Target& target);
@@ -108,5 +144,19 @@ static const Target& DefaultNVGPUTarget() {
 
 std::ostream& operator<<(std::ostream& os, Target::Arch arch);
 
+inline uint64_t CpuFeatureBit(Target::CpuFeature feature) { return uint64_t{1} << static_cast<int>(feature); }
+
+//! Detect the cpu features of the host by cpuid, the features without the OS support are excluded.
+uint64_t HostCpuFeatures();
+
+/**
+ * Get the cpu features of an instruction set level, which is one of sse4.2, avx2, avx512, avx512_vnni and amx.
+ * Each level includes the features of the lower ones.
+ */
+uint64_t CpuFeaturesOfIsa(const std::string& isa);
+
+//! Join the names of the cpu features with commas.
+std::string CpuFeaturesToString(uint64_t features);
+
 }  // namespace common
 }  // namespace cinn
@@ -0,0 +1,66 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/common/target.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+namespace cinn {
+namespace common {
+
+TEST(Target, CpuFeaturesOfIsa) {
+  Target target       = DefaultHostTarget();
+  target.cpu_features = CpuFeaturesOfIsa("avx2");
+  EXPECT_TRUE(target.has_cpu_feature(Target::CpuFeature::AVX2));
+  EXPECT_TRUE(target.has_cpu_feature(Target::CpuFeature::FMA));
+  EXPECT_FALSE(target.has_cpu_feature(Target::CpuFeature::AVX512F));
+  EXPECT_EQ(target.native_vector_bits(), 256);
+  EXPECT_EQ(target.isa_str(), "avx2");
+  // the targets of different cpu features are the same target
+  EXPECT_EQ(target, DefaultHostTarget());
+  Target avx512_target       = DefaultHostTarget();
+  avx512_target.cpu_features = CpuFeaturesOfIsa("avx512");
+  EXPECT_FALSE(target.same_cpu_features(avx512_target));
+  EXPECT_TRUE(target.same_cpu_features(target));
+
+  target.cpu_features = CpuFeaturesOfIsa("avx512_vnni");
+  EXPECT_EQ(target.native_vector_bits(), 512);
+  EXPECT_EQ(target.isa_str(), "avx512_vnni");
+
+  target.cpu_features = CpuFeatureBit(Target::CpuFeature::SSE4_2);
+  EXPECT_EQ(target.native_vector_bits(), 128);
+  EXPECT_EQ(target.isa_str(), "sse4.2");
+  EXPECT_EQ(CpuFeaturesToString(target.cpu_features), "sse4.2");
+}
+
+TEST(Target, HostCpuFeatures) {
+  uint64_t features = HostCpuFeatures();
+  LOG(INFO) << "The host cpu features: " << CpuFeaturesToString(features);
+  // the features are detected once and stay the same
+  EXPECT_EQ(features, HostCpuFeatures());
+  // the higher levels imply the lower ones
+  if (features & CpuFeatureBit(Target::CpuFeature::AVX512F)) {
+    EXPECT_TRUE(features & CpuFeatureBit(Target::CpuFeature::AVX2));
+  }
+  EXPECT_EQ(DefaultHostTarget().has_cpu_feature(Target::CpuFeature::AVX2),
+            static_cast<bool>(features & CpuFeatureBit(Target::CpuFeature::AVX2)));
+#if defined(__x86_64__)
+  // every x86-64 cpu has SSE2, the vector registers are at least 128 bits
+  EXPECT_GE(DefaultHostTarget().native_vector_bits(), 128);
+#endif
+}
+
+}  // namespace common
+}  // namespace cinn
@@ -22,7 +22,7 @@ namespace common {
 
 struct Type::Storage {
   Storage() = default;
-  Storage(type_t t, int b, int w) : type_(t), bits_(b), lanes_(w) {}
+  Storage(type_t t, int b, int w, float_format_t f) : type_(t), bits_(b), lanes_(w), float_format_(f) {}
 
   type_t type_{type_t::Unk};
   cpp_type_t cpp_type_{cpp_type_t::None};
@@ -33,6 +33,9 @@ struct Type::Storage {
   //! How many elements(if a vector type), for scalar types, it should be 1.
   int lanes_{1};
 
+  //! The format of a float, which tells bfloat16 from the IEEE half.
+  float_format_t float_format_{float_format_t::IEEE};
+
   //! Name of the customized type.
   std::string customized_type_;
 };
@@ -107,7 +110,7 @@ Type &Type::set_cpp_handle2(bool x) {
 
 Type Type::VectorOf(int w) const {
   CheckTypeValid();
-  return Type(type(), bits(), w);
+  return Type(type(), bits(), w, float_format());
 }
 
 Type::Type(const Type &other) {
@@ -152,12 +155,15 @@ Type Type::with_bits(int x) const {
   CHECK(is_primitive());
   Type type               = *this;
   type.GetStorage().bits_ = x;
+  // only the 16-bit floats have the formats
+  if (x != 16) type.GetStorage().float_format_ = float_format_t::IEEE;
   return type;
 }
 
 Type Type::with_type(Type::type_t x) const {
   Type type               = *this;
   type.GetStorage().type_ = x;
+  if (x != type_t::Float) type.GetStorage().float_format_ = float_format_t::IEEE;
   return type;
 }
 
@@ -202,7 +208,7 @@ bool Type::valid() const {
   return true;
 }
 
-Type::Type(Type::type_t t, int b, int w) : storage_(new Storage(t, b, w)) {}
+Type::Type(Type::type_t t, int b, int w, float_format_t f) : storage_(new Storage(t, b, w, f)) {}
 bool Type::is_primitive() const { return !is_unk() && type() != type_t::Customized; }
 bool Type::is_customized() const { return !is_unk() && type() == type_t::Customized; }
 bool Type::is_unk() const { return type() == type_t::Unk; }
@@ -211,6 +217,8 @@ bool Type::is_void() const { return type() == type_t::Void; }
 bool Type::is_vector() const { return lanes() > 1; }
 bool Type::is_scalar() const { return lanes() == 1; }
 bool Type::is_float(int bits) const { return type() == type_t::Float && (bits < 0 || bits == this->bits()); }
+bool Type::is_float16() const { return is_float(16) && float_format() == float_format_t::IEEE; }
+bool Type::is_bfloat16() const { return is_float(16) && float_format() == float_format_t::BFloat; }
 bool Type::is_uint(int bits) const { return type() == type_t::UInt && (bits < 0 || bits == this->bits()); }
 bool Type::is_int(int bits) const { return type() == type_t::Int && (bits < 0 || bits == this->bits()); }
 bool Type::is_integer(int bits) const {
@@ -232,8 +240,10 @@ Type::type_t Type::type() const { return GetStorage().type_; }
 int Type::bits() const { return GetStorage().bits_; }
 int Type::lanes() const { return GetStorage().lanes_; }
 Type::cpp_type_t Type::cpp_type() const { return GetStorage().cpp_type_; }
+Type::float_format_t Type::float_format() const { return GetStorage().float_format_; }
 bool Type::operator==(const Type &other) const {
   return type() == other.type() && bits() == other.bits() && lanes() == other.lanes() &&
+         float_format() == other.float_format() &&
          GetStorage().cpp_type_ == other.GetStorage().cpp_type_ && customized_type() == other.customized_type();
 }
 bool Type::is_string() const { return type() == type_t::String; }
@@ -253,6 +263,10 @@ const Type &F16() {
   static auto t = Float(16);
   return t;
 }
+const Type &BF16() {
+  static auto t = BFloat16();
+  return t;
+}
 const Type &F32() {
   static auto t = Float(32);
   return t;
@@ -352,6 +366,9 @@ Type Str2Type(const std::string &type) {
       {"float16", F16()},
       {"half", F16()},
 
+      {"bfloat16", BF16()},
+      {"bf16", BF16()},
+
       {"float", F32()},
       {"float32", F32()},
 
@@ -385,6 +402,9 @@ std::string Type2Str(const Type &type) {
       }
 
     case Type::type_t::Float:
+      if (type.is_bfloat16()) {
+        return "bfloat16";
+      }
       return "float" + std::to_string(type.bits());
 
     case Type::type_t::Void:
@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 
+#include "cinn/common/float16.h"
 #include "cinn/common/macros.h"
 #include "cinn/runtime/cinn_runtime.h"
 
@@ -51,8 +52,14 @@ struct Type {
     HandleHandle = 1 << 2,  // pointer of pointer, such as `cinn_buffer_t**`.
   };
 
+  //! The formats of the floats of the same bits, the 16-bit float is an IEEE half by default.
+  enum class float_format_t : uint8_t {
+    IEEE = 0,
+    BFloat,  // bfloat16, the high 16 bits of float
+  };
+
   Type();
-  Type(type_t t, int b, int w);
+  Type(type_t t, int b, int w, float_format_t f = float_format_t::IEEE);
   Type(const Type& other);
   explicit Type(Type&& other);
   Type& operator=(const Type& other);
@@ -69,6 +76,8 @@ struct Type {
   CINN_NODISCARD bool is_vector() const;
   CINN_NODISCARD bool is_scalar() const;
   CINN_NODISCARD bool is_float(int bits = -1) const;
+  CINN_NODISCARD bool is_float16() const;
+  CINN_NODISCARD bool is_bfloat16() const;
   CINN_NODISCARD bool is_int(int bits = -1) const;
   CINN_NODISCARD bool is_integer(int bits = -1) const;
   CINN_NODISCARD bool is_uint(int bits = -1) const;
@@ -104,6 +113,7 @@ struct Type {
   int bits() const;
   int lanes() const;
   cpp_type_t cpp_type() const;
+  float_format_t float_format() const;
   // @}
 
   //! Compare two types for equality.
@@ -141,12 +151,14 @@ inline Type Void() { return Type(Type::type_t ::Void, 1, 0); }
 inline Type Int(int bits, int lanes = 1) { return Type(Type::type_t ::Int, bits, lanes); }
 inline Type UInt(int bits, int lanes = 1) { return Type(Type::type_t ::UInt, bits, lanes); }
 inline Type Float(int bits, int lanes = 1) { return Type(Type::type_t ::Float, bits, lanes); }
+inline Type BFloat16(int lanes = 1) { return Type(Type::type_t ::Float, 16, lanes, Type::float_format_t::BFloat); }
 inline Type Bool(int lanes = 1) { return Type(Type::type_t ::UInt, 1, lanes); }
 inline Type String() { return Type(Type::type_t::String, 1, 1); }
 
 //! Builtin native types as global singletons.
 // @{
 const Type& F16();
+const Type& BF16();
 const Type& F32();
 const Type& F64();
 const Type& I8();
@@ -165,6 +177,8 @@ template <typename T>
 Type type_of();
 
 // clang-format off
+template <> inline Type type_of<float16>() { return F16(); }
+template <> inline Type type_of<bfloat16>() { return BF16(); }
 template <> inline Type type_of<float>() { return F32(); }
 template <> inline Type type_of<double>() { return F64(); }
 template <> inline Type type_of<unsigned char>() { return UI8(); }
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 namespace cinn::common {
 
 TEST(Type, basic) {
@@ -28,4 +30,38 @@ TEST(Type, basic) {
   LOG(INFO) << type_of<float>();
 }
 
+TEST(Type, float16) {
+  EXPECT_TRUE(F16().is_float16());
+  EXPECT_TRUE(BF16().is_bfloat16());
+  EXPECT_TRUE(BF16().is_float(16));
+  EXPECT_NE(F16(), BF16());
+  EXPECT_EQ(BFloat16(8).ElementOf(), BF16());
+  EXPECT_EQ(BF16().with_bits(32), F32());
+  EXPECT_EQ(Str2Type("bfloat16"), BF16());
+  EXPECT_EQ(Type2Str(BF16()), "bfloat16");
+  EXPECT_EQ(Type2Str(F16()), "float16");
+  EXPECT_EQ(type_of<bfloat16>(), BF16());
+
+  EXPECT_EQ(FloatToHalfBits(1.f), 0x3c00);
+  EXPECT_EQ(FloatToHalfBits(65504.f), 0x7bff);
+  EXPECT_EQ(FloatToHalfBits(1e6f), 0x7c00);
+  // the smallest subnormal half
+  EXPECT_EQ(FloatToHalfBits(5.9604645e-8f), 0x0001);
+  EXPECT_EQ(HalfBitsToFloat(0x0001), 5.9604645e-8f);
+  EXPECT_EQ(HalfBitsToFloat(0xc000), -2.f);
+  // the ties round to the even
+  EXPECT_EQ(FloatToHalfBits(1.f + 1.f / 2048), 0x3c00);
+  EXPECT_EQ(FloatToHalfBits(1.f + 3.f / 2048), 0x3c02);
+
+  EXPECT_EQ(FloatToBFloat16Bits(1.f), 0x3f80);
+  EXPECT_EQ(BFloat16BitsToFloat(0x4049), 3.140625f);
+  EXPECT_EQ(FloatToBFloat16Bits(1.f + 1.f / 256), 0x3f80);
+  EXPECT_EQ(FloatToBFloat16Bits(1.f + 3.f / 256), 0x3f82);
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(std::nanf("")))));
+  for (float v : {0.5f, -3.25f, 1024.f}) {
+    EXPECT_EQ(static_cast<float>(float16(v)), v);
+    EXPECT_EQ(static_cast<float>(bfloat16(v)), v);
+  }
+}
+
 }  // namespace cinn::common
@@ -59,6 +59,8 @@ std::shared_ptr<ComputationContext> CompileProgram(const Target &target,
 
 #ifndef CINN_WITH_CUDA
     if (target.arch == Target::Arch::X86) {
+      hlir::framework::ApplyPass(ctx->graph.get(), "MixedPrecision");
+      hlir::framework::ApplyPass(ctx->graph.get(), "Conv2dAlgoSelect");
       hlir::framework::ApplyPass(ctx->graph.get(), "AlterLayout");
     }
 #endif
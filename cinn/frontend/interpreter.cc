@@ -116,6 +116,8 @@ void Interpreter::Impl::Build(const std::vector<std::string>& input_names,
   hlir::framework::ApplyPass(graph.get(), "InferShape");
 #ifndef CINN_WITH_CUDA
   if (target.arch == Target::Arch::X86) {
+    hlir::framework::ApplyPass(graph.get(), "MixedPrecision");
+    hlir::framework::ApplyPass(graph.get(), "Conv2dAlgoSelect");
     hlir::framework::ApplyPass(graph.get(), "AlterLayout");
   }
 #endif
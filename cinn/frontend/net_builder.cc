@@ -199,6 +199,14 @@ Variable NetBuilder::Scale(const Variable& a, float scale, float bias, bool bias
   return instr.GetOutput(0);
 }
 
+Variable NetBuilder::Cast(const Variable& a, const std::string& dtype) {
+  Instruction instr("cast", {a});
+  instr.SetAttr("dtype", dtype);
+  InferShape(instr);
+  AppendInstruction(instr);
+  return instr.GetOutput(0);
+}
+
 Variable NetBuilder::Softmax(const Variable& a, int axis, const std::string& data_format) {
   Instruction instr("softmax", {a});
   instr.SetAttr("axis", axis);
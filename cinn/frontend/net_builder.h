@@ -143,6 +143,9 @@ class NetBuilder : public BaseBuilder {
 
   Variable Scale(const Variable& a, float scale = 1.0f, float bias = 0.0f, bool bias_after_scale = true);
 
+  // cast the input to the given dtype, such as "float32", "float16" or "bfloat16"
+  Variable Cast(const Variable& a, const std::string& dtype);
+
   Variable Softmax(const Variable& a, int axis = -1, const std::string& data_format = "AnyLayout");
 
   Variable DropoutInfer(const Variable& a,
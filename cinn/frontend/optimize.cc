@@ -29,6 +29,9 @@
 
 DECLARE_bool(cinn_use_new_fusion_pass);
 DECLARE_bool(cinn_use_fill_constant_folding);
+DECLARE_bool(cinn_use_graph_cse);
+DECLARE_bool(cinn_use_uniform_constant_folding);
+DECLARE_string(cinn_x86_conv2d_algo);
 
 namespace cinn {
 namespace frontend {
@@ -53,6 +56,19 @@ OptimizeOptions DefaultTrainingOptimizeOptions() {
   } else {
     options.graph_passes = {"OpFusion"};
   }
+  // the graph is simplified before fusion
+  if (FLAGS_cinn_use_graph_cse) {
+    options.graph_passes.insert(options.graph_passes.begin(), "CommonSubexpressionElimination");
+  }
+  if (FLAGS_cinn_use_uniform_constant_folding) {
+    options.graph_passes.insert(options.graph_passes.begin(), "UniformConstantFolding");
+  }
+  // the conv2d is rewritten before the graph is simplified and fused
+  if (!FLAGS_cinn_x86_conv2d_algo.empty()) {
+    options.graph_passes.insert(options.graph_passes.begin(), "Conv2dAlgoSelect");
+  }
+  // the 16-bit floats are computed in float32 on x86, which does nothing for the graphs of float32
+  options.graph_passes.insert(options.graph_passes.begin(), "MixedPrecision");
   return options;
 }
 
@@ -19,12 +19,18 @@
 
 #include "cinn/frontend/cinn_builder.h"
 #include "cinn/frontend/program_pass.h"
+#include "gflags/gflags.h"
 #include "glog/logging.h"
 
+DECLARE_bool(cinn_use_cpu_gemm);
+
 namespace cinn {
 namespace frontend {
 namespace pass {
 
+// the activations fused into the epilogue of the cpu gemm
+static const std::unordered_set<std::string> kCpuGemmActivations{"relu", "sigmoid", "tanh"};
+
 class GemmRewriterPass : public ProgramPass {
  public:
   using ProgramPass::ProgramPass;
@@ -33,7 +39,9 @@ class GemmRewriterPass : public ProgramPass {
   void ApplyImpl(Program* prog,
                  const std::unordered_set<std::string>& fetch_ids,
                  const common::Target& target) override {
-    if (target.arch != Target::Arch::NVGPU || !prog->size()) {
+    // on x86 the matmul with its bias and activation is fused into the native cpu gemm
+    bool cpu_gemm = target.arch == Target::Arch::X86 && FLAGS_cinn_use_cpu_gemm;
+    if ((target.arch != Target::Arch::NVGPU && !cpu_gemm) || !prog->size()) {
       return;
     }
 
@@ -47,7 +55,13 @@ class GemmRewriterPass : public ProgramPass {
     }
     for (int i = prog->size() - 1; i >= 0; i--) {
       auto& instr = prog->operator[](i);
-      if (instr->op_type == "elementwise_add") {
+      if (cpu_gemm && !removed_instrs_.count(instr.get()) &&
+          (instr->op_type == "elementwise_add" || kCpuGemmActivations.count(instr->op_type))) {
+        if (DoCpuGemmFusion(&builder, instr, fetch_ids)) {
+          // the elementwise_add and the activation are fused in gemm, just skip them
+          continue;
+        }
+      } else if (!cpu_gemm && instr->op_type == "elementwise_add") {
         auto fused = DoGemmFusion(&builder, instr, fetch_ids);
         if (fused) {
           // the elementwise_add is fused in gemm, just skip it
@@ -60,8 +74,10 @@ class GemmRewriterPass : public ProgramPass {
     }
     *prog = builder.Build(true);
 
-    // Use the cublas call instead of the single matmul
-    RewriteSingleMatmul(prog);
+    // Use the cublas call instead of the single matmul, the single matmul on x86 selects the cpu gemm by itself
+    if (!cpu_gemm) {
+      RewriteSingleMatmul(prog);
+    }
 
     // relink old outputs to new outputs
     for (size_t i = 0; i < prog->size(); i++) {
@@ -168,6 +184,80 @@ class GemmRewriterPass : public ProgramPass {
     return false;
   }
 
+  // the output var of the instruction can be fused into its only consumer
+  bool IsFusible(const Variable& var, const std::unordered_set<std::string>& fetch_ids) const {
+    auto it = var_used_count_.find(var.get());
+    return it != var_used_count_.end() && it->second == 1 && !fetch_ids.count(var->id);
+  }
+
+  // Fuse the pattern of `matmul + add` and `matmul + add + activation` into the cpu_gemm on x86, the instr is the
+  // last instruction of the pattern. The bias should be a vector broadcast to the rows or of the output shape.
+  bool DoCpuGemmFusion(CinnBuilder* builder,
+                       const Instruction& instr,
+                       const std::unordered_set<std::string>& fetch_ids) {
+    Instruction add_instr = instr;
+    std::string activation;
+    if (instr->op_type != "elementwise_add") {
+      auto it = output2instr_.find(instr->inputs[0].get());
+      if (it == output2instr_.end() || it->second->op_type != "elementwise_add" ||
+          !IsFusible(instr->inputs[0], fetch_ids)) {
+        return false;
+      }
+      activation = instr->op_type;
+      add_instr  = it->second;
+    }
+    CHECK_EQ(add_instr->inputs.size(), 2) << "elementwise should have only two inputs";
+    int axis = -1;
+    if (add_instr->attrs.count("axis")) {
+      axis = absl::get<int>(add_instr->attrs.at("axis"));
+    }
+
+    for (int k = 0; k < 2; ++k) {
+      auto& var = add_instr->inputs[k];
+      auto it   = output2instr_.find(var.get());
+      if (it == output2instr_.end() || it->second->op_type != "matmul" || !IsFusible(var, fetch_ids)) {
+        continue;
+      }
+      auto& matmul_instr  = it->second;
+      auto& matmul_inputs = matmul_instr->inputs;
+      auto& bias          = add_instr->inputs[1 - k];
+      auto& attrs         = matmul_instr->attrs;
+      if (matmul_inputs[0]->shape.size() != 2 || matmul_inputs[1]->shape.size() != 2 ||
+          var->type != common::Float(32) || (attrs.count("trans_out") && absl::get<bool>(attrs.at("trans_out")))) {
+        continue;
+      }
+      // only the bias of the output shape, or the bias of the last dim broadcast as the y of elementwise_add
+      auto& out_shape = var->shape;
+      bool full_bias  = bias->shape == out_shape;
+      bool row_bias =
+          k == 0 && bias->shape.size() == 1 && bias->shape[0] == out_shape[1] && (axis == -1 || axis == 1);
+      if (!full_bias && !row_bias) {
+        continue;
+      }
+
+      bool trans_a = attrs.count("trans_a") && absl::get<bool>(attrs.at("trans_a"));
+      bool trans_b = attrs.count("trans_b") && absl::get<bool>(attrs.at("trans_b"));
+      float alpha  = attrs.count("alpha") ? absl::get<float>(attrs.at("alpha")) : 1.f;
+      VLOG(4) << "-- Fuse the matmul " << var->id << " with the bias " << bias->id << " and the activation "
+              << activation;
+      const auto& new_outs = builder->CustomInstr(
+          "cpu_gemm",
+          {matmul_inputs[0], matmul_inputs[1], bias},
+          {{"trans_a", trans_a}, {"trans_b", trans_b}, {"alpha", alpha}, {"activation", activation}});
+      auto new_out = new_outs[0];
+      auto old_out = instr.GetOutput(0);
+      new_out.set_id(old_out->id);
+      origin2new_.emplace(old_out.get(), new_out);
+
+      // After the fusion, matmul, elementwise_add and the activation should be removed.
+      removed_instrs_.emplace(matmul_instr.get());
+      removed_instrs_.emplace(add_instr.get());
+      removed_instrs_.emplace(instr.get());
+      return true;
+    }
+    return false;
+  }
+
   // Rewrite the left single matmul, use cublas call instead
   void RewriteSingleMatmul(Program* prog) {
     for (int i = 0; i < prog->size(); i++) {
@@ -20,6 +20,8 @@
 #include <utility>
 #include <vector>
 
+#include <gflags/gflags.h>
+
 #include "absl/algorithm/container.h"
 #include "absl/strings/string_view.h"
 #include "cinn/common/target.h"
@@ -27,6 +29,8 @@
 #include "cinn/frontend/pass/pass_test_helper.h"
 #include "cinn/hlir/op/use_ops.h"
 
+DECLARE_bool(cinn_use_cpu_gemm);
+
 namespace cinn::frontend {
 
 TEST(GemmRwriter, BatchedTransLeft) {
@@ -276,4 +280,48 @@ TEST(GemmRwriter, Complex) {
   CompareResult(&program, target, input_ids, {out->id}, 4, passes, 123, false);
 }
 
+TEST(GemmRwriter, CpuGemmBiasRelu) {
+  FLAGS_cinn_use_cpu_gemm = true;
+  NetBuilder builder("net_builder");
+  auto a       = builder.CreateInput(Float(32), {16, 40}, "A");
+  auto b       = builder.CreateInput(Float(32), {40, 24}, "B");
+  auto c       = builder.Matmul(a, b);
+  auto bias    = builder.CreateInput(Float(32), {24}, "Bias");
+  auto d       = builder.ElementwiseAdd(c, bias, 1);
+  auto out     = builder.Relu(d);
+  auto program = builder.Build();
+
+  common::Target target = common::DefaultHostTarget();
+  std::vector<std::string> input_ids;
+  absl::c_transform(std::vector<absl::string_view>{a.id(), b.id(), bias.id()},
+                    std::back_inserter(input_ids),
+                    [](absl::string_view id) { return std::string(id); });
+  auto passes = std::make_pair(std::vector<std::string>{"Decomposer", "RemoveIdentity"},
+                               std::vector<std::string>{"GemmRewriter"});
+  // the matmul, the elementwise_add and the relu are fused into one cpu_gemm
+  CompareResult(&program, target, input_ids, {out->id}, 2, passes, 123, false);
+  FLAGS_cinn_use_cpu_gemm = false;
+}
+
+TEST(GemmRwriter, CpuGemmFullBias) {
+  FLAGS_cinn_use_cpu_gemm = true;
+  NetBuilder builder("net_builder");
+  auto a       = builder.CreateInput(Float(32), {17, 300}, "A");
+  auto b       = builder.CreateInput(Float(32), {300, 9}, "B");
+  auto c       = builder.Matmul(a, b);
+  auto e       = builder.CreateInput(Float(32), {17, 9}, "E");
+  auto out     = builder.Add(e, c);
+  auto program = builder.Build();
+
+  common::Target target = common::DefaultHostTarget();
+  std::vector<std::string> input_ids;
+  absl::c_transform(std::vector<absl::string_view>{a.id(), b.id(), e.id()},
+                    std::back_inserter(input_ids),
+                    [](absl::string_view id) { return std::string(id); });
+  auto passes = std::make_pair(std::vector<std::string>{"Decomposer", "RemoveIdentity"},
+                               std::vector<std::string>{"GemmRewriter"});
+  CompareResult(&program, target, input_ids, {out->id}, 1, passes, 123, false);
+  FLAGS_cinn_use_cpu_gemm = false;
+}
+
 }  // namespace cinn::frontend
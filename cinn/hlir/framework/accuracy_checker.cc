@@ -14,6 +14,10 @@
 
 #include "cinn/hlir/framework/accuracy_checker.h"
 
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
 #ifdef CINN_WITH_CUDA
 #include <cuda_runtime.h>
 #endif
@@ -42,6 +46,8 @@ template <typename T>
 std::string GetTypeString() {
   if (std::is_same<T, float>::value) {
     return "float";
+  } else if (std::is_same<T, int8_t>::value) {
+    return "int8_t";
   } else if (std::is_same<T, int32_t>::value) {
     return "int32_t";
   } else if (std::is_same<T, int64_t>::value) {
@@ -63,18 +69,18 @@ std::string DebugString(const Tensor& cpu_tensor, const std::string& name, const
       if (i > 0) {
         ss << ", ";
       }
-      ss << data[i];
+      ss << +data[i];
     }
   } else {
     for (size_t i = 0; i < 5; ++i) {
       if (i > 0) {
         ss << ", ";
       }
-      ss << data[i];
+      ss << +data[i];
     }
     ss << " ... ";
     for (size_t i = numel - 5; i < numel; ++i) {
-      ss << data[i];
+      ss << +data[i];
       if (i != numel - 1) {
         ss << ", ";
       }
@@ -97,6 +103,8 @@ std::string AccuracyChecker::operator()(const std::string& arg_name) {
   auto tensor = scope_->GetTensor(arg_name);
   if (tensor->type().is_float()) {
     return CheckTensor<float>(tensor, arg_name);
+  } else if (tensor->type().is_int(8)) {
+    return CheckTensor<int8_t>(tensor, arg_name);
   } else if (tensor->type().is_int()) {
     return CheckTensor<int32_t>(tensor, arg_name);
   } else {
@@ -111,6 +119,8 @@ std::string AccuracyChecker::operator()(const std::map<std::string, cinn_pod_val
   const cinn_buffer_t* buffer = cinn_pod_value_to_buffer_p(const_cast<cinn_pod_value_t*>(&name2podargs->at(arg_name)));
   if (buffer->type == cinn_float32_t()) {
     return CheckBuffer<float>(buffer, arg_name);
+  } else if (buffer->type == cinn_int8_t()) {
+    return CheckBuffer<int8_t>(buffer, arg_name);
   } else if (buffer->type == cinn_int32_t()) {
     return CheckBuffer<int32_t>(buffer, arg_name);
   } else if (buffer->type == cinn_int64_t()) {
@@ -121,8 +131,61 @@ std::string AccuracyChecker::operator()(const std::map<std::string, cinn_pod_val
   }
 }
 
+std::string AccuracyStats::DebugString() const {
+  std::stringstream ss;
+  ss << "max_abs_diff=" << max_abs_diff << ", mean_abs_diff=" << mean_abs_diff
+     << ", cosine_similarity=" << cosine_similarity;
+  if (result == CheckResult::kZero) {
+    ss << ", Zero";
+  } else if (result == CheckResult::kNaN) {
+    ss << ", NaN";
+  } else if (result == CheckResult::kInf) {
+    ss << ", Inf";
+  } else {
+    ss << ", OK";
+  }
+  return ss.str();
+}
+
+AccuracyStats AccuracyChecker::Compare(const std::string& arg_name, const Tensor& reference) {
+  auto tensor = scope_->GetTensor(arg_name);
+  CHECK(tensor->type().is_float(32) && reference->type().is_float(32))
+      << "Only the float tensors are compared, but " << arg_name << " is " << tensor->type();
+  CHECK(tensor->shape().data() == reference->shape().data()) << "The shape of " << arg_name << " differs from the reference";
+  Tensor cpu_tensor    = CopyToHost<float>(tensor);
+  Tensor cpu_reference = CopyToHost<float>(reference);
+
+  AccuracyStats stats;
+  stats.result = CheckNanOrInf<float>(cpu_tensor);
+  if (stats.result == CheckResult::kNaN || stats.result == CheckResult::kInf) {
+    return stats;
+  }
+  size_t numel     = cpu_tensor->shape().numel();
+  const float* out = cpu_tensor->data<float>();
+  const float* ref = cpu_reference->data<float>();
+  double sum_diff  = 0.0;
+  double dot       = 0.0;
+  double out_norm  = 0.0;
+  double ref_norm  = 0.0;
+  for (size_t i = 0; i < numel; ++i) {
+    double diff        = std::abs(static_cast<double>(out[i]) - ref[i]);
+    stats.max_abs_diff = std::max(stats.max_abs_diff, diff);
+    sum_diff += diff;
+    dot += static_cast<double>(out[i]) * ref[i];
+    out_norm += static_cast<double>(out[i]) * out[i];
+    ref_norm += static_cast<double>(ref[i]) * ref[i];
+  }
+  stats.mean_abs_diff = numel > 0 ? sum_diff / numel : 0.0;
+  if (out_norm > 0.0 && ref_norm > 0.0) {
+    stats.cosine_similarity = dot / std::sqrt(out_norm * ref_norm);
+  } else if (out_norm != ref_norm) {
+    stats.cosine_similarity = 0.0;
+  }
+  return stats;
+}
+
 template <typename T>
-std::string AccuracyChecker::CheckTensor(const Tensor& tensor, const std::string& arg_name) {
+Tensor AccuracyChecker::CopyToHost(const Tensor& tensor) {
   Tensor cpu_tensor;
   cpu_tensor->Resize(tensor->shape());
   T* dst = cpu_tensor->mutable_data<T>(common::DefaultHostTarget());
@@ -130,6 +193,12 @@ std::string AccuracyChecker::CheckTensor(const Tensor& tensor, const std::string
   const T* src = tensor->data<T>();
   size_t numel = tensor->shape().numel();
   MemcpyDeviceToHost(src, numel, dst);
+  return cpu_tensor;
+}
+
+template <typename T>
+std::string AccuracyChecker::CheckTensor(const Tensor& tensor, const std::string& arg_name) {
+  Tensor cpu_tensor = CopyToHost<T>(tensor);
 
   auto res        = CheckNanOrInf<T>(cpu_tensor);
   auto result_str = DebugString<T>(cpu_tensor, arg_name, res);
@@ -23,6 +23,16 @@ namespace framework {
 
 enum CheckResult { kOK = 0, kZero = 1, kNaN = 2, kInf = 3 };
 
+// The difference of a float tensor to its reference, such as the output of a quantized program to the float one.
+struct AccuracyStats {
+  CheckResult result       = kOK;
+  double max_abs_diff      = 0.0;
+  double mean_abs_diff     = 0.0;
+  double cosine_similarity = 1.0;
+
+  std::string DebugString() const;
+};
+
 class AccuracyChecker {
  public:
   AccuracyChecker(const Target& target, Scope* scope) : target_(target), scope_(scope) {}
@@ -30,6 +40,9 @@ class AccuracyChecker {
   std::string operator()(const std::string& arg_name);
   std::string operator()(const std::map<std::string, cinn_pod_value_t>* name2podargs, const std::string& arg_name);
 
+  // Compare the float tensor of arg_name with the reference tensor of the same shape, which may be on the device.
+  AccuracyStats Compare(const std::string& arg_name, const Tensor& reference);
+
  private:
   template <typename T>
   std::string CheckTensor(const Tensor& tensor, const std::string& arg_name);
@@ -37,6 +50,9 @@ class AccuracyChecker {
   template <typename T>
   std::string CheckBuffer(const cinn_buffer_t* buffer, const std::string& arg_name);
 
+  template <typename T>
+  Tensor CopyToHost(const Tensor& tensor);
+
   template <typename T>
   void MemcpyDeviceToHost(const T* src, size_t numel, T* dst);
 
@@ -49,6 +49,17 @@ void Buffer::SetTarget(const common::Target& target) {
   memory_mng_cache_ = MemoryManager::Global().RetrieveSafely(target_.arch);
 }
 
+void Buffer::ShareMemory(const std::shared_ptr<Buffer>& arena, uint32_t offset, uint32_t size) {
+  CHECK(arena && arena.get() != this);
+  CHECK_LE(offset + size, arena->size_) << "The shared memory is out of the range of the arena";
+  Free();
+  SetTarget(arena->target_);
+  arena_            = arena;
+  data_.memory      = arena->data_.memory + offset;
+  data_.memory_size = size;
+  size_             = size;
+}
+
 void Buffer::ResizeLazy(uint32_t size) {
   if (size <= size_) return;
   Resize(size);
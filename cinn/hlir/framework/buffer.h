@@ -53,12 +53,23 @@ struct Buffer final {
 
   void SetTarget(const common::Target& target);
 
+  /**
+   * Let this buffer refer to the \p size bytes at \p offset of \p arena instead of owning its memory,
+   * the arena is kept alive until this buffer is freed or resized.
+   */
+  void ShareMemory(const std::shared_ptr<Buffer>& arena, uint32_t offset, uint32_t size);
+
   const cinn_buffer_t* data() const { return &data_; }
   cinn_buffer_t* data() { return &data_; }
 
   //! Free all the memory owned by this buffer.
   void Free() {
     if (!data_.memory) return;
+    // the memory shared from an arena is released with the arena
+    if (arena_) {
+      arena_.reset();
+      return;
+    }
     memory_mng_cache_->free(data_.memory);
   }
 
@@ -84,6 +95,9 @@ struct Buffer final {
 
   //! Hold the corresponding memory manager for speed.
   MemoryInterface* memory_mng_cache_{};
+
+  //! The buffer owning the memory, if the memory is shared from it.
+  std::shared_ptr<Buffer> arena_;
 };
 
 }  // namespace framework
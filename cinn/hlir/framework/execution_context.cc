@@ -0,0 +1,127 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/execution_context.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstring>
+#include <unordered_set>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+std::shared_ptr<Buffer> AllocLocalBuffer(uint32_t size) {
+  auto buffer = std::make_shared<Buffer>(common::DefaultHostTarget());
+  buffer->ResizeLazy(1024, size);
+  return buffer;
+}
+}  // namespace
+
+ExecutionContext::ExecutionContext(const std::shared_ptr<Scope>& scope,
+                                   const std::vector<std::unique_ptr<Instruction>>& instrs,
+                                   const MemoryPlan& memory_plan)
+    : shared_scope_(scope), instrs_(instrs) {
+  std::unordered_set<std::string> written_vars;
+  for (auto& ins : instrs_) {
+    CHECK(ins->target_.arch == Target::Arch::X86) << "ExecutionContext only supports the programs on host";
+    for (auto& out_args : ins->GetOutArgs()) {
+      written_vars.insert(out_args.begin(), out_args.end());
+    }
+  }
+
+  // the variables reusing the memory of another one share the same buffer, they must be copied together
+  absl::flat_hash_map<Buffer*, std::vector<std::string>> buffer2vars;
+  for (auto& name : shared_scope_->var_names()) {
+    auto tensor = shared_scope_->GetTensor(std::string({name.data(), name.size()}));
+    buffer2vars[tensor->get_buffer().get()].emplace_back(name.data(), name.size());
+  }
+
+  if (!memory_plan.offsets.empty()) {
+    arena_ = AllocLocalBuffer(memory_plan.arena_size);
+  }
+  std::unordered_set<Buffer*> copied_buffers;
+  for (auto& name : written_vars) {
+    if (!shared_scope_->FindVar(name)) continue;
+    auto shared_buffer = shared_scope_->GetTensor(name)->get_buffer();
+    if (!copied_buffers.insert(shared_buffer.get()).second) continue;
+
+    uint32_t size = shared_buffer->data()->memory_size;
+    CHECK_GT(size, 0) << "The variable " << name << " should be instantiated before creating an ExecutionContext";
+    std::shared_ptr<Buffer> buffer;
+    auto it = memory_plan.offsets.find(name);
+    if (it != memory_plan.offsets.end()) {
+      buffer = std::make_shared<Buffer>();
+      buffer->ShareMemory(arena_, it->second, size);
+    } else {
+      buffer = AllocLocalBuffer(size);
+    }
+
+    bool has_unwritten_alias = false;
+    for (auto& var : buffer2vars.at(shared_buffer.get())) {
+      CreateLocalTensor(var, buffer);
+      has_unwritten_alias |= !written_vars.count(var);
+    }
+    // a variable not written by the instructions, such as a feed reused by a reshape, keeps its value
+    if (has_unwritten_alias) {
+      std::memcpy(buffer->data()->memory, shared_buffer->data()->memory, size);
+    }
+  }
+  VLOG(3) << "ExecutionContext is created with " << local_scope_.var_names().size() << " local variables";
+}
+
+Tensor ExecutionContext::CreateLocalTensor(const std::string& name, const std::shared_ptr<Buffer>& buffer) {
+  auto shared_tensor = shared_scope_->GetTensor(name);
+  auto* var          = local_scope_.Var<Tensor>(name);
+  auto& tensor       = absl::get<Tensor>(*var);
+  tensor->Resize(shared_tensor->shape());
+  tensor->set_type(shared_tensor->type());
+  tensor->set_buffer(buffer);
+  args_.clear();
+  return tensor;
+}
+
+Tensor ExecutionContext::GetTensor(const std::string& name) {
+  if (auto* var = local_scope_.FindVar(name)) {
+    return absl::get<Tensor>(*var);
+  }
+  auto shared_buffer = shared_scope_->GetTensor(name)->get_buffer();
+  uint32_t size      = shared_buffer->data()->memory_size;
+  auto buffer        = AllocLocalBuffer(size);
+  if (size > 0) {
+    std::memcpy(buffer->data()->memory, shared_buffer->data()->memory, size);
+  }
+  return CreateLocalTensor(name, buffer);
+}
+
+void ExecutionContext::Run() {
+  if (args_.empty()) {
+    auto find_tensor = [this](const std::string& name) {
+      auto* var = local_scope_.FindVar(name);
+      return var ? absl::get<Tensor>(*var) : shared_scope_->GetTensor(name);
+    };
+    for (auto& ins : instrs_) {
+      args_.push_back(ins->BuildArgs(find_tensor));
+    }
+  }
+  for (int i = 0; i < instrs_.size(); ++i) {
+    instrs_[i]->RunWithArgs(&args_[i]);
+  }
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,79 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/hlir/framework/buffer.h"
+#include "cinn/hlir/framework/instruction.h"
+#include "cinn/hlir/framework/memory_planner.h"
+#include "cinn/hlir/framework/scope.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * ExecutionContext holds the mutable state of one execution of a compiled program, so several requests can
+ * run the same program concurrently, each in its own context.
+ *
+ * The instructions, the compiled functions and the variables never written by the instructions (the
+ * weights) are shared with the program. The variables written by the instructions, and the variables
+ * aliasing their memory, live in a scope owned by the context. The planned variables are placed into a
+ * per-context arena by the memory plan of the program. The other variables, such as the feeds, are read
+ * from the shared scope until GetTensor is called for them.
+ *
+ * A context must not outlive its program, and it can only be used by one thread at a time.
+ */
+class ExecutionContext {
+ public:
+  /**
+   * Constructor.
+   * @param scope The scope of the program.
+   * @param instrs The runtime instructions of the program.
+   * @param memory_plan The memory plan of the program, it is empty if the memory is not planned.
+   */
+  ExecutionContext(const std::shared_ptr<Scope>& scope,
+                   const std::vector<std::unique_ptr<Instruction>>& instrs,
+                   const MemoryPlan& memory_plan);
+
+  /**
+   * Get the tensor of a variable in this context, a shared variable is copied into this context on the first
+   * call, so it can be set without affecting the other contexts.
+   */
+  Tensor GetTensor(const std::string& name);
+
+  //! Run all the instructions sequentially in this context.
+  void Run();
+
+  const Scope& local_scope() const { return local_scope_; }
+
+ private:
+  // create a variable of this context with the shape and type of the shared one
+  Tensor CreateLocalTensor(const std::string& name, const std::shared_ptr<Buffer>& buffer);
+
+  std::shared_ptr<Scope> shared_scope_;
+  const std::vector<std::unique_ptr<Instruction>>& instrs_;
+  Scope local_scope_;
+  std::shared_ptr<Buffer> arena_;
+  // the arguments of each instruction, rebuilt after a new local variable is created
+  std::vector<std::vector<std::vector<cinn_pod_value_t>>> args_;
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
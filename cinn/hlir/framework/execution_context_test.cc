@@ -0,0 +1,98 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/execution_context.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/scope.h"
+#include "cinn/hlir/op/use_ops.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+using common::Float;
+
+TEST(ExecutionContext, ConcurrentRequests) {
+  constexpr int kNumel = 32 * 64;
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {32, 64}, "A");
+  auto w      = builder.CreateInput(Float(32), {32, 64}, "W");
+  auto b      = builder.Add(a, w);
+  auto c      = builder.Relu(b);
+  auto d      = builder.Scale(c, 2.f);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+  auto scope  = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  options.with_memory_planning       = true;
+  auto result                        = gc.Build(options, {d->id});
+  auto& program                      = result.runtime_program;
+  program->PreRun();
+
+  // the weight is shared by all the contexts
+  auto* w_data = scope->GetTensor("W")->mutable_data<float>(target);
+  for (int i = 0; i < kNumel; ++i) {
+    w_data[i] = i % 5 - 2.f;
+  }
+
+  constexpr int kNumContexts = 4;
+  std::vector<std::unique_ptr<ExecutionContext>> contexts;
+  for (int i = 0; i < kNumContexts; ++i) {
+    contexts.push_back(program->CreateExecutionContext());
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<int> passed(kNumContexts, 1);
+  for (int k = 0; k < kNumContexts; ++k) {
+    threads.emplace_back([&, k] {
+      auto* ctx    = contexts[k].get();
+      auto* a_data = ctx->GetTensor("A")->mutable_data<float>(target);
+      for (int repeat = 0; repeat < 10; ++repeat) {
+        for (int i = 0; i < kNumel; ++i) {
+          a_data[i] = (i + k + repeat) % 7 - 3.f;
+        }
+        program->Execute(ctx);
+        auto* d_data = ctx->GetTensor(d->id)->data<float>();
+        for (int i = 0; i < kNumel; ++i) {
+          float expected = 2.f * std::max(a_data[i] + w_data[i], 0.f);
+          if (std::abs(d_data[i] - expected) > 1e-5) passed[k] = 0;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int k = 0; k < kNumContexts; ++k) {
+    EXPECT_TRUE(passed[k]) << "The context " << k << " got wrong results";
+  }
+
+  // the output of the program itself is not touched by the contexts
+  EXPECT_NE(contexts[0]->GetTensor(d->id)->buffer()->memory, scope->GetTensor(d->id)->buffer()->memory);
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
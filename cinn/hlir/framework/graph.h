@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
@@ -114,7 +115,10 @@ class Graph : public cinn::common::Graph {
       }
     }
 
-    std::string GetFuncName() { return "fn_" + group_id + unique_id; }
+    // the function of a structurally identical group whose kernel is shared by this group, empty if not shared
+    std::string shared_func_name;
+
+    std::string GetFuncName() { return shared_func_name.empty() ? "fn_" + group_id + unique_id : shared_func_name; }
   };
   std::vector<std::shared_ptr<Group>> fusion_groups;
 
@@ -176,12 +180,19 @@ class Graph : public cinn::common::Graph {
   void VisualizeGroupedGraph(const std::vector<std::vector<Node*>>& groups,
                              const std::unordered_set<std::string>& fetch_var_ids);
 
+  /**
+   * \brief The mutex held by a GraphCompiler while it reads or updates the graph, so the compilers sharing the
+   * graph can build concurrently.
+   */
+  std::mutex& mutex() { return mtx_; }
+
  private:
   void VisualizeGroups(const std::vector<std::vector<Node*>>& groups,
                        const std::unordered_set<std::string>& fetch_var_ids);
 
   std::string viz_path_;
   static std::atomic_size_t viz_count_;
+  std::mutex mtx_;
 
   CINN_DISALLOW_COPY_AND_ASSIGN(Graph);
 };
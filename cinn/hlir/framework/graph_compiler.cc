@@ -15,22 +15,54 @@
 #include "cinn/hlir/framework/graph_compiler.h"
 
 #include <absl/container/flat_hash_map.h>
+#include <sys/stat.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <thread>
 #include <unordered_set>
 
 #include "cinn/backends/codegen_cuda_dev.h"
 #include "cinn/common/context.h"
+#include "cinn/hlir/framework/group_signature.h"
 #include "cinn/hlir/framework/instruction.h"
 #include "cinn/hlir/framework/op_lowering.h"
 #include "cinn/hlir/framework/tensor.h"
 #include "cinn/hlir/pe/schedule.h"
 #include "cinn/lang/lower.h"
+#include "cinn/optim/count_float_ops.h"
 #include "cinn/poly/stage.h"
+#include "cinn/utils/profiler.h"
+#include "cinn/utils/thread_pool.h"
+
+DECLARE_bool(cinn_parallel_execute);
+DECLARE_int32(cinn_inter_op_threads);
+DECLARE_bool(cinn_self_check_accuracy);
+DECLARE_int32(cinn_compile_threads);
+DECLARE_bool(cinn_share_group_kernels);
+DECLARE_bool(cinn_memory_planning);
+DECLARE_int32(cinn_host_buffer_alignment);
 
 namespace cinn {
 namespace hlir {
 namespace framework {
+namespace {
+// the instantiated variables are at least as large as float32 ones, which mutable_data<float> allocates
+uint32_t MemoryPlanSizeOf(Tensor tensor) {
+  int bytes = std::max((tensor->type().bits() + 7) / 8, static_cast<int>(sizeof(float)));
+  return tensor->shape().numel() * bytes;
+}
+
+int GetNumCompileThreads() {
+  if (FLAGS_cinn_compile_threads > 0) return FLAGS_cinn_compile_threads;
+  return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+}
+}  // namespace
+
 // Store params from node to instruction
 void AddAttrs(const absl::flat_hash_map<std::string, AttrType>& attrs_store,
               const std::vector<std::string>& attrs_name,
@@ -109,9 +141,10 @@ void Program::Export(const std::vector<std::string>& persistent_vars, const std:
   }
 
   FILE* f = fopen(filename.c_str(), "w+");
+  CHECK(f) << "Failed to open " << filename << " to export the program";
 
   fwrite("CINN", 4, 1, f);
-  int major_v = 0;
+  int major_v = CINN_PROGRAM_FILE_VERSION;
   int minor_v = 0;
   fwrite(&major_v, 4, 1, f);
   fwrite(&minor_v, 4, 1, f);
@@ -150,16 +183,17 @@ void Program::Export(const std::vector<std::string>& persistent_vars, const std:
   }
   padding(16, 0, f);
   tellplaceholder(buffersec, f);
-  // persistent_buffers
+  // persistent_buffers, the section is page aligned so that the loader maps them from the file without copying,
+  // and the processes loading the same file share their pages
   int pbuffer = writeplaceholder(4, 1, f);
+  padding(CINN_PROGRAM_FILE_PAGE_SIZE, 0, f);
   for (auto& p : pvars) {
-    if (p.first->align) {
-      padding(p.first->align, 0, f);
-    }
+    // the kernels assume the host buffers are aligned as the allocated ones, the file is mapped page aligned
+    padding(std::max<int>(p.first->align, CINN_HOST_BUFFER_ALIGNMENT), 0, f);
     tellplaceholder(p.second, f);
     fwrite(p.first->memory, p.first->memory_size, 1, f);
   }
-  padding(16, 0, f);
+  padding(CINN_PROGRAM_FILE_PAGE_SIZE, 0, f);
   tellplaceholder(pbuffer, f);
   // instructions
   int instsec = writeplaceholder(4, 1, f);
@@ -201,9 +235,25 @@ void Program::Export(const std::vector<std::string>& persistent_vars, const std:
 }
 
 void Program::Execute(const std::map<std::string, cinn_pod_value_t>* name2podargs, void* stream, bool use_cache) {
+  // the accuracy checker reads all the arguments after each instruction, so keep it sequential
+  // the planned variables share memory by the order of the instructions, so keep it sequential too
+  if (FLAGS_cinn_parallel_execute && !FLAGS_cinn_self_check_accuracy && !memory_planned_ && !instrs_.empty() &&
+      instrs_[0]->target_.arch == Target::Arch::X86) {
+    if (!parallel_executor_) {
+      parallel_executor_.reset(new ParallelExecutor(instrs_, FLAGS_cinn_inter_op_threads));
+    }
+    PrepareBindings();
+    CopyStagedBindings(false);
+    parallel_executor_->Run(name2podargs, use_cache);
+    CopyStagedBindings(true);
+    return;
+  }
+  PrepareBindings();
+  CopyStagedBindings(false);
   for (auto& ins : instrs_) {
     ins->Run(name2podargs, false, stream, use_cache);
   }
+  CopyStagedBindings(true);
 #ifdef CINN_WITH_CUDA
   VLOG(4) << "-- The value of the used stream: " << stream;
   if (instrs_[0]->target_.arch == Target::Arch::NVGPU && stream == nullptr) {
@@ -212,6 +262,107 @@ void Program::Execute(const std::map<std::string, cinn_pod_value_t>* name2podarg
 #endif
 }
 
+int Program::RegisterBinding(const std::string& name) {
+  auto* var = scope_->FindVar(name);
+  CHECK(var) << "The variable " << name << " to bind is not found in the scope";
+  auto& tensor          = absl::get<Tensor>(*var);
+  cinn_buffer_t* shared = tensor->buffer();
+  auto it               = buffer2binding_.find(shared);
+  if (it != buffer2binding_.end()) {
+    return it->second;
+  }
+
+  auto binding   = std::make_unique<Binding>();
+  binding->shape = tensor->shape().data();
+  binding->type  = tensor->type();
+  // the bound buffer has the same header, and it keeps the memory of the scope until a buffer is bound
+  binding->buffer             = *shared;
+  binding->buffer.memory_size = (tensor->shape().numel() * binding->type.bits() + 7) / 8;
+  CHECK_GT(binding->buffer.memory_size, 0) << "The variable " << name << " to bind should have a static shape";
+  int num_rebound = 0;
+  for (auto& ins : instrs_) {
+    CHECK(ins->target_.arch == Target::Arch::X86) << "Only the variables of the programs on host can be bound";
+    num_rebound += ins->RebindArgs(shared, &binding->buffer, &binding->written);
+  }
+  if (num_rebound == 0) {
+    LOG(WARNING) << "The bound variable " << name << " is not used by any instruction";
+  }
+  VLOG(3) << "Register the binding of " << name << " for " << num_rebound << " arguments";
+
+  int index = bindings_.size();
+  bindings_.push_back(std::move(binding));
+  buffer2binding_[shared] = index;
+  return index;
+}
+
+void Program::Bind(int index, void* data, const std::vector<int>& shape, const common::Type& type) {
+  CHECK(index >= 0 && index < bindings_.size()) << "The binding " << index << " is not registered";
+  CHECK(data) << "The bound buffer should not be null";
+  auto& binding = *bindings_[index];
+  CHECK(shape == binding.shape) << "The shape of the bound buffer mismatches the variable of the binding " << index;
+  CHECK(type == binding.type) << "The bound buffer of type " << type << " mismatches the variable of type "
+                              << binding.type;
+  if (binding.data != data) {
+    binding.data      = data;
+    bindings_changed_ = true;
+  }
+}
+
+void Program::PrepareBindings() {
+  if (!bindings_changed_) return;
+  bindings_changed_ = false;
+  // the kernels assume their buffer arguments don't overlap, so a written buffer overlapping another one is staged
+  std::vector<int> order;
+  for (int i = 0; i < bindings_.size(); ++i) {
+    if (bindings_[i]->data) order.push_back(i);
+  }
+  auto begin_of = [this](int i) { return reinterpret_cast<uintptr_t>(bindings_[i]->data); };
+  auto end_of   = [&](int i) { return begin_of(i) + bindings_[i]->buffer.memory_size; };
+  std::sort(order.begin(), order.end(), [&](int lhs, int rhs) { return begin_of(lhs) < begin_of(rhs); });
+  std::vector<bool> overlapped(bindings_.size(), false);
+  for (int i = 0; i < order.size(); ++i) {
+    for (int j = i + 1; j < order.size() && begin_of(order[j]) < end_of(order[i]); ++j) {
+      overlapped[order[i]] = overlapped[order[j]] = true;
+    }
+  }
+
+  uintptr_t alignment = std::max(FLAGS_cinn_host_buffer_alignment, 1);
+  for (int index : order) {
+    auto& binding = *bindings_[index];
+    bool aligned  = begin_of(index) % alignment == 0;
+    bool staged   = !aligned || (binding.written && overlapped[index]);
+    if (!staged) {
+      binding.buffer.memory = static_cast<uint8_t*>(binding.data);
+      binding.staged_data   = nullptr;
+      continue;
+    }
+    if (!binding.staging) {
+      binding.staging = std::make_shared<Buffer>(common::DefaultHostTarget());
+      binding.staging->ResizeLazy(std::max(FLAGS_cinn_host_buffer_alignment, CINN_HOST_BUFFER_ALIGNMENT),
+                                  binding.buffer.memory_size);
+    }
+    binding.buffer.memory = binding.staging->data()->memory;
+    binding.staged_data   = binding.data;
+    VLOG(3) << "The buffer bound to the binding " << index << " is staged, it is "
+            << (aligned ? "overlapped with another bound buffer" : "misaligned");
+  }
+}
+
+void Program::CopyStagedBindings(bool outputs) {
+  for (auto& binding : bindings_) {
+    if (!binding->staged_data || binding->written != outputs) continue;
+    if (outputs) {
+      std::memcpy(binding->staged_data, binding->buffer.memory, binding->buffer.memory_size);
+    } else {
+      std::memcpy(binding->buffer.memory, binding->staged_data, binding->buffer.memory_size);
+    }
+  }
+}
+
+std::unique_ptr<ExecutionContext> Program::CreateExecutionContext() const {
+  return std::make_unique<ExecutionContext>(scope_, instrs_, memory_plan_);
+}
+
 void Program::ExecuteTest(int repeat_) {
   cinn::utils::Timer timer1;
   for (int i = 0; i < 100; i++) {
@@ -234,6 +385,18 @@ void Program::ExecuteTest(int repeat_) {
   VLOG(3) << "Repeat times: [" << repeat_ << "], average op time: [" << test_op_time << "] ms";
 }
 
+void GraphCompiler::ExportPackage(Program* program,
+                                  const std::vector<std::string>& persistent_vars,
+                                  const std::string& dir) {
+  CHECK(target_.arch == Target::Arch::X86) << "Only the programs on host can be exported as a package";
+  CHECK(compiler_) << "The program should be built before exporting";
+  if (mkdir(dir.c_str(), 0755) != 0) {
+    CHECK_EQ(errno, EEXIST) << "Failed to create the package directory " << dir << ": " << strerror(errno);
+  }
+  compiler_->ExportSharedLibrary(dir + "/kernels.so");
+  program->Export(persistent_vars, dir + "/program.cinn");
+}
+
 void GraphCompiler::PrintFunc() {
   auto topo_order = graph_->topological_order();
   auto& nodes     = std::get<0>(topo_order);
@@ -290,7 +453,7 @@ std::vector<ir::LoweredFunc> GraphCompiler::GetOpFunc(const Node* node) {
     std::string input_id = i->source()->as<NodeData>()->id();
     auto in_shape        = shape_dict.at(input_id);
     Type dtype           = dtype_dict.at(input_id);
-    CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32))
+    CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32) || dtype == Int(8) || dtype.is_float(16))
         << "The dtype of node " << input_id << " is not float or bool or int! Other dtype is not implemented yet.";
     ir::Tensor temp;
     if (dtype == Float(32)) {
@@ -299,6 +462,12 @@ std::vector<ir::LoweredFunc> GraphCompiler::GetOpFunc(const Node* node) {
       temp = lang::Placeholder<bool>(input_id, in_shape);
     } else if (dtype == Int(32)) {
       temp = lang::Placeholder<int>(input_id, in_shape);
+    } else if (dtype == Int(8)) {
+      temp = lang::Placeholder<int8_t>(input_id, in_shape);
+    } else if (dtype.is_float16()) {
+      temp = lang::Placeholder<common::float16>(input_id, in_shape);
+    } else if (dtype.is_bfloat16()) {
+      temp = lang::Placeholder<common::bfloat16>(input_id, in_shape);
     }
     inputs.push_back(temp);
     cinn_inputs.push_back(common::CINNValue(temp));
@@ -392,7 +561,7 @@ std::vector<ir::LoweredFunc> GraphCompiler::GetOpFunc(const std::vector<Node*>&
         std::string input_id = source_data->id();
         auto in_shape        = shape_dict.at(input_id);
         Type dtype           = dtype_dict.at(input_id);
-        CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32))
+        CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32) || dtype == Int(8) || dtype.is_float(16))
             << "The dtype of node " << input_id << " is not float or bool or int! Other dtype is not implemented yet.";
         ir::Tensor temp_in;
         if (dtype == Float(32)) {
@@ -401,6 +570,12 @@ std::vector<ir::LoweredFunc> GraphCompiler::GetOpFunc(const std::vector<Node*>&
           temp_in = lang::Placeholder<bool>(input_id, in_shape);
         } else if (dtype == Int(32)) {
           temp_in = lang::Placeholder<int>(input_id, in_shape);
+        } else if (dtype == Int(8)) {
+          temp_in = lang::Placeholder<int8_t>(input_id, in_shape);
+        } else if (dtype.is_float16()) {
+          temp_in = lang::Placeholder<common::float16>(input_id, in_shape);
+        } else if (dtype.is_bfloat16()) {
+          temp_in = lang::Placeholder<common::bfloat16>(input_id, in_shape);
         }
         inputs.push_back(temp_in);
         temp_inputs.push_back(temp_in);
@@ -566,6 +741,37 @@ std::vector<ir::LoweredFunc> GraphCompiler::GetOpFunc(const std::vector<Node*>&
 }
 
 void GraphCompiler::ProcessFunction(const std::vector<ir::LoweredFunc>& lowered_func) {
+  // a kernel never writes a variable sharing memory with another argument, the memory is only shared by the no-run
+  // reshapes and by the bound buffers, and the Program stages a written bound buffer overlapping another one
+  if (target_.arch == Target::Arch::X86) {
+    for (auto& func : lowered_func) {
+      std::unordered_set<std::string> names;
+      func->distinct_buffer_args = true;
+      for (auto& arg : func->args) {
+        if (arg.is_buffer() && !names.insert(arg.name()).second) func->distinct_buffer_args = false;
+      }
+    }
+  }
+  // the host tensors are allocated with at least this alignment, let the codegen assume it for the arguments
+  if (target_.arch == Target::Arch::X86 && FLAGS_cinn_host_buffer_alignment > 0) {
+    CHECK_EQ(FLAGS_cinn_host_buffer_alignment & (FLAGS_cinn_host_buffer_alignment - 1), 0)
+        << "The host buffer alignment should be a power of 2";
+    // the allocators and the memory planner only guarantee CINN_HOST_BUFFER_ALIGNMENT
+    CHECK_LE(FLAGS_cinn_host_buffer_alignment, CINN_HOST_BUFFER_ALIGNMENT)
+        << "The host buffer alignment should not exceed the alignment of the host allocations";
+    for (auto& func : lowered_func) {
+      for (auto& arg : func->args) {
+        if (arg.is_buffer()) arg.buffer_arg()->data_alignment = FLAGS_cinn_host_buffer_alignment;
+      }
+    }
+  }
+  // the profiler reports the FLOPs of the kernels estimated from their IR, only if it is enabled on compiling
+  auto& profiler = utils::HostProfiler::Global();
+  if (profiler.enabled()) {
+    for (auto& func : lowered_func) {
+      profiler.SetFlops(func->name, optim::CountFloatOps(func->body));
+    }
+  }
   if (lowered_func.size() > 1) {
     for (auto& i : lowered_func) {
       VLOG(3) << "In lowered_func, its name is : " << i->name;
@@ -630,7 +836,10 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
                                                       void* stream) {
   compile_options_ = options;
   fetch_var_ids_   = std::move(fetch_var_ids);
-  auto topo_order  = graph_->topological_order();
+  // the graph may be shared by the compilers building concurrently, it is locked while it's read or updated,
+  // while the processing and the codegen of the lowered functions run without the lock
+  std::unique_lock<std::mutex> graph_lock(graph_->mutex());
+  auto topo_order = graph_->topological_order();
   auto& nodes      = std::get<0>(topo_order);
 
   m_builder_.Clear();
@@ -646,6 +855,8 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
   }
   // use the input groups in options firstly if exists
   auto groups = options.groups.empty() ? graph_->groups : options.groups;
+  // only the host modules are lowered and compiled concurrently
+  int num_compile_threads = target_.arch == Target::Arch::X86 ? GetNumCompileThreads() : 1;
 
   // if the input lowered_funcs is empty, we will use the defalut lowering process to generate
   std::vector<std::vector<ir::LoweredFunc>> local_lowered_funcs;
@@ -656,7 +867,6 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
       auto& dtype_dict = graph_->GetMutableAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
       auto& shape_dict = graph_->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
 
-      OpLowerer op_lowerer(dtype_dict, shape_dict, target_);
       for (auto& group : graph_->fusion_groups) {
         VLOG(3) << group->group_id;
         groups.push_back(std::move(group->CollectNodes()));
@@ -673,9 +883,44 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
             }
           }
         }
-        local_lowered_funcs.emplace_back(std::move(op_lowerer.Lower(group)));
-        CHECK_EQ(local_lowered_funcs.back().size(), 1) << "Lowerd Function Is Not Equal 1!";
-        VLOG(3) << local_lowered_funcs.back()[0];
+      }
+      // the structurally identical groups are lowered only once, the others share the kernel of the first one
+      std::vector<int> kernel_owners(graph_->fusion_groups.size());
+      std::vector<GroupSignature> signatures(graph_->fusion_groups.size());
+      absl::flat_hash_map<std::string, int> signature2owner;
+      for (int idx = 0; idx < graph_->fusion_groups.size(); ++idx) {
+        graph_->fusion_groups[idx]->shared_func_name.clear();
+        kernel_owners[idx] = idx;
+        if (FLAGS_cinn_share_group_kernels) {
+          signatures[idx]    = GetGroupSignature(graph_->fusion_groups[idx], dtype_dict, shape_dict);
+          kernel_owners[idx] = signature2owner.emplace(signatures[idx].key, idx).first->second;
+        }
+      }
+
+      // the groups are lowered independently, each task owns its lowerer
+      local_lowered_funcs.resize(graph_->fusion_groups.size());
+      utils::ParallelFor(
+          0,
+          graph_->fusion_groups.size(),
+          [&](int idx) {
+            if (kernel_owners[idx] != idx) return;
+            OpLowerer op_lowerer(dtype_dict, shape_dict, target_);
+            local_lowered_funcs[idx] = op_lowerer.Lower(graph_->fusion_groups[idx]);
+            CHECK_EQ(local_lowered_funcs[idx].size(), 1) << "Lowerd Function Is Not Equal 1!";
+            VLOG(3) << local_lowered_funcs[idx][0];
+          },
+          num_compile_threads);
+
+      for (int idx = 0; idx < graph_->fusion_groups.size(); ++idx) {
+        int owner = kernel_owners[idx];
+        if (owner == idx) continue;
+        auto& owner_group = graph_->fusion_groups[owner];
+        auto& group       = graph_->fusion_groups[idx];
+        // bind the arguments of the shared kernel to the corresponding variables of this group
+        group->input_names      = MapGroupVarNames(signatures[owner], signatures[idx], owner_group->input_names);
+        group->output_names     = MapGroupVarNames(signatures[owner], signatures[idx], owner_group->output_names);
+        group->shared_func_name = owner_group->GetFuncName();
+        VLOG(3) << "Group " << group->group_id << " shares the kernel " << group->shared_func_name;
       }
     } else {
       for (int i = 0; i < groups.size(); i++) {
@@ -693,27 +938,61 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
   // use the input lowered_funcs in options firstly if exists
   const auto& lowered_funcs = options.lowered_funcs.empty() ? local_lowered_funcs : options.lowered_funcs;
   CHECK_EQ(groups.size(), lowered_funcs.size()) << "The size of groups and lowered_funcs shoule be equal";
+  graph_->VisualizeGroupedGraph(groups, fetch_var_ids_);
+  graph_lock.unlock();
+
   for (auto&& lowered_func : lowered_funcs) {
+    // empty for the groups sharing the kernel of another group
+    if (lowered_func.empty()) continue;
     this->ProcessFunction(lowered_func);
   }
 
-  graph_->VisualizeGroupedGraph(groups, fetch_var_ids_);
-
   // compile the module
   // Need to create a new compiler for every call of Build,
   // because the underneath jit engine does't support addIRModule repeatedly now.
-  compiler_ = backends::Compiler::Create(target_);
+  if (num_compile_threads > 1) {
+    // every group is built into a module of its own, so that the optimization and the LLVM codegen of
+    // the groups run concurrently
+    std::vector<Expr> module_exprs(lowered_funcs.size());
+    utils::ParallelFor(
+        0,
+        lowered_funcs.size(),
+        [&](int idx) {
+          if (lowered_funcs[idx].empty()) return;
+          ir::Module::Builder builder("module_" + std::to_string(idx), target_);
+          for (auto& func : lowered_funcs[idx]) {
+            builder.AddFunction(func);
+          }
+          module_exprs[idx] = builder.Build();
+        },
+        num_compile_threads);
+    std::vector<ir::Module> modules;
+    for (auto& expr : module_exprs) {
+      if (!expr.defined()) continue;
+      modules.push_back(expr.as_module_ref());
+    }
 
-  auto build_module = m_builder_.Build();
-  if (this->target_.arch == Target::Arch::X86) {
-    CodeGenCX86 codegen(this->target_, CodeGenCX86::Feature::AVX512);
-    codegen.SetInlineBuiltinCodes(false);
-    auto out = codegen.Compile(build_module, CodeGenC::OutputKind::CImpl);
-    VLOG(3) << "[X86] C Code is:\n" << out;
-  }
+    backends::ExecutionOptions exec_options;
+    exec_options.num_compile_threads = num_compile_threads;
+    compiler_                        = backends::Compiler::Create(target_, exec_options);
+    compiler_->Build(modules);
+  } else {
+    compiler_ = backends::Compiler::Create(target_);
+
+    auto build_module = m_builder_.Build();
+    // the C code is only for debugging, don't pay for it otherwise
+    if (this->target_.arch == Target::Arch::X86 && VLOG_IS_ON(3)) {
+      CodeGenCX86 codegen(this->target_, CodeGenCX86::FeatureOf(this->target_));
+      codegen.SetInlineBuiltinCodes(false);
+      auto out = codegen.Compile(build_module, CodeGenC::OutputKind::CImpl);
+      VLOG(3) << "[X86] C Code is:\n" << out;
+    }
 
-  compiler_->Build(build_module, options.attached_code, stream);
+    compiler_->Build(build_module, options.attached_code, stream);
+  }
+  graph_lock.lock();
   auto instructions = BuildInstructions(groups, graph_->fusion_groups);
+  graph_lock.unlock();
   if (options.remove_unused_variables) {
     RemoveInvalidVariables(instructions);
   }
@@ -722,7 +1001,15 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
     InsertBufferHandlers(&instructions);
   }
 
+  GraphCompiler::CompilationResult result;
   if (options.with_instantiate_variables) {
+    // the buffer handlers allocate the variables at runtime, they can't be planned at compile-time
+    if ((options.with_memory_planning || FLAGS_cinn_memory_planning) &&
+        !options.with_buffer_handle_instruction_inserted) {
+      result.memory_plan = PlanMemory(instructions);
+    }
+    const auto& offsets = result.memory_plan.offsets;
+
     VLOG(3) << "Initantiate all variables on compile-time";
     // All variables reside in scope_, so traverse it to instantiate each one
     for (auto& name : scope_->var_names()) {
@@ -733,16 +1020,82 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
         auto* src_var     = scope_->Var<Tensor>(src_var_name);
         auto& src_tensor  = absl::get<Tensor>(*src_var);
         tensor->set_buffer(src_tensor->get_buffer());
-      } else {
+      } else if (!offsets.count(std::string({name.data(), name.size()}))) {
         tensor->mutable_data<float>(target_);
       }
     }
+
+    if (!offsets.empty()) {
+      auto& plan = result.memory_plan;
+      CHECK_LE(plan.arena_size, std::numeric_limits<uint32_t>::max()) << "The memory arena is too large";
+      auto arena = std::make_shared<Buffer>(target_);
+      if (target_ == common::DefaultHostTarget()) {
+        arena->ResizeLazy(1024, plan.arena_size);
+      } else {
+        arena->ResizeLazy(plan.arena_size);
+      }
+      for (auto& var2offset : offsets) {
+        auto tensor = scope_->GetTensor(var2offset.first);
+        tensor->get_buffer()->ShareMemory(arena, var2offset.second, MemoryPlanSizeOf(tensor));
+      }
+      VLOG(1) << "Memory planning packs " << offsets.size() << " intermediate variables into an arena of "
+              << plan.arena_size << " bytes, " << plan.naive_size << " bytes without reuse";
+    }
   }
-  GraphCompiler::CompilationResult result;
   result.runtime_program.reset(new Program(scope_, std::move(instructions)));
+  result.runtime_program->set_memory_plan(result.memory_plan);
   return result;
 }
 
+MemoryPlan GraphCompiler::PlanMemory(const std::vector<std::unique_ptr<Instruction>>& instructions) {
+  std::unordered_map<int, std::vector<std::string>> step2malloc, step2free;
+  AnalyzeVariableLifeTime(instructions, &step2malloc, &step2free);
+  absl::flat_hash_map<std::string, int> first_used, last_used;
+  for (auto& step2vars : step2malloc) {
+    for (auto& var_name : step2vars.second) {
+      first_used[var_name] = step2vars.first;
+    }
+  }
+  for (auto& step2vars : step2free) {
+    for (auto& var_name : step2vars.second) {
+      last_used[var_name] = step2vars.first;
+    }
+  }
+
+  // the variables read before written are fed by the user, and the ones used by the pre-run
+  // instructions must keep their contents between runs
+  std::unordered_set<std::string> written, read, excluded;
+  for (auto& instr : instructions) {
+    for (auto& args : instr->GetInArgs()) {
+      for (auto& var_name : args) {
+        if (!written.count(var_name) || instr->pre_run) excluded.insert(var_name);
+        read.insert(var_name);
+      }
+    }
+    for (auto& args : instr->GetOutArgs()) {
+      for (auto& var_name : args) {
+        if (instr->pre_run) excluded.insert(var_name);
+        written.insert(var_name);
+      }
+    }
+  }
+  for (auto& dst2src : reuse_vars_map_) {
+    excluded.insert(dst2src.first);
+    excluded.insert(dst2src.second);
+  }
+
+  MemoryPlanner planner;
+  for (auto& var_name : written) {
+    // the variables never read by the instructions are the outputs
+    if (!read.count(var_name) || excluded.count(var_name) || fetch_var_ids_.count(var_name)) continue;
+    if (!scope_->FindVar(var_name)) continue;
+    auto size = MemoryPlanSizeOf(scope_->GetTensor(var_name));
+    if (size == 0) continue;
+    planner.AddBuffer(var_name, size, first_used.at(var_name), last_used.at(var_name));
+  }
+  return planner.Plan();
+}
+
 void GraphCompiler::SetSubKernels(Instruction* instr, const std::string& func_name) {
   int i                   = 1;
   std::string new_op_func = func_name + "_" + std::to_string(i);
@@ -1228,9 +1581,12 @@ std::shared_ptr<Scope> BuildScope(Target target, const std::shared_ptr<Graph>& g
     }
     VLOG(3) << "Tensor [" << iter.first << "] resize to " << utils::Join(shape, ",");
     tensor->Resize(Shape{shape});
+    // int8 is the dtype of the quantized tensors, float16 and bfloat16 store the tensors of mixed precision
     CHECK(dtype_dict.at(iter.first) == Float(32) || dtype_dict.at(iter.first).is_bool() ||
-          dtype_dict.at(iter.first) == Int(32))
-        << "The dtype of node " << iter.first << " is not float or bool or int! Other dtype is not implemented yet.";
+          dtype_dict.at(iter.first) == Int(32) || dtype_dict.at(iter.first) == Int(8) ||
+          dtype_dict.at(iter.first).is_float(16))
+        << "The dtype of node " << iter.first
+        << " is not float or bool or int32 or int8 or float16! Other dtype is not implemented yet.";
     tensor->set_type(dtype_dict.at(iter.first));
   }
   return scope;
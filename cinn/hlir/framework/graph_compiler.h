@@ -27,9 +27,12 @@
 #include "cinn/backends/compiler.h"
 #include "cinn/backends/cuda_util.h"
 #include "cinn/common/macros.h"
+#include "cinn/hlir/framework/execution_context.h"
 #include "cinn/hlir/framework/graph.h"
 #include "cinn/hlir/framework/instruction.h"
+#include "cinn/hlir/framework/memory_planner.h"
 #include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/framework/parallel_executor.h"
 #include "cinn/hlir/framework/scope.h"
 #include "cinn/ir/lowered_func.h"
 #include "cinn/lang/packed_func.h"
@@ -57,6 +60,7 @@ class Program {
 
   /**
    * Execute the program -- that is running all the instructions inside it.
+   * On host, the independent instructions run concurrently if FLAGS_cinn_parallel_execute is enabled.
    */
   void Execute(const std::map<std::string, cinn_pod_value_t>* name2podargs = nullptr,
                void* stream                                                = nullptr,
@@ -72,6 +76,39 @@ class Program {
   const std::vector<std::unique_ptr<Instruction>>& GetPreRunInstructions() { return prerun_instrs_; }
   const std::vector<std::unique_ptr<Instruction>>& GetRunInstructions() { return instrs_; }
 
+  /**
+   * Create a context to execute this program concurrently with the other contexts, the program must be
+   * PreRun already.
+   */
+  std::unique_ptr<ExecutionContext> CreateExecutionContext() const;
+
+  //! Execute the program in \p context instead of the scope of the program.
+  void Execute(ExecutionContext* context) const { context->Run(); }
+
+  /**
+   * Register the host variable \p name to be bound to external buffers, and return the index of the binding to
+   * pass to Bind. The arguments of the instructions referring to the buffer of the variable, including the
+   * variables sharing it, are redirected to the binding here once, so binding a buffer later costs no lookup.
+   * It should be called after PreRun. Registering a variable again returns the same index.
+   */
+  int RegisterBinding(const std::string& name);
+
+  /**
+   * Bind the host buffer \p data to the registered variable at \p index, which is read or written in place by
+   * the following executions of the program, but not by the execution contexts. The \p shape and \p type must
+   * match the variable. The kernels assume their buffers aligned to FLAGS_cinn_host_buffer_alignment and not
+   * overlapping each other, so a misaligned buffer, or a written buffer overlapping another bound one, is copied
+   * through an aligned staging buffer instead.
+   */
+  void Bind(int index, void* data, const std::vector<int>& shape, const common::Type& type);
+
+  //! Set the memory plan of the variables, the planned variables share memory by the order of the
+  //! instructions, so they can't run concurrently.
+  void set_memory_plan(const MemoryPlan& memory_plan) {
+    memory_plan_    = memory_plan;
+    memory_planned_ = !memory_plan.offsets.empty();
+  }
+
  private:
   // We need to hold scope to assure tensors alive used in instructions.
   std::shared_ptr<Scope> scope_;
@@ -79,6 +116,34 @@ class Program {
   std::vector<std::unique_ptr<Instruction>> prerun_instrs_;
   // only runtime instructions
   std::vector<std::unique_ptr<Instruction>> instrs_;
+  // created on the first parallel execution, after PreRun may have changed the instructions
+  std::unique_ptr<ParallelExecutor> parallel_executor_;
+  MemoryPlan memory_plan_;
+  bool memory_planned_{false};
+
+  // a variable bound to external host buffers
+  struct Binding {
+    // the buffer passed to the instructions instead of the one in the scope
+    cinn_buffer_t buffer;
+    std::vector<int> shape;
+    common::Type type;
+    // whether the variable is written by the instructions
+    bool written{false};
+    // the bound external buffer, or nullptr if it is not bound yet
+    void* data{nullptr};
+    // the bound buffer copied through the staging buffer, or nullptr
+    void* staged_data{nullptr};
+    std::shared_ptr<Buffer> staging;
+  };
+  // point the bindings to their bound buffers, or to the staging buffers if they are misaligned or overlapped
+  void PrepareBindings();
+  // copy the staged bound inputs into their staging buffers, or the outputs back from them
+  void CopyStagedBindings(bool outputs);
+
+  std::vector<std::unique_ptr<Binding>> bindings_;
+  absl::flat_hash_map<const cinn_buffer_t*, int> buffer2binding_;
+  // whether any binding is bound to another buffer since the last execution
+  bool bindings_changed_{false};
 };
 
 /**
@@ -91,6 +156,8 @@ class GraphCompiler final {
 
   struct CompilationResult {
     std::unique_ptr<Program> runtime_program;
+    // the placement of the intermediate variables, empty if the memory planning is disabled
+    MemoryPlan memory_plan;
   };
 
   struct CompileOptions {
@@ -98,6 +165,9 @@ class GraphCompiler final {
     bool with_instantiate_variables              = false;
     bool with_buffer_handle_instruction_inserted = false;
     bool remove_unused_variables                 = true;
+    // pack the intermediate variables into one arena by their lifetimes when instantiating variables,
+    // their contents are invalid after running the program
+    bool with_memory_planning = false;
     // nodes group, it may come from the result of op fusion or graph tuning.
     // nodes in a group will be built into an Instruction
     std::vector<std::vector<Node*>> groups;
@@ -115,6 +185,14 @@ class GraphCompiler final {
                           void* stream                                    = nullptr);
   void ExportObject(const std::string& path) { compiler_->ExportObject(path); }
 
+  /**
+   * Export an ahead-of-time package of a program built by this compiler into the directory \p dir, which holds
+   * the kernels linked into kernels.so, and the program with the values of the persistent variables in
+   * program.cinn. With FLAGS_cinn_x86_isa_variants, the kernels of every level are linked into kernels.<level>.so
+   * too, and load_package of the tiny runtime loads the best one the cpu supports.
+   */
+  void ExportPackage(Program* program, const std::vector<std::string>& persistent_vars, const std::string& dir);
+
   std::unique_ptr<Program> Build(const std::string& code = "");
 
   std::string GenSourceCode();
@@ -122,6 +200,8 @@ class GraphCompiler final {
   void PrintFunc();
 
   const std::shared_ptr<Scope>& GetScope() const { return scope_; }
+  const std::shared_ptr<Graph>& GetGraph() const { return graph_; }
+  const Target& GetTarget() const { return target_; }
 
   std::vector<std::vector<ir::LoweredFunc>> FusedGraphToLoweredFunc(
       const std::vector<std::vector<hlir::framework::Node*>>& graph);
@@ -167,6 +247,10 @@ class GraphCompiler final {
   // applying on variables after no instruction will use them anymore
   void InsertBufferHandlers(std::vector<std::unique_ptr<Instruction>>* instructions);
 
+  // plan the offsets of the intermediate variables, which are produced and consumed by the instructions
+  // and are not fetched, in an arena by their lifetimes
+  MemoryPlan PlanMemory(const std::vector<std::unique_ptr<Instruction>>& instructions);
+
  private:
   void ProcessFunction(const std::vector<ir::LoweredFunc>& lowered_func);
   void SetSubKernels(Instruction* instr, const std::string& func_name);
@@ -14,7 +14,14 @@
 
 #include "cinn/hlir/framework/graph_compiler.h"
 
+#include <dlfcn.h>
 #include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 #include "cinn/frontend/net_builder.h"
 #include "cinn/hlir/framework/pass.h"
@@ -22,6 +29,16 @@
 #include "cinn/hlir/op/use_ops.h"
 #include "cinn/hlir/pass/use_pass.h"
 
+DECLARE_int32(cinn_compile_threads);
+
+// the entries of the tiny runtime loading the exported packages
+extern "C" {
+void* load_package(const char* package_dir);
+void destroy_program(void* ctx);
+void run_program(void* ctx);
+cinn_pod_value_t* get_pod_value(void* ctx, const char* tname);
+}
+
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -114,6 +131,233 @@ TEST(GraphCompilerTest, TestInsertBufferHandlers) {
             used_variable_names);
 }
 
+TEST(GraphCompilerTest, TestParallelCompile) {
+  frontend::NetBuilder builder("test");
+  auto a = builder.CreateInput(Float(32), {32, 64}, "A");
+  auto b = builder.CreateInput(Float(32), {64, 32}, "B");
+  // two groups which don't depend on each other
+  auto c      = builder.Relu(builder.ElementwiseAdd(a, a));
+  auto d      = builder.ReduceSum(b, {1});
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+  ApplyPass(graph.get(), "OpFusionPass");
+  ApplyPass(graph.get(), "FusionMergePass");
+  ASSERT_GE(graph->fusion_groups.size(), 2UL);
+  auto scope = BuildScope(target, graph);
+
+  FLAGS_cinn_compile_threads = 2;
+  GraphCompiler gc(target, scope, graph);
+  auto runtime_program       = gc.Build();
+  FLAGS_cinn_compile_threads = 1;
+
+  auto* a_data = scope->GetTensor("A")->mutable_data<float>(target);
+  auto* b_data = scope->GetTensor("B")->mutable_data<float>(target);
+  for (int i = 0; i < 32 * 64; ++i) {
+    a_data[i] = i % 7 - 3.f;
+    b_data[i] = i % 5 * 0.5f;
+  }
+  runtime_program->Execute();
+
+  auto* c_data = scope->GetTensor(c->id)->data<float>();
+  for (int i = 0; i < 32 * 64; ++i) {
+    ASSERT_NEAR(c_data[i], std::max(a_data[i] * 2, 0.f), 1e-5);
+  }
+  auto* d_data = scope->GetTensor(d->id)->data<float>();
+  for (int i = 0; i < 64; ++i) {
+    float expect = 0.f;
+    for (int j = 0; j < 32; ++j) {
+      expect += b_data[i * 32 + j];
+    }
+    ASSERT_NEAR(d_data[i], expect, 1e-4);
+  }
+}
+
+TEST(GraphCompilerTest, TestMemoryPlanning) {
+  frontend::NetBuilder builder("test");
+  auto a = builder.CreateInput(Float(32), {32, 64}, "A");
+  // a chain without fusion, every intermediate is dead after its consumer
+  auto b      = builder.Relu(a);
+  auto c      = builder.Scale(b, 2.f);
+  auto d      = builder.Relu(c);
+  auto e      = builder.Scale(d, 0.5f);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+  auto scope  = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  options.with_memory_planning       = true;
+  auto result                        = gc.Build(options, {e->id});
+  auto& plan                         = result.memory_plan;
+  // b, c and d are planned, b and d can share memory
+  ASSERT_EQ(plan.offsets.size(), 3UL);
+  EXPECT_FALSE(plan.offsets.count(e->id));
+  EXPECT_EQ(plan.offsets.at(b->id), plan.offsets.at(d->id));
+  EXPECT_LT(plan.arena_size, plan.naive_size);
+
+  auto* a_data = scope->GetTensor("A")->mutable_data<float>(target);
+  for (int i = 0; i < 32 * 64; ++i) {
+    a_data[i] = i % 7 - 3.f;
+  }
+  result.runtime_program->Execute();
+  auto* e_data = scope->GetTensor(e->id)->data<float>();
+  for (int i = 0; i < 32 * 64; ++i) {
+    ASSERT_NEAR(e_data[i], std::max(a_data[i], 0.f), 1e-5);
+  }
+}
+
+TEST(GraphCompilerTest, TestBindExternalBuffers) {
+  constexpr int kNumel = 32 * 64;
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {32, 64}, "A");
+  auto w      = builder.CreateInput(Float(32), {32, 64}, "W");
+  auto b      = builder.Add(a, w);
+  auto c      = builder.Relu(b);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+  auto scope  = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto result                        = gc.Build(options, {c->id});
+  auto& program                      = result.runtime_program;
+  program->PreRun();
+  auto* w_data = scope->GetTensor("W")->mutable_data<float>(target);
+  for (int i = 0; i < kNumel; ++i) {
+    w_data[i] = i % 5 - 2.f;
+  }
+  int a_index = program->RegisterBinding("A");
+  int c_index = program->RegisterBinding(c->id);
+  EXPECT_EQ(program->RegisterBinding("A"), a_index);
+
+  // the input is aligned and used in place, the output is misaligned and copied through the staging buffer
+  std::vector<float> a_data(kNumel + 64);
+  std::vector<float> c_data(kNumel + 64);
+  float* a_ptr = a_data.data() + (64 - reinterpret_cast<uintptr_t>(a_data.data()) % 64) / sizeof(float);
+  float* c_ptr = c_data.data() + (64 - reinterpret_cast<uintptr_t>(c_data.data()) % 64) / sizeof(float) + 1;
+  for (int repeat = 0; repeat < 2; ++repeat) {
+    for (int i = 0; i < kNumel; ++i) {
+      a_ptr[i] = (i + repeat) % 7 - 3.f;
+    }
+    program->Bind(a_index, a_ptr, {32, 64}, Float(32));
+    program->Bind(c_index, c_ptr, {32, 64}, Float(32));
+    program->Execute();
+    for (int i = 0; i < kNumel; ++i) {
+      ASSERT_NEAR(c_ptr[i], std::max(a_ptr[i] + w_data[i], 0.f), 1e-5);
+    }
+  }
+
+  // the output bound to the memory of the input is staged, the kernels assume their buffers don't overlap
+  std::vector<float> expected(kNumel);
+  for (int i = 0; i < kNumel; ++i) {
+    a_ptr[i]    = i % 7 - 3.f;
+    expected[i] = std::max(a_ptr[i] + w_data[i], 0.f);
+  }
+  program->Bind(a_index, a_ptr, {32, 64}, Float(32));
+  program->Bind(c_index, a_ptr, {32, 64}, Float(32));
+  program->Execute();
+  for (int i = 0; i < kNumel; ++i) {
+    ASSERT_NEAR(a_ptr[i], expected[i], 1e-5);
+  }
+}
+
+TEST(GraphCompilerTest, TestExportPackage) {
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {32, 64}, "A");
+  auto w      = builder.CreateInput(Float(32), {32, 64}, "W");
+  auto b      = builder.Add(a, w);
+  auto c      = builder.Relu(b);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+  auto scope  = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto result                        = gc.Build(options, {c->id});
+  scope->GetTensor("W")->mutable_data<float>(target);
+
+  char dir_template[] = "/tmp/cinn_package_XXXXXX";
+  ASSERT_TRUE(mkdtemp(dir_template));
+  std::string dir(dir_template);
+  gc.ExportPackage(result.runtime_program.get(), {"W"}, dir);
+
+  struct stat st;
+  ASSERT_EQ(stat((dir + "/program.cinn").c_str(), &st), 0);
+  // the weights are page aligned in the program file
+  EXPECT_EQ(st.st_size % CINN_PROGRAM_FILE_PAGE_SIZE, 0);
+  void* library = dlopen((dir + "/kernels.so").c_str(), RTLD_LAZY | RTLD_LOCAL);
+  ASSERT_TRUE(library) << dlerror();
+  for (auto& ins : result.runtime_program->GetRunInstructions()) {
+    for (auto& fn_name : ins->GetFnNames()) {
+      EXPECT_TRUE(dlsym(library, fn_name.c_str())) << "The kernel " << fn_name << " is not exported";
+    }
+  }
+  dlclose(library);
+
+  for (auto* name : {"/program.cinn", "/kernels.so"}) {
+    std::remove((dir + name).c_str());
+  }
+  rmdir(dir.c_str());
+}
+
+TEST(GraphCompilerTest, TestRunPackage) {
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {32, 64}, "A");
+  auto w      = builder.CreateInput(Float(32), {32, 64}, "W");
+  auto b      = builder.Add(a, w);
+  auto c      = builder.Relu(b);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+  auto scope  = BuildScope(target, graph);
+
+  GraphCompiler gc(target, scope, graph);
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto result                        = gc.Build(options, {c->id});
+  constexpr int kNumel               = 32 * 64;
+  auto* w_data                       = scope->GetTensor("W")->mutable_data<float>(target);
+  for (int i = 0; i < kNumel; ++i) {
+    w_data[i] = static_cast<float>(i % 7) - 3.f;
+  }
+
+  char dir_template[] = "/tmp/cinn_package_XXXXXX";
+  ASSERT_TRUE(mkdtemp(dir_template));
+  std::string dir(dir_template);
+  gc.ExportPackage(result.runtime_program.get(), {"W"}, dir);
+
+  void* ctx = load_package(dir.c_str());
+  ASSERT_TRUE(ctx);
+  // both the weights mapped from the file and the temporaries are aligned as the host buffers
+  for (auto& name : scope->var_names()) {
+    cinn_pod_value_t* value = get_pod_value(ctx, std::string(name).c_str());
+    ASSERT_TRUE(value) << "The variable " << std::string(name) << " is not loaded";
+    cinn_buffer_t* buffer = *value;
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer->memory) % CINN_HOST_BUFFER_ALIGNMENT, 0)
+        << "The variable " << std::string(name) << " is not aligned";
+  }
+  cinn_buffer_t* a_buffer = *get_pod_value(ctx, "A");
+  auto* a_data            = reinterpret_cast<float*>(a_buffer->memory);
+  for (int i = 0; i < kNumel; ++i) {
+    a_data[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  run_program(ctx);
+
+  cinn_buffer_t* c_buffer = *get_pod_value(ctx, c->id.c_str());
+  auto* c_data            = reinterpret_cast<float*>(c_buffer->memory);
+  for (int i = 0; i < kNumel; ++i) {
+    ASSERT_NEAR(c_data[i], std::max(a_data[i] + w_data[i], 0.f), 1e-5);
+  }
+  destroy_program(ctx);
+
+  for (auto* name : {"/program.cinn", "/kernels.so"}) {
+    std::remove((dir + name).c_str());
+  }
+  rmdir(dir.c_str());
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
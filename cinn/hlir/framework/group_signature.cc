@@ -0,0 +1,176 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/group_signature.h"
+
+#include <absl/types/variant.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+// floats are printed exactly, so that different constants never get the same key
+struct AttrPrinter {
+  std::ostream& os;
+  explicit AttrPrinter(std::ostream& os) : os(os) {}
+
+  void operator()(bool v) { os << "b" << v; }
+  void operator()(int v) { os << "i" << v; }
+  void operator()(float v) { os << "f" << std::hexfloat << v << std::defaultfloat; }
+  void operator()(const std::string& v) { os << "s" << v.size() << ":" << v; }
+  void operator()(const std::vector<bool>& vs) { os << "b[" << utils::Join(vs, ",") << "]"; }
+  void operator()(const std::vector<int>& vs) { os << "i[" << utils::Join(vs, ",") << "]"; }
+  void operator()(const std::vector<float>& vs) {
+    os << "f[";
+    for (float v : vs) {
+      os << std::hexfloat << v << std::defaultfloat << ",";
+    }
+    os << "]";
+  }
+  void operator()(const std::vector<std::string>& vs) {
+    os << "s[";
+    for (auto& v : vs) {
+      os << v.size() << ":" << v << ",";
+    }
+    os << "]";
+  }
+};
+}  // namespace
+
+GroupSignature GetGroupSignature(const std::shared_ptr<Graph::Group>& group,
+                                 const absl::flat_hash_map<std::string, Type>& dtype_dict,
+                                 const absl::flat_hash_map<std::string, shape_t>& shape_dict) {
+  GroupSignature signature;
+  std::stringstream ss;
+  absl::flat_hash_map<std::string, int> var_index;
+  auto write_var = [&](const std::string& name) {
+    auto it = var_index.find(name);
+    if (it == var_index.end()) {
+      it = var_index.emplace(name, signature.var_names.size()).first;
+      signature.var_names.push_back(name);
+    }
+    ss << "v" << it->second << ":";
+    if (dtype_dict.count(name)) ss << dtype_dict.at(name);
+    if (shape_dict.count(name)) ss << "[" << utils::Join(shape_dict.at(name), ",") << "]";
+  };
+
+  auto nodes = group->CollectNodes();
+  absl::flat_hash_map<const Node*, int> node_index;
+  for (int i = 0; i < nodes.size(); ++i) {
+    node_index.emplace(nodes[i], i);
+  }
+  // the membership of a node in the sets the lowering schedules it by
+  auto write_node_roles = [&](const Graph::Group& g, Node* node) {
+    ss << (g.master_nodes.count(node) ? "m" : "") << (g.internal_nodes.count(node) ? "i" : "")
+       << (g.output_nodes.count(node) ? "o" : "");
+  };
+
+  ss << "kind:" << group->op_pattern_kind << ";";
+  for (int i = 0; i < nodes.size(); ++i) {
+    auto* node = nodes[i];
+    ss << "node" << i << ":" << node->op()->name << "(";
+    for (auto& link : node->inlinks_in_order()) {
+      write_var(link->source()->id());
+      ss << ",";
+    }
+    ss << ")->(";
+    for (auto& link : node->outlinks_in_order()) {
+      auto* node_data = link->sink()->safe_as<NodeData>();
+      CHECK(node_data);
+      write_var(node_data->id());
+      // consumers in the group by index, and the number of the others
+      std::vector<int> inner_consumers;
+      int outer_consumers = 0;
+      for (auto& consumer_link : node_data->outlinks()) {
+        auto it = node_index.find(consumer_link->sink()->safe_as<Node>());
+        if (it != node_index.end()) {
+          inner_consumers.push_back(it->second);
+        } else {
+          outer_consumers++;
+        }
+      }
+      std::sort(inner_consumers.begin(), inner_consumers.end());
+      ss << "{" << utils::Join(inner_consumers, ",") << "|" << outer_consumers << "},";
+    }
+    ss << ")";
+
+    std::vector<std::string> attr_names;
+    for (auto& item : node->attrs.attr_store) {
+      attr_names.push_back(item.first);
+    }
+    std::sort(attr_names.begin(), attr_names.end());
+    ss << "attrs{";
+    for (auto& name : attr_names) {
+      ss << name << "=";
+      absl::visit(AttrPrinter(ss), node->attrs.attr_store.at(name));
+      ss << ";";
+    }
+    ss << "}roles:";
+    write_node_roles(*group, node);
+    ss << ";";
+  }
+
+  absl::flat_hash_map<const Graph::Group*, int> sub_group_index;
+  for (int i = 0; i < group->fused_sub_groups.size(); ++i) {
+    sub_group_index.emplace(group->fused_sub_groups[i].get(), i);
+  }
+  for (int i = 0; i < group->fused_sub_groups.size(); ++i) {
+    auto& sub_group = group->fused_sub_groups[i];
+    ss << "sub" << i << ":" << sub_group->op_pattern_kind << "{";
+    for (auto* node : sub_group->nodes) {
+      ss << node_index.at(node) << ":";
+      write_node_roles(*sub_group, node);
+      ss << ",";
+    }
+    // the consumers in the same fused group
+    std::vector<int> consumers;
+    for (auto& consumer : sub_group->consumer_groups) {
+      if (consumer->belong_groups.count(group) && sub_group_index.count(consumer.get())) {
+        consumers.push_back(sub_group_index.at(consumer.get()));
+      }
+    }
+    std::sort(consumers.begin(), consumers.end());
+    ss << "}->{" << utils::Join(consumers, ",") << "};";
+  }
+
+  signature.key = ss.str();
+  return signature;
+}
+
+std::vector<std::string> MapGroupVarNames(const GroupSignature& from,
+                                          const GroupSignature& to,
+                                          const std::vector<std::string>& names) {
+  CHECK_EQ(from.key, to.key) << "Only the variables of the groups with the same signature can be mapped";
+  absl::flat_hash_map<std::string, int> var_index;
+  for (int i = 0; i < from.var_names.size(); ++i) {
+    var_index.emplace(from.var_names[i], i);
+  }
+  std::vector<std::string> mapped;
+  for (auto& name : names) {
+    auto it = var_index.find(name);
+    CHECK(it != var_index.end()) << "Variable " << name << " is not in the group";
+    mapped.push_back(to.var_names[it->second]);
+  }
+  return mapped;
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
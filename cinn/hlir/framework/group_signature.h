@@ -0,0 +1,59 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/op.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * The structure of a fusion group which doesn't depend on the names of its nodes and variables.
+ *
+ * The key describes the ops, attributes, shapes, dtypes and the links of the nodes, together with everything
+ * the op lowering reads from the group, so groups with equal keys lower to the same function except for the
+ * names and can share one kernel. The variables are numbered in the order they are visited, and
+ * var_names[i] is the name of the i-th variable in this group.
+ */
+struct GroupSignature {
+  std::string key;
+  std::vector<std::string> var_names;
+};
+
+GroupSignature GetGroupSignature(const std::shared_ptr<Graph::Group>& group,
+                                 const absl::flat_hash_map<std::string, Type>& dtype_dict,
+                                 const absl::flat_hash_map<std::string, shape_t>& shape_dict);
+
+/**
+ * Map the variable names of a group to the corresponding names in another group of the same key.
+ * @param from The signature of the group which \p names belong to.
+ * @param to The signature of the group to map to.
+ */
+std::vector<std::string> MapGroupVarNames(const GroupSignature& from,
+                                          const GroupSignature& to,
+                                          const std::vector<std::string>& names);
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
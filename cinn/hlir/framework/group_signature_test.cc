@@ -0,0 +1,123 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/group_signature.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+
+DECLARE_bool(cinn_share_group_kernels);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+using common::Float;
+
+namespace {
+// three independent add+relu blocks, the last one is of a different shape
+std::shared_ptr<Graph> BuildGraph(const Target& target, std::vector<std::string>* output_ids) {
+  frontend::NetBuilder builder("test");
+  for (int i = 0; i < 3; ++i) {
+    int dim = i == 2 ? 32 : 64;
+    auto x  = builder.CreateInput(Float(32), {16, dim}, "X" + std::to_string(i));
+    auto y  = builder.CreateInput(Float(32), {16, dim}, "Y" + std::to_string(i));
+    auto z  = builder.Relu(builder.ElementwiseAdd(x, y));
+    output_ids->push_back(z->id);
+  }
+  auto graph = std::make_shared<Graph>(builder.Build(), target);
+  ApplyPass(graph.get(), "OpFusionPass");
+  ApplyPass(graph.get(), "FusionMergePass");
+  return graph;
+}
+}  // namespace
+
+TEST(GroupSignature, IdenticalGroups) {
+  auto target = common::DefaultHostTarget();
+  std::vector<std::string> output_ids;
+  auto graph = BuildGraph(target, &output_ids);
+  ASSERT_EQ(graph->fusion_groups.size(), 3UL);
+
+  auto& dtype_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
+  auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+  // signatures[i] is of the group reading Xi
+  std::vector<GroupSignature> signatures(3);
+  for (auto& group : graph->fusion_groups) {
+    auto signature = GetGroupSignature(group, dtype_dict, shape_dict);
+    for (int i = 0; i < 3; ++i) {
+      auto& names = signature.var_names;
+      if (std::find(names.begin(), names.end(), "X" + std::to_string(i)) != names.end()) {
+        signatures[i] = signature;
+      }
+    }
+  }
+  // X0/Y0 and X1/Y1 are of the same structure
+  EXPECT_EQ(signatures[0].key, signatures[1].key);
+  EXPECT_NE(signatures[0].key, signatures[2].key);
+
+  auto mapped = MapGroupVarNames(signatures[0], signatures[1], {"Y0", "X0", output_ids[0]});
+  EXPECT_EQ(mapped, std::vector<std::string>({"Y1", "X1", output_ids[1]}));
+}
+
+TEST(GroupSignature, SharedKernels) {
+  FLAGS_cinn_share_group_kernels = true;
+  auto target                    = common::DefaultHostTarget();
+  std::vector<std::string> output_ids;
+  auto graph = BuildGraph(target, &output_ids);
+  auto scope = BuildScope(target, graph);
+  GraphCompiler gc(target, scope, graph);
+  auto program = gc.Build();
+  ASSERT_EQ(program->size(), 3);
+
+  std::set<std::string> fn_names;
+  for (auto& instr : program->GetRunInstructions()) {
+    auto names = instr->GetFnNames();
+    fn_names.insert(names.begin(), names.end());
+  }
+  EXPECT_EQ(fn_names.size(), 2UL);
+
+  for (int i = 0; i < 3; ++i) {
+    int size     = i == 2 ? 16 * 32 : 16 * 64;
+    auto* x_data = scope->GetTensor("X" + std::to_string(i))->mutable_data<float>(target);
+    auto* y_data = scope->GetTensor("Y" + std::to_string(i))->mutable_data<float>(target);
+    for (int j = 0; j < size; ++j) {
+      x_data[j] = (i + j) % 7 - 3.f;
+      y_data[j] = j % 5 * 0.5f;
+    }
+  }
+  program->Execute();
+
+  for (int i = 0; i < 3; ++i) {
+    int size     = i == 2 ? 16 * 32 : 16 * 64;
+    auto* z_data = scope->GetTensor(output_ids[i])->data<float>();
+    for (int j = 0; j < size; ++j) {
+      float expect = std::max((i + j) % 7 - 3.f + j % 5 * 0.5f, 0.f);
+      ASSERT_NEAR(z_data[j], expect, 1e-5);
+    }
+  }
+  FLAGS_cinn_share_group_kernels = false;
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -25,22 +25,40 @@ namespace cinn {
 namespace hlir {
 namespace framework {
 
+namespace {
+// the bytes of the buffers passed to a function, reported by the HostProfiler
+uint64_t ArgsBytes(const std::vector<cinn_pod_value_t>& pod_args) {
+  uint64_t bytes = 0;
+  for (auto& arg : pod_args) {
+    if (arg.type_code() == ::cinn_type_code<cinn_buffer_t*>()) {
+      bytes += static_cast<cinn_buffer_t*>(arg)->memory_size;
+    }
+  }
+  return bytes;
+}
+}  // namespace
+
+std::vector<std::string> Instruction::GetAllArgs(int i) const {
+  // Remove duplicate input arguments
+  std::unordered_set<std::string> in_args_set;
+  std::vector<std::string> all_args;
+  for (const auto& arg : in_args_[i]) {
+    if (in_args_set.count(arg) != 0) continue;
+    all_args.push_back(arg);
+    in_args_set.insert(arg);
+  }
+
+  all_args.insert(std::end(all_args), out_args_[i].begin(), out_args_[i].end());
+  return all_args;
+}
+
 void Instruction::UpdateArgsCache(const std::map<std::string, cinn_pod_value_t>* name2podargs) {
   int cache_size = size();
   args_cached_.resize(cache_size);
 
   for (int i = 0; i < cache_size; ++i) {
     common::ArgsBuilder builder;
-    // Remove duplicate input arguments
-    std::unordered_set<std::string> in_args_set;
-    std::vector<std::string> all_args;
-    for (const auto& arg : in_args_[i]) {
-      if (in_args_set.count(arg) != 0) continue;
-      all_args.push_back(arg);
-      in_args_set.insert(arg);
-    }
-
-    all_args.insert(std::end(all_args), out_args_[i].begin(), out_args_[i].end());
+    auto all_args = GetAllArgs(i);
 
     if (name2podargs != nullptr) {
       for (const auto& arg : all_args) {
@@ -60,6 +78,58 @@ void Instruction::UpdateArgsCache(const std::map<std::string, cinn_pod_value_t>*
 
     args_cached_[i] = builder.Build();
   }
+  for (auto& rebound : rebound_args_) {
+    args_cached_[std::get<0>(rebound)][std::get<1>(rebound)] = cinn_pod_value_t(std::get<2>(rebound));
+  }
+}
+
+int Instruction::RebindArgs(const cinn_buffer_t* from, cinn_buffer_t* to, bool* written) {
+  if (args_cached_.size() != size()) {
+    UpdateArgsCache(nullptr);
+  }
+  int num_rebound = 0;
+  for (int i = 0; i < args_cached_.size(); ++i) {
+    // the outputs are placed after the inputs
+    int first_output = args_cached_[i].size() - out_args_[i].size();
+    for (int j = 0; j < args_cached_[i].size(); ++j) {
+      if (static_cast<cinn_buffer_t*>(args_cached_[i][j]) != from) continue;
+      args_cached_[i][j] = cinn_pod_value_t(to);
+      rebound_args_.emplace_back(i, j, to);
+      *written |= j >= first_output;
+      ++num_rebound;
+    }
+  }
+  return num_rebound;
+}
+
+std::vector<std::vector<cinn_pod_value_t>> Instruction::BuildArgs(
+    const std::function<Tensor(const std::string&)>& find_tensor) const {
+  std::vector<std::vector<cinn_pod_value_t>> pod_args(fn_.size());
+  for (int i = 0; i < fn_.size(); ++i) {
+    common::ArgsBuilder builder;
+    for (const auto& arg : GetAllArgs(i)) {
+      auto tensor = find_tensor(arg);
+      builder.Add(tensor->buffer());
+    }
+    pod_args[i] = builder.Build();
+  }
+  return pod_args;
+}
+
+void Instruction::RunWithArgs(std::vector<std::vector<cinn_pod_value_t>>* pod_args) const {
+  CHECK(finalized_flag_) << "Instruction must be finalized before run";
+  CHECK(target_.arch == Target::Arch::X86) << "Only the instructions on host can run with external arguments";
+  if (function_name_ == "no_run") return;
+  CHECK_EQ(pod_args->size(), fn_.size());
+  bool profiling = utils::HostProfiler::Global().enabled();
+  utils::HostRecordEvent record_instr(utils::HostEvent::Kind::kInstruction, profile_id_, 0, profiling);
+  for (int i = 0; i < fn_.size(); ++i) {
+    CHECK(fn_[i]) << "The LoweredFunc address should be set first by calling SetLoweredFunc method";
+    auto& args = (*pod_args)[i];
+    utils::HostRecordEvent record_fn(
+        utils::HostEvent::Kind::kKernel, fn_profile_ids_[i], profiling ? ArgsBytes(args) : 0, profiling);
+    fn_[i](args.data(), args.size());
+  }
 }
 
 void Instruction::Finalize() {
@@ -190,10 +260,14 @@ void Instruction::Run(const std::map<std::string, cinn_pod_value_t>* name2podarg
   int i = 0;
   CHECK_EQ(fn_names_.size(), fn_.size());
   VLOG(3) << "fn_ size is " << fn_.size() << ", function_name_ is : " << function_name_;
+  bool profiling = !dryrun && utils::HostProfiler::Global().enabled();
+  utils::HostRecordEvent record_instr(utils::HostEvent::Kind::kInstruction, profile_id_, 0, profiling);
   for (auto& it_fn : fn_) {
     auto& pod_args = args_cached_[i];
     CHECK(it_fn) << "The LoweredFunc address should be set first by calling SetLoweredFunc method";
     if (!dryrun) {
+      utils::HostRecordEvent record_fn(
+          utils::HostEvent::Kind::kKernel, fn_profile_ids_[i], profiling ? ArgsBytes(pod_args) : 0, profiling);
       it_fn(pod_args.data(), pod_args.size());
     }
     i++;
@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -24,6 +26,7 @@
 #ifdef CINN_WITH_CUDA
 #include "cinn/runtime/cuda/cuda_util.h"
 #endif
+#include "cinn/utils/profiler.h"
 #include "cinn/utils/string.h"
 #include "cinn/utils/timer.h"
 
@@ -53,7 +56,12 @@ class Instruction {
               const std::vector<std::string>& in_args,
               const std::vector<std::string>& out_args,
               const std::string& function_name = "")
-      : target_(target), scope_(scope), in_args_({in_args}), out_args_({out_args}), function_name_(function_name) {}
+      : target_(target),
+        scope_(scope),
+        in_args_({in_args}),
+        out_args_({out_args}),
+        function_name_(function_name),
+        profile_id_(utils::HostProfiler::Global().RegisterName(function_name)) {}
 
   /**
    * Set compiled function address.
@@ -62,12 +70,37 @@ class Instruction {
   void SetLoweredFunc(lower_func_ptr_t fn, const std::string& name = "") {
     fn_.push_back(fn);
     fn_names_.push_back(name);
+    fn_profile_ids_.push_back(utils::HostProfiler::Global().RegisterName(name));
   }
 
   // explicitly finalize the instruction, and can't append function again after call it
   void Finalize();
 
   void UpdateArgsCache(const std::map<std::string, cinn_pod_value_t>* name2podargs);
+
+  /**
+   * Let the cached arguments referring to the buffer \p from refer to \p to instead, the rebound arguments are
+   * kept when the cache is rebuilt.
+   * @param from The buffer of a variable in the scope.
+   * @param to The buffer to pass to the functions instead.
+   * @param written Set to true if any rebound argument is an output.
+   * @return The number of the rebound arguments.
+   */
+  int RebindArgs(const cinn_buffer_t* from, cinn_buffer_t* to, bool* written);
+
+  /**
+   * Build the arguments of the functions from the tensors returned by \p find_tensor instead of the scope
+   * of this instruction.
+   */
+  std::vector<std::vector<cinn_pod_value_t>> BuildArgs(
+      const std::function<Tensor(const std::string&)>& find_tensor) const;
+
+  /**
+   * Run the functions with the arguments built by BuildArgs. It doesn't change the instruction, so an
+   * instruction can be run by several threads with their own arguments. Only host instructions are supported.
+   */
+  void RunWithArgs(std::vector<std::vector<cinn_pod_value_t>>* pod_args) const;
+
   /**
    * Run the Instruction.
    */
@@ -107,6 +140,7 @@ class Instruction {
       out_args_.erase(out_args_.begin() + flag);
       fn_.erase(fn_.begin() + flag);
       fn_names_.erase(fn_names_.begin() + flag);
+      fn_profile_ids_.erase(fn_profile_ids_.begin() + flag);
     }
   }
 
@@ -123,6 +157,9 @@ class Instruction {
   Target target_;
 
  protected:
+  // the arguments of the i-th function, the duplicate inputs are removed
+  std::vector<std::string> GetAllArgs(int i) const;
+
   void CheckResults(const std::map<std::string, cinn_pod_value_t>* name2podargs = nullptr, void* stream = nullptr);
 
  private:
@@ -133,9 +170,14 @@ class Instruction {
   std::vector<std::vector<std::string>> out_args_;
 
   std::vector<std::vector<cinn_pod_value_t>> args_cached_;
+  // the positions of the rebound arguments in args_cached_ and their buffers
+  std::vector<std::tuple<int, int, cinn_buffer_t*>> rebound_args_;
 
   std::vector<lower_func_ptr_t> fn_{};
   std::vector<std::string> fn_names_;
+  // the ids of the instruction and the functions in the HostProfiler
+  int profile_id_;
+  std::vector<int> fn_profile_ids_;
 };
 
 }  // namespace framework
@@ -14,6 +14,14 @@
 
 #include "cinn/hlir/framework/memory.h"
 
+#include <gflags/gflags.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "cinn/hlir/framework/memory_pool.h"
+#include "cinn/runtime/cinn_runtime.h"
+
 #ifdef CINN_WITH_CUDA
 #include <cuda.h>
 #include <cuda_runtime.h>
@@ -21,6 +29,8 @@
 #include "cinn/backends/cuda_util.h"
 #endif
 
+DECLARE_bool(cinn_host_memory_pool);
+
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -29,14 +39,21 @@ using common::Target;
 
 namespace {
 
+// the host kernels assume the buffers aligned to CINN_HOST_BUFFER_ALIGNMENT at least
 class X86MemoryMng : public MemoryInterface {
  public:
-  void* malloc(size_t nbytes) override { return ::malloc(nbytes); }
+  void* malloc(size_t nbytes) override { return aligned_alloc(CINN_HOST_BUFFER_ALIGNMENT, nbytes); }
   void free(void* data) override {
     if (!data) return;
     ::free(data);
   }
-  void* aligned_alloc(size_t alignment, size_t nbytes) override { return ::aligned_alloc(alignment, nbytes); }
+  void* aligned_alloc(size_t alignment, size_t nbytes) override {
+    void* data = nullptr;
+    if (posix_memalign(&data, std::max<size_t>(alignment, CINN_HOST_BUFFER_ALIGNMENT), nbytes) != 0) {
+      return nullptr;
+    }
+    return data;
+  }
 };
 
 #ifdef CINN_WITH_CUDA
@@ -57,7 +74,11 @@ class CudaMemoryMng : public MemoryInterface {
 
 MemoryManager::MemoryManager() {
   Register(Target::Arch::Unk, new X86MemoryMng);
-  Register(Target::Arch::X86, new X86MemoryMng);
+  if (FLAGS_cinn_host_memory_pool) {
+    Register(Target::Arch::X86, new HostMemoryPool);
+  } else {
+    Register(Target::Arch::X86, new X86MemoryMng);
+  }
 #ifdef CINN_WITH_CUDA
   Register(Target::Arch::NVGPU, new CudaMemoryMng);
 #endif
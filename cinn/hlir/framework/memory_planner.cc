@@ -0,0 +1,94 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/memory_planner.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+MemoryPlanner::MemoryPlanner(uint64_t alignment) : alignment_(alignment) {
+  CHECK_GT(alignment_, 0UL);
+  CHECK_EQ(alignment_ & (alignment_ - 1), 0UL) << "The alignment should be a power of 2";
+}
+
+void MemoryPlanner::AddBuffer(const std::string& name, uint64_t size, int first_use, int last_use) {
+  CHECK_LE(first_use, last_use) << "Invalid lifetime of buffer " << name;
+  uint64_t aligned_size = (size + alignment_ - 1) & ~(alignment_ - 1);
+  buffers_.push_back({name, aligned_size, first_use, last_use});
+}
+
+MemoryPlan MemoryPlanner::Plan() const {
+  // the placing order, the ties are broken by the lifetime and the name to make the plan deterministic
+  std::vector<const BufferInfo*> order;
+  for (auto& buffer : buffers_) {
+    order.push_back(&buffer);
+  }
+  std::sort(order.begin(), order.end(), [](const BufferInfo* a, const BufferInfo* b) {
+    if (a->size != b->size) return a->size > b->size;
+    if (a->first_use != b->first_use) return a->first_use < b->first_use;
+    return a->name < b->name;
+  });
+
+  MemoryPlan plan;
+  struct Placement {
+    const BufferInfo* buffer;
+    uint64_t offset;
+  };
+  std::vector<Placement> placed;
+  for (auto* buffer : order) {
+    // the placed buffers alive at the same time, in the order of offset
+    std::vector<Placement> conflicts;
+    for (auto& placement : placed) {
+      if (placement.buffer->first_use <= buffer->last_use && buffer->first_use <= placement.buffer->last_use) {
+        conflicts.push_back(placement);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(), [](const Placement& a, const Placement& b) {
+      return a.offset < b.offset;
+    });
+
+    uint64_t best_offset = std::numeric_limits<uint64_t>::max();
+    uint64_t best_gap    = std::numeric_limits<uint64_t>::max();
+    uint64_t gap_begin   = 0;
+    for (auto& conflict : conflicts) {
+      if (conflict.offset > gap_begin) {
+        uint64_t gap = conflict.offset - gap_begin;
+        if (gap >= buffer->size && gap < best_gap) {
+          best_gap    = gap;
+          best_offset = gap_begin;
+        }
+      }
+      gap_begin = std::max(gap_begin, conflict.offset + conflict.buffer->size);
+    }
+    if (best_offset == std::numeric_limits<uint64_t>::max()) {
+      best_offset = gap_begin;
+    }
+
+    placed.push_back({buffer, best_offset});
+    plan.offsets[buffer->name] = best_offset;
+    plan.arena_size            = std::max(plan.arena_size, best_offset + buffer->size);
+    plan.naive_size += buffer->size;
+  }
+  return plan;
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,79 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * The placement of the planned variables in a single arena.
+ */
+struct MemoryPlan {
+  //! Offset in bytes of each variable from the beginning of the arena.
+  absl::flat_hash_map<std::string, uint64_t> offsets;
+  //! Size of the arena, which is the peak memory of the planned variables.
+  uint64_t arena_size{0};
+  //! Total size if every variable had a buffer of its own.
+  uint64_t naive_size{0};
+};
+
+/**
+ * MemoryPlanner packs the buffers with known sizes and lifetimes into one arena at compile time, two
+ * buffers share memory if their lifetimes don't overlap.
+ *
+ * The buffers are placed from the largest to the smallest, each into the smallest gap between the placed
+ * buffers alive at the same time that fits it (best-fit), or at the end of them if no gap fits.
+ */
+class MemoryPlanner {
+ public:
+  /**
+   * Constructor.
+   * @param alignment The alignment in bytes of every offset and size.
+   */
+  explicit MemoryPlanner(uint64_t alignment = 64);
+
+  /**
+   * Add a buffer to plan.
+   * @param name The name of the variable.
+   * @param size The size in bytes.
+   * @param first_use The first step the buffer is used.
+   * @param last_use The last step the buffer is used, inclusive.
+   */
+  void AddBuffer(const std::string& name, uint64_t size, int first_use, int last_use);
+
+  MemoryPlan Plan() const;
+
+ private:
+  struct BufferInfo {
+    std::string name;
+    uint64_t size;
+    int first_use;
+    int last_use;
+  };
+
+  uint64_t alignment_;
+  std::vector<BufferInfo> buffers_;
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
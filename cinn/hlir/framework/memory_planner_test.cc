@@ -0,0 +1,69 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/memory_planner.h"
+
+#include <gtest/gtest.h>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+TEST(MemoryPlanner, Chain) {
+  MemoryPlanner planner(64);
+  // A -> B -> C, A and C are never alive at the same time
+  planner.AddBuffer("A", 100, 0, 1);
+  planner.AddBuffer("B", 100, 1, 2);
+  planner.AddBuffer("C", 100, 2, 3);
+  auto plan = planner.Plan();
+
+  EXPECT_EQ(plan.naive_size, 3 * 128UL);
+  EXPECT_EQ(plan.arena_size, 2 * 128UL);
+  EXPECT_EQ(plan.offsets.at("A"), plan.offsets.at("C"));
+  EXPECT_NE(plan.offsets.at("A"), plan.offsets.at("B"));
+}
+
+TEST(MemoryPlanner, BestFit) {
+  MemoryPlanner planner(1);
+  planner.AddBuffer("big", 1000, 0, 0);
+  planner.AddBuffer("medium", 600, 1, 2);
+  planner.AddBuffer("keep", 100, 0, 3);
+  // a gap of 300 bytes before "keep" in [0, 1000) is left at step 2, it fits exactly
+  planner.AddBuffer("small", 300, 2, 3);
+  auto plan = planner.Plan();
+
+  EXPECT_EQ(plan.offsets.at("big"), 0UL);
+  EXPECT_EQ(plan.offsets.at("keep"), 1000UL);
+  EXPECT_EQ(plan.offsets.at("medium"), 0UL);
+  EXPECT_EQ(plan.offsets.at("small"), 600UL);
+  EXPECT_EQ(plan.arena_size, 1100UL);
+  EXPECT_EQ(plan.naive_size, 2000UL);
+}
+
+TEST(MemoryPlanner, NoOverlap) {
+  MemoryPlanner planner(64);
+  for (int i = 0; i < 8; ++i) {
+    planner.AddBuffer("var_" + std::to_string(i), 64 * (i + 1), i, i);
+  }
+  auto plan = planner.Plan();
+  // every buffer reuses the memory of the largest one
+  EXPECT_EQ(plan.arena_size, 64 * 8UL);
+  for (auto& var2offset : plan.offsets) {
+    EXPECT_EQ(var2offset.second, 0UL);
+  }
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,291 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/memory_pool.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+constexpr uint32_t kBlockMagic = 0xC1AA0B10;
+// a block doesn't belong to any bin if it is not cached
+constexpr uint32_t kNoBin = ~0U;
+// the limits of the blocks cached by one thread in a pool
+constexpr size_t kMaxThreadCachedBlocks = 16;
+constexpr size_t kMaxThreadCachedBytes  = size_t(64) << 20;
+
+// The header before the memory returned to the user, it is placed at the end of the alignment padding,
+// so the user memory keeps its alignment.
+struct BlockHeader {
+  uint32_t magic;
+  uint32_t bin;
+  uint64_t bytes;
+  uint64_t alignment;
+  void* base;
+};
+static_assert(sizeof(BlockHeader) <= HostMemoryPool::kMinAlignment, "The block header should fit the padding");
+
+// size classes are the powers of 2 and their midpoints, so at most 1/3 of a block is wasted
+const std::vector<size_t>& SizeClasses() {
+  static const std::vector<size_t> classes = [] {
+    std::vector<size_t> res;
+    for (size_t size = HostMemoryPool::kMinAlignment; size <= HostMemoryPool::kMaxPooledBytes; size *= 2) {
+      res.push_back(size);
+      if (size < HostMemoryPool::kMaxPooledBytes) res.push_back(size + size / 2);
+    }
+    return res;
+  }();
+  return classes;
+}
+
+int Log2(size_t x) {
+  int res = 0;
+  while ((size_t(1) << res) < x) ++res;
+  return res;
+}
+
+const int kNumAlignmentClasses = Log2(HostMemoryPool::kMaxAlignment) - Log2(HostMemoryPool::kMinAlignment) + 1;
+
+size_t NumBins() { return SizeClasses().size() * kNumAlignmentClasses; }
+
+BlockHeader* HeaderOf(void* data) { return reinterpret_cast<BlockHeader*>(data) - 1; }
+
+void ReleaseBlock(void* data) { std::free(HeaderOf(data)->base); }
+}  // namespace
+
+// The state shared by all the threads, the thread caches refer to it weakly, so the blocks cached by a
+// thread are released to the system on the thread exit if the pool is gone already.
+struct HostMemoryPool::Central {
+  explicit Central(size_t max_cached_bytes) : max_cached_bytes(max_cached_bytes), bins(NumBins()) {}
+
+  ~Central() {
+    for (auto& bin : bins) {
+      for (void* data : bin) {
+        ReleaseBlock(data);
+      }
+    }
+  }
+
+  // return false if the block should be released to the system
+  bool Push(uint32_t bin, void* data) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto bytes = HeaderOf(data)->bytes;
+    if (max_cached_bytes && central_cached_bytes + bytes > max_cached_bytes) return false;
+    bins[bin].push_back(data);
+    central_cached_bytes += bytes;
+    return true;
+  }
+
+  void* Pop(uint32_t bin) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (bins[bin].empty()) return nullptr;
+    void* data = bins[bin].back();
+    bins[bin].pop_back();
+    central_cached_bytes -= HeaderOf(data)->bytes;
+    return data;
+  }
+
+  void Trim() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto& bin : bins) {
+      for (void* data : bin) {
+        bytes_cached -= HeaderOf(data)->bytes;
+        ReleaseBlock(data);
+      }
+      bin.clear();
+    }
+    central_cached_bytes = 0;
+  }
+
+  void OnAlloc(uint64_t bytes, bool hit) {
+    num_allocs++;
+    if (hit) num_hits++;
+    uint64_t in_use = bytes_in_use += bytes;
+    uint64_t peak   = peak_bytes_in_use.load();
+    while (in_use > peak && !peak_bytes_in_use.compare_exchange_weak(peak, in_use)) {
+    }
+  }
+
+  const size_t max_cached_bytes;
+  std::mutex mtx;
+  std::vector<std::vector<void*>> bins;
+  size_t central_cached_bytes{0};
+
+  std::atomic<uint64_t> bytes_in_use{0};
+  std::atomic<uint64_t> peak_bytes_in_use{0};
+  std::atomic<uint64_t> bytes_cached{0};
+  std::atomic<uint64_t> num_allocs{0};
+  std::atomic<uint64_t> num_hits{0};
+  // bumped by every Trim, a thread cache of an older epoch is released on its next use
+  std::atomic<uint64_t> trim_epoch{0};
+};
+
+namespace {
+struct ThreadCache {
+  explicit ThreadCache(const std::shared_ptr<HostMemoryPool::Central>& central)
+      : central(central), bins(NumBins()), trim_epoch(central->trim_epoch.load()) {}
+
+  ~ThreadCache() { Flush(); }
+
+  // release the cached blocks to the system
+  void Release(HostMemoryPool::Central* shared) {
+    for (auto& bin : bins) {
+      for (void* data : bin) {
+        shared->bytes_cached -= HeaderOf(data)->bytes;
+        ReleaseBlock(data);
+      }
+      bin.clear();
+    }
+    bytes = 0;
+  }
+
+  // move the cached blocks to the shared pool, or release them if it is gone or full
+  void Flush() {
+    auto shared = central.lock();
+    for (uint32_t bin = 0; bin < bins.size(); ++bin) {
+      for (void* data : bins[bin]) {
+        if (shared && shared->Push(bin, data)) continue;
+        if (shared) shared->bytes_cached -= HeaderOf(data)->bytes;
+        ReleaseBlock(data);
+      }
+      bins[bin].clear();
+    }
+    bytes = 0;
+  }
+
+  std::weak_ptr<HostMemoryPool::Central> central;
+  std::vector<std::vector<void*>> bins;
+  size_t bytes{0};
+  uint64_t trim_epoch;
+};
+
+// the caches of the calling thread for every pool
+ThreadCache* GetThreadCache(const std::shared_ptr<HostMemoryPool::Central>& central) {
+  thread_local std::unordered_map<const HostMemoryPool::Central*, std::unique_ptr<ThreadCache>> caches;
+  auto& cache = caches[central.get()];
+  // a new pool may be allocated at the address of a destroyed one
+  if (!cache || cache->central.lock() != central) {
+    cache.reset(new ThreadCache(central));
+  }
+  // the pool is trimmed since the last use of the cache
+  uint64_t epoch = central->trim_epoch.load();
+  if (cache->trim_epoch != epoch) {
+    cache->Release(central.get());
+    cache->trim_epoch = epoch;
+  }
+  return cache.get();
+}
+}  // namespace
+
+HostMemoryPool::HostMemoryPool(size_t max_cached_bytes) : central_(std::make_shared<Central>(max_cached_bytes)) {}
+
+HostMemoryPool::~HostMemoryPool() = default;
+
+void* HostMemoryPool::aligned_alloc(size_t alignment, size_t nbytes) {
+  alignment = std::max(alignment, kMinAlignment);
+  CHECK_EQ(alignment & (alignment - 1), 0UL) << "The alignment should be a power of 2";
+
+  auto& classes = SizeClasses();
+  uint32_t bin  = kNoBin;
+  size_t bytes  = std::max<size_t>(nbytes, 1);
+  if (nbytes <= kMaxPooledBytes && alignment <= kMaxAlignment) {
+    size_t size_class = std::lower_bound(classes.begin(), classes.end(), bytes) - classes.begin();
+    bin               = size_class * kNumAlignmentClasses + Log2(alignment) - Log2(kMinAlignment);
+    bytes             = classes[size_class];
+
+    auto* cache = GetThreadCache(central_);
+    void* data  = nullptr;
+    if (!cache->bins[bin].empty()) {
+      data = cache->bins[bin].back();
+      cache->bins[bin].pop_back();
+      cache->bytes -= bytes;
+    } else {
+      data = central_->Pop(bin);
+    }
+    if (data) {
+      central_->bytes_cached -= bytes;
+      central_->OnAlloc(bytes, true);
+      return data;
+    }
+  }
+
+  // the header is placed in the padding before the user memory
+  void* base = nullptr;
+  if (posix_memalign(&base, alignment, alignment + bytes) != 0) {
+    LOG(ERROR) << "Failed to allocate " << bytes << " bytes of host memory";
+    return nullptr;
+  }
+  void* data        = static_cast<char*>(base) + alignment;
+  auto* header      = HeaderOf(data);
+  header->magic     = kBlockMagic;
+  header->bin       = bin;
+  header->bytes     = bytes;
+  header->alignment = alignment;
+  header->base      = base;
+  central_->OnAlloc(bytes, false);
+  return data;
+}
+
+void HostMemoryPool::free(void* data) {
+  if (!data) return;
+  auto* header = HeaderOf(data);
+  CHECK_EQ(header->magic, kBlockMagic) << "The memory is not allocated by the HostMemoryPool";
+  central_->bytes_in_use -= header->bytes;
+  if (header->bin == kNoBin) {
+    ReleaseBlock(data);
+    return;
+  }
+
+  central_->bytes_cached += header->bytes;
+  auto* cache = GetThreadCache(central_);
+  auto& bin   = cache->bins[header->bin];
+  if (bin.size() < kMaxThreadCachedBlocks && cache->bytes + header->bytes <= kMaxThreadCachedBytes) {
+    bin.push_back(data);
+    cache->bytes += header->bytes;
+    return;
+  }
+  if (!central_->Push(header->bin, data)) {
+    central_->bytes_cached -= header->bytes;
+    ReleaseBlock(data);
+  }
+}
+
+HostMemoryPool::Stats HostMemoryPool::GetStats() const {
+  Stats stats;
+  stats.bytes_in_use      = central_->bytes_in_use.load();
+  stats.peak_bytes_in_use = central_->peak_bytes_in_use.load();
+  stats.bytes_cached      = central_->bytes_cached.load();
+  stats.num_allocs        = central_->num_allocs.load();
+  stats.num_hits          = central_->num_hits.load();
+  return stats;
+}
+
+void HostMemoryPool::Trim() {
+  // the other threads release their caches on their next allocation or free
+  central_->trim_epoch++;
+  GetThreadCache(central_);
+  central_->Trim();
+  VLOG(3) << "HostMemoryPool is trimmed, " << central_->bytes_cached.load() << " bytes are still cached by threads";
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
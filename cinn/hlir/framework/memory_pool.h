@@ -0,0 +1,85 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "cinn/hlir/framework/memory.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * A caching allocator of host memory, which keeps the freed blocks for the later allocations of the same
+ * size class instead of returning them to the system.
+ *
+ * The requested sizes are rounded up to the size classes (powers of 2 and their midpoints), and a block
+ * is reused only for the same size class and alignment. A freed block is cached by the freeing thread
+ * first, and overflows to the pool shared by all the threads. The blocks larger than kMaxPooledBytes or
+ * aligned over kMaxAlignment are not cached.
+ */
+class HostMemoryPool : public MemoryInterface {
+ public:
+  static constexpr size_t kMinAlignment   = 64;
+  static constexpr size_t kMaxAlignment   = 4096;
+  static constexpr size_t kMaxPooledBytes = size_t(1) << 30;
+
+  struct Stats {
+    //! Bytes of the size classes of the allocated blocks not freed yet.
+    uint64_t bytes_in_use{0};
+    //! Peak of bytes_in_use.
+    uint64_t peak_bytes_in_use{0};
+    //! Bytes of the size classes of the cached blocks.
+    uint64_t bytes_cached{0};
+    uint64_t num_allocs{0};
+    //! Number of the allocations served by the cached blocks.
+    uint64_t num_hits{0};
+
+    double hit_rate() const { return num_allocs ? static_cast<double>(num_hits) / num_allocs : 0.; }
+  };
+
+  /**
+   * Constructor.
+   * @param max_cached_bytes The maximum bytes cached in the shared pool, 0 means unlimited.
+   */
+  explicit HostMemoryPool(size_t max_cached_bytes = 0);
+  ~HostMemoryPool();
+
+  void* malloc(size_t nbytes) override { return aligned_alloc(kMinAlignment, nbytes); }
+  void free(void* data) override;
+  void* aligned_alloc(size_t alignment, size_t nbytes) override;
+
+  Stats GetStats() const;
+
+  /**
+   * Return the cached blocks to the system. The shared pool and the cache of the calling thread are released
+   * immediately, and the caches of the other threads are released on their next allocation or free in this pool.
+   */
+  void Trim();
+
+  struct Central;
+
+ private:
+  std::shared_ptr<Central> central_;
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
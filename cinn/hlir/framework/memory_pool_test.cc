@@ -0,0 +1,129 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/memory_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>  // NOLINT
+#include <cstring>
+#include <mutex>  // NOLINT
+#include <thread>
+#include <vector>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+TEST(HostMemoryPool, ReuseSameSizeClass) {
+  HostMemoryPool pool;
+  void* a = pool.malloc(1000);
+  ASSERT_NE(a, nullptr);
+  std::memset(a, 1, 1000);
+  pool.free(a);
+  // 1000 and 1020 bytes are of the same size class
+  void* b = pool.malloc(1020);
+  EXPECT_EQ(a, b);
+  // a different alignment doesn't reuse the block
+  void* c = pool.aligned_alloc(1024, 1000);
+  EXPECT_NE(b, c);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 1024, 0UL);
+
+  auto stats = pool.GetStats();
+  EXPECT_EQ(stats.num_allocs, 3UL);
+  EXPECT_EQ(stats.num_hits, 1UL);
+  EXPECT_EQ(stats.bytes_in_use, 2 * 1024UL);
+  EXPECT_EQ(stats.bytes_cached, 0UL);
+  pool.free(b);
+  pool.free(c);
+
+  stats = pool.GetStats();
+  EXPECT_EQ(stats.bytes_in_use, 0UL);
+  EXPECT_EQ(stats.peak_bytes_in_use, 2 * 1024UL);
+  EXPECT_EQ(stats.bytes_cached, 2 * 1024UL);
+  pool.Trim();
+  EXPECT_EQ(pool.GetStats().bytes_cached, 0UL);
+}
+
+TEST(HostMemoryPool, LargeBlocksNotCached) {
+  HostMemoryPool pool;
+  void* a = pool.malloc(HostMemoryPool::kMaxPooledBytes + 1);
+  ASSERT_NE(a, nullptr);
+  pool.free(a);
+  EXPECT_EQ(pool.GetStats().bytes_cached, 0UL);
+}
+
+TEST(HostMemoryPool, CrossThreads) {
+  HostMemoryPool pool;
+  std::vector<void*> blocks(64);
+  for (auto& block : blocks) {
+    block = pool.malloc(4096);
+  }
+  // the blocks freed by other threads are returned to the shared pool when the threads exit
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool, &blocks, t] {
+      for (int i = t; i < blocks.size(); i += 4) {
+        pool.free(blocks[i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& block : blocks) {
+    block = pool.malloc(4096);
+  }
+  auto stats = pool.GetStats();
+  EXPECT_EQ(stats.num_hits, 64UL);
+  EXPECT_EQ(stats.bytes_cached, 0UL);
+  for (auto* block : blocks) {
+    pool.free(block);
+  }
+}
+
+TEST(HostMemoryPool, TrimOtherThreads) {
+  HostMemoryPool pool;
+  std::mutex mtx;
+  std::condition_variable cv;
+  int step = 0;
+  auto wait_step = [&](int target) {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [&] { return step >= target; });
+  };
+  auto set_step = [&](int target) {
+    std::lock_guard<std::mutex> lock(mtx);
+    step = target;
+    cv.notify_all();
+  };
+  std::thread worker([&] {
+    pool.free(pool.malloc(4096));
+    set_step(1);
+    wait_step(2);
+    // the cache of this thread is released on its next use after the trim
+    pool.free(pool.malloc(1024));
+    set_step(3);
+  });
+  wait_step(1);
+  EXPECT_EQ(pool.GetStats().bytes_cached, 4096UL);
+  pool.Trim();
+  set_step(2);
+  wait_step(3);
+  EXPECT_EQ(pool.GetStats().bytes_cached, 1024UL);
+  worker.join();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
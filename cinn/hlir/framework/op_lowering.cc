@@ -245,7 +245,7 @@ std::vector<ir::Tensor> OpLowerer::CollectInputTensor(std::vector<ir::Tensor>& f
     CHECK(source_data);
     if (FLAGS_cinn_ir_schedule) {
       auto dtype = this->type_dict_.at(source_data->id());
-      CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32))
+      CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32) || dtype == Int(8) || dtype.is_float(16))
           << "The dtype of node " << source_data->id()
           << " is not float or bool or int! Other dtype is not implemented yet.";
       ir::Tensor tensor;
@@ -255,6 +255,12 @@ std::vector<ir::Tensor> OpLowerer::CollectInputTensor(std::vector<ir::Tensor>& f
         tensor = lang::Placeholder<bool>(source_data->id(), this->shape_dict_.at(source_data->id()));
       } else if (dtype == Int(32)) {
         tensor = lang::Placeholder<int>(source_data->id(), this->shape_dict_.at(source_data->id()));
+      } else if (dtype == Int(8)) {
+        tensor = lang::Placeholder<int8_t>(source_data->id(), this->shape_dict_.at(source_data->id()));
+      } else if (dtype.is_float16()) {
+        tensor = lang::Placeholder<common::float16>(source_data->id(), this->shape_dict_.at(source_data->id()));
+      } else if (dtype.is_bfloat16()) {
+        tensor = lang::Placeholder<common::bfloat16>(source_data->id(), this->shape_dict_.at(source_data->id()));
       }
       if (!tensor_map.count(source_data->id())) {
         tensor_map[source_data->id()] = tensor;
@@ -267,7 +273,7 @@ std::vector<ir::Tensor> OpLowerer::CollectInputTensor(std::vector<ir::Tensor>& f
         tensor_inputs.push_back(tensor_map[source_data->id()]);
       } else {
         auto dtype = this->type_dict_.at(source_data->id());
-        CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32))
+        CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32) || dtype == Int(8) || dtype.is_float(16))
             << "The dtype of node " << source_data->id()
             << " is not float or bool or int! Other dtype is not implemented yet.";
         ir::Tensor tensor;
@@ -277,6 +283,12 @@ std::vector<ir::Tensor> OpLowerer::CollectInputTensor(std::vector<ir::Tensor>& f
           tensor = lang::Placeholder<bool>(source_data->id(), this->shape_dict_.at(source_data->id()));
         } else if (dtype == Int(32)) {
           tensor = lang::Placeholder<int>(source_data->id(), this->shape_dict_.at(source_data->id()));
+        } else if (dtype == Int(8)) {
+          tensor = lang::Placeholder<int8_t>(source_data->id(), this->shape_dict_.at(source_data->id()));
+        } else if (dtype.is_float16()) {
+          tensor = lang::Placeholder<common::float16>(source_data->id(), this->shape_dict_.at(source_data->id()));
+        } else if (dtype.is_bfloat16()) {
+          tensor = lang::Placeholder<common::bfloat16>(source_data->id(), this->shape_dict_.at(source_data->id()));
         }
         tensor_map[source_data->id()] = tensor;
         tensor_inputs.push_back(tensor);
@@ -1040,7 +1052,7 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerOpaqueOp(GroupPtr& group) {
     std::string input_id = i->source()->as<NodeData>()->id();
     auto in_shape        = shape_dict_.at(input_id);
     Type dtype           = type_dict_.at(input_id);
-    CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32))
+    CHECK(dtype == Float(32) || dtype.is_bool() || dtype == Int(32) || dtype == Int(8) || dtype.is_float(16))
         << "The dtype of node " << input_id << " is not float or bool or int! Other dtype is not implemented yet.";
     ir::Tensor temp;
     if (dtype == Float(32)) {
@@ -1049,6 +1061,12 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerOpaqueOp(GroupPtr& group) {
       temp = lang::Placeholder<bool>(input_id, in_shape);
     } else if (dtype == Int(32)) {
       temp = lang::Placeholder<int>(input_id, in_shape);
+    } else if (dtype == Int(8)) {
+      temp = lang::Placeholder<int8_t>(input_id, in_shape);
+    } else if (dtype.is_float16()) {
+      temp = lang::Placeholder<common::float16>(input_id, in_shape);
+    } else if (dtype.is_bfloat16()) {
+      temp = lang::Placeholder<common::bfloat16>(input_id, in_shape);
     }
     input_args.push_back(temp);
     inputs.push_back(temp);
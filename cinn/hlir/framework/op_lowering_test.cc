@@ -23,6 +23,8 @@
 #include "cinn/common/target.h"
 #include "cinn/frontend/decomposer/test_helper.h"
 
+DECLARE_bool(cinn_use_ir_cse_licm);
+
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -1177,6 +1179,41 @@ TEST(OP_LOWERING, Reduce_Test_21) {
   }
 }
 
+TEST(OP_LOWERING, CSE_LICM_Test_0) {
+  FLAGS_cinn_use_ir_cse_licm = true;
+  NetBuilder net_builder("CSE_LICM_Test_0");
+  // create model
+  {
+    auto A = net_builder.CreateInput(Float(32), {32, 64}, "A");
+    auto B = net_builder.CreateInput(Float(32), {64}, "B");
+    auto C = net_builder.CreateInput(Float(32), {32, 1}, "C");
+    auto D = net_builder.ElementwiseAdd(A, B, 1);
+    auto E = net_builder.ElementwiseMul(D, C);
+    auto F = net_builder.ElementwiseAdd(E, D);
+    auto G = net_builder.Reduce(F, ReduceKind::kSum, {1});
+  }
+
+  auto program = net_builder.Build();
+  auto target  = GetTarget();
+  RunDecomposer(&program, target);
+
+  auto graph = std::make_shared<hlir::framework::Graph>(program, target);
+  hlir::framework::ApplyPass(graph.get(), "OpFusionPass");
+  hlir::framework::ApplyPass(graph.get(), "FusionMergePass");
+
+  auto& dtype_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
+  auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+
+  OpLowerer op_lowerer(dtype_dict, shape_dict, target);
+  for (auto& fusion_op : graph->fusion_groups) {
+    auto lowered_func = op_lowerer.Lower(fusion_op);
+    CHECK_EQ(lowered_func.size(), 1);
+    LOG(INFO) << lowered_func[0];
+    CodeGen(lowered_func[0]);
+  }
+  FLAGS_cinn_use_ir_cse_licm = false;
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
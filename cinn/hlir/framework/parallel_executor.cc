@@ -0,0 +1,152 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/parallel_executor.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+// The malloc instruction inserted by GraphCompiler::InsertBufferHandlers takes the variables
+// as inputs, but it produces their buffers actually.
+bool IsBufferMallocInstruction(Instruction* instr) {
+  auto fn_names = instr->GetFnNames();
+  return fn_names.size() == 1 && fn_names[0].find("malloc_buffer_instruction") != std::string::npos;
+}
+}  // namespace
+
+ParallelExecutor::ParallelExecutor(const std::vector<std::unique_ptr<Instruction>>& instrs, int num_inter_op_threads) {
+  for (auto& instr : instrs) {
+    CHECK(instr->target_.arch == Target::Arch::X86) << "ParallelExecutor only supports instructions on host";
+    instrs_.push_back(instr.get());
+  }
+  BuildDependencies();
+
+  int num_cores = max_concurrency();
+  if (num_inter_op_threads <= 0) {
+    num_inter_op_threads = GraphWidth();
+  }
+  num_inter_op_threads_ = std::max(std::min(num_inter_op_threads, num_cores), 1);
+  num_intra_op_threads_ = std::max(num_cores / num_inter_op_threads_, 1);
+  pool_.reset(new utils::ThreadPool(num_inter_op_threads_));
+  VLOG(3) << "ParallelExecutor of " << instrs_.size() << " instructions runs with " << num_inter_op_threads_
+          << " inter-op threads and " << num_intra_op_threads_ << " intra-op threads";
+}
+
+void ParallelExecutor::BuildDependencies() {
+  int num_instrs = instrs_.size();
+  std::vector<std::set<int>> edges(num_instrs);
+  absl::flat_hash_map<std::string, int> last_writer;
+  absl::flat_hash_map<std::string, std::vector<int>> readers_after_write;
+
+  auto add_edge = [&edges](int from, int to) {
+    if (from != to) edges[from].insert(to);
+  };
+  auto on_read = [&](const std::string& var, int idx) {
+    auto it = last_writer.find(var);
+    if (it != last_writer.end()) add_edge(it->second, idx);
+    readers_after_write[var].push_back(idx);
+  };
+  auto on_write = [&](const std::string& var, int idx) {
+    auto it = last_writer.find(var);
+    if (it != last_writer.end()) add_edge(it->second, idx);
+    for (int reader : readers_after_write[var]) {
+      add_edge(reader, idx);
+    }
+    readers_after_write[var].clear();
+    last_writer[var] = idx;
+  };
+
+  for (int idx = 0; idx < num_instrs; ++idx) {
+    auto* instr         = instrs_[idx];
+    bool inputs_written = IsBufferMallocInstruction(instr);
+    for (auto& args : instr->GetInArgs()) {
+      for (auto& var : args) {
+        if (inputs_written) {
+          on_write(var, idx);
+        } else {
+          on_read(var, idx);
+        }
+      }
+    }
+    for (auto& args : instr->GetOutArgs()) {
+      for (auto& var : args) {
+        on_write(var, idx);
+      }
+    }
+  }
+
+  successors_.assign(num_instrs, {});
+  num_predecessors_.assign(num_instrs, 0);
+  for (int idx = 0; idx < num_instrs; ++idx) {
+    successors_[idx].assign(edges[idx].begin(), edges[idx].end());
+    for (int succ : successors_[idx]) {
+      num_predecessors_[succ]++;
+    }
+  }
+}
+
+int ParallelExecutor::GraphWidth() const {
+  // instructions are in a topological order already, so the depth can be computed in one pass
+  std::vector<int> depth(instrs_.size(), 0);
+  std::vector<int> num_at_depth(instrs_.size() + 1, 0);
+  int width = 1;
+  for (int idx = 0; idx < instrs_.size(); ++idx) {
+    width = std::max(width, ++num_at_depth[depth[idx]]);
+    for (int succ : successors_[idx]) {
+      depth[succ] = std::max(depth[succ], depth[idx] + 1);
+    }
+  }
+  return width;
+}
+
+void ParallelExecutor::Run(const std::map<std::string, cinn_pod_value_t>* name2podargs, bool use_cache) {
+  if (instrs_.empty()) return;
+  int num_instrs = instrs_.size();
+  std::unique_ptr<std::atomic<int>[]> remaining(new std::atomic<int>[num_instrs]);
+  for (int idx = 0; idx < num_instrs; ++idx) {
+    remaining[idx] = num_predecessors_[idx];
+  }
+
+  // successors are submitted before the task finished, so the pool won't be drained until the last one
+  std::function<void(int)> run_instr = [&](int idx) {
+    cinn_backend_set_intra_op_concurrency(num_intra_op_threads_);
+    instrs_[idx]->Run(name2podargs, false, nullptr, use_cache);
+    for (int succ : successors_[idx]) {
+      if (--remaining[succ] == 0) {
+        pool_->Submit([&run_instr, succ] { run_instr(succ); });
+      }
+    }
+  };
+
+  for (int idx = 0; idx < num_instrs; ++idx) {
+    if (num_predecessors_[idx] == 0) {
+      pool_->Submit([&run_instr, idx] { run_instr(idx); });
+    }
+  }
+  pool_->Wait();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
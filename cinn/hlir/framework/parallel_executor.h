@@ -0,0 +1,69 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/hlir/framework/instruction.h"
+#include "cinn/utils/thread_pool.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * ParallelExecutor runs the instructions of a Program as a dependency graph on host.
+ *
+ * The graph is built from the argument names of the instructions: an instruction depends on the last
+ * writer of each variable it reads or writes, and on every reader of a variable it overwrites. The ready
+ * instructions run on a work-stealing thread pool, and the cores are split between the inter-op threads
+ * and the parallel loops(cinn_backend_parallel_launch) inside each instruction.
+ */
+class ParallelExecutor {
+ public:
+  /**
+   * Constructor.
+   * @param instrs The instructions in their sequential order, they should outlive the executor.
+   * @param num_inter_op_threads The number of instructions running concurrently, 0 means deciding it by the
+   * width of the dependency graph.
+   */
+  ParallelExecutor(const std::vector<std::unique_ptr<Instruction>>& instrs, int num_inter_op_threads = 0);
+
+  //! Run all the instructions and return after the last one finished.
+  void Run(const std::map<std::string, cinn_pod_value_t>* name2podargs = nullptr, bool use_cache = true);
+
+  const std::vector<std::vector<int>>& successors() const { return successors_; }
+  int num_inter_op_threads() const { return num_inter_op_threads_; }
+  int num_intra_op_threads() const { return num_intra_op_threads_; }
+
+ private:
+  void BuildDependencies();
+  // the maximum number of instructions at the same depth of the dependency graph
+  int GraphWidth() const;
+
+  std::vector<Instruction*> instrs_;
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> num_predecessors_;
+  int num_inter_op_threads_;
+  int num_intra_op_threads_;
+  std::unique_ptr<utils::ThreadPool> pool_;
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
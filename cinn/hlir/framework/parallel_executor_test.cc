@@ -0,0 +1,74 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/parallel_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+using common::Float;
+
+TEST(ParallelExecutor, IndependentBranches) {
+  frontend::NetBuilder builder("test");
+  auto a = builder.CreateInput(Float(32), {32, 64}, "A");
+  auto b = builder.CreateInput(Float(32), {32, 64}, "B");
+  // c and d don't depend on each other
+  auto c = builder.ElementwiseAdd(a, b);
+  auto d = builder.Relu(a);
+  auto e = builder.ElementwiseMul(c, d);
+
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+  auto scope  = BuildScope(target, graph);
+  GraphCompiler gc(target, scope, graph);
+  auto program = gc.Build();
+  ASSERT_EQ(program->size(), 3);
+
+  auto* a_data = scope->GetTensor("A")->mutable_data<float>(target);
+  auto* b_data = scope->GetTensor("B")->mutable_data<float>(target);
+  for (int i = 0; i < 32 * 64; ++i) {
+    a_data[i] = i % 7 - 3.f;
+    b_data[i] = i % 5 * 0.5f;
+  }
+
+  ParallelExecutor executor(program->GetRunInstructions(), 2);
+  auto& successors = executor.successors();
+  ASSERT_EQ(successors.size(), 3UL);
+  EXPECT_EQ(successors[0], std::vector<int>({2}));
+  EXPECT_EQ(successors[1], std::vector<int>({2}));
+  EXPECT_TRUE(successors[2].empty());
+  EXPECT_GE(executor.num_intra_op_threads(), 1);
+
+  executor.Run();
+  auto* e_data = scope->GetTensor(e->id)->data<float>();
+  for (int i = 0; i < 32 * 64; ++i) {
+    float expect = (a_data[i] + b_data[i]) * std::max(a_data[i], 0.f);
+    ASSERT_NEAR(e_data[i], expect, 1e-5);
+  }
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
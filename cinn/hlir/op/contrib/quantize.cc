@@ -0,0 +1,557 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/quantize.h"
+
+#include <gflags/gflags.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/cas.h"
+#include "cinn/common/common.h"
+#include "cinn/common/context.h"
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/pe/ir_schedule_pe.h"
+#include "cinn/hlir/pe/schedule.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_operators.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/lang/builtin.h"
+#include "cinn/lang/compute.h"
+#include "cinn/runtime/cpu/gemm_int8.h"
+#include "cinn/utils/string.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+using common::_CINNValuePack_;
+using common::CINNValue;
+using common::CINNValuePack;
+using framework::OpStrategy;
+using framework::shape_t;
+using framework::StrategyFunction;
+
+namespace {
+
+template <typename T>
+T GetAttr(const framework::AttrMapType &attrs, const std::string &name, T default_value) {
+  auto it = attrs.find(name);
+  return it == attrs.end() ? default_value : absl::get<T>(it->second);
+}
+
+// The depth K and the columns N of the weights packed by pack_weights_int8.
+std::pair<int, int> GetPackedWeightsKN(const shape_t &weight_shape, bool trans_b) {
+  if (weight_shape.size() == 4U) {
+    return {weight_shape[1] * weight_shape[2] * weight_shape[3], weight_shape[0]};
+  }
+  CHECK_EQ(weight_shape.size(), 2U) << "The weights of pack_weights_int8 should be 2-D or the 4-D weights of conv2d";
+  return trans_b ? std::make_pair(weight_shape[1], weight_shape[0]) : std::make_pair(weight_shape[0], weight_shape[1]);
+}
+
+// Wrap the tensors of the extern call of an INT8 op into the result of the compute.
+void SetExternCallResult(const std::vector<ir::Tensor> &inputs,
+                         const std::vector<ir::Tensor> &out,
+                         lang::RetValue *ret) {
+  auto stages = CreateStages(inputs);
+  std::vector<CINNValue> res;
+  for (auto &t : out) {
+    stages->InsertLazily(t);
+    res.push_back(CINNValue(t));
+  }
+  res.push_back(CINNValue(stages));
+  *ret = CINNValuePack{res};
+}
+
+framework::CINNSchedule GetExternCallSchedule(const std::string &op_name) {
+  return framework::CINNSchedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of " << op_name << " schedule is empty! Please check.";
+    CINNValuePack arg_pack = args[0];
+    // the extern call is not scheduled
+    CHECK_EQ(arg_pack.size(), 3UL);
+    *ret = arg_pack;
+  });
+}
+
+}  // namespace
+
+std::vector<ir::Tensor> Quantize(const ir::Tensor &in_tensor, float scale, const std::string &output_name) {
+  CHECK_GT(scale, 0.f) << "The scale of quantize should be positive";
+  float inv_scale = 1.f / scale;
+  return {Compute(
+      in_tensor->shape,
+      [=](const std::vector<Expr> &indice) {
+        ir::Tensor in(in_tensor);
+        auto e = lang::Round(in(indice) * Expr(inv_scale));
+        return ir::Cast::Make(Int(8), ir::Max::Make(ir::Min::Make(e, Expr(127.f)), Expr(-127.f)));
+      },
+      output_name)};
+}
+
+std::vector<ir::Tensor> PackWeightsInt8CPU(const ir::Tensor &weights, bool trans_b, const std::string &output_name) {
+  shape_t weight_shape;
+  for (auto &dim : weights->shape) {
+    weight_shape.push_back(dim.as_int32());
+  }
+  // the weights of conv2d are packed as the transposed matrix of [C_out, C_in * filter_h * filter_w]
+  bool tb = weight_shape.size() == 4U || trans_b;
+  int K, N;
+  std::tie(K, N) = GetPackedWeightsKN(weight_shape, trans_b);
+
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern("cinn_cpu_pack_weights_s8",
+                                {
+                                    Expr(K),                // K
+                                    Expr(N),                // N
+                                    common::make_bool(tb),  // tb
+                                    weights                 // B
+                                });
+      },
+      output_name);
+  auto out = call->TupleGet(0);
+  out->WithBuffer(Int(8));
+  return {out, call};
+}
+
+std::vector<ir::Tensor> GemmInt8CPU(const ir::Tensor &A,
+                                    const ir::Tensor &packed_b,
+                                    const ir::Tensor &bias,
+                                    bool trans_a,
+                                    float a_scale,
+                                    float out_scale,
+                                    const std::string &activation,
+                                    const std::string &output_name) {
+  CHECK_EQ(A->shape.size(), 2U) << "The lhs of the int8 gemm should be a matrix";
+  Expr M = trans_a ? A->shape[1] : A->shape[0];
+  Expr K = trans_a ? A->shape[0] : A->shape[1];
+  Expr N = bias->shape.back();
+
+  // the values of cinn::runtime::cpu::GemmBiasMode and GemmActivation
+  int bias_mode = 1;
+  if (bias->shape.size() == 2U && !is_zero(bias->shape[0] - 1)) {
+    CHECK(is_zero(bias->shape[0] - M)) << "The bias of the int8 gemm should be of the shape [N] or [M, N], but got ["
+                                       << utils::Join(bias->shape, ", ") << "]";
+    bias_mode = 2;
+  }
+  static const std::unordered_map<std::string, int> activations{{"", 0}, {"relu", 1}, {"sigmoid", 2}, {"tanh", 3}};
+  CHECK(activations.count(activation)) << "Unsupported activation " << activation << " of the int8 gemm";
+
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern("cinn_cpu_gemm_s8",
+                                {
+                                    M,                                 // M
+                                    N,                                 // N
+                                    K,                                 // K
+                                    common::make_bool(trans_a),        // ta
+                                    Expr(a_scale),                     // a_scale
+                                    Expr(out_scale),                   // out_scale
+                                    Expr(bias_mode),                   // bias_mode
+                                    Expr(activations.at(activation)),  // activation
+                                    A,                                 // A
+                                    packed_b,                          // packed_b
+                                    bias                               // bias
+                                });
+      },
+      output_name);
+  auto out = call->TupleGet(0);
+  out->WithBuffer(out_scale > 0.f ? Int(8) : Float(32));
+  return {out, call};
+}
+
+std::vector<ir::Tensor> Conv2dInt8CPU(const ir::Tensor &input,
+                                      const ir::Tensor &packed_weights,
+                                      const std::vector<int> &weight_shape,
+                                      const std::vector<int> &padding,
+                                      const std::vector<int> &stride,
+                                      const std::vector<int> &dilation,
+                                      float a_scale,
+                                      float out_scale,
+                                      const std::string &output_name) {
+  CHECK_EQ(input->shape.size(), 4U) << "Input's dimension of the int8 conv2d is not 4! Please check.";
+  CHECK_EQ(weight_shape.size(), 4U) << "Weight's dimension of the int8 conv2d is not 4! Please check.";
+  CHECK(is_zero(input->shape[1] - weight_shape[1])) << "The int8 conv2d only supports a single group";
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern("cinn_cpu_im2col_conv2d_nchw_s8",
+                                {
+                                    Expr(input->shape[0]),  // batch_size
+                                    Expr(input->shape[1]),  // c_in
+                                    Expr(input->shape[2]),  // input_h
+                                    Expr(input->shape[3]),  // input_w
+                                    Expr(weight_shape[0]),  // c_out
+                                    Expr(weight_shape[2]),  // filter_h
+                                    Expr(weight_shape[3]),  // filter_w
+                                    Expr(padding[0]),       // pad_h
+                                    Expr(padding[1]),       // pad_w
+                                    Expr(stride[0]),        // stride_h
+                                    Expr(stride[1]),        // stride_w
+                                    Expr(dilation[0]),      // dilation_h
+                                    Expr(dilation[1]),      // dilation_w
+                                    Expr(a_scale),          // a_scale
+                                    Expr(out_scale),        // out_scale
+                                    input,                  // input
+                                    packed_weights          // packed_weights
+                                });
+      },
+      output_name);
+  auto out = call->TupleGet(0);
+  out->WithBuffer(out_scale > 0.f ? Int(8) : Float(32));
+  return {out, call};
+}
+
+std::shared_ptr<OpStrategy> StrategyForQuantize(const framework::NodeAttr &attrs,
+                                                const std::vector<ir::Tensor> &inputs,
+                                                const std::vector<Type> &out_type,
+                                                const std::vector<std::vector<int>> &output_shapes,
+                                                const Target &target) {
+  CHECK(attrs.attr_store.count("scale")) << "find no attr of scale";
+  float scale = absl::get<float>(attrs.attr_store.at("scale"));
+
+  std::string op_name("quantize");
+
+  framework::CINNCompute quantize_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of " << op_name << " compute is empty! Please check.";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 1U) << "1 input tensor for " << op_name << " compute";
+    std::string tensor_name = UniqName(op_name + "_Out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 2U);
+      tensor_name = pack_args[1].operator std::string();
+    }
+    Expr A_expr = pack_args[0];
+    CHECK(A_expr.as_tensor());
+    ir::Tensor A = A_expr.as_tensor_ref();
+    auto out     = Quantize(A, scale, tensor_name);
+    auto stages  = CreateStages({A});
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule quantize_schedule([=](lang::Args args, lang::RetValue *ret) {
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK(!args.empty()) << "The input argument of " << op_name << " schedule is empty! Please check.";
+      CINNValuePack arg_pack = args[0];
+      Expr ast_expr          = arg_pack[0];
+      std::vector<Expr> vec_ast{ast_expr};
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      if (target.arch == Target::Arch::NVGPU) {
+        pe::IRCudaScheduleInjective(ir_sch, output_shapes.front(), target);
+      } else if (target.arch == Target::Arch::X86) {
+        pe::IRScheduleInjectiveCPU(ir_sch, output_shapes.front(), target);
+      }
+      std::vector<CINNValue> res;
+      res.push_back(arg_pack[0]);
+      *ret = CINNValuePack{res};
+    } else {
+      CHECK(!args.empty()) << "The input argument of " << op_name << " schedule is empty! Please check.";
+      CINNValuePack arg_pack = args[0];
+      CHECK_EQ(arg_pack.size(), 2UL);
+      Expr Out              = arg_pack[0];
+      poly::StageMap stages = arg_pack[1];
+      CHECK(Out.as_tensor());
+      if (target.arch == Target::Arch::NVGPU) {
+        pe::CudaScheduleInjective(stages[Out.as_tensor_ref()], output_shapes.front(), target);
+      } else if (target.arch == Target::Arch::X86) {
+        pe::ScheduleInjectiveCPU(stages[Out.as_tensor_ref()], output_shapes.front(), target);
+      }
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(quantize_compute, quantize_schedule, "strategy.quantize.x86", 1);
+
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForQuantize(const std::vector<shape_t> &inputs_shape,
+                                           const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 1UL);
+  return {inputs_shape[0]};
+}
+
+std::vector<Type> InferDtypeForQuantize(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK(!inputs_type.empty()) << "The input's type size is 0! Please check again.";
+  CHECK(inputs_type[0].is_float(32)) << "Only the float tensors are quantized";
+  return {Int(8)};
+}
+
+std::vector<std::vector<std::string>> InferLayoutForQuantize(const std::vector<framework::shape_t> &input_shapes,
+                                                             const std::vector<std::string> &input_layouts,
+                                                             const framework::NodeAttr &attrs,
+                                                             const Target &target) {
+  CHECK_EQ(input_layouts.size(), 1U) << "The input's layouts size is not 1! Please check again.";
+  // the int8 convolutions read NCHW, and the int8 tensors can't be transformed by layout_transform
+  if (input_shapes[0].size() == 4U || input_layouts[0].size() > 4U) {
+    return {{"NCHW"}, {"NCHW"}};
+  }
+  return {input_layouts, input_layouts};
+}
+
+std::shared_ptr<OpStrategy> StrategyForPackWeightsInt8(const framework::NodeAttr &attrs,
+                                                       const std::vector<ir::Tensor> &inputs,
+                                                       const std::vector<Type> &out_type,
+                                                       const std::vector<std::vector<int>> &output_shapes,
+                                                       const Target &target) {
+  bool trans_b = GetAttr<bool>(attrs.attr_store, "trans_b", false);
+  framework::CINNCompute pack_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(target.arch == Target::Arch::X86) << "The pack_weights_int8 only supports the x86 target.";
+    CHECK(!args.empty()) << "The input argument of pack_weights_int8 compute is empty! Please check.";
+    CINNValuePack pack_args = args[0];
+    CHECK(!pack_args.empty()) << "at least one input tensor for pack_weights_int8 compute";
+    Expr weights = pack_args[0];
+    CHECK(weights.as_tensor());
+    auto out = PackWeightsInt8CPU(weights.as_tensor_ref(), trans_b, UniqName("pack_weights_int8_out"));
+    SetExternCallResult({weights.as_tensor_ref()}, out, ret);
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(pack_compute, GetExternCallSchedule("pack_weights_int8"), "strategy.pack_weights_int8.x86", 1);
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForPackWeightsInt8(const std::vector<shape_t> &inputs_shape,
+                                                  const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 1U) << "pack_weights_int8 should have 1 input shape";
+  int K, N;
+  std::tie(K, N) = GetPackedWeightsKN(inputs_shape[0], GetAttr<bool>(attrs, "trans_b", false));
+  // the bytes of the packed weights, and the tensor of the extern call
+  return {{static_cast<int>(runtime::cpu::PackedWeightsS8Bytes(K, N))}, {1}};
+}
+
+std::vector<Type> InferDtypeForPackWeightsInt8(const std::vector<Type> &inputs_type,
+                                               const framework::AttrMapType &attrs) {
+  CHECK(!inputs_type.empty()) << "The input's type size is 0! Please check again.";
+  CHECK(inputs_type[0].is_float(32)) << "Only the float weights are packed";
+  return {Int(8), Int(8)};
+}
+
+std::vector<std::vector<std::string>> InferLayoutForPackWeightsInt8(const std::vector<framework::shape_t> &input_shapes,
+                                                                    const std::vector<std::string> &input_layouts,
+                                                                    const framework::NodeAttr &attrs,
+                                                                    const Target &target) {
+  CHECK_EQ(input_layouts.size(), 1U) << "The input's layouts size is not 1! Please check again.";
+  return {{"", ""}, input_layouts};
+}
+
+std::shared_ptr<OpStrategy> StrategyForCpuGemmInt8(const framework::NodeAttr &attrs,
+                                                   const std::vector<ir::Tensor> &inputs,
+                                                   const std::vector<Type> &out_type,
+                                                   const std::vector<std::vector<int>> &output_shapes,
+                                                   const Target &target) {
+  bool trans_a           = GetAttr<bool>(attrs.attr_store, "trans_a", false);
+  float a_scale          = GetAttr<float>(attrs.attr_store, "a_scale", 1.f);
+  float out_scale        = GetAttr<float>(attrs.attr_store, "out_scale", 0.f);
+  std::string activation = GetAttr<std::string>(attrs.attr_store, "activation", "");
+  framework::CINNCompute gemm_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(target.arch == Target::Arch::X86) << "The cpu_gemm_int8 only supports the x86 target.";
+    CHECK(!args.empty()) << "The input `args` of cpu_gemm_int8 is empty! Please check.";
+    CINNValuePack input_args = args[0];
+    CHECK_GE(input_args.size(), 3U) << "The input number of cpu_gemm_int8 should be equal to 3.";
+    Expr lhs    = input_args[0];
+    Expr packed = input_args[1];
+    Expr bias   = input_args[2];
+    CHECK(lhs.as_tensor());
+    CHECK(packed.as_tensor());
+    CHECK(bias.as_tensor());
+    auto out = GemmInt8CPU(lhs.as_tensor_ref(),
+                           packed.as_tensor_ref(),
+                           bias.as_tensor_ref(),
+                           trans_a,
+                           a_scale,
+                           out_scale,
+                           activation,
+                           UniqName("cpu_gemm_int8_out"));
+    SetExternCallResult({lhs.as_tensor_ref(), packed.as_tensor_ref(), bias.as_tensor_ref()}, out, ret);
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(gemm_compute, GetExternCallSchedule("cpu_gemm_int8"), "strategy.cpu_gemm_int8.x86", 1);
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForCpuGemmInt8(const std::vector<shape_t> &inputs_shape,
+                                              const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 3U) << "cpu_gemm_int8 should have 3 input shapes";
+  CHECK_EQ(inputs_shape[0].size(), 2U) << "The lhs of cpu_gemm_int8 should be a matrix";
+  bool trans_a = GetAttr<bool>(attrs, "trans_a", false);
+  int m        = trans_a ? inputs_shape[0][1] : inputs_shape[0][0];
+  // the columns are given by the bias
+  int n = inputs_shape[2].back();
+  // the second output is the tensor of the extern call
+  return {{m, n}, {1}};
+}
+
+std::vector<Type> InferDtypeForInt8Output(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK(!inputs_type.empty()) << "The input's type size is 0! Please check again.";
+  CHECK(inputs_type[0].is_int(8)) << "The input of the int8 op should be quantized";
+  // the output is requantized to int8 if out_scale is positive
+  Type out_type = GetAttr<float>(attrs, "out_scale", 0.f) > 0.f ? Int(8) : Float(32);
+  return {out_type, out_type};
+}
+
+std::vector<std::vector<std::string>> InferLayoutForCpuGemmInt8(const std::vector<framework::shape_t> &input_shapes,
+                                                                const std::vector<std::string> &input_layouts,
+                                                                const framework::NodeAttr &attrs,
+                                                                const Target &target) {
+  CHECK_EQ(input_layouts.size(), 3U) << "The input's layouts size is not 3! Please check again.";
+  return {{"", ""}, input_layouts};
+}
+
+std::shared_ptr<OpStrategy> StrategyForCpuConv2dInt8(const framework::NodeAttr &attrs,
+                                                     const std::vector<ir::Tensor> &inputs,
+                                                     const std::vector<Type> &out_type,
+                                                     const std::vector<std::vector<int>> &output_shapes,
+                                                     const Target &target) {
+  CHECK(attrs.attr_store.count("weight_shape")) << "find no attr of weight_shape";
+  std::vector<int> weight_shape = absl::get<std::vector<int>>(attrs.attr_store.at("weight_shape"));
+  std::vector<int> padding      = GetAttr<std::vector<int>>(attrs.attr_store, "padding", {0, 0});
+  std::vector<int> stride       = GetAttr<std::vector<int>>(attrs.attr_store, "stride", {1, 1});
+  std::vector<int> dilation     = GetAttr<std::vector<int>>(attrs.attr_store, "dilation", {1, 1});
+  float a_scale                 = GetAttr<float>(attrs.attr_store, "a_scale", 1.f);
+  float out_scale               = GetAttr<float>(attrs.attr_store, "out_scale", 0.f);
+  framework::CINNCompute conv2d_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(target.arch == Target::Arch::X86) << "The cpu_conv2d_int8 only supports the x86 target.";
+    CHECK(!args.empty()) << "The input argument of cpu_conv2d_int8 compute is empty! Please check.";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 2U) << "at least 2 input tensors for cpu_conv2d_int8 compute";
+    Expr A = pack_args[0];
+    Expr B = pack_args[1];
+    CHECK(A.as_tensor());
+    CHECK(B.as_tensor());
+    CHECK_EQ(padding.size(), 2) << "The size of padding in cpu_conv2d_int8 op is not 2! Please check.";
+    CHECK_EQ(stride.size(), 2) << "The size of stride in cpu_conv2d_int8 op is not 2! Please check.";
+    CHECK_EQ(dilation.size(), 2) << "The size of dilation in cpu_conv2d_int8 op is not 2! Please check.";
+    auto out = Conv2dInt8CPU(A.as_tensor_ref(),
+                             B.as_tensor_ref(),
+                             weight_shape,
+                             padding,
+                             stride,
+                             dilation,
+                             a_scale,
+                             out_scale,
+                             UniqName("cpu_conv2d_int8_out"));
+    SetExternCallResult({A.as_tensor_ref(), B.as_tensor_ref()}, out, ret);
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(conv2d_compute, GetExternCallSchedule("cpu_conv2d_int8"), "strategy.cpu_conv2d_int8.x86", 1);
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForCpuConv2dInt8(const std::vector<shape_t> &inputs_shape,
+                                                const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 2U) << "cpu_conv2d_int8 should have 2 input shapes";
+  CHECK_EQ(inputs_shape[0].size(), 4U) << "The input of cpu_conv2d_int8 should be NCHW";
+  CHECK(attrs.count("weight_shape")) << "find no attr of weight_shape";
+  std::vector<int> weight_shape = absl::get<std::vector<int>>(attrs.at("weight_shape"));
+  std::vector<int> padding      = GetAttr<std::vector<int>>(attrs, "padding", {0, 0});
+  std::vector<int> stride       = GetAttr<std::vector<int>>(attrs, "stride", {1, 1});
+  std::vector<int> dilation     = GetAttr<std::vector<int>>(attrs, "dilation", {1, 1});
+  CHECK_EQ(weight_shape.size(), 4U) << "The weight_shape of cpu_conv2d_int8 should be 4-D";
+  int out_shape_h = (inputs_shape[0][2] - ((weight_shape[2] - 1) * dilation[0] + 1) + 2 * padding[0]) / stride[0] + 1;
+  int out_shape_w = (inputs_shape[0][3] - ((weight_shape[3] - 1) * dilation[1] + 1) + 2 * padding[1]) / stride[1] + 1;
+  // the second output is the tensor of the extern call
+  return {{inputs_shape[0][0], weight_shape[0], out_shape_h, out_shape_w}, {1}};
+}
+
+std::vector<std::vector<std::string>> InferLayoutForCpuConv2dInt8(const std::vector<framework::shape_t> &input_shapes,
+                                                                  const std::vector<std::string> &input_layouts,
+                                                                  const framework::NodeAttr &attrs,
+                                                                  const Target &target) {
+  CHECK_EQ(input_layouts.size(), 2U) << "The input's layouts size is not 2! Please check again.";
+  return {{"NCHW", ""}, {"NCHW", input_layouts[1]}};
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(quantize_ops) {
+  CINN_REGISTER_OP(quantize)
+      .describe("Quantize the float tensor to int8 symmetrically by the attr scale.")
+      .set_num_inputs(1)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForQuantize)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForQuantize))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForQuantize))
+#ifndef CINN_WITH_CUDA
+      .set_attr("inferlayout", MakeOpFunction(cinn::hlir::op::InferLayoutForQuantize))
+#endif
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kElemWise)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(pack_weights_int8)
+      .describe("Quantize the float weights to int8 per output channel and pack them for the int8 kernels on x86.")
+      .set_num_inputs(1)
+      .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForPackWeightsInt8)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForPackWeightsInt8))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForPackWeightsInt8))
+#ifndef CINN_WITH_CUDA
+      .set_attr("inferlayout", MakeOpFunction(cinn::hlir::op::InferLayoutForPackWeightsInt8))
+#endif
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kOpaque)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(cpu_gemm_int8)
+      .describe("Compute the int8 matmul with the int32 accumulation, the fused bias, activation and requantization.")
+      .set_num_inputs(3)
+      .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForCpuGemmInt8)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForCpuGemmInt8))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForInt8Output))
+#ifndef CINN_WITH_CUDA
+      .set_attr("inferlayout", MakeOpFunction(cinn::hlir::op::InferLayoutForCpuGemmInt8))
+#endif
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kOpaque)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(cpu_conv2d_int8)
+      .describe("Do the int8 NCHW convolution by im2col and the int8 gemm of the host runtime on x86.")
+      .set_num_inputs(2)
+      .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForCpuConv2dInt8)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForCpuConv2dInt8))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForInt8Output))
+#ifndef CINN_WITH_CUDA
+      .set_attr("inferlayout", MakeOpFunction(cinn::hlir::op::InferLayoutForCpuConv2dInt8))
+#endif
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kOpaque)
+      .set_support_level(4);
+
+  return true;
+}
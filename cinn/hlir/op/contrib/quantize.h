@@ -0,0 +1,84 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+/**
+ * @brief Quantize the float tensor to int8 symmetrically, round(x / scale) clamped to [-127, 127].
+ */
+std::vector<ir::Tensor> Quantize(const ir::Tensor& in_tensor, float scale, const std::string& output_name);
+
+/**
+ * @brief Quantize the float weights to int8 with a scale per output channel and pack them for the INT8 kernels of the
+ * host runtime on x86.
+ *
+ * @param weights The weights of the shape [K, N], [N, K] if trans_b, or the 4-D weights of conv2d
+ * {C_out, C_in, filter_h, filter_w}, which are packed as [C_out, C_in * filter_h * filter_w].
+ *
+ * @return the packed weights of int8 and the tensor of the extern call
+ */
+std::vector<ir::Tensor> PackWeightsInt8CPU(const ir::Tensor& weights, bool trans_b, const std::string& output_name);
+
+/**
+ * @brief The INT8 matrix multiplication on x86 with the int32 accumulation, out = activation(a_scale * op(A) *
+ * dequant(B) + bias), requantized to int8 by out_scale if it's positive.
+ *
+ * @param A The int8 matrix quantized by a_scale.
+ * @param packed_b The weights packed by PackWeightsInt8CPU.
+ * @param bias The float bias of the shape [N], [1, N] or [M, N], whose last dimension decides N.
+ *
+ * @return the output tensor and the tensor of the extern call
+ */
+std::vector<ir::Tensor> GemmInt8CPU(const ir::Tensor& A,
+                                    const ir::Tensor& packed_b,
+                                    const ir::Tensor& bias,
+                                    bool trans_a,
+                                    float a_scale,
+                                    float out_scale,
+                                    const std::string& activation,
+                                    const std::string& output_name);
+
+/**
+ * @brief The INT8 NCHW convolution of a single group on x86 by im2col and the INT8 GEMM.
+ *
+ * @param input The int8 input {N, C_in, H, W} quantized by a_scale.
+ * @param packed_weights The weights packed by PackWeightsInt8CPU.
+ * @param weight_shape The shape of the weights before packing {C_out, C_in, filter_h, filter_w}.
+ *
+ * @return the output tensor and the tensor of the extern call
+ */
+std::vector<ir::Tensor> Conv2dInt8CPU(const ir::Tensor& input,
+                                      const ir::Tensor& packed_weights,
+                                      const std::vector<int>& weight_shape,
+                                      const std::vector<int>& padding,
+                                      const std::vector<int>& stride,
+                                      const std::vector<int>& dilation,
+                                      float a_scale,
+                                      float out_scale,
+                                      const std::string& output_name);
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,89 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/quantize.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/backends/codegen_c.h"
+#include "cinn/backends/codegen_c_x86.h"
+#include "cinn/common/context.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+TEST(GenerateCode_Cpu, Quantize) {
+  common::Context::Global().ResetNameId();
+
+  common::Target target = common::DefaultHostTarget();
+
+  lang::Placeholder<float> in("in", {4, 16, 32});
+  std::vector<ir::Tensor> res = Quantize(in, 0.05f, "test_quantize");
+  ASSERT_EQ(res.size(), 1U);
+  EXPECT_EQ(res[0]->type(), Int(8));
+
+  poly::StageMap stages = poly::CreateStages({res});
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestGenerateCodeCpu_Quantize", stages, res, {}, {}, nullptr, target, true);
+
+  VLOG(6) << "Expr before CPU codegen:";
+  VLOG(6) << funcs[0]->body;
+
+  ir::Module::Builder builder("Quantize_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  EXPECT_NE(code.find("int8_t"), std::string::npos);
+}
+
+TEST(Quantize, Int8CPUShapes) {
+  lang::Placeholder<float> weights("weights", {16, 8, 3, 3});
+  lang::Placeholder<int8_t> input("input", {2, 8, 14, 14});
+  auto packed = PackWeightsInt8CPU(weights, false, "packed_weights");
+  ASSERT_EQ(packed.size(), 2U);
+  EXPECT_EQ(packed[0]->buffer->dtype, Int(8));
+
+  auto conv = Conv2dInt8CPU(input, packed[0], {16, 8, 3, 3}, {1, 1}, {2, 2}, {1, 1}, 0.1f, 0.f, "conv_out");
+  ASSERT_EQ(conv.size(), 2U);
+  EXPECT_EQ(conv[0]->buffer->dtype, Float(32));
+  ASSERT_EQ(conv[0]->shape.size(), 4U);
+  EXPECT_EQ(conv[0]->shape[1].as_int32(), 16);
+  EXPECT_EQ(conv[0]->shape[2].as_int32(), 7);
+
+  lang::Placeholder<int8_t> lhs("lhs", {5, 72});
+  lang::Placeholder<float> bias("bias", std::vector<int>{16});
+  auto gemm = GemmInt8CPU(lhs, packed[0], bias, false, 0.1f, 0.2f, "relu", "gemm_out");
+  ASSERT_EQ(gemm.size(), 2U);
+  EXPECT_EQ(gemm[0]->buffer->dtype, Int(8));
+  EXPECT_EQ(gemm[0]->shape[0].as_int32(), 5);
+  EXPECT_EQ(gemm[0]->shape[1].as_int32(), 16);
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
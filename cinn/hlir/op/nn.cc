@@ -629,6 +629,11 @@ std::vector<std::vector<std::string>> InferLayoutForConv2d(const std::vector<fra
                                                            const Target &target) {
   CHECK_EQ(input_layouts.size(), 2U) << "The input's layouts size is not 2! Please check again.";
   ir::Layout weight_layout(input_layouts[1]);
+  if (attrs.attr_store.count("use_mkldnn") && absl::get<bool>(attrs.attr_store.at("use_mkldnn"))) {
+    // the conv2d calling MKLDNN is not altered to NCHWc, the altered NCHWxc input is transformed back
+    std::string out_layout = "NCHW";
+    return {{out_layout, out_layout, out_layout, out_layout}, {out_layout, input_layouts[1]}};
+  }
   return {{input_layouts[0], input_layouts[0], input_layouts[0], input_layouts[0]}, input_layouts};
 }
 
@@ -825,6 +830,212 @@ std::vector<Type> InferDtypeForConv2dNCHWc(const std::vector<Type> &inputs_type,
   return res;
 }
 
+std::shared_ptr<OpStrategy> StrategyForWinogradWeightTransform(const framework::NodeAttr &attrs,
+                                                               const std::vector<ir::Tensor> &inputs,
+                                                               const std::vector<Type> &out_type,
+                                                               const std::vector<std::vector<int>> &output_shapes,
+                                                               const Target &target) {
+  int tile_size = 4;
+  if (attrs.attr_store.find("tile_size") != attrs.attr_store.end()) {
+    tile_size = absl::get<int>(attrs.attr_store.at("tile_size"));
+  }
+  framework::CINNCompute transform_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(target.arch == Target::Arch::X86) << "The winograd_weight_transform only supports the x86 target.";
+    CHECK(!args.empty()) << "The input argument of winograd_weight_transform compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK(!pack_args.empty()) << "at least one input tensor for winograd_weight_transform compute\n";
+    Expr weights = pack_args[0];
+    CHECK(weights.as_tensor());
+    auto stages = CreateStages({weights.as_tensor_ref()});
+    auto out    = pe::Conv2dWinogradWeightTransformCPU(
+        weights.as_tensor_ref(), tile_size, UniqName("winograd_weight_transform_out"));
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule transform_schedule([](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of winograd_weight_transform schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    // the extern call is not scheduled
+    CHECK_EQ(arg_pack.size(), 3UL);
+    *ret = arg_pack;
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(transform_compute, transform_schedule, "strategy.winograd_weight_transform.x86", 1);
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForWinogradWeightTransform(const std::vector<shape_t> &inputs_shape,
+                                                          const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 1U) << "winograd_weight_transform should have 1 input shape";
+  CHECK_EQ(inputs_shape[0].size(), 4U) << "The weights of winograd_weight_transform should be 4-D";
+  int tile_size = 4;
+  if (attrs.find("tile_size") != attrs.end()) {
+    tile_size = absl::get<int>(attrs.at("tile_size"));
+  }
+  int alpha = tile_size + inputs_shape[0][2] - 1;
+  // the second output is the tensor of the extern call
+  return {{alpha * alpha, inputs_shape[0][0], inputs_shape[0][1]}, {1}};
+}
+
+std::vector<Type> InferDtypeForWinogradWeightTransform(const std::vector<Type> &inputs_type,
+                                                       const framework::AttrMapType &attrs) {
+  CHECK(!inputs_type.empty()) << "The input's type size is 0! Please check again.";
+  return {inputs_type[0], inputs_type[0]};
+}
+
+std::vector<std::vector<std::string>> InferLayoutForWinogradWeightTransform(
+    const std::vector<framework::shape_t> &input_shapes,
+    const std::vector<std::string> &input_layouts,
+    const framework::NodeAttr &attrs,
+    const Target &target) {
+  CHECK_EQ(input_layouts.size(), 1U) << "The input's layouts size is not 1! Please check again.";
+  return {{"", ""}, input_layouts};
+}
+
+std::shared_ptr<OpStrategy> StrategyForCpuConv2d(const framework::NodeAttr &attrs,
+                                                 const std::vector<ir::Tensor> &inputs,
+                                                 const std::vector<Type> &out_type,
+                                                 const std::vector<std::vector<int>> &output_shapes,
+                                                 const Target &target) {
+  std::vector<int> padding({0, 0});
+  std::vector<int> stride({1, 1});
+  std::vector<int> dilation({1, 1});
+  std::string algo = "im2col";
+  int tile_size    = 4;
+  if (attrs.attr_store.find("padding") != attrs.attr_store.end()) {
+    padding = absl::get<std::vector<int>>(attrs.attr_store.at("padding"));
+  }
+  if (attrs.attr_store.find("stride") != attrs.attr_store.end()) {
+    stride = absl::get<std::vector<int>>(attrs.attr_store.at("stride"));
+  }
+  if (attrs.attr_store.find("dilation") != attrs.attr_store.end()) {
+    dilation = absl::get<std::vector<int>>(attrs.attr_store.at("dilation"));
+  }
+  if (attrs.attr_store.find("algo") != attrs.attr_store.end()) {
+    algo = absl::get<std::string>(attrs.attr_store.at("algo"));
+  }
+  if (attrs.attr_store.find("tile_size") != attrs.attr_store.end()) {
+    tile_size = absl::get<int>(attrs.attr_store.at("tile_size"));
+  }
+  framework::CINNCompute conv2d_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(target.arch == Target::Arch::X86) << "The cpu_conv2d only supports the x86 target.";
+    CHECK(!args.empty()) << "The input argument of cpu_conv2d compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 2U) << "at least 2 input tensors for cpu_conv2d compute\n";
+    Expr A = pack_args[0];
+    Expr B = pack_args[1];
+    CHECK(A.as_tensor());
+    CHECK(B.as_tensor());
+    CHECK_EQ(padding.size(), 2) << "The size of padding in cpu_conv2d op is not 2! Please check.";
+    CHECK_EQ(stride.size(), 2) << "The size of stride in cpu_conv2d op is not 2! Please check.";
+    CHECK_EQ(dilation.size(), 2) << "The size of dilation in cpu_conv2d op is not 2! Please check.";
+    std::vector<ir::Tensor> out;
+    if (algo == "winograd") {
+      CHECK(stride[0] == 1 && stride[1] == 1 && dilation[0] == 1 && dilation[1] == 1)
+          << "The Winograd convolution only supports the stride 1 and the dilation 1";
+      out = pe::Conv2dWinogradCPU(A.as_tensor_ref(),
+                                  B.as_tensor_ref(),
+                                  tile_size,
+                                  padding[0],
+                                  padding[1],
+                                  UniqName("Conv2d_winograd_cpu_out"));
+    } else if (algo == "im2col") {
+      out = pe::Conv2dIm2colCPU(A.as_tensor_ref(),
+                                B.as_tensor_ref(),
+                                padding[0],
+                                padding[1],
+                                stride[0],
+                                stride[1],
+                                dilation[0],
+                                dilation[1],
+                                UniqName("Conv2d_im2col_cpu_out"));
+    } else {
+      LOG(FATAL) << "Unknown algorithm " << algo << " of cpu_conv2d, it should be winograd or im2col";
+    }
+    auto stages = CreateStages({A.as_tensor_ref(), B.as_tensor_ref()});
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule conv2d_schedule([](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of cpu_conv2d schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    // the extern call is not scheduled
+    CHECK_EQ(arg_pack.size(), 3UL);
+    *ret = arg_pack;
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(conv2d_compute, conv2d_schedule, "strategy.cpu_conv2d.x86", 1);
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForCpuConv2d(const std::vector<shape_t> &inputs_shape,
+                                            const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 2U) << "cpu_conv2d should have 2 input shapes";
+  CHECK_EQ(inputs_shape[0].size(), 4U) << "The input of cpu_conv2d should be NCHW";
+  std::vector<int> padding({0, 0});
+  std::vector<int> stride({1, 1});
+  std::vector<int> dilation({1, 1});
+  std::string algo = "im2col";
+  if (attrs.find("padding") != attrs.end()) {
+    padding = absl::get<std::vector<int>>(attrs.at("padding"));
+  }
+  if (attrs.find("stride") != attrs.end()) {
+    stride = absl::get<std::vector<int>>(attrs.at("stride"));
+  }
+  if (attrs.find("dilation") != attrs.end()) {
+    dilation = absl::get<std::vector<int>>(attrs.at("dilation"));
+  }
+  if (attrs.find("algo") != attrs.end()) {
+    algo = absl::get<std::string>(attrs.at("algo"));
+  }
+  int c_out = 0, filter_h = 0, filter_w = 0;
+  if (algo == "winograd") {
+    // the transformed weights: [alpha * alpha, C_out, C_in]
+    CHECK_EQ(inputs_shape[1].size(), 3U) << "The weights of the winograd cpu_conv2d should be transformed";
+    c_out    = inputs_shape[1][1];
+    filter_h = 3;
+    filter_w = 3;
+  } else {
+    // the weights: [C_out, C_in, filter_h, filter_w]
+    CHECK_EQ(inputs_shape[1].size(), 4U) << "The weights of the im2col cpu_conv2d should be 4-D";
+    c_out    = inputs_shape[1][0];
+    filter_h = inputs_shape[1][2];
+    filter_w = inputs_shape[1][3];
+  }
+  int out_shape_h = (inputs_shape[0][2] - ((filter_h - 1) * dilation[0] + 1) + 2 * padding[0]) / stride[0] + 1;
+  int out_shape_w = (inputs_shape[0][3] - ((filter_w - 1) * dilation[1] + 1) + 2 * padding[1]) / stride[1] + 1;
+  // the second output is the tensor of the extern call
+  return {{inputs_shape[0][0], c_out, out_shape_h, out_shape_w}, {1}};
+}
+
+std::vector<Type> InferDtypeForCpuConv2d(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK(!inputs_type.empty()) << "The input's type size is 0! Please check again.";
+  return {inputs_type[0], inputs_type[0]};
+}
+
+std::vector<std::vector<std::string>> InferLayoutForCpuConv2d(const std::vector<framework::shape_t> &input_shapes,
+                                                              const std::vector<std::string> &input_layouts,
+                                                              const framework::NodeAttr &attrs,
+                                                              const Target &target) {
+  CHECK_EQ(input_layouts.size(), 2U) << "The input's layouts size is not 2! Please check again.";
+  // the extern kernels only compute the NCHW input, the altered NCHWxc input is transformed back
+  return {{"NCHW", ""}, {"NCHW", input_layouts[1]}};
+}
+
 std::shared_ptr<OpStrategy> StrategyForDepthwiseConv2d(const framework::NodeAttr &attrs,
                                                        const std::vector<ir::Tensor> &inputs,
                                                        const std::vector<Type> &out_type,
@@ -2266,6 +2477,33 @@ CINN_REGISTER_HELPER(nn_ops) {
 #endif
       .set_support_level(4);
 
+  CINN_REGISTER_OP(winograd_weight_transform)
+      .describe("Transform the 3x3 weights of the Winograd convolution on x86 by the host runtime.")
+      .set_num_inputs(1)
+      .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy",
+                                                         cinn::hlir::op::StrategyForWinogradWeightTransform)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForWinogradWeightTransform))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForWinogradWeightTransform))
+#ifndef CINN_WITH_CUDA
+      .set_attr("inferlayout", MakeOpFunction(cinn::hlir::op::InferLayoutForWinogradWeightTransform))
+#endif
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kOpaque)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(cpu_conv2d)
+      .describe("Do a 2-D NCHW convolution by the Winograd or im2col kernels of the host runtime on x86.")
+      .set_num_inputs(2)  // here we consider filter as another input
+      .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForCpuConv2d)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForCpuConv2d))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForCpuConv2d))
+#ifndef CINN_WITH_CUDA
+      .set_attr("inferlayout", MakeOpFunction(cinn::hlir::op::InferLayoutForCpuConv2d))
+#endif
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kOpaque)
+      .set_support_level(4);
+
   CINN_REGISTER_OP(conv2d_NCHWc)
       .describe("Do a 2-D convolution with an NCHWc layout. Input is 5D tensor and weight is 6D tensor.")
       .set_num_inputs(2)  // here we consider filter as another input
@@ -28,6 +28,7 @@
 #include "cinn/ir/ir_schedule.h"
 
 DECLARE_bool(cinn_ir_schedule);
+DECLARE_bool(cinn_use_cpu_reduce_schedule);
 
 namespace cinn {
 namespace hlir {
@@ -44,22 +45,27 @@ using BlockReduceFunc = std::function<std::vector<ir::Tensor>(
 using ReduceFunc =
     std::function<ir::Tensor(const ir::Tensor &, const std::vector<int> &, const bool, const std::string &)>;
 
-#define STRATEGY_FOR_REDUCE(                                                                                  \
-    op_name_, reduce_op_, gpu_reduce_with_last_axis_func, gpu_reduce_without_last_axis_func, cpu_reduce_func) \
-  std::shared_ptr<OpStrategy> StrategyFor##reduce_op_(const framework::NodeAttr &attrs,                       \
-                                                      const std::vector<ir::Tensor> &inputs,                  \
-                                                      const std::vector<Type> &out_type,                      \
-                                                      const std::vector<std::vector<int>> &output_shapes,     \
-                                                      const Target &target) {                                 \
-    return StrategyForReduce(attrs,                                                                           \
-                             inputs,                                                                          \
-                             out_type,                                                                        \
-                             output_shapes,                                                                   \
-                             target,                                                                          \
-                             #op_name_,                                                                       \
-                             gpu_reduce_with_last_axis_func,                                                  \
-                             gpu_reduce_without_last_axis_func,                                               \
-                             cpu_reduce_func);                                                                \
+#define STRATEGY_FOR_REDUCE(op_name_,                                                                     \
+                            reduce_op_,                                                                   \
+                            gpu_reduce_with_last_axis_func,                                               \
+                            gpu_reduce_without_last_axis_func,                                            \
+                            cpu_reduce_func,                                                              \
+                            cpu_two_step_reduce_func)                                                     \
+  std::shared_ptr<OpStrategy> StrategyFor##reduce_op_(const framework::NodeAttr &attrs,                   \
+                                                      const std::vector<ir::Tensor> &inputs,              \
+                                                      const std::vector<Type> &out_type,                  \
+                                                      const std::vector<std::vector<int>> &output_shapes, \
+                                                      const Target &target) {                             \
+    return StrategyForReduce(attrs,                                                                       \
+                             inputs,                                                                      \
+                             out_type,                                                                    \
+                             output_shapes,                                                               \
+                             target,                                                                      \
+                             #op_name_,                                                                   \
+                             gpu_reduce_with_last_axis_func,                                              \
+                             gpu_reduce_without_last_axis_func,                                           \
+                             cpu_reduce_func,                                                             \
+                             cpu_two_step_reduce_func);                                                   \
   }
 
 std::shared_ptr<OpStrategy> StrategyForReduce(const framework::NodeAttr &attrs,
@@ -70,7 +76,8 @@ std::shared_ptr<OpStrategy> StrategyForReduce(const framework::NodeAttr &attrs,
                                               const std::string &op_name,
                                               BlockReduceFunc gpu_reduce_with_last_axis_func,
                                               BlockReduceFunc gpu_reduce_without_last_axis_func,
-                                              ReduceFunc cpu_reduce_func) {
+                                              ReduceFunc cpu_reduce_func,
+                                              BlockReduceFunc cpu_two_step_reduce_func) {
   std::vector<int> reduce_axes;
   if (attrs.attr_store.count("dim")) {
     reduce_axes = absl::get<std::vector<int>>(attrs.attr_store.at("dim"));
@@ -151,6 +158,17 @@ std::shared_ptr<OpStrategy> StrategyForReduce(const framework::NodeAttr &attrs,
         cinn_values.emplace_back(stages);
         *ret = CINNValuePack{cinn_values};
       }
+    } else if (target.arch == Target::Arch::X86 && FLAGS_cinn_use_cpu_reduce_schedule) {
+      VLOG(3) << "Do CPU Two Step Reduce Compute!";
+      auto res    = cpu_two_step_reduce_func(x, reduce_axes, keep_dim, tensor_name);
+      auto stages = CreateStages(res);
+
+      std::vector<CINNValue> cinn_values;
+      for (auto &t : res) {
+        cinn_values.emplace_back(t);
+      }
+      cinn_values.emplace_back(stages);
+      *ret = CINNValuePack{cinn_values};
     } else {
       VLOG(3) << "Do Reduce Compute!";
       auto out    = cpu_reduce_func(x, reduce_axes, keep_dim, tensor_name);
@@ -301,6 +319,29 @@ std::shared_ptr<OpStrategy> StrategyForReduce(const framework::NodeAttr &attrs,
             LOG(FATAL) << "Unkown Reduce Type!";
           }
         }
+      } else if (target.arch == Target::Arch::X86 && FLAGS_cinn_use_cpu_reduce_schedule) {
+        std::vector<Expr> vec_ast;
+        for (int idx = arg_pack.size() / 2; idx < arg_pack.size(); ++idx) {
+          Expr expr = arg_pack[idx];
+          vec_ast.push_back(expr);
+        }
+        ir::ModuleExpr model_expr(vec_ast);
+        ir::IRSchedule ir_sch(model_expr);
+        ir_sch.MergeExprs();
+
+        Expr out = arg_pack[0];
+        if (arg_pack.size() == 2) {
+          VLOG(3) << "Do IRReduceScheduleCPU Schedule!";
+          pe::IRReduceScheduleCPU(ir_sch, out.as_tensor_ref(), target);
+        } else {
+          CHECK_EQ(arg_pack.size(), 4) << "args is not equal 4!";
+          Expr partial = arg_pack[1];
+          VLOG(3) << "Do IRTwoStepReduceScheduleCPU Schedule!";
+          pe::IRTwoStepReduceScheduleCPU(ir_sch, partial.as_tensor_ref(), out.as_tensor_ref(), target);
+        }
+
+        std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+        *ret = CINNValuePack{res};
       }
     } else {
       CHECK_GE(arg_pack.size(), 2UL);
@@ -360,6 +401,20 @@ std::shared_ptr<OpStrategy> StrategyForReduce(const framework::NodeAttr &attrs,
                                                target);
           }
         }
+      } else if (target.arch == Target::Arch::X86 && FLAGS_cinn_use_cpu_reduce_schedule) {
+        Expr out              = arg_pack[0];
+        poly::StageMap stages = arg_pack.back();
+        if (arg_pack.size() == 2) {
+          VLOG(3) << "Do ReduceScheduleCPU Schedule!";
+          pe::ReduceScheduleCPU(stages, out.as_tensor_ref(), inputs[0]->shape.size() - reduce_axes.back() - 1, target);
+        } else {
+          CHECK_EQ(arg_pack.size(), 3) << "args is not equal 3!";
+          Expr partial = arg_pack[1];
+          VLOG(3) << "Do TwoStepReduceScheduleCPU Schedule!";
+          pe::TwoStepReduceScheduleCPU(stages, partial.as_tensor_ref(), out.as_tensor_ref(), target);
+          // the partial results are a temporary buffer of the function rather than an output
+          arg_pack = CINNValuePack{std::vector<CINNValue>{arg_pack[0], arg_pack.back()}};
+        }
       }
       *ret = arg_pack;
     }
@@ -445,10 +500,30 @@ std::vector<std::vector<std::string>> InferLayoutForBnOptimize(const std::vector
   return {{"", ""}, {"", ""}};
 }
 
-STRATEGY_FOR_REDUCE(reduce_sum, ReduceSum, pe::TwoStepBlockReduceSum, pe::BlockShuffleReduceSum, pe::ReduceSum);
-STRATEGY_FOR_REDUCE(reduce_prod, ReduceProd, pe::TwoStepBlockReduceProd, pe::BlockShuffleReduceProd, pe::ReduceProd);
-STRATEGY_FOR_REDUCE(reduce_max, ReduceMax, pe::TwoStepBlockReduceMax, pe::BlockShuffleReduceMax, pe::ReduceMax);
-STRATEGY_FOR_REDUCE(reduce_min, ReduceMin, pe::TwoStepBlockReduceMin, pe::BlockShuffleReduceMin, pe::ReduceMin);
+STRATEGY_FOR_REDUCE(reduce_sum,
+                    ReduceSum,
+                    pe::TwoStepBlockReduceSum,
+                    pe::BlockShuffleReduceSum,
+                    pe::ReduceSum,
+                    pe::CpuTwoStepReduceSum);
+STRATEGY_FOR_REDUCE(reduce_prod,
+                    ReduceProd,
+                    pe::TwoStepBlockReduceProd,
+                    pe::BlockShuffleReduceProd,
+                    pe::ReduceProd,
+                    pe::CpuTwoStepReduceProd);
+STRATEGY_FOR_REDUCE(reduce_max,
+                    ReduceMax,
+                    pe::TwoStepBlockReduceMax,
+                    pe::BlockShuffleReduceMax,
+                    pe::ReduceMax,
+                    pe::CpuTwoStepReduceMax);
+STRATEGY_FOR_REDUCE(reduce_min,
+                    ReduceMin,
+                    pe::TwoStepBlockReduceMin,
+                    pe::BlockShuffleReduceMin,
+                    pe::ReduceMin,
+                    pe::CpuTwoStepReduceMin);
 
 #undef STRATEGY_FOR_REDUCE
 
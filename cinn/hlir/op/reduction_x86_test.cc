@@ -0,0 +1,214 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/cinn.h"
+#include "cinn/common/target.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/ir/lowered_func.h"
+#include "cinn/lang/lower.h"
+#include "cinn/optim/optimize.h"
+#include "cinn/runtime/cinn_runtime.h"
+#include "cinn/runtime/cpu/use_extern_funcs.h"
+
+DECLARE_bool(cinn_ir_schedule);
+DECLARE_bool(cinn_use_cpu_reduce_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+using common::CINNValue;
+using common::CINNValuePack;
+
+// Lower a reduce op through its strategy with the cpu reduce schedule, as GraphCompiler lowers a node on the poly
+// stages, or as OpLowerer lowers a reduce node with the ir schedule, then run it and check the results with a naive
+// reduction by \p combine from \p initial.
+void TestCpuReduceOp(const std::string &op_name,
+                     std::function<double(double, double)> combine,
+                     double initial,
+                     const std::vector<int> &shape,
+                     const std::vector<int> &dim,
+                     bool keep_dim,
+                     bool ir_schedule) {
+  bool old_ir_schedule               = FLAGS_cinn_ir_schedule;
+  FLAGS_cinn_ir_schedule             = ir_schedule;
+  FLAGS_cinn_use_cpu_reduce_schedule = true;
+
+  auto reduce   = Operator::Get(op_name);
+  auto strategy = Operator::GetAttrs<StrategyFunction>("CINNStrategy");
+  std::vector<Expr> shape_expr;
+  for (int value : shape) {
+    shape_expr.emplace_back(value);
+  }
+  Placeholder<float> X("X", shape_expr);
+
+  NodeAttr attrs;
+  attrs.attr_store["dim"]      = dim;
+  attrs.attr_store["keep_dim"] = keep_dim;
+  std::vector<int> output_shape;
+  for (int idx = 0; idx < shape.size(); ++idx) {
+    if (std::find(dim.begin(), dim.end(), idx) == dim.end()) {
+      output_shape.push_back(shape[idx]);
+    } else if (keep_dim) {
+      output_shape.push_back(1);
+    }
+  }
+  auto target = common::DefaultHostTarget();
+  auto impl   = OpStrategy::SelectImpl(strategy[reduce](attrs, {X.tensor()}, {Float(32)}, {output_shape}, target));
+
+  std::string func_name = "fn_" + op_name;
+  std::vector<ir::Tensor> tensor_args{X.tensor()};
+  ir::Tensor out;
+  ir::LoweredFunc func;
+  if (ir_schedule) {
+    CINNValuePack pack =
+        impl->fcompute(CINNValuePack{{CINNValue(Expr(X.tensor())), CINNValue(std::string(op_name + "_out"))}});
+    poly::StageMap stages = pack.back();
+    std::vector<CINNValue> schedule_inputs;
+    for (int idx = 0; idx < pack.size() - 1; ++idx) {
+      Expr tensor = pack[idx];
+      tensor_args.push_back(tensor.as_tensor_ref());
+      schedule_inputs.push_back(pack[idx]);
+    }
+    out = tensor_args[1];
+    for (auto &f : lang::LowerVec(func_name, stages, tensor_args, {}, {}, nullptr, target, true)) {
+      schedule_inputs.push_back(CINNValue(f->body));
+    }
+    CINNValuePack expr_pack = impl->fschedule(CINNValuePack{schedule_inputs});
+    Expr body               = expr_pack[0];
+    func                    = ir::_LoweredFunc_::Make(
+        func_name, lang::GetArgs(body, {X.tensor()}), body, lang::GetTempBuffers(tensor_args, stages, body));
+    func->PrepareBufferCastExprs();
+    func = optim::Optimize(Expr(func), target, false).as_lowered_func_ref();
+  } else {
+    CINNValuePack pack    = impl->fcompute(CINNValuePack{{CINNValue(X)}});
+    poly::StageMap stages = pack.back();
+    for (int idx = 0; idx < pack.size() - 1; ++idx) {
+      Expr tensor = pack[idx];
+      stages->InsertLazily(tensor.as_tensor_ref());
+    }
+    pack = impl->fschedule(pack);
+    for (int idx = 0; idx < pack.size() - 1; ++idx) {
+      Expr tensor = pack[idx];
+      tensor_args.push_back(tensor.as_tensor_ref());
+    }
+    out  = tensor_args[1];
+    func = lang::LowerVec(func_name, stages, tensor_args, {}, {}, nullptr, target).front();
+  }
+  FLAGS_cinn_ir_schedule             = old_ir_schedule;
+  FLAGS_cinn_use_cpu_reduce_schedule = false;
+  LOG(INFO) << "func:\n" << func;
+
+  Module::Builder builder("module_" + op_name, target);
+  builder.AddFunction(func);
+  auto jit = backends::ExecutionEngine::Create({});
+  jit->Link(builder.Build());
+  auto fn = reinterpret_cast<void (*)(void *, int32_t)>(jit->Lookup(func_name));
+  ASSERT_TRUE(fn);
+
+  // the arguments are bound by the buffers, the partial results may be an output of the function
+  cinn_buffer_t *x_buf   = common::BufferBuilder(Float(32), shape).set_random().Build();
+  cinn_buffer_t *out_buf = nullptr;
+  std::vector<cinn_pod_value_t> args;
+  for (auto &arg : func->args) {
+    ASSERT_TRUE(arg.is_buffer());
+    if (arg.name() == X.tensor()->buffer->name) {
+      args.emplace_back(x_buf);
+      continue;
+    }
+    std::vector<int> buf_shape;
+    for (auto &value : arg.buffer_arg()->shape) {
+      buf_shape.push_back(value.as_int32());
+    }
+    cinn_buffer_t *buf = common::BufferBuilder(Float(32), buf_shape).set_zero().Build();
+    if (arg.name() == out->buffer->name) {
+      out_buf = buf;
+    }
+    args.emplace_back(buf);
+  }
+  ASSERT_TRUE(out_buf);
+  fn(args.data(), args.size());
+
+  int numel = 1;
+  for (int value : shape) {
+    numel *= value;
+  }
+  std::vector<double> expected(out_buf->num_elements(), initial);
+  auto *xd = reinterpret_cast<float *>(x_buf->memory);
+  for (int idx = 0; idx < numel; ++idx) {
+    int out_idx = 0;
+    int remain  = idx;
+    int stride  = numel;
+    for (int axis = 0; axis < shape.size(); ++axis) {
+      stride /= shape[axis];
+      int index = remain / stride;
+      remain %= stride;
+      if (std::find(dim.begin(), dim.end(), axis) == dim.end()) {
+        out_idx = out_idx * shape[axis] + index;
+      }
+    }
+    expected[out_idx] = combine(expected[out_idx], xd[idx]);
+  }
+  auto *od = reinterpret_cast<float *>(out_buf->memory);
+  for (int idx = 0; idx < expected.size(); ++idx) {
+    ASSERT_NEAR(od[idx], expected[idx], 1e-4 * std::abs(expected[idx]) + 1e-4);
+  }
+}
+
+double Sum(double x, double y) { return x + y; }
+double Max(double x, double y) { return std::max(x, y); }
+double Min(double x, double y) { return std::min(x, y); }
+
+TEST(Operator, Operator_Reduction_X86_Sum_LastAxis) {
+  TestCpuReduceOp("reduce_sum", Sum, 0., {32, 1024}, {1}, false, false);
+  TestCpuReduceOp("reduce_sum", Sum, 0., {32, 1024}, {1}, false, true);
+}
+
+TEST(Operator, Operator_Reduction_X86_Sum_Chunks) {
+  TestCpuReduceOp("reduce_sum", Sum, 0., {2, 2048}, {1}, true, false);
+  TestCpuReduceOp("reduce_sum", Sum, 0., {2, 2048}, {1}, true, true);
+}
+
+TEST(Operator, Operator_Reduction_X86_Sum_FirstAxis) {
+  TestCpuReduceOp("reduce_sum", Sum, 0., {64, 128}, {0}, false, false);
+  TestCpuReduceOp("reduce_sum", Sum, 0., {64, 128}, {0}, false, true);
+}
+
+TEST(Operator, Operator_Reduction_X86_Max) {
+  TestCpuReduceOp("reduce_max", Max, -3.402823e+38, {4, 8, 256}, {0, 2}, true, false);
+  TestCpuReduceOp("reduce_max", Max, -3.402823e+38, {4, 8, 256}, {0, 2}, true, true);
+}
+
+TEST(Operator, Operator_Reduction_X86_Min_Chunks) {
+  TestCpuReduceOp("reduce_min", Min, 3.402823e+38, {4096}, {0}, false, false);
+  TestCpuReduceOp("reduce_min", Min, 3.402823e+38, {4096}, {0}, false, true);
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
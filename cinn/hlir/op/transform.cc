@@ -26,6 +26,7 @@
 #include "cinn/utils/string.h"
 
 DECLARE_bool(cinn_ir_schedule);
+DECLARE_bool(cinn_use_cpu_gemm);
 
 namespace cinn {
 namespace hlir {
@@ -178,7 +179,9 @@ std::shared_ptr<OpStrategy> StrategyForMatMul(const framework::NodeAttr &attrs,
     new_A = tensor_A->Reshape(new_shape_A_e, stages);
     new_B = tensor_B->Reshape(new_shape_B_e, stages);
     std::vector<ir::Tensor> out;
-    if (target.arch == Target::Arch::X86) {
+    if (target.arch == Target::Arch::X86 && FLAGS_cinn_use_cpu_gemm) {
+      out = pe::MatmulCPU(new_A, new_B, trans_a, trans_b, alpha, UniqName("MatmulCPU_output"), target);
+    } else if (target.arch == Target::Arch::X86) {
 #ifdef CINN_WITH_MKL_CBLAS
       out = pe::MatmulMKL(new_A, new_B, trans_a, trans_b, alpha, UniqName("MatmulMKL_output"), target);
 #else
@@ -209,6 +212,9 @@ std::shared_ptr<OpStrategy> StrategyForMatMul(const framework::NodeAttr &attrs,
       stages[out.as_tensor_ref()]->Split(1, 2);
       stages[out.as_tensor_ref()]->Bind(0, "blockIdx.x");
       stages[out.as_tensor_ref()]->Bind(1, "threadIdx.x");
+    } else if (target.arch == Target::Arch::X86 && FLAGS_cinn_use_cpu_gemm) {
+      // the extern call of the cpu gemm is not scheduled
+      CHECK_EQ(arg_pack.size(), 3UL);
     } else if (target.arch == Target::Arch::X86) {
 #ifdef CINN_WITH_MKL_CBLAS
       CHECK_EQ(arg_pack.size(), 3UL);
@@ -811,7 +817,9 @@ std::shared_ptr<OpStrategy> StrategyForMul(const framework::NodeAttr &attrs,
     auto new_A = A_tensor->Reshape(new_shape_A, stages);
     auto new_B = B_tensor->Reshape(new_shape_B, stages);
     std::vector<ir::Tensor> out;
-    if (target.arch == Target::Arch::X86) {
+    if (target.arch == Target::Arch::X86 && FLAGS_cinn_use_cpu_gemm) {
+      out = pe::MulCPU(new_A, new_B, UniqName("Mul_cpu_gemm_output"), target);
+    } else if (target.arch == Target::Arch::X86) {
 #ifdef CINN_WITH_MKL_CBLAS
       out = pe::MulMKL(new_A, new_B, UniqName("Mul_mkl_output"), target);
 #else
@@ -843,9 +851,11 @@ std::shared_ptr<OpStrategy> StrategyForMul(const framework::NodeAttr &attrs,
     } else if (target.arch == Target::Arch::X86) {
       CHECK_EQ(arg_pack.size(), 3UL);
 #ifndef CINN_WITH_MKL_CBLAS
-      Expr reduce_first = arg_pack[1];
-      CHECK(reduce_first.as_tensor());
-      pe::MulScheduleCPU(stages, out.as_tensor_ref(), reduce_first.as_tensor_ref(), target);
+      if (!FLAGS_cinn_use_cpu_gemm) {
+        Expr reduce_first = arg_pack[1];
+        CHECK(reduce_first.as_tensor());
+        pe::MulScheduleCPU(stages, out.as_tensor_ref(), reduce_first.as_tensor_ref(), target);
+      }
 #endif
     }
     *ret = arg_pack;
@@ -1016,6 +1026,92 @@ std::vector<Type> InferDtypeForCublasGemm(const std::vector<Type> &inputs_type,
   return {inputs_type[0]};
 }
 
+std::shared_ptr<OpStrategy> StrategyForCpuGemm(const framework::NodeAttr &attrs,
+                                                const std::vector<ir::Tensor> &inputs,
+                                                const std::vector<Type> &out_type,
+                                                const std::vector<std::vector<int>> &output_shapes,
+                                                const Target &target) {
+  framework::CINNCompute gemm_compute([attrs, target](lang::Args args, lang::RetValue *ret) {
+    CHECK(target.arch == Target::Arch::X86) << "The cpu_gemm only supports the x86 target.";
+    CHECK(!args.empty()) << "The input `args` of cpu_gemm is empty! Please check.";
+    CINNValuePack input_args = args[0];
+    CHECK_GE(input_args.size(), 3U) << "The input number of cpu_gemm should be equal to 3.";
+    Expr lhs  = input_args[0];
+    Expr rhs  = input_args[1];
+    Expr bias = input_args[2];
+    CHECK(lhs.as_tensor());
+    CHECK(rhs.as_tensor());
+    CHECK(bias.as_tensor());
+    auto &attr_store = attrs.attr_store;
+    bool trans_a     = false;
+    bool trans_b     = false;
+    float alpha      = 1.f;
+    std::string activation;
+    if (attr_store.count("trans_a")) {
+      trans_a = absl::get<bool>(attr_store.at("trans_a"));
+    }
+    if (attr_store.count("trans_b")) {
+      trans_b = absl::get<bool>(attr_store.at("trans_b"));
+    }
+    if (attr_store.count("alpha")) {
+      alpha = absl::get<float>(attr_store.at("alpha"));
+    }
+    if (attr_store.count("activation")) {
+      activation = absl::get<std::string>(attr_store.at("activation"));
+    }
+
+    auto stages = CreateStages({lhs.as_tensor_ref(), rhs.as_tensor_ref(), bias.as_tensor_ref()});
+
+    auto out = pe::GemmBiasActCPU(lhs.as_tensor_ref(),
+                                  rhs.as_tensor_ref(),
+                                  bias.as_tensor_ref(),
+                                  trans_a,
+                                  trans_b,
+                                  alpha,
+                                  activation,
+                                  UniqName("cpu_gemm_output"),
+                                  target);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule gemm_schedule([](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input `args` of cpu_gemm schedule is empty! Please check.";
+    CINNValuePack arg_pack = args[0];
+    // the extern call of the cpu gemm is not scheduled
+    CHECK_EQ(arg_pack.size(), 3UL);
+    *ret = arg_pack;
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(gemm_compute, gemm_schedule, "strategy.cpu_gemm.x86", 1);
+
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForCpuGemm(const std::vector<std::vector<int>> &input_shapes,
+                                          const framework::AttrMapType &attrs) {
+  CHECK_EQ(input_shapes.size(), 3U) << "cpu_gemm should have 3 input shapes";
+  CHECK_EQ(input_shapes[0].size(), 2U) << "The lhs of cpu_gemm should be a matrix";
+  CHECK_EQ(input_shapes[1].size(), 2U) << "The rhs of cpu_gemm should be a matrix";
+  bool trans_a = attrs.count("trans_a") && absl::get<bool>(attrs.at("trans_a"));
+  bool trans_b = attrs.count("trans_b") && absl::get<bool>(attrs.at("trans_b"));
+  int m        = trans_a ? input_shapes[0][1] : input_shapes[0][0];
+  int n        = trans_b ? input_shapes[1][0] : input_shapes[1][1];
+  // the second output is the tensor of the extern call
+  return {{m, n}, {1}};
+}
+
+std::vector<Type> InferDtypeForCpuGemm(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK(!inputs_type.empty()) << "The input's type size is 0! Please check again.";
+  return {inputs_type[0], inputs_type[0]};
+}
+
 std::shared_ptr<OpStrategy> StrategyForLayoutTransform(const framework::NodeAttr &attrs,
                                                        const std::vector<ir::Tensor> &inputs,
                                                        const std::vector<Type> &out_type,
@@ -2263,6 +2359,16 @@ CINN_REGISTER_HELPER(transform_ops) {
       .set_support_level(4);
 #endif
 
+  CINN_REGISTER_OP(cpu_gemm)
+      .describe("This operator uses the native packed gemm to compute the matmul with the fused bias and activation.")
+      .set_num_inputs(3)
+      .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForCpuGemm)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForCpuGemm))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForCpuGemm))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kOpaque)
+      .set_support_level(4);
+
   CINN_REGISTER_OP(layout_transform)
       .describe("This operator is used to transform op's layouts")
       .set_num_inputs(1)
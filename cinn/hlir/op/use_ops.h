@@ -24,3 +24,4 @@ CINN_USE_REGISTER(elementwise_ops)
 CINN_USE_REGISTER(transform_ops)
 CINN_USE_REGISTER(reduce_ops)
 CINN_USE_REGISTER(clip_ops)
+CINN_USE_REGISTER(quantize_ops)
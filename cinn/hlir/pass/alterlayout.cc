@@ -81,6 +81,12 @@ std::tuple<Node*, NodeData*> InsertLayoutTransformNodeBefore(Graph* graph,
   return std::make_tuple(trans_node, temp_outdata);
 }
 
+// the conv2d selected to call MKLDNN keeps the NCHW layout
+bool UseMKLDNN(const Node* node) {
+  auto iter = node->attrs.attr_store.find("use_mkldnn");
+  return iter != node->attrs.attr_store.end() && absl::get<bool>(iter->second);
+}
+
 std::vector<framework::shape_t> UpdateInferInfos(Node* node,
                                                  const std::vector<framework::shape_t>& input_shapes,
                                                  const std::vector<Type>& input_types,
@@ -175,7 +181,7 @@ void AlterLayoutPass(Graph* graph) {
     for (int i = 0; i < store_nodes.size(); i++) {
       auto node = store_nodes[i]->safe_as<Node>();
       if (node) {
-        if (node->op()->name == "conv2d") {
+        if (node->op()->name == "conv2d" && !UseMKLDNN(node)) {
           CHECK(node->attrs.attr_store.count("data_format")) << node->op()->name << " op has no data_format attr";
           std::string data_format = absl::get<std::string>(node->attrs.attr_store.at("data_format"));
           if (data_format != "NCHW") {
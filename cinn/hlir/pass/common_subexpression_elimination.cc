@@ -0,0 +1,138 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+namespace {
+
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+
+// print an attribute exactly, the floats are printed with enough digits to be distinguished
+struct AttrPrinter {
+  std::ostream& os;
+  void operator()(bool v) { os << "b" << v; }
+  void operator()(float v) { os << "f" << std::setprecision(std::numeric_limits<float>::max_digits10) << v; }
+  void operator()(int v) { os << "i" << v; }
+  void operator()(const std::string& v) { os << "s" << v.size() << ":" << v; }
+  template <typename T>
+  void operator()(const std::vector<T>& v) {
+    os << "[";
+    for (const auto& item : v) {
+      (*this)(static_cast<T>(item));
+      os << ",";
+    }
+    os << "]";
+  }
+};
+
+// The key of a node, the nodes with the same key compute the same outputs
+std::string NodeKey(const Node* node) {
+  std::stringstream ss;
+  ss << node->op()->name << "(";
+  for (auto& link : node->inlinks_in_order(true)) {
+    ss << link->source()->id() << ",";
+  }
+  ss << ")->" << node->outlinks().size() << "{";
+  std::vector<std::string> attr_names;
+  for (auto& attr : node->attrs.attr_store) {
+    attr_names.push_back(attr.first);
+  }
+  std::sort(attr_names.begin(), attr_names.end());
+  for (auto& name : attr_names) {
+    ss << name << "=";
+    absl::visit(AttrPrinter{ss}, node->attrs.attr_store.at(name));
+    ss << ";";
+  }
+  ss << "}";
+  return ss.str();
+}
+
+}  // namespace
+
+/**
+ * Eliminate the op nodes computing the same outputs as an earlier node, which have the same op, attributes
+ * and inputs. The nodes are visited in topological order, so the duplicate chains, such as the repeated
+ * broadcast, reshape and transpose chains of the decomposed graphs, are eliminated entirely. The nodes
+ * producing a kept variable are not eliminated.
+ */
+void CommonSubexpressionEliminationPass(Graph* graph) {
+  auto kept  = GetKeptNodeDatas(*graph);
+  auto nodes = std::get<0>(graph->topological_order());
+  std::unordered_map<std::string, Node*> key2node;
+  // the removed outputs are freed, they are skipped without being accessed
+  std::unordered_set<common::GraphNode*> removed;
+  EliminationStats stats;
+  for (auto* graph_node : nodes) {
+    if (removed.count(graph_node)) continue;
+    auto* node = graph_node->safe_as<Node>();
+    if (!node || !node->op()) continue;
+    auto key = NodeKey(node);
+    auto it  = key2node.find(key);
+    if (it == key2node.end()) {
+      key2node.emplace(std::move(key), node);
+      continue;
+    }
+    auto& outlinks      = node->outlinks_in_order(true);
+    auto& prev_outlinks = it->second->outlinks_in_order(true);
+    bool removable      = outlinks.size() == prev_outlinks.size();
+    for (auto& link : outlinks) {
+      removable &= !kept.count(link->sink()->safe_as<NodeData>());
+    }
+    if (!removable) continue;
+
+    VLOG(4) << "Eliminate " << node->id() << " computing the same outputs as " << it->second->id();
+    for (size_t i = 0; i < outlinks.size(); ++i) {
+      removed.insert(outlinks[i]->sink());
+      ReplaceNodeData(outlinks[i]->sink()->safe_as<NodeData>(), prev_outlinks[i]->sink()->safe_as<NodeData>());
+    }
+    stats.num_bytes += RemoveOpNode(graph, node);
+    stats.num_nodes += 1;
+  }
+  VLOG(3) << "CommonSubexpressionElimination eliminates " << stats.num_nodes << " nodes and " << stats.num_bytes
+          << " bytes of intermediate variables";
+  graph->attrs["cse_stats"] = std::make_shared<absl::any>(stats);
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(CommonSubexpressionElimination) {
+  CINN_REGISTER_PASS(CommonSubexpressionElimination)
+      .describe("This pass eliminates the op nodes with the same op, attributes and inputs as an earlier node.")
+      .set_change_structure(true)
+      .provide_graph_attr("infershape")
+      .provide_graph_attr("inferdtype")
+      .provide_graph_attr("cse_stats")
+      .set_body(cinn::hlir::pass::CommonSubexpressionEliminationPass);
+  return true;
+}
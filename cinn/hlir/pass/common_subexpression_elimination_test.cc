@@ -0,0 +1,114 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+#include "cinn/hlir/pass/use_pass.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+using common::Float;
+using framework::Graph;
+using framework::Node;
+
+int NumOpNodes(Graph* graph) {
+  int num = 0;
+  for (auto* node : graph->nodes()) {
+    num += node->safe_as<Node>() != nullptr;
+  }
+  return num;
+}
+
+TEST(CommonSubexpressionElimination, DuplicateChains) {
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {4, 8}, "A");
+  auto b      = builder.Transpose(a, {1, 0});
+  auto c      = builder.Transpose(a, {1, 0});
+  auto d      = builder.Relu(b);
+  auto e      = builder.Relu(c);
+  auto f      = builder.Add(d, e);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{f->id}, target);
+  EXPECT_EQ(NumOpNodes(graph.get()), 5);
+
+  framework::ApplyPass(graph.get(), "CommonSubexpressionElimination");
+  auto& stats = graph->GetAttrs<EliminationStats>("cse_stats");
+  EXPECT_EQ(stats.num_nodes, 2);
+  EXPECT_EQ(stats.num_bytes, 2 * 4 * 8 * 4);
+  EXPECT_EQ(NumOpNodes(graph.get()), 3);
+
+  auto scope = framework::BuildScope(target, graph);
+  framework::GraphCompiler gc(target, scope, graph);
+  framework::GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto result                        = gc.Build(options, {f->id});
+  auto* a_data                       = scope->GetTensor("A")->mutable_data<float>(target);
+  for (int i = 0; i < 32; ++i) {
+    a_data[i] = i % 5 - 2.f;
+  }
+  result.runtime_program->Execute();
+
+  auto* f_data = scope->GetTensor(f->id)->data<float>();
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_FLOAT_EQ(f_data[i * 4 + j], 2.f * std::max(a_data[j * 8 + i], 0.f));
+    }
+  }
+}
+
+TEST(CommonSubexpressionElimination, KeepFetchedOutputs) {
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {4, 8}, "A");
+  auto b      = builder.Scale(a, 2.f);
+  auto c      = builder.Scale(a, 2.f);
+  auto d      = builder.Scale(a, 3.f);
+  auto e      = builder.Add(b, c);
+  auto f      = builder.Add(e, d);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{c->id, f->id}, target);
+
+  framework::ApplyPass(graph.get(), "CommonSubexpressionElimination");
+  // the fetched c is kept, and d has another scale
+  EXPECT_EQ(graph->GetAttrs<EliminationStats>("cse_stats").num_nodes, 0);
+  EXPECT_EQ(NumOpNodes(graph.get()), 5);
+}
+
+TEST(CommonSubexpressionElimination, KeepAllWithoutFetches) {
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {4, 8}, "A");
+  auto b      = builder.Relu(a);
+  auto c      = builder.Relu(a);
+  auto d      = builder.Add(b, c);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), target);
+
+  framework::ApplyPass(graph.get(), "CommonSubexpressionElimination");
+  // any of the variables may be fetched
+  EXPECT_EQ(graph->GetAttrs<EliminationStats>("cse_stats").num_nodes, 0);
+  EXPECT_EQ(NumOpNodes(graph.get()), 3);
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,145 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+#include "cinn/hlir/pe/conv2d_selector.h"
+
+DECLARE_string(cinn_x86_conv2d_algo);
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+namespace {
+
+using common::GraphNode;
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+using framework::shape_t;
+
+using dtype_dict_t = absl::flat_hash_map<std::string, common::Type>;
+using shape_dict_t = absl::flat_hash_map<std::string, shape_t>;
+
+template <typename T>
+T GetAttr(const Node* node, const std::string& name, T default_value) {
+  auto it = node->attrs.attr_store.find(name);
+  return it == node->attrs.attr_store.end() ? default_value : absl::get<T>(it->second);
+}
+
+}  // namespace
+
+/**
+ * Select the algorithm of every NCHW conv2d on x86 by the cost table of pe::SelectConv2dAlgoX86, limited by
+ * FLAGS_cinn_x86_conv2d_algo. The conv2d selected to run by Winograd or im2col is replaced by a cpu_conv2d node
+ * calling the host runtime, and the weights of the Winograd convolution are transformed by a separate
+ * winograd_weight_transform node, which ConstPropagate marks to pre-run once when the weights are constant. The
+ * conv2d selected to call MKLDNN is marked by the attr use_mkldnn, which AlterLayout keeps in NCHW.
+ */
+void Conv2dAlgoSelectPass(Graph* graph) {
+  if (graph->target_.arch != common::Target::Arch::X86 || FLAGS_cinn_x86_conv2d_algo.empty()) {
+    return;
+  }
+  auto& shape_dict = graph->GetMutableAttrs<shape_dict_t>("infershape");
+  auto& dtype_dict = graph->GetMutableAttrs<dtype_dict_t>("inferdtype");
+  std::unordered_set<const NodeData*> fetched(graph->outputs.begin(), graph->outputs.end());
+  // collect the conv2d first, the rewrite drops the nodes of their outputs from the graph
+  std::vector<Node*> conv2d_nodes;
+  for (auto* graph_node : std::get<0>(graph->topological_order())) {
+    auto* node = graph_node->safe_as<Node>();
+    if (node && node->op() && node->op()->name == "conv2d") {
+      conv2d_nodes.push_back(node);
+    }
+  }
+
+  for (auto* node : conv2d_nodes) {
+    if (GetAttr<std::string>(node, "data_format", "NCHW") != "NCHW" ||
+        GetAttr<std::string>(node, "conv_type", "forward") != "forward") {
+      continue;
+    }
+    auto inlinks = node->inlinks_in_order(true);
+    CHECK_EQ(inlinks.size(), 2U) << "conv2d should have 2 inputs";
+    auto* input   = inlinks[0]->source()->safe_as<NodeData>();
+    auto* weights = inlinks[1]->source()->safe_as<NodeData>();
+    CHECK(input && weights);
+    const auto& input_shape  = shape_dict.at(input->id());
+    const auto& weight_shape = shape_dict.at(weights->id());
+    if (input_shape.size() != 4U || weight_shape.size() != 4U || dtype_dict.at(input->id()) != common::Float(32)) {
+      continue;
+    }
+    // the outputs except the result are the intermediate tensors of the NCHWc compute, which should not be consumed
+    auto outlinks = node->outlinks_in_order(true);
+    auto* output  = outlinks[0]->sink()->safe_as<NodeData>();
+    bool consumed = false;
+    for (int i = 1; i < outlinks.size(); ++i) {
+      auto* extra = outlinks[i]->sink()->safe_as<NodeData>();
+      consumed |= !extra->outlinks().empty() || fetched.count(extra);
+    }
+    if (consumed) continue;
+
+    std::vector<int> padding  = GetAttr<std::vector<int>>(node, "padding", {0, 0});
+    std::vector<int> stride   = GetAttr<std::vector<int>>(node, "stride", {1, 1});
+    std::vector<int> dilation = GetAttr<std::vector<int>>(node, "dilation", {1, 1});
+    int groups                = GetAttr<int>(node, "groups", 1);
+    auto algo                 = pe::SelectConv2dAlgoX86(
+        input_shape, weight_shape, stride, padding, dilation, groups, FLAGS_cinn_x86_conv2d_algo);
+    VLOG(3) << "Select the algorithm " << pe::Conv2dAlgoToString(algo) << " for " << node->id();
+    if (algo == pe::Conv2dAlgo::kNCHWc) {
+      continue;
+    }
+    if (algo == pe::Conv2dAlgo::kMKLDNN) {
+      node->attrs.attr_store["use_mkldnn"] = true;
+      continue;
+    }
+
+    framework::AttrMapType attrs = {{"padding", padding}, {"stride", stride}, {"dilation", dilation}};
+    NodeData* conv_weights       = weights;
+    if (algo == pe::Conv2dAlgo::kIm2col) {
+      attrs["algo"] = std::string("im2col");
+    } else {
+      int tile_size      = algo == pe::Conv2dAlgo::kWinograd2x2 ? 2 : 4;
+      attrs["algo"]      = std::string("winograd");
+      attrs["tile_size"] = tile_size;
+      conv_weights = CreateExternCallNode(graph, "winograd_weight_transform", {weights}, {{"tile_size", tile_size}});
+    }
+    node->UnLinkSingleTo(output);
+    RemoveOpNode(graph, node);
+    CreateExternCallNode(graph, "cpu_conv2d", {input, conv_weights}, attrs, output);
+  }
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(Conv2dAlgoSelect) {
+  CINN_REGISTER_PASS(Conv2dAlgoSelect)
+      .describe(
+          "This pass selects the algorithm of the NCHW conv2d on x86 between Winograd and im2col by the measured cost "
+          "table, or NCHWc and MKLDNN explicitly, controlled by FLAGS_cinn_x86_conv2d_algo.")
+      .set_change_structure(true)
+      .provide_graph_attr("infershape")
+      .provide_graph_attr("inferdtype")
+      .set_body(cinn::hlir::pass::Conv2dAlgoSelectPass);
+  return true;
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+#include "cinn/hlir/pe/conv2d_selector.h"
+
+DECLARE_string(cinn_x86_conv2d_algo);
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+using common::Float;
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+
+std::vector<std::string> GetOpNames(const Graph& graph) {
+  std::vector<std::string> names;
+  for (auto* graph_node : std::get<0>(graph.topological_order())) {
+    auto* node = graph_node->safe_as<Node>();
+    if (node) names.push_back(node->op()->name);
+  }
+  return names;
+}
+
+// Run the conv2d selected by the algorithm and compare it with the direct convolution
+void TestConv2dAlgo(const std::string& algo,
+                    const std::vector<int>& input_shape,
+                    const std::vector<int>& weight_shape,
+                    int stride,
+                    int padding,
+                    const std::vector<std::string>& expected_ops) {
+  FLAGS_cinn_x86_conv2d_algo = algo;
+  frontend::NetBuilder builder("test");
+  auto input   = builder.CreateInput(Float(32), input_shape, "A");
+  auto weights = builder.CreateInput(Float(32), weight_shape, "W");
+  auto out     = builder.Conv2d(input, weights, {stride, stride}, {padding, padding});
+  auto target  = common::DefaultHostTarget();
+  auto graph   = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{out->id}, target);
+
+  framework::ApplyPass(graph.get(), "InferShape");
+  framework::ApplyPass(graph.get(), "Conv2dAlgoSelect");
+  EXPECT_EQ(GetOpNames(*graph), expected_ops);
+  auto* out_node_data = graph->RetrieveNode(out->id)->safe_as<NodeData>();
+  ASSERT_TRUE(out_node_data);
+  EXPECT_EQ(out_node_data->source_node->op()->name, expected_ops.back());
+
+  auto scope = framework::BuildScope(target, graph);
+  framework::GraphCompiler gc(target, scope, graph);
+  framework::GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto result                        = gc.Build(options, {out->id});
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  auto* a_data = scope->GetTensor("A")->mutable_data<float>(target);
+  auto* w_data = scope->GetTensor("W")->mutable_data<float>(target);
+  int a_size   = input_shape[0] * input_shape[1] * input_shape[2] * input_shape[3];
+  int w_size   = weight_shape[0] * weight_shape[1] * weight_shape[2] * weight_shape[3];
+  for (int i = 0; i < a_size; ++i) a_data[i] = dist(rng);
+  for (int i = 0; i < w_size; ++i) w_data[i] = dist(rng);
+  result.runtime_program->Execute();
+
+  int n = input_shape[0], c_in = input_shape[1], h = input_shape[2], w = input_shape[3];
+  int c_out = weight_shape[0], fh = weight_shape[2], fw = weight_shape[3];
+  int oh = (h + 2 * padding - fh) / stride + 1, ow = (w + 2 * padding - fw) / stride + 1;
+  auto* out_data = scope->GetTensor(out->id)->data<float>();
+  for (int b = 0; b < n; ++b) {
+    for (int k = 0; k < c_out; ++k) {
+      for (int oy = 0; oy < oh; ++oy) {
+        for (int ox = 0; ox < ow; ++ox) {
+          double sum = 0;
+          for (int ci = 0; ci < c_in; ++ci) {
+            for (int ky = 0; ky < fh; ++ky) {
+              for (int kx = 0; kx < fw; ++kx) {
+                int y = oy * stride - padding + ky, x = ox * stride - padding + kx;
+                if (y < 0 || y >= h || x < 0 || x >= w) continue;
+                sum += a_data[((b * c_in + ci) * h + y) * w + x] * w_data[((k * c_in + ci) * fh + ky) * fw + kx];
+              }
+            }
+          }
+          ASSERT_NEAR(out_data[((b * c_out + k) * oh + oy) * ow + ox], sum, 1e-3);
+        }
+      }
+    }
+  }
+  FLAGS_cinn_x86_conv2d_algo = "";
+}
+
+TEST(Conv2dAlgoSelect, Winograd) {
+  TestConv2dAlgo("winograd", {1, 16, 14, 14}, {8, 16, 3, 3}, 1, 1, {"winograd_weight_transform", "cpu_conv2d"});
+}
+
+TEST(Conv2dAlgoSelect, Im2col) {
+  TestConv2dAlgo("im2col", {2, 8, 15, 15}, {16, 8, 3, 3}, 2, 1, {"cpu_conv2d"});
+}
+
+TEST(Conv2dAlgoSelect, AutoSelectsMeasured) {
+  // only im2col of the measured algorithms applies to the 1x1 conv2d
+  TestConv2dAlgo("auto", {1, 64, 8, 8}, {16, 64, 1, 1}, 1, 0, {"cpu_conv2d"});
+}
+
+TEST(Conv2dAlgoSelect, KeepNCHWc) {
+  // Winograd doesn't apply to the strided conv2d, which keeps the conv2d op
+  FLAGS_cinn_x86_conv2d_algo = "winograd";
+  frontend::NetBuilder builder("test");
+  auto a     = builder.CreateInput(Float(32), {1, 8, 16, 16}, "A");
+  auto w     = builder.CreateInput(Float(32), {8, 8, 3, 3}, "W");
+  auto c     = builder.Conv2d(a, w, {2, 2}, {1, 1});
+  auto graph = std::make_shared<Graph>(
+      builder.Build(), std::unordered_set<std::string>{c->id}, common::DefaultHostTarget());
+  framework::ApplyPass(graph.get(), "InferShape");
+  framework::ApplyPass(graph.get(), "Conv2dAlgoSelect");
+  EXPECT_EQ(GetOpNames(*graph), std::vector<std::string>{"conv2d"});
+  FLAGS_cinn_x86_conv2d_algo = "";
+}
+
+TEST(Conv2dAlgoSelect, SelectNCHWcExplicitly) {
+  // NCHWc has no measured cost, it is only selected explicitly even if Winograd applies
+  EXPECT_LT(pe::EstimateConv2dCostX86(pe::Conv2dAlgo::kNCHWc, {1, 16, 14, 14}, {8, 16, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1),
+            0);
+  FLAGS_cinn_x86_conv2d_algo = "nchwc";
+  frontend::NetBuilder builder("test");
+  auto a     = builder.CreateInput(Float(32), {1, 16, 14, 14}, "A");
+  auto w     = builder.CreateInput(Float(32), {8, 16, 3, 3}, "W");
+  auto c     = builder.Conv2d(a, w, {1, 1}, {1, 1});
+  auto graph = std::make_shared<Graph>(
+      builder.Build(), std::unordered_set<std::string>{c->id}, common::DefaultHostTarget());
+  framework::ApplyPass(graph.get(), "InferShape");
+  framework::ApplyPass(graph.get(), "Conv2dAlgoSelect");
+  EXPECT_EQ(GetOpNames(*graph), std::vector<std::string>{"conv2d"});
+  FLAGS_cinn_x86_conv2d_algo = "";
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
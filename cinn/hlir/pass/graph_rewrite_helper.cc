@@ -0,0 +1,169 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "cinn/common/context.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/pass/infershape.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+using common::GraphNode;
+using framework::Node;
+using framework::NodeData;
+using framework::shape_t;
+
+void ReplaceNodeData(NodeData* from, NodeData* to) {
+  std::vector<Node*> consumers;
+  for (auto& link : from->outlinks()) {
+    auto* consumer = link->sink()->safe_as<Node>();
+    CHECK(consumer);
+    if (std::find(consumers.begin(), consumers.end(), consumer) == consumers.end()) {
+      consumers.push_back(consumer);
+    }
+  }
+  for (auto* consumer : consumers) {
+    ReplaceInput(consumer, from, to);
+  }
+}
+
+void ReplaceInput(Node* consumer, NodeData* from, NodeData* to) {
+  // unlink and relink all the inputs to keep their order
+  std::vector<GraphNode*> sources;
+  for (auto& link : consumer->inlinks_in_order(true)) {
+    sources.push_back(link->source());
+  }
+  for (auto* source : sources) {
+    source->UnLinkSingleTo(consumer);
+  }
+  for (auto* source : sources) {
+    (source == from ? to : source)->LinkTo(consumer);
+  }
+  consumer->inlinks_in_order(true);
+}
+
+int64_t RemoveOpNode(framework::Graph* graph, Node* node) {
+  auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+  auto& dtype_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  int64_t bytes    = 0;
+  std::vector<GraphNode*> sources;
+  for (auto& link : node->inlinks()) {
+    sources.push_back(link->source());
+  }
+  for (auto* source : sources) {
+    source->UnLinkSingleTo(node);
+  }
+  std::vector<NodeData*> outputs;
+  for (auto& link : node->outlinks()) {
+    outputs.push_back(link->sink()->safe_as<NodeData>());
+  }
+  for (auto* output : outputs) {
+    CHECK(output->outlinks().empty()) << "The output " << output->id() << " of the removed node is still consumed";
+    node->UnLinkSingleTo(output);
+    auto shape_it = shape_dict.find(output->id());
+    auto dtype_it = dtype_dict.find(output->id());
+    if (shape_it != shape_dict.end() && dtype_it != dtype_dict.end()) {
+      int64_t numel = 1;
+      for (int dim : shape_it->second) {
+        numel *= dim;
+      }
+      bytes += (numel * dtype_it->second.bits() + 7) / 8;
+    }
+    if (shape_it != shape_dict.end()) shape_dict.erase(shape_it);
+    if (dtype_it != dtype_dict.end()) dtype_dict.erase(dtype_it);
+    graph->DropNode(output);
+  }
+  graph->DropNode(node);
+  return bytes;
+}
+
+NodeData* CreateOpNode(framework::Graph* graph,
+                       const std::string& op_type,
+                       const std::vector<NodeData*>& inputs,
+                       const framework::AttrMapType& attrs,
+                       NodeData* output) {
+  auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+  auto& dtype_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+
+  auto node              = Node::Create(framework::Operator::Get(op_type), op_type, common::UniqName(op_type));
+  node->attrs.attr_store = attrs;
+  for (auto* input : inputs) {
+    input->LinkTo(node.get());
+  }
+  if (output) {
+    output->source_node  = node;
+    output->output_index = 0;
+  } else {
+    output = new NodeData(node, 0, 0, common::UniqName(node->id() + "_out"));
+    graph->RegisterNode(output->id(), output);
+  }
+  node->LinkTo(output);
+  graph->RegisterNode(node->id(), node.get());
+
+  InferShape(node.get(), dtype_dict, shape_dict);
+  return output;
+}
+
+NodeData* CreateExternCallNode(framework::Graph* graph,
+                               const std::string& op_type,
+                               const std::vector<NodeData*>& inputs,
+                               const framework::AttrMapType& attrs,
+                               NodeData* output) {
+  auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+  auto& dtype_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+
+  auto node              = Node::Create(framework::Operator::Get(op_type), op_type, common::UniqName(op_type));
+  node->attrs.attr_store = attrs;
+  for (auto* input : inputs) {
+    input->LinkTo(node.get());
+  }
+  if (output) {
+    output->source_node  = node;
+    output->output_index = 0;
+  } else {
+    output = new NodeData(node, 0, 0, common::UniqName(node->id() + "_out"));
+    graph->RegisterNode(output->id(), output);
+  }
+  node->LinkTo(output);
+  auto* call = new NodeData(node, 1, 0, common::UniqName(node->id() + "_call"));
+  node->LinkTo(call);
+  graph->RegisterNode(call->id(), call);
+  graph->RegisterNode(node->id(), node.get());
+
+  InferShape(node.get(), dtype_dict, shape_dict);
+  return output;
+}
+
+std::unordered_set<const NodeData*> GetKeptNodeDatas(const framework::Graph& graph) {
+  std::unordered_set<const NodeData*> kept(graph.outputs.begin(), graph.outputs.end());
+  if (!kept.empty()) return kept;
+  // any variable may be fetched from the scope after the graph runs
+  for (auto* graph_node : graph.nodes()) {
+    if (auto* node_data = graph_node->safe_as<NodeData>()) {
+      kept.insert(node_data);
+    }
+  }
+  return kept;
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
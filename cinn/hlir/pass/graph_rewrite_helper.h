@@ -0,0 +1,68 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/node.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+// The nodes and the bytes of the intermediate variables eliminated by a graph pass, which is set as the graph
+// attribute named by the pass, such as "cse_stats"
+struct EliminationStats {
+  int num_nodes{0};
+  int64_t num_bytes{0};
+};
+
+// Let the consumers of \p from read \p to instead, the order of their inputs is kept
+void ReplaceNodeData(framework::NodeData* from, framework::NodeData* to);
+
+// Let \p consumer read \p to instead of \p from, the order of its inputs is kept
+void ReplaceInput(framework::Node* consumer, framework::NodeData* from, framework::NodeData* to);
+
+// Remove an op node and its outputs from the graph and the shape and dtype dicts, returns the bytes of the
+// removed outputs. The outputs should not be consumed.
+int64_t RemoveOpNode(framework::Graph* graph, framework::Node* node);
+
+// Create a node of the op of a single output reading the inputs, and infer the shape and the dtype of its output. The
+// output is \p output if it's given, or a new variable otherwise.
+framework::NodeData* CreateOpNode(framework::Graph* graph,
+                                  const std::string& op_type,
+                                  const std::vector<framework::NodeData*>& inputs,
+                                  const framework::AttrMapType& attrs,
+                                  framework::NodeData* output = nullptr);
+
+// Create a node of the extern call op reading the inputs, whose outputs are the result and the tensor of the call, and
+// infer their shapes and dtypes. The result is \p output if it's given, or a new variable otherwise.
+framework::NodeData* CreateExternCallNode(framework::Graph* graph,
+                                          const std::string& op_type,
+                                          const std::vector<framework::NodeData*>& inputs,
+                                          const framework::AttrMapType& attrs,
+                                          framework::NodeData* output = nullptr);
+
+// Return the variables the graph can't eliminate, which are the fetched outputs of the graph, or all the
+// variables if the fetched outputs are unknown
+std::unordered_set<const framework::NodeData*> GetKeptNodeDatas(const framework::Graph& graph);
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
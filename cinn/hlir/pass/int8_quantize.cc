@@ -0,0 +1,336 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/pass/int8_quantize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/context.h"
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+#include "cinn/hlir/pass/infershape.h"
+#include "cinn/utils/string.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+namespace {
+
+using common::GraphNode;
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+using framework::shape_t;
+
+using dtype_dict_t = absl::flat_hash_map<std::string, common::Type>;
+using shape_dict_t = absl::flat_hash_map<std::string, shape_t>;
+
+template <typename T>
+T GetAttr(const Node* node, const std::string& name, T default_value) {
+  auto it = node->attrs.attr_store.find(name);
+  return it == node->attrs.attr_store.end() ? default_value : absl::get<T>(it->second);
+}
+
+// The float ops Int8Quantize rewrites into the int8 ops, whose first input is the quantized activation.
+bool IsQuantizableOp(const Node* node) {
+  return node && node->op() &&
+         (node->op()->name == "conv2d" || node->op()->name == "matmul" || node->op()->name == "cpu_gemm");
+}
+
+// Whether the outputs except the result are consumed, they are the intermediate tensors like the packed B of matmul.
+bool HasConsumedExtraOutputs(Node* node, const std::unordered_set<const NodeData*>& fetched) {
+  auto outlinks = node->outlinks_in_order(true);
+  for (int i = 1; i < outlinks.size(); ++i) {
+    auto* extra = outlinks[i]->sink()->safe_as<NodeData>();
+    if (!extra->outlinks().empty() || fetched.count(extra)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Fold the quantize node reading the float output of the int8 op into the op, which requantizes the output in its
+// epilogue. The quantized variable becomes the output of the op, so its consumers are kept.
+bool FoldRequantize(Graph* graph, Node* node, const std::unordered_set<const NodeData*>& fetched) {
+  auto& shape_dict = graph->GetMutableAttrs<shape_dict_t>("infershape");
+  auto& dtype_dict = graph->GetMutableAttrs<dtype_dict_t>("inferdtype");
+  auto outlinks    = node->outlinks_in_order(true);
+  CHECK_EQ(outlinks.size(), 2U) << "The int8 op " << node->id() << " should have the output and the call";
+  auto* output = outlinks[0]->sink()->safe_as<NodeData>();
+  auto* call   = outlinks[1]->sink()->safe_as<NodeData>();
+  if (fetched.count(output) || output->outlinks().size() != 1U) {
+    return false;
+  }
+  auto* quantize = (*output->outlinks().begin())->sink()->safe_as<Node>();
+  if (!quantize || quantize->op()->name != "quantize") {
+    return false;
+  }
+  auto* quantized = quantize->outlinks_in_order(true)[0]->sink()->safe_as<NodeData>();
+  float out_scale = GetAttr<float>(quantize, "scale", 0.f);
+  VLOG(3) << "Fold the requantization of " << output->id() << " into " << node->id();
+
+  // relink the outputs in order, the quantized variable replaces the float output
+  node->UnLinkSingleTo(output);
+  node->UnLinkSingleTo(call);
+  quantize->UnLinkSingleTo(quantized);
+  RemoveOpNode(graph, quantize);
+  shape_dict.erase(output->id());
+  dtype_dict.erase(output->id());
+  graph->DropNode(output);
+
+  quantized->source_node  = node;
+  quantized->output_index = 0;
+  node->LinkTo(quantized);
+  node->LinkTo(call);
+  node->outlinks_in_order(true);
+  node->attrs.attr_store["out_scale"] = out_scale;
+  InferShape(node, dtype_dict, shape_dict);
+  return true;
+}
+
+}  // namespace
+
+/**
+ * Rewrite the float conv2d, matmul and cpu_gemm on x86 into the int8 ops by the activation scales of the graph attr
+ * "quant_scales", which are collected by the calibration of the frontend. The input of an op with a scale is
+ * quantized by a quantize node, and its weights are quantized per output channel and packed by a pack_weights_int8
+ * node, which ConstPropagate marks to pre-run once when the weights are constant. The op is replaced by
+ * cpu_conv2d_int8 or cpu_gemm_int8, which accumulate in int32 and dequantize the products in the epilogue. At last,
+ * the quantize node consuming the output of an int8 op is folded into the op, which requantizes its output directly.
+ */
+void Int8QuantizePass(Graph* graph) {
+  if (graph->target_.arch != common::Target::Arch::X86 || !graph->HasAttr("quant_scales")) {
+    return;
+  }
+  const auto& scales = graph->GetAttrs<quant_scales_t>("quant_scales");
+  auto& shape_dict   = graph->GetMutableAttrs<shape_dict_t>("infershape");
+  auto& dtype_dict   = graph->GetMutableAttrs<dtype_dict_t>("inferdtype");
+  std::unordered_set<const NodeData*> fetched(graph->outputs.begin(), graph->outputs.end());
+
+  // collect the ops first, the rewrite drops the nodes of their outputs from the graph
+  std::vector<Node*> candidates;
+  for (auto* graph_node : std::get<0>(graph->topological_order())) {
+    auto* node = graph_node->safe_as<Node>();
+    if (IsQuantizableOp(node)) {
+      candidates.push_back(node);
+    }
+  }
+
+  // the quantized variables are shared by their int8 consumers
+  absl::flat_hash_map<NodeData*, NodeData*> quantized;
+  auto quantize = [&](NodeData* input, float scale) {
+    auto it = quantized.find(input);
+    if (it == quantized.end()) {
+      it = quantized.emplace(input, CreateOpNode(graph, "quantize", {input}, {{"scale", scale}})).first;
+    }
+    return it->second;
+  };
+
+  std::vector<Node*> int8_nodes;
+  for (auto* node : candidates) {
+    const std::string op_name = node->op()->name;
+    auto inlinks              = node->inlinks_in_order(true);
+    auto* input               = inlinks[0]->source()->safe_as<NodeData>();
+    auto* weights             = inlinks[1]->source()->safe_as<NodeData>();
+    CHECK(input && weights);
+    auto scale_it = scales.find(input->id());
+    if (scale_it == scales.end() || scale_it->second <= 0.f || dtype_dict.at(input->id()) != common::Float(32) ||
+        dtype_dict.at(weights->id()) != common::Float(32) || HasConsumedExtraOutputs(node, fetched)) {
+      continue;
+    }
+    const auto& input_shape  = shape_dict.at(input->id());
+    const auto& weight_shape = shape_dict.at(weights->id());
+    float a_scale            = scale_it->second;
+
+    std::string op_type;
+    framework::AttrMapType attrs;
+    std::vector<NodeData*> int8_inputs;
+    if (op_name == "conv2d") {
+      if (GetAttr<std::string>(node, "data_format", "NCHW") != "NCHW" ||
+          GetAttr<std::string>(node, "conv_type", "forward") != "forward" || GetAttr<int>(node, "groups", 1) != 1 ||
+          input_shape.size() != 4U || weight_shape.size() != 4U) {
+        continue;
+      }
+      op_type               = "cpu_conv2d_int8";
+      attrs["padding"]      = GetAttr<std::vector<int>>(node, "padding", {0, 0});
+      attrs["stride"]       = GetAttr<std::vector<int>>(node, "stride", {1, 1});
+      attrs["dilation"]     = GetAttr<std::vector<int>>(node, "dilation", {1, 1});
+      attrs["weight_shape"] = std::vector<int>(weight_shape.begin(), weight_shape.end());
+      attrs["a_scale"]      = a_scale;
+      int8_inputs = {quantize(input, a_scale), CreateExternCallNode(graph, "pack_weights_int8", {weights}, {})};
+    } else {
+      if (input_shape.size() != 2U || weight_shape.size() != 2U) {
+        continue;
+      }
+      bool trans_b = GetAttr<bool>(node, "trans_b", false);
+      NodeData* bias;
+      if (op_name == "cpu_gemm") {
+        bias = inlinks[2]->source()->safe_as<NodeData>();
+        if (dtype_dict.at(bias->id()) != common::Float(32)) continue;
+      } else {
+        // the int8 gemm always adds a bias, which is zero for matmul
+        framework::AttrMapType zeros;
+        zeros["shape"]     = std::vector<int>{trans_b ? weight_shape[0] : weight_shape[1]};
+        zeros["value"]     = 0.f;
+        zeros["force_cpu"] = false;
+        zeros["dtype"]     = std::string("float32");
+        bias               = CreateOpNode(graph, "fill_constant", {}, zeros);
+      }
+      op_type             = "cpu_gemm_int8";
+      attrs["trans_a"]    = GetAttr<bool>(node, "trans_a", false);
+      attrs["activation"] = GetAttr<std::string>(node, "activation", "");
+      // alpha scales the products, which is folded into the scale of the input
+      attrs["a_scale"] = a_scale * GetAttr<float>(node, "alpha", 1.f);
+      int8_inputs      = {quantize(input, a_scale),
+                     CreateExternCallNode(graph, "pack_weights_int8", {weights}, {{"trans_b", trans_b}}),
+                     bias};
+    }
+    VLOG(3) << "Rewrite " << node->id() << " into " << op_type << " with the input scale " << a_scale;
+    auto* output = node->outlinks_in_order(true)[0]->sink()->safe_as<NodeData>();
+    node->UnLinkSingleTo(output);
+    RemoveOpNode(graph, node);
+    CreateExternCallNode(graph, op_type, int8_inputs, attrs, output);
+    int8_nodes.push_back(output->source_node.get());
+  }
+
+  for (auto* node : int8_nodes) {
+    FoldRequantize(graph, node, fetched);
+  }
+}
+
+Int8Calibrator::Int8Calibrator(const common::Target& target, const std::shared_ptr<Graph>& graph) : target_(target) {
+  CHECK(target_.arch == common::Target::Arch::X86) << "The calibration of the int8 quantization runs on x86";
+  if (!graph->HasAttr("infershape")) {
+    framework::ApplyPass(graph.get(), "InferShape");
+  }
+  const auto& dtype_dict = graph->GetAttrs<dtype_dict_t>("inferdtype");
+  std::unordered_set<std::string> calibrated;
+  std::unordered_set<std::string> fetch_ids;
+  for (auto* output : graph->outputs) {
+    fetch_ids.insert(output->id());
+  }
+  for (auto* graph_node : std::get<0>(graph->topological_order())) {
+    auto* node = graph_node->safe_as<Node>();
+    if (!IsQuantizableOp(node)) continue;
+    auto* input = node->inlinks_in_order(true)[0]->source()->safe_as<NodeData>();
+    if (dtype_dict.at(input->id()) == common::Float(32) && calibrated.insert(input->id()).second) {
+      activations_.push_back(input->id());
+      fetch_ids.insert(input->id());
+    }
+  }
+  VLOG(3) << "Calibrate the activations " << utils::Join(activations_, ", ");
+
+  // the calibrated activations are fetched, so they are kept alive after the execution
+  scope_ = framework::BuildScope(target_, graph);
+  framework::GraphCompiler gc(target_, scope_, graph);
+  framework::GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  program_                           = gc.Build(options, std::move(fetch_ids)).runtime_program;
+}
+
+void Int8Calibrator::Collect(const FeedFunction& feed) {
+  feed(scope_.get());
+  program_->Execute();
+  for (auto& id : activations_) {
+    auto tensor       = scope_->GetTensor(id);
+    const float* data = tensor->data<float>();
+    int64_t numel     = tensor->shape().numel();
+    float& abs_max    = abs_max_[id];
+    for (int64_t i = 0; i < numel; ++i) {
+      abs_max = std::max(abs_max, std::abs(data[i]));
+    }
+  }
+  ++num_batches_;
+}
+
+quant_scales_t Int8Calibrator::GetScales() const {
+  CHECK_GT(num_batches_, 0) << "No batch is calibrated";
+  quant_scales_t scales;
+  for (auto& item : abs_max_) {
+    // the activations of all zeros have no range and are kept in float
+    if (item.second > 0.f) {
+      scales[item.first] = item.second / 127.f;
+    }
+  }
+  return scales;
+}
+
+std::string Int8QuantizeReport::DebugString() const {
+  std::stringstream ss;
+  ss << "The int8 quantization of " << output << ": " << accuracy.DebugString() << ", float " << float_ms
+     << " ms, int8 " << int8_ms << " ms, speedup " << speedup();
+  return ss.str();
+}
+
+Int8QuantizeReport CompareInt8Quantize(const common::Target& target,
+                                       const std::shared_ptr<Graph>& float_graph,
+                                       const std::shared_ptr<Graph>& int8_graph,
+                                       const FeedFunction& feed,
+                                       const std::string& output,
+                                       int repeat) {
+  CHECK_GT(repeat, 0) << "The repeat of the comparison should be positive";
+  // compile and run the graph on the batch, return the scope and the average time of an execution
+  auto run = [&](const std::shared_ptr<Graph>& graph, double* ms) {
+    auto scope = framework::BuildScope(target, graph);
+    framework::GraphCompiler gc(target, scope, graph);
+    framework::GraphCompiler::CompileOptions options;
+    options.with_instantiate_variables = true;
+    auto program                       = gc.Build(options, {output}).runtime_program;
+    feed(scope.get());
+    // the first execution warms up, and pre-runs the packing of the constant weights
+    program->Execute();
+    utils::Timer timer;
+    timer.Start();
+    for (int i = 0; i < repeat; ++i) {
+      program->Execute();
+    }
+    *ms = timer.Stop() / repeat;
+    return scope;
+  };
+
+  Int8QuantizeReport report;
+  report.output    = output;
+  auto float_scope = run(float_graph, &report.float_ms);
+  auto int8_scope  = run(int8_graph, &report.int8_ms);
+  framework::AccuracyChecker checker(target, int8_scope.get());
+  report.accuracy = checker.Compare(output, float_scope->GetTensor(output));
+  VLOG(1) << report.DebugString();
+  return report;
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(Int8Quantize) {
+  CINN_REGISTER_PASS(Int8Quantize)
+      .describe(
+          "This pass rewrites the float conv2d and matmul on x86 into the int8 ops by the calibrated activation scales "
+          "of the graph attr quant_scales, and folds the requantization into the int8 ops.")
+      .set_change_structure(true)
+      .provide_graph_attr("infershape")
+      .provide_graph_attr("inferdtype")
+      .set_body(cinn::hlir::pass::Int8QuantizePass);
+  return true;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/hlir/framework/accuracy_checker.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/scope.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+// The graph attr "quant_scales" read by the pass Int8Quantize, which maps the ids of the float activations to their
+// symmetric int8 scales, abs_max / 127. The activations without a scale are kept in float.
+using quant_scales_t = absl::flat_hash_map<std::string, float>;
+
+// Write the inputs of a sample batch into the scope of a compiled graph.
+using FeedFunction = std::function<void(framework::Scope*)>;
+
+/**
+ * Int8Calibrator collects the ranges of the float activations the pass Int8Quantize quantizes, which are the inputs
+ * of conv2d, matmul and cpu_gemm, by running the float graph over the sample batches. The graph is compiled by the
+ * calibrator with the activations fetched, so it should be a copy of the graph to quantize, built from the same
+ * program so the ids of the variables match.
+ */
+class Int8Calibrator {
+ public:
+  Int8Calibrator(const common::Target& target, const std::shared_ptr<framework::Graph>& graph);
+
+  // Run the graph on the batch written by feed and update the ranges of the activations.
+  void Collect(const FeedFunction& feed);
+
+  // The scales of the activations per tensor, to be set as the graph attr quant_scales.
+  quant_scales_t GetScales() const;
+
+  int num_batches() const { return num_batches_; }
+
+ private:
+  common::Target target_;
+  std::shared_ptr<framework::Scope> scope_;
+  std::unique_ptr<framework::Program> program_;
+  // the ids of the calibrated activations
+  std::vector<std::string> activations_;
+  absl::flat_hash_map<std::string, float> abs_max_;
+  int num_batches_{0};
+};
+
+// The accuracy and the speed of the quantized graph compared with the float one.
+struct Int8QuantizeReport {
+  std::string output;
+  framework::AccuracyStats accuracy;
+  // the average time of an execution in milliseconds
+  double float_ms{0.0};
+  double int8_ms{0.0};
+
+  double speedup() const { return int8_ms > 0.0 ? float_ms / int8_ms : 0.0; }
+  std::string DebugString() const;
+};
+
+/**
+ * Compile the float graph and the graph rewritten by Int8Quantize, run them on the same batch written by feed, and
+ * report the difference of the float output by AccuracyChecker with the execution time averaged over repeat runs.
+ */
+Int8QuantizeReport CompareInt8Quantize(const common::Target& target,
+                                       const std::shared_ptr<framework::Graph>& float_graph,
+                                       const std::shared_ptr<framework::Graph>& int8_graph,
+                                       const FeedFunction& feed,
+                                       const std::string& output,
+                                       int repeat = 10);
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
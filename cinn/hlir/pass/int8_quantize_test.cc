@@ -0,0 +1,157 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/pass/int8_quantize.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+using common::Float;
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+
+std::map<std::string, int> CountOps(const Graph& graph) {
+  std::map<std::string, int> counts;
+  for (auto* graph_node : std::get<0>(graph.topological_order())) {
+    auto* node = graph_node->safe_as<Node>();
+    if (node) ++counts[node->op()->name];
+  }
+  return counts;
+}
+
+// Write the random values of the seed into the float inputs
+FeedFunction RandomFeed(const std::vector<std::string>& inputs, int seed) {
+  return [=](framework::Scope* scope) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (auto& name : inputs) {
+      auto tensor = scope->GetTensor(name);
+      auto* data  = tensor->mutable_data<float>(common::DefaultHostTarget());
+      for (int i = 0; i < tensor->shape().numel(); ++i) data[i] = dist(rng);
+    }
+  };
+}
+
+TEST(Int8Quantize, Conv2dRequantize) {
+  frontend::NetBuilder builder("test");
+  auto a       = builder.CreateInput(Float(32), {2, 8, 12, 12}, "A");
+  auto w1      = builder.CreateInput(Float(32), {16, 8, 3, 3}, "W1");
+  auto w2      = builder.CreateInput(Float(32), {8, 16, 1, 1}, "W2");
+  auto c1      = builder.Conv2d(a, w1, {1, 1}, {1, 1});
+  auto c2      = builder.Conv2d(c1, w2);
+  auto program = builder.Build();
+  auto target  = common::DefaultHostTarget();
+
+  auto make_graph = [&]() {
+    auto graph = std::make_shared<Graph>(program, std::unordered_set<std::string>{c2->id}, target);
+    framework::ApplyPass(graph.get(), "InferShape");
+    return graph;
+  };
+
+  Int8Calibrator calibrator(target, make_graph());
+  for (int seed = 0; seed < 3; ++seed) {
+    calibrator.Collect(RandomFeed({"A", "W1", "W2"}, seed));
+  }
+  auto scales = calibrator.GetScales();
+  ASSERT_TRUE(scales.count("A"));
+  ASSERT_TRUE(scales.count(c1->id));
+  EXPECT_LE(scales.at("A"), 1.f / 127.f);
+
+  auto float_graph = make_graph();
+  auto int8_graph  = make_graph();
+
+  int8_graph->attrs["quant_scales"] = std::make_shared<absl::any>(scales);
+  framework::ApplyPass(int8_graph.get(), "Int8Quantize");
+  // the quantization of the output of the first conv2d is folded into it
+  auto counts = CountOps(*int8_graph);
+  EXPECT_EQ(counts["cpu_conv2d_int8"], 2);
+  EXPECT_EQ(counts["pack_weights_int8"], 2);
+  EXPECT_EQ(counts["quantize"], 1);
+  EXPECT_EQ(counts["conv2d"], 0);
+  auto& dtype_dict = int8_graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  EXPECT_EQ(dtype_dict.at(c1->id), common::Int(8));
+  EXPECT_EQ(dtype_dict.at(c2->id), Float(32));
+
+  auto report = CompareInt8Quantize(target, float_graph, int8_graph, RandomFeed({"A", "W1", "W2"}, 0), c2->id, 2);
+  LOG(INFO) << report.DebugString();
+  EXPECT_EQ(report.accuracy.result, framework::kOK);
+  EXPECT_GT(report.accuracy.cosine_similarity, 0.99);
+}
+
+TEST(Int8Quantize, Matmul) {
+  frontend::NetBuilder builder("test");
+  auto x       = builder.CreateInput(Float(32), {16, 64}, "X");
+  auto y       = builder.CreateInput(Float(32), {64, 24}, "Y");
+  auto out     = builder.Matmul(x, y);
+  auto program = builder.Build();
+  auto target  = common::DefaultHostTarget();
+
+  auto make_graph = [&]() {
+    auto graph = std::make_shared<Graph>(program, std::unordered_set<std::string>{out->id}, target);
+    framework::ApplyPass(graph.get(), "InferShape");
+    return graph;
+  };
+
+  Int8Calibrator calibrator(target, make_graph());
+  calibrator.Collect(RandomFeed({"X", "Y"}, 0));
+
+  auto float_graph = make_graph();
+  auto int8_graph  = make_graph();
+
+  int8_graph->attrs["quant_scales"] = std::make_shared<absl::any>(calibrator.GetScales());
+  framework::ApplyPass(int8_graph.get(), "Int8Quantize");
+  auto counts = CountOps(*int8_graph);
+  EXPECT_EQ(counts["cpu_gemm_int8"], 1);
+  EXPECT_EQ(counts["matmul"], 0);
+  auto* out_node_data = int8_graph->RetrieveNode(out->id)->safe_as<NodeData>();
+  ASSERT_TRUE(out_node_data);
+  EXPECT_EQ(out_node_data->source_node->op()->name, "cpu_gemm_int8");
+
+  auto report = CompareInt8Quantize(target, float_graph, int8_graph, RandomFeed({"X", "Y"}, 0), out->id, 2);
+  LOG(INFO) << report.DebugString();
+  EXPECT_GT(report.accuracy.cosine_similarity, 0.99);
+  EXPECT_LT(report.accuracy.max_abs_diff, 0.5);
+}
+
+TEST(Int8Quantize, KeepWithoutScales) {
+  frontend::NetBuilder builder("test");
+  auto x     = builder.CreateInput(Float(32), {4, 8}, "X");
+  auto y     = builder.CreateInput(Float(32), {8, 4}, "Y");
+  auto out   = builder.Matmul(x, y);
+  auto graph = std::make_shared<Graph>(
+      builder.Build(), std::unordered_set<std::string>{out->id}, common::DefaultHostTarget());
+  framework::ApplyPass(graph.get(), "InferShape");
+  graph->attrs["quant_scales"] = std::make_shared<absl::any>(quant_scales_t{});
+  framework::ApplyPass(graph.get(), "Int8Quantize");
+  EXPECT_EQ(CountOps(*graph)["matmul"], 1);
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
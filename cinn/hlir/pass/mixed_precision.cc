@@ -0,0 +1,168 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/context.h"
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+#include "cinn/hlir/pass/infershape.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+namespace {
+
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+using framework::OpPatternKind;
+using framework::shape_t;
+
+using dtype_dict_t = absl::flat_hash_map<std::string, common::Type>;
+using shape_dict_t = absl::flat_hash_map<std::string, shape_t>;
+
+// Whether the op keeps its output in float32, which are the reductions, the ops like matmul, conv2d and softmax, and
+// the elementwise ops whose results lose much precision in 16 bits.
+bool KeepsFloat32(const Node* node) {
+  static const std::unordered_set<std::string> sensitive_ops = {"exp", "log", "log2", "log10"};
+  static auto& op_pattern_dict = framework::Operator::GetAttrs<OpPatternKind>("OpPattern");
+  if (sensitive_ops.count(node->op()->name) || !op_pattern_dict.Find(node->op())) {
+    return true;
+  }
+  auto pattern = op_pattern_dict[node->op()];
+  return pattern != framework::kElemWise && pattern != framework::kBroadcast && pattern != framework::kInjective;
+}
+
+// Let the op write a new float32 variable, which is cast to \p output of the 16-bit float type, so the consumers and
+// the fetch of the output are kept.
+void CastOutput(Graph* graph, Node* node, NodeData* output, const common::Type& type) {
+  auto& shape_dict = graph->GetMutableAttrs<shape_dict_t>("infershape");
+  auto& dtype_dict = graph->GetMutableAttrs<dtype_dict_t>("inferdtype");
+
+  auto source = output->source_node;
+  node->UnLinkSingleTo(output);
+  auto* float_output = new NodeData(source, 0, 0, common::UniqName(output->id() + "_fp32"));
+  node->LinkTo(float_output);
+  graph->RegisterNode(float_output->id(), float_output);
+  shape_dict[float_output->id()] = shape_dict.at(output->id());
+  dtype_dict[float_output->id()] = dtype_dict.at(output->id());
+  CreateOpNode(graph, "cast", {float_output}, {{"dtype", common::Type2Str(type)}}, output);
+}
+
+}  // namespace
+
+/**
+ * Compute the ops reading the float16 or bfloat16 variables in float32 on x86, where the 16-bit floats are the storage
+ * types only. Every 16-bit float input of an op is cast to float32 by a cast node shared by its consumers, so the
+ * reductions and the gemm accumulate in float32. The output of an elementwise, broadcast or injective op is cast back
+ * to its 16-bit type to keep the bytes of the tensors halved, while the reductions, the ops like matmul, conv2d and
+ * softmax, the sensitive ops like exp and the ops of several outputs keep their outputs in float32. The consumers of
+ * the outputs kept in float32 are inferred again in the topological order, so the dtypes in the graph always match
+ * the kernels. The fetched single outputs are always cast back, so the dtypes of the graph outputs are unchanged. The
+ * casts are fused into the kernels by the fusion passes.
+ */
+void MixedPrecisionPass(Graph* graph) {
+  if (graph->target_.arch != common::Target::Arch::X86) {
+    return;
+  }
+  auto& dtype_dict = graph->GetMutableAttrs<dtype_dict_t>("inferdtype");
+  if (std::none_of(dtype_dict.begin(), dtype_dict.end(), [](auto& item) { return item.second.is_float(16); })) {
+    return;
+  }
+  std::unordered_set<const NodeData*> fetched(graph->outputs.begin(), graph->outputs.end());
+  // collect the ops first, the rewrite adds the cast nodes to the graph
+  std::vector<Node*> nodes;
+  for (auto* graph_node : std::get<0>(graph->topological_order())) {
+    auto* node = graph_node->safe_as<Node>();
+    // a cast converts the 16-bit floats itself
+    if (node && node->op() && node->op()->name != "cast") {
+      nodes.push_back(node);
+    }
+  }
+
+  // the float32 variables cast from the 16-bit float variables
+  absl::flat_hash_map<NodeData*, NodeData*> casted;
+  // the outputs of the 16-bit float types which are kept in float32, the kernels of their consumers compute in
+  // float32 too, so the consumers are inferred again even if they read no 16-bit float
+  std::unordered_set<const NodeData*> promoted;
+  for (auto* node : nodes) {
+    // collect the inputs first, the replacement relinks the inputs of the node
+    std::vector<NodeData*> low_precision_inputs;
+    bool reads_promoted = false;
+    for (auto& link : node->inlinks_in_order(true)) {
+      auto* input = link->source()->safe_as<NodeData>();
+      if (input && dtype_dict.at(input->id()).is_float(16)) {
+        low_precision_inputs.push_back(input);
+      }
+      reads_promoted |= promoted.count(input) > 0;
+    }
+    if (low_precision_inputs.empty() && !reads_promoted) continue;
+    for (auto* input : low_precision_inputs) {
+      auto it = casted.find(input);
+      if (it == casted.end()) {
+        it = casted.emplace(input, CreateOpNode(graph, "cast", {input}, {{"dtype", std::string("float32")}})).first;
+      }
+      ReplaceInput(node, input, it->second);
+    }
+
+    std::vector<std::pair<NodeData*, common::Type>> outputs;
+    for (auto& link : node->outlinks_in_order(true)) {
+      auto* output = link->sink()->safe_as<NodeData>();
+      outputs.emplace_back(output, dtype_dict.at(output->id()));
+    }
+    // the outputs of the float32 inputs are inferred to float32
+    InferShape(node, dtype_dict, graph->GetMutableAttrs<shape_dict_t>("infershape"));
+    if (outputs.size() == 1U) {
+      auto* output     = outputs[0].first;
+      const auto& type = outputs[0].second;
+      if (type.is_float(16) && dtype_dict.at(output->id()) == common::Float(32) &&
+          (!KeepsFloat32(node) || fetched.count(output))) {
+        VLOG(3) << "Cast the output of " << node->id() << " back to " << type;
+        CastOutput(graph, node, output, type);
+        continue;
+      }
+    }
+    for (auto& output : outputs) {
+      if (dtype_dict.at(output.first->id()) != output.second) {
+        VLOG(3) << "Keep the output " << output.first->id() << " of " << node->id() << " in float32";
+        promoted.insert(output.first);
+      }
+    }
+  }
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(MixedPrecision) {
+  CINN_REGISTER_PASS(MixedPrecision)
+      .describe(
+          "This pass computes the ops reading the float16 or bfloat16 variables in float32 on x86 by inserting the "
+          "cast nodes, and keeps the numerically sensitive ops in float32.")
+      .set_change_structure(true)
+      .provide_graph_attr("infershape")
+      .provide_graph_attr("inferdtype")
+      .set_body(cinn::hlir::pass::MixedPrecisionPass);
+  return true;
+}
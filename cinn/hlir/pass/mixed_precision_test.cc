@@ -0,0 +1,222 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+using common::bfloat16;
+using common::float16;
+using framework::Graph;
+using framework::Node;
+
+std::map<std::string, int> CountOps(const Graph& graph) {
+  std::map<std::string, int> counts;
+  for (auto* graph_node : std::get<0>(graph.topological_order())) {
+    auto* node = graph_node->safe_as<Node>();
+    if (node) ++counts[node->op()->name];
+  }
+  return counts;
+}
+
+// Write the random values of the seed into the 16-bit float input, and return the values it stores
+template <typename T>
+std::vector<float> Feed(framework::Scope* scope, const std::string& name, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  auto tensor = scope->GetTensor(name);
+  auto* data  = tensor->mutable_data<T>(common::DefaultHostTarget());
+  std::vector<float> values(tensor->shape().numel());
+  for (int i = 0; i < values.size(); ++i) {
+    data[i]   = T(dist(rng));
+    values[i] = static_cast<float>(data[i]);
+  }
+  return values;
+}
+
+std::unique_ptr<framework::Program> Compile(const std::shared_ptr<Graph>& graph,
+                                            const std::shared_ptr<framework::Scope>& scope,
+                                            const std::string& output) {
+  framework::ApplyPass(graph.get(), "OpFusion");
+  framework::GraphCompiler gc(common::DefaultHostTarget(), scope, graph);
+  framework::GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  return gc.Build(options, {output}).runtime_program;
+}
+
+TEST(MixedPrecision, BFloat16ElementwiseReduce) {
+  frontend::NetBuilder builder("test");
+  auto x      = builder.CreateInput(common::BF16(), {16, 64}, "X");
+  auto y      = builder.CreateInput(common::BF16(), {16, 64}, "Y");
+  auto z      = builder.Add(x, y);
+  auto out    = builder.ReduceSum(z, {1});
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{out->id}, target);
+
+  framework::ApplyPass(graph.get(), "MixedPrecision");
+  // X and Y are cast to float32, the sum is cast back and to float32 again, and the fetched reduction is cast back
+  EXPECT_EQ(CountOps(*graph)["cast"], 5);
+  auto& dtype_dict = graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  EXPECT_EQ(dtype_dict.at(z->id), common::BF16());
+  EXPECT_EQ(dtype_dict.at(out->id), common::BF16());
+
+  auto scope   = framework::BuildScope(target, graph);
+  auto program = Compile(graph, scope, out->id);
+  auto x_data  = Feed<bfloat16>(scope.get(), "X", 0);
+  auto y_data  = Feed<bfloat16>(scope.get(), "Y", 1);
+  program->Execute();
+
+  auto tensor = scope->GetTensor(out->id);
+  ASSERT_EQ(tensor->type(), common::BF16());
+  const auto* result = tensor->data<bfloat16>();
+  for (int i = 0; i < 16; ++i) {
+    // the sums are stored in bfloat16 and accumulated in float32
+    float expected = 0.f;
+    for (int j = 0; j < 64; ++j) {
+      expected += static_cast<float>(bfloat16(x_data[i * 64 + j] + y_data[i * 64 + j]));
+    }
+    EXPECT_NEAR(static_cast<float>(result[i]), expected, std::abs(expected) / 128.f + 1e-3f);
+  }
+}
+
+TEST(MixedPrecision, Float16Matmul) {
+  frontend::NetBuilder builder("test");
+  auto x      = builder.CreateInput(common::F16(), {8, 32}, "X");
+  auto w      = builder.CreateInput(common::F16(), {32, 16}, "W");
+  auto out    = builder.Matmul(x, w);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{out->id}, target);
+
+  framework::ApplyPass(graph.get(), "MixedPrecision");
+  EXPECT_EQ(CountOps(*graph)["cast"], 3);
+
+  auto scope   = framework::BuildScope(target, graph);
+  auto program = Compile(graph, scope, out->id);
+  auto x_data  = Feed<float16>(scope.get(), "X", 0);
+  auto w_data  = Feed<float16>(scope.get(), "W", 1);
+  program->Execute();
+
+  auto tensor = scope->GetTensor(out->id);
+  ASSERT_EQ(tensor->type(), common::F16());
+  const auto* result = tensor->data<float16>();
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 16; ++j) {
+      float expected = 0.f;
+      for (int k = 0; k < 32; ++k) {
+        expected += x_data[i * 32 + k] * w_data[k * 16 + j];
+      }
+      EXPECT_NEAR(static_cast<float>(result[i * 16 + j]), expected, std::abs(expected) / 1024.f + 1e-3f);
+    }
+  }
+}
+
+TEST(MixedPrecision, Float16MatmulRelu) {
+  frontend::NetBuilder builder("test");
+  auto x      = builder.CreateInput(common::F16(), {8, 32}, "X");
+  auto w      = builder.CreateInput(common::F16(), {32, 16}, "W");
+  auto y      = builder.Matmul(x, w);
+  auto out    = builder.Relu(y);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{out->id}, target);
+
+  framework::ApplyPass(graph.get(), "MixedPrecision");
+  // the matmul keeps its output in float32, the relu reading it computes in float32 and is cast back
+  EXPECT_EQ(CountOps(*graph)["cast"], 3);
+  auto& dtype_dict = graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  EXPECT_EQ(dtype_dict.at(y->id), common::Float(32));
+  EXPECT_EQ(dtype_dict.at(out->id), common::F16());
+
+  auto scope   = framework::BuildScope(target, graph);
+  auto program = Compile(graph, scope, out->id);
+  auto x_data  = Feed<float16>(scope.get(), "X", 0);
+  auto w_data  = Feed<float16>(scope.get(), "W", 1);
+  program->Execute();
+
+  auto tensor = scope->GetTensor(out->id);
+  ASSERT_EQ(tensor->type(), common::F16());
+  const auto* result = tensor->data<float16>();
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 16; ++j) {
+      float expected = 0.f;
+      for (int k = 0; k < 32; ++k) {
+        expected += x_data[i * 32 + k] * w_data[k * 16 + j];
+      }
+      expected = std::max(expected, 0.f);
+      EXPECT_NEAR(static_cast<float>(result[i * 16 + j]), expected, std::abs(expected) / 1024.f + 1e-3f);
+    }
+  }
+}
+
+TEST(MixedPrecision, Float16ReduceScale) {
+  frontend::NetBuilder builder("test");
+  auto x      = builder.CreateInput(common::F16(), {16, 64}, "X");
+  auto y      = builder.ReduceSum(x, {1});
+  auto out    = builder.Scale(y, 0.5f, 1.f);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{out->id}, target);
+
+  framework::ApplyPass(graph.get(), "MixedPrecision");
+  // the reduction keeps its output in float32, the scale reading it computes in float32 and is cast back
+  EXPECT_EQ(CountOps(*graph)["cast"], 2);
+  auto& dtype_dict = graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  EXPECT_EQ(dtype_dict.at(y->id), common::Float(32));
+  EXPECT_EQ(dtype_dict.at(out->id), common::F16());
+
+  auto scope   = framework::BuildScope(target, graph);
+  auto program = Compile(graph, scope, out->id);
+  auto x_data  = Feed<float16>(scope.get(), "X", 0);
+  program->Execute();
+
+  auto tensor = scope->GetTensor(out->id);
+  ASSERT_EQ(tensor->type(), common::F16());
+  const auto* result = tensor->data<float16>();
+  for (int i = 0; i < 16; ++i) {
+    float expected = 0.f;
+    for (int j = 0; j < 64; ++j) {
+      expected += x_data[i * 64 + j];
+    }
+    expected = 0.5f * expected + 1.f;
+    EXPECT_NEAR(static_cast<float>(result[i]), expected, std::abs(expected) / 1024.f + 1e-3f);
+  }
+}
+
+TEST(MixedPrecision, KeepFloat32) {
+  frontend::NetBuilder builder("test");
+  auto x     = builder.CreateInput(common::Float(32), {4, 8}, "X");
+  auto out   = builder.ReduceSum(builder.Relu(x), {1});
+  auto graph = std::make_shared<Graph>(
+      builder.Build(), std::unordered_set<std::string>{out->id}, common::DefaultHostTarget());
+  framework::ApplyPass(graph.get(), "MixedPrecision");
+  EXPECT_EQ(CountOps(*graph)["cast"], 0);
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,249 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/context.h"
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+namespace {
+
+using common::GraphNode;
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+using framework::shape_t;
+
+using dtype_dict_t = absl::flat_hash_map<std::string, common::Type>;
+using shape_dict_t = absl::flat_hash_map<std::string, shape_t>;
+
+// the ops keeping a uniform input uniform, and their value on the uniform inputs
+const std::unordered_map<std::string, std::function<double(double)>>& UnaryFuncs() {
+  static const std::unordered_map<std::string, std::function<double(double)>> funcs = {
+      {"identity", [](double x) { return x; }},
+      {"broadcast_to", [](double x) { return x; }},
+      {"reshape", [](double x) { return x; }},
+      {"transpose", [](double x) { return x; }},
+      {"negative", [](double x) { return -x; }},
+      {"abs", [](double x) { return std::abs(x); }},
+      {"relu", [](double x) { return x > 0 ? x : 0.; }},
+      {"sign", [](double x) { return static_cast<double>((x > 0) - (x < 0)); }},
+      {"exp", [](double x) { return std::exp(x); }},
+      {"log", [](double x) { return std::log(x); }},
+      {"sqrt", [](double x) { return std::sqrt(x); }},
+      {"rsqrt", [](double x) { return 1. / std::sqrt(x); }},
+      {"tanh", [](double x) { return std::tanh(x); }},
+      {"sigmoid", [](double x) { return 1. / (1. + std::exp(-x)); }},
+      {"floor", [](double x) { return std::floor(x); }},
+      {"ceil", [](double x) { return std::ceil(x); }},
+      {"round", [](double x) { return std::round(x); }},
+      {"trunc", [](double x) { return std::trunc(x); }},
+  };
+  return funcs;
+}
+
+const std::unordered_map<std::string, std::function<double(double, double)>>& BinaryFuncs() {
+  static const std::unordered_map<std::string, std::function<double(double, double)>> funcs = {
+      {"elementwise_add", [](double x, double y) { return x + y; }},
+      {"substract", [](double x, double y) { return x - y; }},
+      {"elementwise_mul", [](double x, double y) { return x * y; }},
+      {"divide", [](double x, double y) { return x / y; }},
+      {"max", [](double x, double y) { return std::max(x, y); }},
+      {"min", [](double x, double y) { return std::min(x, y); }},
+      {"power", [](double x, double y) { return std::pow(x, y); }},
+  };
+  return funcs;
+}
+
+bool IsFoldableType(const common::Type& type) {
+  return type == common::Float(32) || type == common::Int(32) || type == common::Int(64);
+}
+
+// round a value to the precision of the type, returns false if it can't be represented by the value attribute
+bool CastToType(const common::Type& type, double* value) {
+  if (!std::isfinite(*value)) return false;
+  if (type.is_float()) {
+    *value = static_cast<float>(*value);
+    return true;
+  }
+  *value = std::trunc(*value);
+  return *value >= std::numeric_limits<int>::min() && *value <= std::numeric_limits<int>::max();
+}
+
+double GetScalarValue(const framework::AttrType& attr) {
+  if (absl::holds_alternative<float>(attr)) return absl::get<float>(attr);
+  if (absl::holds_alternative<int>(attr)) return absl::get<int>(attr);
+  CHECK(absl::holds_alternative<bool>(attr)) << "The value of fill_constant should be a scalar";
+  return absl::get<bool>(attr);
+}
+
+template <typename T>
+T GetAttr(const Node* node, const std::string& name, T default_value) {
+  auto it = node->attrs.attr_store.find(name);
+  return it == node->attrs.attr_store.end() ? default_value : absl::get<T>(it->second);
+}
+
+// Evaluate the uniform value of the output of a node, whose inputs are all uniform, returns false if the node
+// can't be folded
+bool EvaluateNode(const Node* node, const std::vector<double>& inputs, const common::Type& type, double* value) {
+  const auto& name = node->op()->name;
+  if (name == "scale") {
+    if (inputs.size() != 1) return false;
+    double scale          = GetAttr<float>(node, "scale", 1.f);
+    double bias           = GetAttr<float>(node, "bias", 0.f);
+    bool bias_after_scale = GetAttr<bool>(node, "bias_after_scale", true);
+    *value                = bias_after_scale ? scale * inputs[0] + bias : scale * (inputs[0] + bias);
+  } else if (UnaryFuncs().count(name)) {
+    if (inputs.size() != 1) return false;
+    *value = UnaryFuncs().at(name)(inputs[0]);
+  } else if (BinaryFuncs().count(name)) {
+    if (inputs.size() != 2) return false;
+    // the integer division truncates, and the division by zero is left to the kernel
+    if (name == "divide" && !type.is_float()) {
+      if (inputs[1] == 0) return false;
+      *value = std::trunc(inputs[0] / inputs[1]);
+    } else {
+      *value = BinaryFuncs().at(name)(inputs[0], inputs[1]);
+    }
+  } else {
+    return false;
+  }
+  return CastToType(type, value);
+}
+
+// Replace the producer of \p node_data by a fill_constant node of the value
+Node* ReplaceByFillConstant(Graph* graph, Node* node, NodeData* node_data, double value) {
+  auto& shape_dict = graph->GetMutableAttrs<shape_dict_t>("infershape");
+  auto& dtype_dict = graph->GetMutableAttrs<dtype_dict_t>("inferdtype");
+  auto& type       = dtype_dict.at(node_data->id());
+
+  auto fill_constant = Node::Create(framework::Operator::Get("fill_constant"), "fill_constant",
+                                    common::UniqName("fill_constant"));
+  fill_constant->attrs.attr_store["shape"] = shape_dict.at(node_data->id());
+  if (type.is_float()) {
+    fill_constant->attrs.attr_store["value"] = static_cast<float>(value);
+  } else {
+    fill_constant->attrs.attr_store["value"] = static_cast<int>(value);
+  }
+  fill_constant->attrs.attr_store["dtype"]     = common::Type2Str(type);
+  fill_constant->attrs.attr_store["force_cpu"] = false;
+
+  std::vector<GraphNode*> sources;
+  for (auto& link : node->inlinks()) {
+    sources.push_back(link->source());
+  }
+  for (auto* source : sources) {
+    source->UnLinkSingleTo(node);
+  }
+  node->UnLinkSingleTo(node_data);
+  fill_constant->LinkTo(node_data);
+  node_data->source_node  = fill_constant;
+  node_data->output_index = 0;
+  graph->RegisterNode(fill_constant->id(), fill_constant.get());
+  graph->DropNode(node);
+  return fill_constant.get();
+}
+
+}  // namespace
+
+/**
+ * Fold the nodes computed only from uniform constants into fill_constant nodes. The outputs of fill_constant are
+ * uniform, and the elementwise, broadcast and layout ops keep them uniform, so the folded value is evaluated
+ * on the host once instead of generating a kernel for every node. The nodes producing non-uniform values, such as
+ * the reductions and concat, are left to the kernels. The fill_constant nodes only consumed by
+ * the folded nodes are removed then.
+ */
+void UniformConstantFoldingPass(Graph* graph) {
+  auto& dtype_dict = graph->GetMutableAttrs<dtype_dict_t>("inferdtype");
+  auto kept        = GetKeptNodeDatas(*graph);
+  auto nodes       = std::get<0>(graph->topological_order());
+
+  std::unordered_map<const NodeData*, double> values;
+  std::unordered_set<Node*> fill_constants;
+  EliminationStats stats;
+  for (auto* graph_node : nodes) {
+    auto* node = graph_node->safe_as<Node>();
+    if (!node || !node->op()) continue;
+    auto& outlinks = node->outlinks_in_order(true);
+    if (outlinks.size() != 1) continue;
+    auto* output = outlinks[0]->sink()->safe_as<NodeData>();
+    if (!dtype_dict.count(output->id()) || !IsFoldableType(dtype_dict.at(output->id()))) continue;
+
+    if (node->op()->name == "fill_constant") {
+      if (node->inlinks().empty()) {
+        values[output] = GetScalarValue(node->attrs.attr_store.at("value"));
+        fill_constants.insert(node);
+      }
+      continue;
+    }
+
+    std::vector<double> inputs;
+    for (auto& link : node->inlinks_in_order(true)) {
+      auto* input = link->source()->safe_as<NodeData>();
+      auto it     = values.find(input);
+      if (it == values.end() || !IsFoldableType(dtype_dict.at(input->id()))) break;
+      inputs.push_back(it->second);
+    }
+    double value;
+    if (inputs.empty() || inputs.size() != node->inlinks().size() ||
+        !EvaluateNode(node, inputs, dtype_dict.at(output->id()), &value)) {
+      continue;
+    }
+    VLOG(4) << "Fold " << node->id() << " into the constant " << value;
+    values[output] = value;
+    fill_constants.insert(ReplaceByFillConstant(graph, node, output, value));
+    stats.num_nodes += 1;
+  }
+
+  for (auto* node : fill_constants) {
+    auto* output = node->outlinks_in_order(true)[0]->sink()->safe_as<NodeData>();
+    if (output->outlinks().empty() && !kept.count(output)) {
+      stats.num_bytes += RemoveOpNode(graph, node);
+    }
+  }
+  VLOG(3) << "UniformConstantFolding folds " << stats.num_nodes << " nodes and eliminates " << stats.num_bytes
+          << " bytes of intermediate variables";
+  graph->attrs["uniform_constant_folding_stats"] = std::make_shared<absl::any>(stats);
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(UniformConstantFolding) {
+  CINN_REGISTER_PASS(UniformConstantFolding)
+      .describe(
+          "This pass folds the elementwise, broadcast and layout nodes of uniform constants into fill_constant "
+          "nodes.")
+      .set_change_structure(true)
+      .provide_graph_attr("infershape")
+      .provide_graph_attr("inferdtype")
+      .provide_graph_attr("uniform_constant_folding_stats")
+      .set_body(cinn::hlir::pass::UniformConstantFoldingPass);
+  return true;
+}
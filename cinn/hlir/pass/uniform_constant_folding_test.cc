@@ -0,0 +1,96 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/graph_rewrite_helper.h"
+#include "cinn/hlir/pass/use_pass.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+using common::Float;
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+
+TEST(UniformConstantFolding, FoldScaleChain) {
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {4, 8}, "A");
+  auto x      = builder.FillConstant<float>({4, 8}, 2.f, "x");
+  auto y      = builder.Scale(x, 3.f, 1.f);
+  auto z      = builder.Relu(y);
+  auto out    = builder.Add(a, z);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{out->id}, target);
+
+  framework::ApplyPass(graph.get(), "UniformConstantFolding");
+  auto& stats = graph->GetAttrs<EliminationStats>("uniform_constant_folding_stats");
+  EXPECT_EQ(stats.num_nodes, 2);
+  EXPECT_EQ(stats.num_bytes, 2 * 4 * 8 * 4);
+
+  // z is produced by a fill_constant of the folded value now
+  auto* z_data = graph->RetrieveNode(z->id)->safe_as<NodeData>();
+  ASSERT_TRUE(z_data);
+  auto* producer = z_data->source_node.get();
+  EXPECT_EQ(producer->op()->name, "fill_constant");
+  EXPECT_TRUE(producer->inlinks().empty());
+  EXPECT_FLOAT_EQ(absl::get<float>(producer->attrs.attr_store.at("value")), 7.f);
+  for (auto* node : graph->nodes()) {
+    auto* node_data = node->safe_as<NodeData>();
+    EXPECT_FALSE(node_data && node_data->id() == x->id) << "The folded constant x should be removed";
+  }
+
+  auto scope = framework::BuildScope(target, graph);
+  framework::GraphCompiler gc(target, scope, graph);
+  framework::GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  auto result                        = gc.Build(options, {out->id});
+  auto* a_data                       = scope->GetTensor("A")->mutable_data<float>(target);
+  for (int i = 0; i < 32; ++i) {
+    a_data[i] = i % 5 - 2.f;
+  }
+  result.runtime_program->Execute();
+
+  auto* out_data = scope->GetTensor(out->id)->data<float>();
+  for (int i = 0; i < 32; ++i) {
+    EXPECT_FLOAT_EQ(out_data[i], a_data[i] + 7.f);
+  }
+}
+
+TEST(UniformConstantFolding, KeepNonConstantNodes) {
+  frontend::NetBuilder builder("test");
+  auto a      = builder.CreateInput(Float(32), {4, 8}, "A");
+  auto x      = builder.FillConstant<float>({4, 8}, 2.f, "x");
+  auto y      = builder.Add(a, x);
+  auto z      = builder.Relu(y);
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{z->id}, target);
+
+  framework::ApplyPass(graph.get(), "UniformConstantFolding");
+  auto& stats = graph->GetAttrs<EliminationStats>("uniform_constant_folding_stats");
+  EXPECT_EQ(stats.num_nodes, 0);
+  EXPECT_EQ(stats.num_bytes, 0);
+  EXPECT_TRUE(graph->RetrieveNode(x->id));
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
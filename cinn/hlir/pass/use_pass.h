@@ -20,6 +20,11 @@ CINN_USE_REGISTER(InferShape)
 CINN_USE_REGISTER(OpFusion)
 CINN_USE_REGISTER(AlterLayout)
 CINN_USE_REGISTER(ConstPropagate)
+CINN_USE_REGISTER(UniformConstantFolding)
+CINN_USE_REGISTER(CommonSubexpressionElimination)
+CINN_USE_REGISTER(Conv2dAlgoSelect)
+CINN_USE_REGISTER(Int8Quantize)
+CINN_USE_REGISTER(MixedPrecision)
 
 CINN_USE_REGISTER(DotMerger)
 CINN_USE_REGISTER(OpFusionPass)
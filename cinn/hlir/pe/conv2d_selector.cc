@@ -0,0 +1,174 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/pe/conv2d_selector.h"
+
+#include <glog/logging.h>
+
+#include <cmath>
+#include <limits>
+
+namespace cinn {
+namespace hlir {
+namespace pe {
+namespace {
+
+enum class FilterKind { k1x1, k3x3Stride1, kOther };
+
+// The algorithms of the measured costs, from kWinograd2x2 to kIm2col.
+constexpr int kFirstMeasuredAlgo = static_cast<int>(Conv2dAlgo::kWinograd2x2);
+constexpr int kNumMeasuredAlgos  = 3;
+
+// The throughput in GFLOPS of the measured algorithms on a layer, 0 means not applicable. The flops of a conv2d are
+// counted as the direct convolution, 2 * N * C_out * out_h * out_w * C_in * filter_h * filter_w, so the Winograd
+// convolutions are compared by the time they save.
+struct Conv2dCostEntry {
+  FilterKind kind;
+  int c_in;
+  // out_h * out_w
+  int out_size;
+  double gflops[kNumMeasuredAlgos];
+};
+
+// The layers of resnet and vgg with batch size 1, measured with the host runtime on one core of an AVX-512 cpu.
+// clang-format off
+const Conv2dCostEntry kCostTable[] = {
+    //                                         wino2x2  wino4x4  im2col
+    {FilterKind::k3x3Stride1,  16, 112 * 112, { 7.3,     8.1,     6.5}},
+    {FilterKind::k3x3Stride1,  32, 112 * 112, {13.4,    13.0,    11.1}},
+    {FilterKind::k3x3Stride1,  64,   56 * 56, {22.6,    29.2,    14.9}},
+    {FilterKind::k3x3Stride1, 128,   28 * 28, {34.1,    37.5,    24.2}},
+    {FilterKind::k3x3Stride1, 256,   14 * 14, {35.8,    23.1,    25.5}},
+    {FilterKind::k3x3Stride1, 512,     7 * 7, {16.5,     7.7,    18.5}},
+    {FilterKind::k1x1,         64,   56 * 56, { 0.0,     0.0,    26.8}},
+    {FilterKind::k1x1,        256,   56 * 56, { 0.0,     0.0,    32.6}},
+    {FilterKind::k1x1,         64,   28 * 28, { 0.0,     0.0,    18.8}},
+    {FilterKind::k1x1,        256,   14 * 14, { 0.0,     0.0,    30.4}},
+    {FilterKind::k1x1,        512,     7 * 7, { 0.0,     0.0,    20.2}},
+    {FilterKind::kOther,        3, 112 * 112, { 0.0,     0.0,    17.5}},
+    {FilterKind::kOther,       64,   28 * 28, { 0.0,     0.0,    24.2}},
+};
+// clang-format on
+
+FilterKind GetFilterKind(const std::vector<int>& weight_shape,
+                         const std::vector<int>& strides,
+                         const std::vector<int>& dilations) {
+  if (weight_shape[2] == 1 && weight_shape[3] == 1) {
+    return FilterKind::k1x1;
+  }
+  if (weight_shape[2] == 3 && weight_shape[3] == 3 && strides[0] == 1 && strides[1] == 1 && dilations[0] == 1 &&
+      dilations[1] == 1) {
+    return FilterKind::k3x3Stride1;
+  }
+  return FilterKind::kOther;
+}
+
+bool IsMeasured(Conv2dAlgo algo) {
+  int index = static_cast<int>(algo) - kFirstMeasuredAlgo;
+  return index >= 0 && index < kNumMeasuredAlgos;
+}
+
+}  // namespace
+
+std::string Conv2dAlgoToString(Conv2dAlgo algo) {
+  switch (algo) {
+    case Conv2dAlgo::kNCHWc:
+      return "nchwc";
+    case Conv2dAlgo::kWinograd2x2:
+      return "winograd2x2";
+    case Conv2dAlgo::kWinograd4x4:
+      return "winograd4x4";
+    case Conv2dAlgo::kIm2col:
+      return "im2col";
+    case Conv2dAlgo::kMKLDNN:
+      return "mkldnn";
+  }
+  LOG(FATAL) << "Unknown conv2d algorithm " << static_cast<int>(algo);
+  return "";
+}
+
+double EstimateConv2dCostX86(Conv2dAlgo algo,
+                             const std::vector<int>& input_shape,
+                             const std::vector<int>& weight_shape,
+                             const std::vector<int>& strides,
+                             const std::vector<int>& paddings,
+                             const std::vector<int>& dilations,
+                             int groups) {
+  CHECK_EQ(input_shape.size(), 4U) << "The input of conv2d should be NCHW";
+  CHECK_EQ(weight_shape.size(), 4U) << "The weights of conv2d should be of the shape [C_out, C_in, h, w]";
+  CHECK(strides.size() == 2U && paddings.size() == 2U && dilations.size() == 2U);
+  // the table only covers the conv2d of a single group
+  if (groups != 1 || !IsMeasured(algo)) {
+    return -1;
+  }
+  int out_h = (input_shape[2] - ((weight_shape[2] - 1) * dilations[0] + 1) + 2 * paddings[0]) / strides[0] + 1;
+  int out_w = (input_shape[3] - ((weight_shape[3] - 1) * dilations[1] + 1) + 2 * paddings[1]) / strides[1] + 1;
+  int c_in  = input_shape[1];
+
+  FilterKind kind              = GetFilterKind(weight_shape, strides, dilations);
+  const Conv2dCostEntry* entry = nullptr;
+  double min_distance          = std::numeric_limits<double>::max();
+  for (const auto& candidate : kCostTable) {
+    if (candidate.kind != kind) continue;
+    double distance = std::abs(std::log2(static_cast<double>(c_in) / candidate.c_in)) +
+                      std::abs(std::log2(static_cast<double>(out_h) * out_w / candidate.out_size));
+    if (distance < min_distance) {
+      min_distance = distance;
+      entry        = &candidate;
+    }
+  }
+  CHECK(entry) << "No entry of the filter kind in the cost table of conv2d";
+  double gflops = entry->gflops[static_cast<int>(algo) - kFirstMeasuredAlgo];
+  if (gflops <= 0) {
+    return -1;
+  }
+  double flops = 2.0 * input_shape[0] * weight_shape[0] * out_h * out_w * c_in * weight_shape[2] * weight_shape[3];
+  return flops / (gflops * 1e3);
+}
+
+Conv2dAlgo SelectConv2dAlgoX86(const std::vector<int>& input_shape,
+                               const std::vector<int>& weight_shape,
+                               const std::vector<int>& strides,
+                               const std::vector<int>& paddings,
+                               const std::vector<int>& dilations,
+                               int groups,
+                               const std::string& preference) {
+  // the algorithms without measured costs are only used when they are selected explicitly
+  if (preference == "mkldnn") {
+#ifdef CINN_WITH_MKLDNN
+    return Conv2dAlgo::kMKLDNN;
+#else
+    return Conv2dAlgo::kNCHWc;
+#endif
+  }
+  Conv2dAlgo best  = Conv2dAlgo::kNCHWc;
+  double best_cost = std::numeric_limits<double>::max();
+  for (int i = kFirstMeasuredAlgo; i < kFirstMeasuredAlgo + kNumMeasuredAlgos; ++i) {
+    auto algo = static_cast<Conv2dAlgo>(i);
+    if (preference != "auto" && Conv2dAlgoToString(algo).compare(0, preference.size(), preference) != 0) {
+      continue;
+    }
+    double cost = EstimateConv2dCostX86(algo, input_shape, weight_shape, strides, paddings, dilations, groups);
+    VLOG(4) << "The estimated cost of the conv2d by " << Conv2dAlgoToString(algo) << " is " << cost << " us";
+    if (cost >= 0 && cost < best_cost) {
+      best      = algo;
+      best_cost = cost;
+    }
+  }
+  return best;
+}
+
+}  // namespace pe
+}  // namespace hlir
+}  // namespace cinn
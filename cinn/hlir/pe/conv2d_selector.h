@@ -0,0 +1,75 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace cinn {
+namespace hlir {
+namespace pe {
+
+//! The algorithms of the NCHW conv2d on x86.
+enum class Conv2dAlgo : int {
+  //! The conv2d op itself, the NCHWc compute with the factors of load_x86_params.cc.
+  kNCHWc = 0,
+  //! The Winograd convolution F(2x2, 3x3) of the host runtime.
+  kWinograd2x2,
+  //! The Winograd convolution F(4x4, 3x3) of the host runtime.
+  kWinograd4x4,
+  //! im2col and the native packed GEMM of the host runtime.
+  kIm2col,
+  //! The conv2d op calling MKLDNN, only available with CINN_WITH_MKLDNN.
+  kMKLDNN,
+};
+
+//! The name of the algorithm, one of nchwc, winograd2x2, winograd4x4, im2col and mkldnn.
+std::string Conv2dAlgoToString(Conv2dAlgo algo);
+
+/**
+ * \brief Estimate the time in microseconds of a conv2d on one core by the measured cost table.
+ *
+ * The table records the throughput of Winograd and im2col on the typical layers of the CNNs. The throughput of the
+ * nearest recorded layer of the same filter kind is used, and it returns a negative value if the algorithm is not
+ * applicable to the conv2d or has no measured cost, as kNCHWc and kMKLDNN.
+ * @param input_shape The shape of the input {N, C_in, H, W}.
+ * @param weight_shape The shape of the weights {C_out, C_in, filter_h, filter_w}.
+ */
+double EstimateConv2dCostX86(Conv2dAlgo algo,
+                             const std::vector<int>& input_shape,
+                             const std::vector<int>& weight_shape,
+                             const std::vector<int>& strides,
+                             const std::vector<int>& paddings,
+                             const std::vector<int>& dilations,
+                             int groups);
+
+/**
+ * \brief Select the algorithm of the NCHW conv2d on x86 with the lowest estimated cost.
+ * @param preference "auto" selects among the algorithms of the measured costs, which are Winograd and im2col, or the
+ * candidates are limited to those whose names start with it, e.g. "winograd" selects between F(2x2, 3x3) and
+ * F(4x4, 3x3). "nchwc" and "mkldnn" select the algorithm directly, as it has no measured cost. kNCHWc is returned if
+ * no candidate applies.
+ */
+Conv2dAlgo SelectConv2dAlgoX86(const std::vector<int>& input_shape,
+                               const std::vector<int>& weight_shape,
+                               const std::vector<int>& strides,
+                               const std::vector<int>& paddings,
+                               const std::vector<int>& dilations,
+                               int groups,
+                               const std::string& preference = "auto");
+
+}  // namespace pe
+}  // namespace hlir
+}  // namespace cinn
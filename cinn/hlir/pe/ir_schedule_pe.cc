@@ -503,6 +503,30 @@ void IRSoftmaxScheduleCPU(ir::IRSchedule &ir_sch, int axis) {
   ir_sch.ComputeAt(all_blocks[1], loops[0]);
 }
 
+void IRReduceScheduleCPU(ir::IRSchedule &ir_sch, ir::Tensor out, const common::Target &target) {
+  auto loops = ir_sch.GetLoops(out->name);
+  if (ir::GetLoopExtent(loops[0]) > 1) {
+    ir_sch.Parallel(loops[0]);
+  }
+}
+
+void IRTwoStepReduceScheduleCPU(ir::IRSchedule &ir_sch,
+                                ir::Tensor partial,
+                                ir::Tensor out,
+                                const common::Target &target) {
+  // the lanes of partial stay the innermost spatial loop, as the loop nest of its reduce init can't be reordered
+  if (partial->shape.size() >= 2) {
+    auto loops = ir_sch.GetLoops(partial->name);
+    ir_sch.Parallel(loops[0]);
+  }
+  auto loops = ir_sch.GetLoops(out->name);
+  ir_sch.Unroll(loops.back());
+  loops = ir_sch.GetLoops(out->name);
+  if (ir::GetLoopExtent(loops[0]) > 1) {
+    ir_sch.Parallel(loops[0]);
+  }
+}
+
 void IRPoolScheduleGPU(ir::IRSchedule &ir_sch, const common::Target &target) {
   auto all_blocks = ir_sch.GetAllBlocks();
   CHECK_EQ(all_blocks.size(), 1U);
@@ -74,6 +74,13 @@ void IRCudaTwoStepReduceSchedule(ir::IRSchedule &ir_sch,
 
 void IRSoftmaxScheduleCPU(ir::IRSchedule &ir_sch, int axis = -1);
 
+void IRReduceScheduleCPU(ir::IRSchedule &ir_sch, ir::Tensor out, const common::Target &target);
+
+void IRTwoStepReduceScheduleCPU(ir::IRSchedule &ir_sch,
+                                ir::Tensor partial,
+                                ir::Tensor out,
+                                const common::Target &target);
+
 void IRPoolScheduleGPU(ir::IRSchedule &ir_sch, const common::Target &target);
 
 void IRGlobalPoolScheduleGPU(ir::IRSchedule &ir_sch, const common::Target &target);
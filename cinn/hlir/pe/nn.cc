@@ -513,6 +513,104 @@ std::vector<ir::Tensor> Conv2d_NCHW_MKLDNN(const ir::Tensor &input,
 }
 #endif
 
+std::vector<ir::Tensor> Conv2dWinogradWeightTransformCPU(const ir::Tensor &weights,
+                                                         int tile_size,
+                                                         const std::string &output_name) {
+  CHECK_EQ(weights->shape.size(), 4U) << "Weight's dimension of the Winograd convolution is not 4! Please check.";
+  CHECK(is_zero(weights->shape[2] - 3) && is_zero(weights->shape[3] - 3))
+      << "The Winograd convolution only supports the 3x3 filters";
+  CHECK(tile_size == 2 || tile_size == 4) << "The tile size of the Winograd convolution should be 2 or 4";
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern("cinn_cpu_winograd_weight_transform_fp32",
+                                {
+                                    Expr(tile_size),          // tile_size
+                                    Expr(weights->shape[0]),  // c_out
+                                    Expr(weights->shape[1]),  // c_in
+                                    weights                   // weights
+                                });
+      },
+      output_name);
+  auto out = call->TupleGet(0);
+  out->WithBuffer(weights->type());
+  return {out, call};
+}
+
+std::vector<ir::Tensor> Conv2dWinogradCPU(const ir::Tensor &input,
+                                          const ir::Tensor &transformed_weights,
+                                          int tile_size,
+                                          int pad_h,
+                                          int pad_w,
+                                          const std::string &output_name) {
+  CHECK_EQ(input->shape.size(), 4U) << "Input's dimension of the Winograd convolution is not 4! Please check.";
+  CHECK_EQ(transformed_weights->shape.size(), 3U)
+      << "The weights of the Winograd convolution should be transformed to 3-D! Please check.";
+  CHECK(is_zero(transformed_weights->shape[2] - input->shape[1]))
+      << "The input channel of the Winograd convolution doesn't match its weights";
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern("cinn_cpu_winograd_conv2d_nchw_fp32",
+                                {
+                                    Expr(tile_size),                      // tile_size
+                                    Expr(input->shape[0]),                // batch_size
+                                    Expr(input->shape[1]),                // c_in
+                                    Expr(input->shape[2]),                // input_h
+                                    Expr(input->shape[3]),                // input_w
+                                    Expr(transformed_weights->shape[1]),  // c_out
+                                    Expr(pad_h),                          // pad_h
+                                    Expr(pad_w),                          // pad_w
+                                    input,                                // input
+                                    transformed_weights                   // transformed_weights
+                                });
+      },
+      output_name);
+  auto out = call->TupleGet(0);
+  out->WithBuffer(input->type());
+  return {out, call};
+}
+
+std::vector<ir::Tensor> Conv2dIm2colCPU(const ir::Tensor &input,
+                                        const ir::Tensor &weights,
+                                        int pad_h,
+                                        int pad_w,
+                                        int stride_h,
+                                        int stride_w,
+                                        int dilation_h,
+                                        int dilation_w,
+                                        const std::string &output_name) {
+  CHECK_EQ(input->shape.size(), 4U) << "Input's dimension of the im2col convolution is not 4! Please check.";
+  CHECK_EQ(weights->shape.size(), 4U) << "Weight's dimension of the im2col convolution is not 4! Please check.";
+  CHECK(is_zero(weights->shape[1] - input->shape[1])) << "The im2col convolution only supports a single group";
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern("cinn_cpu_im2col_conv2d_nchw_fp32",
+                                {
+                                    Expr(input->shape[0]),    // batch_size
+                                    Expr(input->shape[1]),    // c_in
+                                    Expr(input->shape[2]),    // input_h
+                                    Expr(input->shape[3]),    // input_w
+                                    Expr(weights->shape[0]),  // c_out
+                                    Expr(weights->shape[2]),  // filter_h
+                                    Expr(weights->shape[3]),  // filter_w
+                                    Expr(pad_h),              // pad_h
+                                    Expr(pad_w),              // pad_w
+                                    Expr(stride_h),           // stride_h
+                                    Expr(stride_w),           // stride_w
+                                    Expr(dilation_h),         // dilation_h
+                                    Expr(dilation_w),         // dilation_w
+                                    input,                    // input
+                                    weights                   // weights
+                                });
+      },
+      output_name);
+  auto out = call->TupleGet(0);
+  out->WithBuffer(input->type());
+  return {out, call};
+}
+
 std::vector<ir::Tensor> Conv2d_NHWC(const ir::Tensor &input,
                                     const ir::Tensor &weights,
                                     int pad_h,
@@ -191,6 +191,60 @@ std::vector<ir::Tensor> Conv2d_NCHW_MKLDNN(const ir::Tensor &input,
                                            const std::string &output_name = UniqName("T_Conv2d_NCHW_out"));
 #endif
 
+/**
+ * @brief Transform the 3x3 weights of the Winograd convolution on x86 by the host runtime, U = G * g * G^T.
+ *
+ * @param weights The 4-D weight tensor {C_out, C_in, 3, 3}
+ * @param tile_size The size m of the output tiles of F(m x m, 3 x 3), 2 or 4
+ * @param output_name The name of the output tensor
+ *
+ * @return the transformed weights {(m + 2) * (m + 2), C_out, C_in} and the tensor of the extern call
+ */
+std::vector<ir::Tensor> Conv2dWinogradWeightTransformCPU(
+    const ir::Tensor &weights,
+    int tile_size,
+    const std::string &output_name = UniqName("T_Conv2d_winograd_weight_transform_out"));
+
+/**
+ * @brief Perform the NCHW convolution of the 3x3 filters, stride 1 and dilation 1 by the Winograd convolution of the
+ * host runtime on x86.
+ *
+ * @param input The 4-D input tensor {N, C_in, H, W}
+ * @param transformed_weights The weights transformed by Conv2dWinogradWeightTransformCPU
+ * @param tile_size The size m of the output tiles of F(m x m, 3 x 3), 2 or 4
+ * @param pad_h padding applied to the height of the image
+ * @param pad_w padding applied to the width of the image
+ * @param output_name The name of the output tensor
+ *
+ * @return the output tensor and the tensor of the extern call
+ */
+std::vector<ir::Tensor> Conv2dWinogradCPU(const ir::Tensor &input,
+                                          const ir::Tensor &transformed_weights,
+                                          int tile_size,
+                                          int pad_h,
+                                          int pad_w,
+                                          const std::string &output_name = UniqName("T_Conv2d_winograd_cpu_out"));
+
+/**
+ * @brief Perform the NCHW convolution of a single group by im2col and the native packed GEMM of the host runtime on
+ * x86.
+ *
+ * @param input The 4-D input tensor {N, C_in, H, W}
+ * @param weights The 4-D weight tensor {C_out, C_in, filter_h, filter_w}
+ * @param output_name The name of the output tensor
+ *
+ * @return the output tensor and the tensor of the extern call
+ */
+std::vector<ir::Tensor> Conv2dIm2colCPU(const ir::Tensor &input,
+                                        const ir::Tensor &weights,
+                                        int pad_h,
+                                        int pad_w,
+                                        int stride_h,
+                                        int stride_w,
+                                        int dilation_h,
+                                        int dilation_w,
+                                        const std::string &output_name = UniqName("T_Conv2d_im2col_cpu_out"));
+
 /**
  * @brief Perform a 2-D convolution with an NHWC-layout and support group and depthwise convolution.
  *
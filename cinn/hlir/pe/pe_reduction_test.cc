@@ -0,0 +1,210 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/cinn.h"
+#include "cinn/common/target.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/hlir/pe/reduction.h"
+#include "cinn/hlir/pe/schedule.h"
+#include "cinn/runtime/cinn_runtime.h"
+#include "cinn/runtime/cpu/use_extern_funcs.h"
+
+namespace cinn {
+namespace hlir {
+namespace pe {
+using ir::Tensor;
+
+using CpuReduceFunc = std::function<std::vector<ir::Tensor>(
+    const ir::Tensor &, const std::vector<int> &, const bool, const std::string &)>;
+
+// reduce on CPU with the lane-wise schedules, and check the results with a naive reduction by \p combine from
+// \p initial. The inputs of the products are close to 1 to keep the results representable.
+void TestCpuReduce(CpuReduceFunc reduce_func,
+                   std::function<double(double, double)> combine,
+                   double initial,
+                   const std::vector<int> &shape,
+                   const std::vector<int> &axes,
+                   bool keep_dim,
+                   size_t expected_num_tensors,
+                   bool near_one = false) {
+  std::vector<Expr> shape_expr;
+  for (int dim : shape) {
+    shape_expr.push_back(Expr(dim));
+  }
+  Placeholder<float> A("A", shape_expr);
+  Target target = common::DefaultHostTarget();
+
+  auto res = reduce_func(A.tensor(), axes, keep_dim, "C");
+  ASSERT_EQ(res.size(), expected_num_tensors);
+  auto stages                         = CreateStages({A});
+  std::vector<ir::Tensor> tensor_args = {A};
+  for (auto &tensor : res) {
+    stages->InsertLazily(tensor);
+    tensor_args.push_back(tensor);
+  }
+  if (res.size() == 2) {
+    TwoStepReduceScheduleCPU(stages, res[1], res[0], target);
+  } else {
+    ReduceScheduleCPU(stages, res[0], shape.size() - axes.back() - 1, target);
+  }
+
+  Module::Builder builder("module0", target);
+  auto func = Lower("fn", stages, tensor_args);
+  builder.AddFunction(func);
+  LOG(INFO) << "func:\n" << func;
+
+  auto jit = backends::ExecutionEngine::Create({});
+  jit->Link(builder.Build());
+  auto fn = jit->Lookup("fn");
+  CHECK(fn);
+  auto fn_ = reinterpret_cast<void (*)(void *, int32_t)>(fn);
+
+  cinn_buffer_t *A_buf = common::BufferBuilder(Float(32), shape).set_random().Build();
+  int numel            = 1;
+  for (int dim : shape) {
+    numel *= dim;
+  }
+  auto *ad = reinterpret_cast<float *>(A_buf->memory);
+  if (near_one) {
+    for (int idx = 0; idx < numel; ++idx) {
+      ad[idx] = 1.f + (ad[idx] - 0.5f) * 0.01f;
+    }
+  }
+  std::vector<cinn_pod_value_t> args = {cinn_pod_value_t(A_buf)};
+  std::vector<cinn_buffer_t *> out_bufs;
+  for (auto &tensor : res) {
+    std::vector<int> out_shape;
+    for (auto &dim : tensor->shape) {
+      out_shape.push_back(dim.as_int32());
+    }
+    out_bufs.push_back(common::BufferBuilder(Float(32), out_shape).set_zero().Build());
+    args.push_back(cinn_pod_value_t(out_bufs.back()));
+  }
+  fn_(reinterpret_cast<void **>(args.data()), args.size());
+
+  std::vector<double> expected(out_bufs[0]->num_elements(), initial);
+  for (int idx = 0; idx < numel; ++idx) {
+    int out_idx = 0;
+    int remain  = idx;
+    int stride  = numel;
+    for (int dim = 0; dim < shape.size(); ++dim) {
+      stride /= shape[dim];
+      int index = remain / stride;
+      remain %= stride;
+      if (std::find(axes.begin(), axes.end(), dim) == axes.end()) {
+        out_idx = out_idx * shape[dim] + index;
+      }
+    }
+    expected[out_idx] = combine(expected[out_idx], ad[idx]);
+  }
+  auto *cd = reinterpret_cast<float *>(out_bufs[0]->memory);
+  for (int idx = 0; idx < expected.size(); ++idx) {
+    ASSERT_NEAR(cd[idx], expected[idx], 1e-4 * std::abs(expected[idx]) + 1e-4);
+  }
+}
+
+void TestCpuReduceSum(const std::vector<int> &shape,
+                      const std::vector<int> &axes,
+                      bool keep_dim,
+                      size_t expected_num_tensors) {
+  TestCpuReduce(
+      CpuTwoStepReduceSum, [](double x, double y) { return x + y; }, 0., shape, axes, keep_dim, expected_num_tensors);
+}
+
+void TestCpuReduceProd(const std::vector<int> &shape,
+                       const std::vector<int> &axes,
+                       bool keep_dim,
+                       size_t expected_num_tensors) {
+  TestCpuReduce(
+      CpuTwoStepReduceProd,
+      [](double x, double y) { return x * y; },
+      1.,
+      shape,
+      axes,
+      keep_dim,
+      expected_num_tensors,
+      true);
+}
+
+void TestCpuReduceMax(const std::vector<int> &shape,
+                      const std::vector<int> &axes,
+                      bool keep_dim,
+                      size_t expected_num_tensors) {
+  TestCpuReduce(
+      CpuTwoStepReduceMax,
+      [](double x, double y) { return std::max(x, y); },
+      -3.402823e+38,
+      shape,
+      axes,
+      keep_dim,
+      expected_num_tensors);
+}
+
+void TestCpuReduceMin(const std::vector<int> &shape,
+                      const std::vector<int> &axes,
+                      bool keep_dim,
+                      size_t expected_num_tensors) {
+  TestCpuReduce(
+      CpuTwoStepReduceMin,
+      [](double x, double y) { return std::min(x, y); },
+      3.402823e+38,
+      shape,
+      axes,
+      keep_dim,
+      expected_num_tensors);
+}
+
+TEST(ReductionPE, CpuReduceSumLastAxis) { TestCpuReduceSum({32, 1024}, {1}, false, 2); }
+
+TEST(ReductionPE, CpuReduceSumAllAxes) { TestCpuReduceSum({4096}, {0}, false, 2); }
+
+TEST(ReductionPE, CpuReduceSumSeveralAxes) { TestCpuReduceSum({4, 8, 256}, {0, 2}, true, 2); }
+
+TEST(ReductionPE, CpuReduceSumShortLastAxis) { TestCpuReduceSum({64, 6}, {1}, false, 1); }
+
+TEST(ReductionPE, CpuReduceSumFirstAxis) { TestCpuReduceSum({64, 128}, {0}, false, 1); }
+
+TEST(ReductionPE, CpuReduceSumMiddleAxis) { TestCpuReduceSum({16, 32, 24}, {1}, true, 1); }
+
+TEST(ReductionPE, CpuReduceProdLastAxis) { TestCpuReduceProd({32, 512}, {1}, false, 2); }
+
+// the outputs are too few to run in parallel, so the last axis is reduced in several chunks
+TEST(ReductionPE, CpuReduceProdChunks) { TestCpuReduceProd({2, 1024}, {1}, true, 2); }
+
+TEST(ReductionPE, CpuReduceProdFirstAxis) { TestCpuReduceProd({64, 128}, {0}, false, 1); }
+
+TEST(ReductionPE, CpuReduceMaxLastAxis) { TestCpuReduceMax({32, 1024}, {1}, false, 2); }
+
+TEST(ReductionPE, CpuReduceMaxChunks) { TestCpuReduceMax({4096}, {0}, false, 2); }
+
+TEST(ReductionPE, CpuReduceMaxMiddleAxis) { TestCpuReduceMax({16, 32, 24}, {1}, true, 1); }
+
+TEST(ReductionPE, CpuReduceMinLastAxis) { TestCpuReduceMin({4, 8, 256}, {0, 2}, true, 2); }
+
+TEST(ReductionPE, CpuReduceMinChunks) { TestCpuReduceMin({2, 1024}, {1}, false, 2); }
+
+TEST(ReductionPE, CpuReduceMinShortLastAxis) { TestCpuReduceMin({64, 6}, {1}, false, 1); }
+
+}  // namespace pe
+}  // namespace hlir
+}  // namespace cinn
@@ -28,6 +28,7 @@
 #include "cinn/hlir/pe/transform.h"
 #include "cinn/runtime/cinn_runtime.h"
 #include "cinn/runtime/cpu/host_intrinsics.h"
+#include "cinn/runtime/cpu/use_extern_funcs.h"
 #include "cinn/runtime/cuda/cuda_module.h"
 
 namespace cinn {
@@ -101,6 +102,61 @@ TEST(MatmulPE, MatmulCase1) {
   }
 }
 
+TEST(MatmulPE, GemmBiasActCPU) {
+  int m = 50;
+  int n = 40;
+  int k = 300;
+  Expr M(m), N(n), K(k);
+
+  Placeholder<float> A("A", {K, M});
+  Placeholder<float> B("B", {K, N});
+  Placeholder<float> bias("bias", {N});
+
+  auto C = hlir::pe::GemmBiasActCPU(A.tensor(), B.tensor(), bias.tensor(), true, false, 2.f, "relu", "C");
+
+  auto stages                         = CreateStages({A, B, bias});
+  std::vector<ir::Tensor> tensor_args = {A, B, bias};
+  for (auto &t : C) {
+    tensor_args.push_back(t);
+    stages->InsertLazily(t);
+  }
+  Module::Builder builder("module0", common::DefaultHostTarget());
+  auto func = Lower("fn", stages, tensor_args);
+  builder.AddFunction(func);
+  LOG(INFO) << "func:\n" << func;
+
+  auto jit = backends::ExecutionEngine::Create({});
+  jit->Link(builder.Build());
+  auto fn = jit->Lookup("fn");
+  CHECK(fn);
+  auto fn_                = reinterpret_cast<void (*)(void *, int32_t)>(fn);
+  cinn_buffer_t *A_buf    = common::BufferBuilder(Float(32), {k, m}).set_random().Build();
+  cinn_buffer_t *B_buf    = common::BufferBuilder(Float(32), {k, n}).set_random().Build();
+  cinn_buffer_t *bias_buf = common::BufferBuilder(Float(32), {n}).set_random().Build();
+  cinn_buffer_t *C_buf    = common::BufferBuilder(Float(32), {m, n}).set_zero().Build();
+  cinn_buffer_t *call_buf = common::BufferBuilder(Float(32), {1}).set_zero().Build();
+  std::vector<cinn_pod_value_t> args{cinn_pod_value_t(A_buf),
+                                     cinn_pod_value_t(B_buf),
+                                     cinn_pod_value_t(bias_buf),
+                                     cinn_pod_value_t(C_buf),
+                                     cinn_pod_value_t(call_buf)};
+  fn_(reinterpret_cast<void **>(args.data()), args.size());
+
+  auto *ad    = reinterpret_cast<float *>(A_buf->memory);
+  auto *bd    = reinterpret_cast<float *>(B_buf->memory);
+  auto *biasd = reinterpret_cast<float *>(bias_buf->memory);
+  auto *cd    = reinterpret_cast<float *>(C_buf->memory);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float tmp = 0;
+      for (int p = 0; p < k; p++) {
+        tmp += ad[p * m + i] * bd[p * n + j];
+      }
+      ASSERT_NEAR(cd[i * n + j], std::max(2.f * tmp + biasd[j], 0.f), 1e-3);
+    }
+  }
+}
+
 TEST(ScatterAssign, ScatterAssign) {
   int m = 128;
   int n = 32;
@@ -20,6 +20,7 @@
 
 #include "cinn/common/ir_util.h"
 #include "cinn/hlir/pe/broadcast.h"
+#include "cinn/hlir/pe/schedule.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/lang/builtin.h"
@@ -784,6 +785,130 @@ std::vector<ir::Tensor> TwoStepBlockReduceMin(const ir::Tensor& A,
   return TwoStepBlockReduceInternal(A, axes, keep_dim, output_name, ReduceMin, BlockReduceMinInternal);
 }
 
+// the max number of chunks the last axis is split into when there are too few outputs to run in parallel
+constexpr int kCpuReduceMaxChunks = 16;
+
+template <typename FuncOp>
+std::vector<ir::Tensor> CpuTwoStepReduceInternal(const ir::Tensor& A,
+                                                 const std::vector<int>& axes,
+                                                 const bool keep_dim,
+                                                 const std::string& output_name,
+                                                 const FuncOp& fn,
+                                                 Expr initial,
+                                                 ReduceFunc reduce_func) {
+  int ndim = A->shape.size();
+  std::vector<int> real_axes;
+  GetRealAxes(ndim, axes, &real_axes);
+  int last_shape = A->shape.back().as_int32();
+  int lanes      = GetVectorizeFactor(last_shape, GetBasicFactor(A->type(), common::DefaultHostTarget()));
+  // only the last axis with several vectors is worth accumulating lane-wise
+  if (real_axes.back() != ndim - 1 || lanes < 4 || last_shape / lanes < 2) {
+    return {reduce_func(A, axes, keep_dim, output_name)};
+  }
+  int num_vectors = last_shape / lanes;
+
+  int spatial_size = 1;
+  std::vector<Expr> partial_shape;
+  for (int idx = 0; idx < ndim; ++idx) {
+    if (std::find(real_axes.begin(), real_axes.end(), idx) == real_axes.end()) {
+      spatial_size *= A->shape[idx].as_int32();
+      partial_shape.push_back(A->shape[idx]);
+    }
+  }
+  int num_chunks = 1;
+  if (spatial_size < kCpuReduceMaxChunks) {
+    num_chunks = GetMaxSplitter(num_vectors, std::min(kCpuReduceMaxChunks, num_vectors / 2));
+  }
+  int chunk_size = num_vectors / num_chunks;
+  if (num_chunks > 1) {
+    partial_shape.insert(partial_shape.begin(), Expr(num_chunks));
+  }
+  partial_shape.push_back(Expr(lanes));
+
+  // partial[chunk, spatial..., lane] accumulates the elements of the same lane of the vectors in the chunk
+  std::vector<Var> partial_reduce_axes;
+  for (int idx = 0; idx + 1 < real_axes.size(); ++idx) {
+    partial_reduce_axes.push_back(Var(A->shape[real_axes[idx]], UniqName("kk")));
+  }
+  Var vector_axis(Expr(chunk_size), UniqName("kk"));
+  partial_reduce_axes.push_back(vector_axis);
+  auto partial = Compute(
+      partial_shape,
+      [=](const std::vector<Expr>& indices) -> Expr {
+        std::vector<Expr> eval_indice;
+        int indice_cnt = num_chunks > 1 ? 1 : 0;
+        int reduce_cnt = 0;
+        for (int idx = 0; idx + 1 < ndim; ++idx) {
+          if (std::find(real_axes.begin(), real_axes.end(), idx) != real_axes.end()) {
+            eval_indice.push_back(partial_reduce_axes[reduce_cnt++]);
+          } else {
+            eval_indice.push_back(indices[indice_cnt++]);
+          }
+        }
+        Expr vector_index = num_chunks > 1 ? indices[0] * Expr(chunk_size) + vector_axis : Expr(vector_axis);
+        eval_indice.push_back(vector_index * Expr(lanes) + indices.back());
+        return fn(A(eval_indice), partial_reduce_axes, initial);
+      },
+      UniqName(output_name + "_lanes"));
+
+  // the horizontal reduce of the lanes and the chunks
+  std::vector<Expr> output_shape;
+  GetOutputShape(real_axes, &output_shape, A, keep_dim);
+  Var chunk_axis(Expr(num_chunks), UniqName("kk"));
+  Var lane_axis(Expr(lanes), UniqName("kk"));
+  auto out = Compute(
+      output_shape,
+      [=](const std::vector<Expr>& indices) -> Expr {
+        std::vector<Expr> partial_indice;
+        std::vector<Var> out_reduce_axes;
+        if (num_chunks > 1) {
+          partial_indice.push_back(chunk_axis);
+          out_reduce_axes.push_back(chunk_axis);
+        }
+        int indice_cnt = 0;
+        for (int idx = 0; idx < ndim; ++idx) {
+          bool is_reduced = std::find(real_axes.begin(), real_axes.end(), idx) != real_axes.end();
+          if (!is_reduced) {
+            partial_indice.push_back(indices[indice_cnt]);
+          }
+          indice_cnt += keep_dim || !is_reduced;
+        }
+        partial_indice.push_back(lane_axis);
+        out_reduce_axes.push_back(lane_axis);
+        return fn(partial(partial_indice), out_reduce_axes, initial);
+      },
+      output_name);
+  return {out, partial};
+}
+
+std::vector<ir::Tensor> CpuTwoStepReduceSum(const ir::Tensor& A,
+                                            const std::vector<int>& axes,
+                                            const bool keep_dim,
+                                            const std::string& output_name) {
+  return CpuTwoStepReduceInternal(A, axes, keep_dim, output_name, lang::ReduceSum, Expr(0.0f), ReduceSum);
+}
+
+std::vector<ir::Tensor> CpuTwoStepReduceProd(const ir::Tensor& A,
+                                             const std::vector<int>& axes,
+                                             const bool keep_dim,
+                                             const std::string& output_name) {
+  return CpuTwoStepReduceInternal(A, axes, keep_dim, output_name, lang::ReduceMul, Expr(1.0f), ReduceProd);
+}
+
+std::vector<ir::Tensor> CpuTwoStepReduceMax(const ir::Tensor& A,
+                                            const std::vector<int>& axes,
+                                            const bool keep_dim,
+                                            const std::string& output_name) {
+  return CpuTwoStepReduceInternal(A, axes, keep_dim, output_name, lang::ReduceMax, Expr(-3.402823e+38f), ReduceMax);
+}
+
+std::vector<ir::Tensor> CpuTwoStepReduceMin(const ir::Tensor& A,
+                                            const std::vector<int>& axes,
+                                            const bool keep_dim,
+                                            const std::string& output_name) {
+  return CpuTwoStepReduceInternal(A, axes, keep_dim, output_name, lang::ReduceMin, Expr(3.402823e+38f), ReduceMin);
+}
+
 }  // namespace pe
 }  // namespace hlir
 }  // namespace cinn
@@ -302,6 +302,39 @@ std::vector<ir::Tensor> TwoStepBlockReduceMin(const ir::Tensor& A,
                                               const std::vector<int>& axes,
                                               const bool keep_dim,
                                               const std::string& output_name = "T_Reduce_Min_out");
+
+/**
+ * @brief compute the value of array elements over the given axes on CPU in two steps when the last axis is reduced.
+ * The first step accumulates the vectors of the last axis lane-wise, it is also split into chunks when the outputs are
+ * too few to run in parallel. The second step reduces the lanes and the chunks. It falls back to a single reduction if
+ * the last axis is not reduced or too short.
+ *
+ * @param A The input Tensor.
+ * @param axes the reduce axes.
+ * @param keep_dim keep the output tensor shape size as input.
+ * @param output_name The name of the output Tensor.
+ *
+ * @return The output Tensor followed by the lane-wise partial results if there are two steps.
+ */
+std::vector<ir::Tensor> CpuTwoStepReduceSum(const ir::Tensor& A,
+                                            const std::vector<int>& axes,
+                                            const bool keep_dim,
+                                            const std::string& output_name = "T_Reduce_Sum_out");
+
+std::vector<ir::Tensor> CpuTwoStepReduceProd(const ir::Tensor& A,
+                                             const std::vector<int>& axes,
+                                             const bool keep_dim,
+                                             const std::string& output_name = "T_Reduce_Prod_out");
+
+std::vector<ir::Tensor> CpuTwoStepReduceMax(const ir::Tensor& A,
+                                            const std::vector<int>& axes,
+                                            const bool keep_dim,
+                                            const std::string& output_name = "T_Reduce_Max_out");
+
+std::vector<ir::Tensor> CpuTwoStepReduceMin(const ir::Tensor& A,
+                                            const std::vector<int>& axes,
+                                            const bool keep_dim,
+                                            const std::string& output_name = "T_Reduce_Min_out");
 }  // namespace pe
 }  // namespace hlir
 }  // namespace cinn
@@ -85,8 +85,10 @@ int SplitEven(int origin) {
 }
 
 int GetBasicFactor(const Type &type, const common::Target &target) {
-  int target_native_vector_bits = target.get_target_bits() * 8;
-  int type_bits                 = type.bits();
+  // the vector registers of x86 depend on the cpu features of the target, e.g. 256 bits for AVX2
+  int target_native_vector_bits =
+      target.arch == common::Target::Arch::X86 ? target.native_vector_bits() : target.get_target_bits() * 8;
+  int type_bits = type.bits();
   return target_native_vector_bits / type_bits;
 }
 
@@ -566,6 +568,62 @@ void SoftmaxScheduleCPU(poly::StageMap stage, const ir::Tensor &output, const ir
   stage[temp]->ComputeAt(stage[output], 0);
 }
 
+void ReduceScheduleCPU(poly::StageMap stages,
+                       const ir::Tensor &output,
+                       int last_dimension_num,
+                       const common::Target &target) {
+  int out_dims  = output->shape.size();
+  int out_loops = stages[output]->n_out_dims();
+  if (last_dimension_num > 0 && out_loops > out_dims) {
+    if (out_dims >= 2) {
+      auto out_init = output->GetInitTensor(stages, target);
+      stages[out_init]->ComputeAt2(stages[output], out_dims - 2);
+    }
+    // move the last spatial loop inside the reduce loops, so its outputs are accumulated in a vector
+    std::vector<int> order;
+    for (int idx = out_dims; idx < out_loops; ++idx) {
+      order.push_back(idx);
+    }
+    order.push_back(out_dims - 1);
+    stages[output]->Reorder(order);
+    int factor = GetVectorizeFactor(output->shape.back().as_int32(), GetBasicFactor(output->type(), target));
+    if (factor > 1) {
+      stages[output]->Vectorize(out_loops - 1, factor);
+    }
+  }
+  // the first loop is a spatial one unless the only spatial loop is moved inside
+  if (out_dims >= 2 || last_dimension_num == 0) {
+    stages[output]->Parallel(0);
+  }
+}
+
+void TwoStepReduceScheduleCPU(poly::StageMap stages,
+                              const ir::Tensor &partial,
+                              const ir::Tensor &output,
+                              const common::Target &target) {
+  // partial: accumulate the lanes in a vector inside the reduce loops
+  int partial_dims  = partial->shape.size();
+  int partial_loops = stages[partial]->n_out_dims();
+  if (partial_dims >= 2) {
+    auto partial_init = partial->GetInitTensor(stages, target);
+    stages[partial_init]->ComputeAt2(stages[partial], partial_dims - 2);
+  }
+  std::vector<int> order;
+  for (int idx = partial_dims; idx < partial_loops; ++idx) {
+    order.push_back(idx);
+  }
+  order.push_back(partial_dims - 1);
+  stages[partial]->Reorder(order);
+  stages[partial]->Vectorize(partial_loops - 1, partial->shape.back().as_int32());
+  if (partial_dims >= 2) {
+    stages[partial]->Parallel(0);
+  }
+  // output: the horizontal reduce of the lanes
+  int out_loops = stages[output]->n_out_dims();
+  stages[output]->Unroll(out_loops - 1);
+  stages[output]->Parallel(0);
+}
+
 void GlobalPoolScheduleGPU(poly::StageMap stages, const std::vector<ir::Tensor> &output, const common::Target &target) {
   auto &out    = output[0];
   auto &reduce = output[1];
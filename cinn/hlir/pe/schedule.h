@@ -87,6 +87,16 @@ void MulScheduleCPU(poly::StageMap stage,
 
 void SoftmaxScheduleCPU(poly::StageMap stage, const ir::Tensor &output, const ir::Tensor &temp, int axis = -1);
 
+void ReduceScheduleCPU(poly::StageMap stages,
+                       const ir::Tensor &output,
+                       int last_dimension_num,
+                       const common::Target &target);
+
+void TwoStepReduceScheduleCPU(poly::StageMap stages,
+                              const ir::Tensor &partial,
+                              const ir::Tensor &output,
+                              const common::Target &target);
+
 void GetConv2dFactors(absl::flat_hash_map<std::string, int> *factors,
                       int oc,
                       int ic,
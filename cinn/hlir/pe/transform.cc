@@ -15,6 +15,7 @@
 #include "cinn/hlir/pe/transform.h"
 
 #include <algorithm>
+#include <unordered_map>
 #include <utility>
 
 #include "cinn/common/cas.h"
@@ -323,14 +324,17 @@ std::vector<Tensor> MatmulV2(const Tensor& A,
   return {res, packedB};
 }
 
-std::vector<Tensor> MatmulMKL(const Tensor& A,
-                              const Tensor& B,
-                              bool trans_a,
-                              bool trans_b,
-                              float alpha,
-                              const std::string& name,
-                              const common::Target& target) {
-  CHECK(target.arch == Target::Arch::X86) << "mkl should be used in the cpu environment";
+namespace {
+// Call an extern gemm function of the host runtime on the 2-dim or 3-dim A and B, the functions have the same
+// arguments as cinn_cpu_mkl_gemm_fp32 and cinn_cpu_mkl_gemm_batch_fp32.
+std::vector<Tensor> MatmulExtern(const Tensor& A,
+                                 const Tensor& B,
+                                 bool trans_a,
+                                 bool trans_b,
+                                 float alpha,
+                                 const std::string& gemm_func,
+                                 const std::string& batch_gemm_func,
+                                 const std::string& out_prefix) {
   std::vector<Expr> shape_A = A->shape;
   std::vector<Expr> shape_B = B->shape;
   int a_dim                 = shape_A.size();
@@ -355,7 +359,7 @@ std::vector<Tensor> MatmulMKL(const Tensor& A,
     call = Compute(
         {Expr(1)},
         [=]() -> Expr {
-          return lang::CallExtern("cinn_cpu_mkl_gemm_fp32",
+          return lang::CallExtern(gemm_func,
                                   {
                                       Expr(alpha),                 // alpha
                                       M,                           // M
@@ -371,13 +375,13 @@ std::vector<Tensor> MatmulMKL(const Tensor& A,
                                       B,                           // B
                                   });
         },
-        UniqName("matmul_mkl_out"));
+        UniqName(out_prefix));
   } else {
     // batch matmul
     call = Compute(
         {Expr(1)},
         [=]() -> Expr {
-          return lang::CallExtern("cinn_cpu_mkl_gemm_batch_fp32",
+          return lang::CallExtern(batch_gemm_func,
                                   {
                                       Expr(alpha),                 // alpha
                                       shape_A.front(),             // batch
@@ -397,12 +401,96 @@ std::vector<Tensor> MatmulMKL(const Tensor& A,
                                       B,                           // B
                                   });
         },
-        UniqName("batch_matmul_mkl_out"));
+        UniqName("batch_" + out_prefix));
   }
   auto out = call->TupleGet(0);
   out->WithBuffer(A->type());
   return {out, call};
 }
+}  // namespace
+
+std::vector<Tensor> MatmulMKL(const Tensor& A,
+                              const Tensor& B,
+                              bool trans_a,
+                              bool trans_b,
+                              float alpha,
+                              const std::string& name,
+                              const common::Target& target) {
+  CHECK(target.arch == Target::Arch::X86) << "mkl should be used in the cpu environment";
+  return MatmulExtern(
+      A, B, trans_a, trans_b, alpha, "cinn_cpu_mkl_gemm_fp32", "cinn_cpu_mkl_gemm_batch_fp32", "matmul_mkl_out");
+}
+
+std::vector<Tensor> MatmulCPU(const Tensor& A,
+                              const Tensor& B,
+                              bool trans_a,
+                              bool trans_b,
+                              float alpha,
+                              const std::string& name,
+                              const common::Target& target) {
+  CHECK(target.arch == Target::Arch::X86) << "the cpu gemm should be used in the cpu environment";
+  return MatmulExtern(
+      A, B, trans_a, trans_b, alpha, "cinn_cpu_gemm_fp32", "cinn_cpu_gemm_batch_fp32", "matmul_cpu_gemm_out");
+}
+
+std::vector<Tensor> GemmBiasActCPU(const Tensor& A,
+                                   const Tensor& B,
+                                   const Tensor& bias,
+                                   bool trans_a,
+                                   bool trans_b,
+                                   float alpha,
+                                   const std::string& activation,
+                                   const std::string& name,
+                                   const common::Target& target) {
+  CHECK(target.arch == Target::Arch::X86) << "the cpu gemm should be used in the cpu environment";
+  CHECK_EQ(A->shape.size(), 2U) << "tensor_A's dim should be 2 while current dim is " << A->shape.size();
+  CHECK_EQ(B->shape.size(), 2U) << "tensor_B's dim should be 2 while current dim is " << B->shape.size();
+  Expr x_width  = trans_a ? A->shape[0] : A->shape[1];
+  Expr y_height = trans_b ? B->shape[1] : B->shape[0];
+  Expr M        = trans_a ? A->shape[1] : A->shape[0];
+  Expr N        = trans_b ? B->shape[0] : B->shape[1];
+  CHECK(is_zero(x_width - y_height)) << "matrix multiplication requires x_width to be same with y_height";
+
+  // the values of cinn::runtime::cpu::GemmBiasMode and GemmActivation
+  int bias_mode = 0;
+  if (bias->shape.size() == 2U && is_zero(bias->shape[0] - M) && is_zero(bias->shape[1] - N)) {
+    bias_mode = 2;
+  } else if ((bias->shape.size() == 1U || (bias->shape.size() == 2U && is_zero(bias->shape[0] - 1))) &&
+             is_zero(bias->shape.back() - N)) {
+    bias_mode = 1;
+  } else {
+    LOG(FATAL) << "The bias of the cpu gemm should be of the shape [" << N << "] or [" << M << ", " << N
+               << "], but got [" << utils::Join(bias->shape, ", ") << "]";
+  }
+  static const std::unordered_map<std::string, int> activations{{"", 0}, {"relu", 1}, {"sigmoid", 2}, {"tanh", 3}};
+  CHECK(activations.count(activation)) << "Unsupported activation " << activation << " of the cpu gemm";
+
+  auto call = Compute(
+      {Expr(1)},
+      [=]() -> Expr {
+        return lang::CallExtern("cinn_cpu_gemm_bias_act_fp32",
+                                {
+                                    Expr(alpha),                       // alpha
+                                    M,                                 // M
+                                    N,                                 // N
+                                    x_width,                           // K
+                                    common::make_bool(trans_a),        // ta
+                                    common::make_bool(trans_b),        // tb
+                                    A->shape.back(),                   // lda
+                                    B->shape.back(),                   // ldb
+                                    N,                                 // ldc
+                                    Expr(bias_mode),                   // bias_mode
+                                    Expr(activations.at(activation)),  // activation
+                                    A,                                 // A
+                                    B,                                 // B
+                                    bias,                              // bias
+                                });
+      },
+      UniqName("gemm_bias_act_out"));
+  auto out = call->TupleGet(0);
+  out->WithBuffer(A->type());
+  return {out, call};
+}
 
 int GetMulFactor(int shape, const Type& type, const common::Target& target) {
   int split_base   = GetBasicFactor(type, target);
@@ -528,6 +616,16 @@ std::vector<Tensor> MulMKL(const Tensor& A, const Tensor& B, const std::string&
   return {out, call};
 }
 
+std::vector<Tensor> MulCPU(const Tensor& A, const Tensor& B, const std::string& name, const common::Target& target) {
+  CHECK(target.arch == Target::Arch::X86) << "the cpu gemm should be used in the cpu environment";
+  int a_dim = A->shape.size();
+  int b_dim = B->shape.size();
+  CHECK_EQ(a_dim, 2U) << "tensor_A's shape size should be two while current shape size is " << a_dim;
+  CHECK_EQ(b_dim, 2U) << "tensor_B's shape size should be two while current shape size is " << b_dim;
+  // A: [M, K], B: [N, K]
+  return MatmulExtern(A, B, false, true, 1.f, "cinn_cpu_gemm_fp32", "cinn_cpu_gemm_batch_fp32", "mul_cpu_gemm_out");
+}
+
 void GetLayoutTransformInfo(const ir::Layout& src_layout,
                             const ir::Layout& dst_layout,
                             absl::flat_hash_map<int, std::vector<int>>* split_index_map) {
@@ -81,6 +81,37 @@ std::vector<ir::Tensor> MatmulMKL(const ir::Tensor& A,
                                   const std::string& name      = UniqName("T_Transform_MatmulMKL_out"),
                                   const common::Target& target = common::DefaultHostTarget());
 
+/**
+ * @brief Matrix multiplication on x86 by the native packed gemm of the host runtime, it takes the same arguments as
+ * MatmulMKL and doesn't depend on a BLAS library.
+ */
+std::vector<ir::Tensor> MatmulCPU(const ir::Tensor& A,
+                                  const ir::Tensor& B,
+                                  bool trans_a                 = false,
+                                  bool trans_b                 = false,
+                                  float alpha                  = 1,
+                                  const std::string& name      = UniqName("T_Transform_MatmulCPU_out"),
+                                  const common::Target& target = common::DefaultHostTarget());
+
+/**
+ * @brief The 2-dim matrix multiplication on x86 with the bias and the activation computed in the epilogue of the
+ * native packed gemm, out = activation(alpha * op(A) * op(B) + bias).
+ *
+ * @param bias The bias of the shape [N], [1, N] or [M, N].
+ * @param activation The activation applied at last, it is one of "", "relu", "sigmoid" and "tanh".
+ *
+ * @return the output tensor and the tensor of the extern call
+ */
+std::vector<ir::Tensor> GemmBiasActCPU(const ir::Tensor& A,
+                                       const ir::Tensor& B,
+                                       const ir::Tensor& bias,
+                                       bool trans_a                  = false,
+                                       bool trans_b                  = false,
+                                       float alpha                   = 1,
+                                       const std::string& activation = "",
+                                       const std::string& name       = UniqName("T_Transform_GemmBiasActCPU_out"),
+                                       const common::Target& target  = common::DefaultHostTarget());
+
 int GetMulFactor(int shape, const Type& type, const common::Target& target);
 
 /**
@@ -111,6 +142,14 @@ std::vector<ir::Tensor> MulMKL(const ir::Tensor& A,
                                const std::string& name      = UniqName("T_Transform_MulMKL_out"),
                                const common::Target& target = common::DefaultHostTarget());
 
+/**
+ * @brief The mul of the 2-dim A [M, K] and B [N, K] on x86 by the native packed gemm of the host runtime.
+ */
+std::vector<ir::Tensor> MulCPU(const ir::Tensor& A,
+                               const ir::Tensor& B,
+                               const std::string& name      = UniqName("T_Transform_MulCPU_out"),
+                               const common::Target& target = common::DefaultHostTarget());
+
 ir::Tensor LayoutTransform(const ir::Tensor& input,
                            const std::string& src_layout,
                            const std::string& dst_layout,
@@ -243,7 +243,8 @@ Expr For::Make(Var loop_var,
                DeviceAPI device_api,
                Expr body,
                VectorizeInfo vector_info,
-               BindInfo bind_info) {
+               BindInfo bind_info,
+               ParallelInfo parallel_info) {
   auto node = make_shared<For>();
   CHECK(loop_var.defined());
   CHECK(min.defined());
@@ -256,9 +257,11 @@ Expr For::Make(Var loop_var,
   node->set_for_type(for_type);
   node->set_vectorize_info(vector_info);
   node->set_bind_info(bind_info);
+  node->set_parallel_info(parallel_info);
 
   if (node->is_vectorized()) CHECK(node->vectorize_info().valid());
   if (node->is_binded() && bind_info.offset >= 0) CHECK(node->bind_info().valid());
+  CHECK(node->parallel_info().valid()) << "The chunk size of a dynamic or guided parallel loop should be positive";
 
   return Expr(node);
 }
@@ -646,6 +646,28 @@ struct BindInfo {
   }
 };
 
+//! The way the iterations of a parallel loop are distributed over the threads.
+struct ParallelInfo {
+  enum class Schedule : int {
+    Static  = 0,  //! Split the iterations into one equal chunk per thread.
+    Dynamic = 1,  //! Threads grab chunks of `chunk_size` iterations from a shared counter.
+    Guided  = 2,  //! Like Dynamic, but the chunks shrink with the remaining iterations down to `chunk_size`.
+  };
+
+  ParallelInfo() = default;
+  ParallelInfo(Schedule schedule, int chunk_size) : schedule(schedule), chunk_size(chunk_size) {}
+
+  Schedule schedule{Schedule::Static};
+  int chunk_size{-1};
+
+  inline void set(Schedule schedule, int chunk_size) {
+    this->schedule   = schedule;
+    this->chunk_size = chunk_size;
+  }
+  inline bool is_dynamic() const { return schedule != Schedule::Static; }
+  inline bool valid() const { return schedule == Schedule::Static || chunk_size > 0; }
+};
+
 struct ForBase {
   ForType for_type() const { return for_type_; }
   void set_for_type(ForType x) { for_type_ = x; }
@@ -658,8 +680,13 @@ struct ForBase {
     if (x.valid()) set_binded(x.for_type);
     bind_info_ = x;
   }
+  void set_parallel_info(const ParallelInfo& x) {
+    if (x.is_dynamic()) set_parallel();
+    parallel_info_ = x;
+  }
   const VectorizeInfo& vectorize_info() const { return vectorize_info_; }
   const BindInfo& bind_info() const { return bind_info_; }
+  const ParallelInfo& parallel_info() const { return parallel_info_; }
 
   void reset_vectorize_info() {
     set_vectorized(false);
@@ -715,6 +742,7 @@ struct ForBase {
   ForType for_type_{ForType::Serial};
   VectorizeInfo vectorize_info_;
   BindInfo bind_info_;
+  ParallelInfo parallel_info_;
 };
 
 /// LLVM loop unroll metadata infomation
@@ -723,6 +751,8 @@ struct LLVMForLoopMeta {
 
   UnrollMode unroll_mode{DefaultUnroll};
   bool vectorization{true};
+  //! The vectorization width hinted to LLVM, 0 means letting LLVM decide it.
+  int vectorize_width{0};
 };
 
 struct For : public ExprNode<For>, public ForBase {
@@ -745,8 +775,9 @@ struct For : public ExprNode<For>, public ForBase {
                    ForType for_type,
                    DeviceAPI device_api,
                    Expr body,
-                   VectorizeInfo vector_info = VectorizeInfo(),
-                   BindInfo bind_info        = BindInfo());
+                   VectorizeInfo vector_info  = VectorizeInfo(),
+                   BindInfo bind_info         = BindInfo(),
+                   ParallelInfo parallel_info = ParallelInfo());
 
   void Verify() const override;
 
@@ -78,7 +78,14 @@ void IrPrinter::Visit(const Minus *x) {
 }
 void IrPrinter::Visit(const For *x) {
   if (x->is_parallel()) {
-    os() << "parallel for (";
+    auto &parallel_info = x->parallel_info();
+    if (parallel_info.schedule == ParallelInfo::Schedule::Dynamic) {
+      os() << "parallel_dynamic_" << parallel_info.chunk_size << " for (";
+    } else if (parallel_info.schedule == ParallelInfo::Schedule::Guided) {
+      os() << "parallel_guided_" << parallel_info.chunk_size << " for (";
+    } else {
+      os() << "parallel for (";
+    }
   } else if (x->is_unrolled()) {
     os() << "unroll for (";
   } else if (x->is_vectorized()) {
@@ -184,6 +184,23 @@ void IRSchedule::MutateForType(const Expr& loop, ForType for_type, int factor) {
 
 void IRSchedule::Parallel(const Expr& loop) { MutateForType(loop, ForType::Parallel); }
 
+void IRSchedule::Parallel(const Expr& loop, ParallelInfo::Schedule schedule, int chunk_size) {
+  if (schedule == ParallelInfo::Schedule::Static) {
+    Parallel(loop);
+    return;
+  }
+  CHECK_GT(chunk_size, 0) << "chunk size of dynamic or guided parallel loop should be more than 0";
+  auto* for_node = loop.As<ir::For>();
+  CHECK(for_node) << "loop param must be For node! Please check.";
+  CHECK(for_node->is_serial()) << "loop is not serial, current forloop type is "
+                               << static_cast<int>(for_node->for_type());
+  auto loop_copy     = optim::IRCopy(loop);
+  auto* new_for_node = loop_copy.As<ir::For>();
+  CHECK(new_for_node);
+  new_for_node->set_parallel_info(ParallelInfo(schedule, chunk_size));
+  helper_.Replace(loop, loop_copy);
+}
+
 void IRSchedule::Vectorize(const Expr& loop, int factor) {
   CHECK_GT(factor, 0) << "vectorize factor should be more than 0";
   MutateForType(loop, ForType::Vectorized, factor);
@@ -1343,7 +1360,8 @@ void IRSchedule::CopyTransformAndLoopInfo(const Expr& block, const Expr& block_t
                     for_loop->device_api,
                     new_loop,
                     for_loop->vectorize_info(),
-                    for_loop->bind_info());
+                    for_loop->bind_info(),
+                    for_loop->parallel_info());
   } else {
     Expr outer_loop                = used_target_loops.front();
     Expr inner_loop                = used_target_loops.back();
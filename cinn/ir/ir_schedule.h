@@ -266,6 +266,15 @@ class IRSchedule {
    */
   void Parallel(const Expr& loop);
 
+  /**
+   * \brief Parallelize the given loop, the threads take the chunks of its iterations on demand.
+   * @param loop the loop to parallel.
+   * @param schedule the way to distribute the iterations, Dynamic takes chunks of chunk_size iterations,
+   * Guided takes chunks proportional to the remaining iterations but no smaller than chunk_size.
+   * @param chunk_size the number of iterations a thread takes at least each time.
+   */
+  void Parallel(const Expr& loop, ParallelInfo::Schedule schedule, int chunk_size);
+
   /**
    * \brief Vectorize the given loop.
    * @param loop the loop to vectorize.
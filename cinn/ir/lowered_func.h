@@ -156,6 +156,10 @@ struct _LoweredFunc_ : ExprNode<_LoweredFunc_> {
 
   std::vector<Expr> argument_prepare_exprs;
 
+  //! Whether the buffer arguments never overlap when the function is called, the codegen assumes the accesses of
+  //! different argument buffers don't alias only if it is set.
+  bool distinct_buffer_args{false};
+
   static LoweredFunc Make(const std::string& name,
                           const std::vector<Argument>& args,
                           const Expr& body,
@@ -0,0 +1,269 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/optim/common_subexpression_elimination.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "cinn/common/context.h"
+#include "cinn/ir/ir_mutator.h"
+#include "cinn/ir/ir_printer.h"
+
+namespace cinn {
+namespace optim {
+
+namespace {
+
+bool IsScalarValueType(const Type& type) {
+  return type.lanes() == 1 && (type.is_float() || type.is_integer() || type.is_bool()) && !type.is_cpp_handle() &&
+         !type.is_cpp_handle2();
+}
+
+bool IsCommutative(ir::IrNodeTy type) {
+  switch (type) {
+    case ir::IrNodeTy::Add:
+    case ir::IrNodeTy::Mul:
+    case ir::IrNodeTy::EQ:
+    case ir::IrNodeTy::NE:
+    case ir::IrNodeTy::And:
+    case ir::IrNodeTy::Or:
+    case ir::IrNodeTy::Min:
+    case ir::IrNodeTy::Max:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+std::string GetMemoryName(const Expr& tensor) {
+  if (auto* t = tensor.As<ir::_Tensor_>()) {
+    return t->buffer.defined() ? t->buffer->name : t->name;
+  }
+  if (auto* var = tensor.As<ir::_Var_>()) {
+    return var->name;
+  }
+  return utils::GetStreamCnt(tensor);
+}
+
+bool IsPureCall(const ir::Call* call) {
+  if (!call->is_extern_call() || !call->write_args.empty() || !IsScalarValueType(call->type())) return false;
+  return std::all_of(call->read_args.begin(), call->read_args.end(), [](const Expr& arg) {
+    return IsScalarValueType(arg.type());
+  });
+}
+
+const ExprHashCons::Info& ExprHashCons::Visit(const Expr& expr) {
+  auto it = infos_.find(expr.get());
+  if (it != infos_.end()) return it->second;
+
+  Info info;
+  std::stringstream ss;
+  ss << static_cast<int>(expr.node_type()) << ":" << expr.type() << ":";
+  std::vector<const Expr*> children;
+  bool supported = IsScalarValueType(expr.type());
+  switch (expr.node_type()) {
+    case ir::IrNodeTy::IntImm:
+      ss << expr.As<ir::IntImm>()->value;
+      break;
+    case ir::IrNodeTy::UIntImm:
+      ss << expr.As<ir::UIntImm>()->value;
+      break;
+    case ir::IrNodeTy::FloatImm:
+      ss << std::setprecision(std::numeric_limits<double>::max_digits10) << expr.As<ir::FloatImm>()->value;
+      break;
+    case ir::IrNodeTy::_Var_:
+      ss << expr.As<ir::_Var_>()->name;
+      break;
+    case ir::IrNodeTy::Load: {
+      auto* load = expr.As<ir::Load>();
+      ss << load->name();
+      for (auto& index : load->indices) {
+        children.push_back(&index);
+      }
+      info.loads.insert(GetMemoryName(load->tensor));
+      break;
+    }
+    case ir::IrNodeTy::Call: {
+      auto* call = expr.As<ir::Call>();
+      supported &= IsPureCall(call);
+      ss << call->name;
+      for (auto& arg : call->read_args) {
+        children.push_back(&arg);
+      }
+      break;
+    }
+#define __m(t__) case ir::IrNodeTy::t__:
+      NODETY_OP_FOR_EACH(__m)
+#undef __m
+    case ir::IrNodeTy::Cast:
+    case ir::IrNodeTy::Select:
+      for (auto* field : expr->expr_fields()) {
+        children.push_back(field);
+      }
+      break;
+    default:
+      supported = false;
+  }
+
+  std::vector<int> child_ids;
+  for (auto* child : children) {
+    const Info& child_info = Visit(*child);
+    supported &= child_info.id >= 0;
+    child_ids.push_back(child_info.id);
+    info.size += child_info.size;
+    info.loads.insert(child_info.loads.begin(), child_info.loads.end());
+  }
+  if (IsCommutative(expr.node_type())) {
+    std::sort(child_ids.begin(), child_ids.end());
+  }
+  if (supported) {
+    for (int id : child_ids) {
+      ss << id << ",";
+    }
+    info.id = ids_.emplace(ss.str(), ids_.size()).first->second;
+  }
+  return infos_.emplace(expr.get(), std::move(info)).first->second;
+}
+
+namespace {
+
+// An occurrence of a subexpression in a statement of a block
+struct Occurrence {
+  int stmt;
+  Expr* expr;
+};
+
+class CommonSubexpressionEliminator : public ir::IRMutator<Expr*> {
+ public:
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+ private:
+  void Visit(const ir::Block* op, Expr* expr) override {
+    ir::IRMutator<>::Visit(op, expr);
+    auto* node = expr->As<ir::Block>();
+    while (EliminateOnce(&node->stmts)) {
+    }
+  }
+
+  void Visit(const ir::For* op, Expr* expr) override {
+    if (op->is_vectorized() || op->is_unrolled()) return;
+    ir::IRMutator<>::Visit(op, expr);
+    auto* node = expr->As<ir::For>();
+    if (!node->body.As<ir::Block>()) {
+      std::vector<Expr> stmts({node->body});
+      if (EliminateOnce(&stmts)) {
+        while (EliminateOnce(&stmts)) {
+        }
+        node->body = ir::Block::Make(stmts);
+      }
+    }
+  }
+
+  // Collect the candidate subexpressions of a statement, the branches of a select are skipped
+  void Collect(Expr* expr, int stmt, ExprHashCons* table, std::unordered_map<int, std::vector<Occurrence>>* res) {
+    if (!expr->defined() || expr->is_constant() || expr->is_var()) return;
+    int id = table->GetId(*expr);
+    if (id >= 0) {
+      (*res)[id].push_back({stmt, expr});
+    }
+    if (auto* select = expr->As<ir::Select>()) {
+      Collect(&select->condition, stmt, table, res);
+      return;
+    }
+    auto fields = expr->As<ir::Load>() ? std::vector<Expr*>() : (*expr)->expr_fields();
+    if (auto* load = expr->As<ir::Load>()) {
+      for (auto& index : load->indices) {
+        fields.push_back(&index);
+      }
+    }
+    for (auto* field : fields) {
+      Collect(field, stmt, table, res);
+    }
+  }
+
+  // Share the largest common subexpression by a Let, returns false if there is none
+  bool EliminateOnce(std::vector<Expr>* stmts) {
+    ExprHashCons table;
+    std::unordered_map<int, std::vector<Occurrence>> occurrences;
+    // the statements ending the sharing, and the memory written by the statements
+    std::vector<bool> barriers(stmts->size(), false);
+    std::vector<std::string> written(stmts->size());
+    for (int i = 0; i < stmts->size(); ++i) {
+      Expr& stmt = (*stmts)[i];
+      bool impure = !ir::CollectIRNodes(stmt, [](const Expr* x) {
+                       return x->As<ir::Call>() && !IsPureCall(x->As<ir::Call>());
+                     }).empty();
+      // a store to a scalar address changes the variable, which is not tracked
+      if (impure || (stmt.As<ir::Store>() && stmt.As<ir::Store>()->is_addr_scalar())) {
+        barriers[i] = true;
+      } else if (auto* store = stmt.As<ir::Store>()) {
+        written[i] = GetMemoryName(store->tensor);
+        Collect(&store->value, i, &table, &occurrences);
+        for (auto& index : store->indices) {
+          Collect(&index, i, &table, &occurrences);
+        }
+      } else if (auto* let = stmt.As<ir::Let>()) {
+        Collect(&let->body, i, &table, &occurrences);
+      } else {
+        barriers[i] = true;
+      }
+    }
+
+    int best_id   = -1;
+    int best_size = 0;
+    std::vector<Occurrence> best;
+    for (auto& item : occurrences) {
+      auto& occs  = item.second;
+      auto& loads = table.GetLoadedMemory(*occs.front().expr);
+      int size    = table.GetSize(*occs.front().expr);
+      // a group of occurrences is shared until a barrier or a statement writing the memory they load
+      for (size_t begin = 0, end = 1; begin < occs.size(); begin = end++) {
+        for (int stmt = occs[begin].stmt; end < occs.size(); ++end) {
+          for (; stmt < occs[end].stmt; ++stmt) {
+            if (loads.count(written[stmt]) || barriers[stmt + 1]) break;
+          }
+          if (stmt < occs[end].stmt) break;
+        }
+        if (end - begin >= 2 && (size > best_size || (size == best_size && item.first < best_id))) {
+          best_id   = item.first;
+          best_size = size;
+          best.assign(occs.begin() + begin, occs.begin() + end);
+        }
+      }
+    }
+    if (best.empty()) return false;
+
+    Expr value = *best.front().expr;
+    Var tmp(common::UniqName("cse"), value.type());
+    VLOG(4) << "Share " << value << " by " << tmp << " in " << best.size() << " places";
+    for (auto& occ : best) {
+      *occ.expr = tmp;
+    }
+    stmts->insert(stmts->begin() + best.front().stmt, ir::Let::Make(tmp, value));
+    return true;
+  }
+};
+
+}  // namespace
+
+void EliminateCommonSubexpression(Expr* expr) { CommonSubexpressionEliminator()(expr); }
+
+}  // namespace optim
+}  // namespace cinn
@@ -0,0 +1,75 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "cinn/ir/ir.h"
+
+namespace cinn {
+namespace optim {
+
+/**
+ * Hash-consing of the pure scalar expressions, the structurally equal expressions get the same id. The
+ * commutative operands are ordered, and the loads are identified by their tensors and indices, so the
+ * caller should check that the loaded memory is not written between two loads with the same id.
+ *
+ * The ids are cached by the nodes, a new instance should be used after the expressions are mutated.
+ */
+class ExprHashCons {
+ public:
+  //! Return the id of an expression, or -1 if it has side effects or is not supported.
+  int GetId(const Expr& expr) { return Visit(expr).id; }
+
+  //! Return the number of the nodes of an expression.
+  int GetSize(const Expr& expr) { return Visit(expr).size; }
+
+  //! Return the names of the memory loaded by an expression.
+  const std::set<std::string>& GetLoadedMemory(const Expr& expr) { return Visit(expr).loads; }
+
+ private:
+  struct Info {
+    int id{-1};
+    int size{1};
+    std::set<std::string> loads;
+  };
+
+  const Info& Visit(const Expr& expr);
+
+  std::unordered_map<const ir::IrNode*, Info> infos_;
+  std::unordered_map<std::string, int> ids_;
+};
+
+//! Return the name of the memory of a tensor or a scalar address, the tensors sharing a buffer have the same one.
+std::string GetMemoryName(const Expr& tensor);
+
+//! Tell whether a call is a pure scalar function, such as the extern math functions.
+bool IsPureCall(const ir::Call* call);
+
+/**
+ * Eliminate the common subexpressions of the consecutive statements in a block.
+ *
+ * The repeated pure scalar subexpressions of the stores are computed once into a Let before their first
+ * statement, the largest ones first. A load is only shared until its memory is written, and a statement
+ * other than a Store or a Let, or one calling an impure function, ends the statements sharing a Let. The
+ * branches of a select are not shared since they are evaluated conditionally.
+ *
+ * The vectorized and unrolled loops are skipped, since their bodies are transformed later.
+ */
+void EliminateCommonSubexpression(Expr* expr);
+
+}  // namespace optim
+}  // namespace cinn
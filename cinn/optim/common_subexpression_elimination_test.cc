@@ -0,0 +1,77 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/optim/common_subexpression_elimination.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_operators.h"
+
+namespace cinn {
+namespace optim {
+
+using namespace ir;  // NOLINT
+
+bool LoadsTensor(Expr expr, const std::string& name) {
+  return !CollectIRNodes(expr, [&](const Expr* x) { return x->As<Load>() && x->As<Load>()->name() == name; }).empty();
+}
+
+TEST(EliminateCommonSubexpression, shared_until_written) {
+  Placeholder<float> A("A", std::vector<int>{{10}});
+  Placeholder<float> B("B", std::vector<int>{{10}});
+  Placeholder<float> C("C", std::vector<int>{{10}});
+  Placeholder<float> D("D", std::vector<int>{{10}});
+  Var i("i");
+
+  auto a    = [&] { return Load::Make(ir::Tensor(A), {Expr(i)}); };
+  auto b    = [&] { return Load::Make(ir::Tensor(B), {Expr(i)}); };
+  Expr body = Block::Make({Store::Make(ir::Tensor(C), a() * b() + 1.f, {Expr(i)}),
+                           Store::Make(ir::Tensor(D), a() * b() + 2.f, {Expr(i)}),
+                           Store::Make(ir::Tensor(A), Expr(0.f), {Expr(i)}),
+                           Store::Make(ir::Tensor(C), a() * b(), {Expr(i)})});
+  EliminateCommonSubexpression(&body);
+  LOG(INFO) << "After CSE:\n" << body;
+
+  // B[i] is shared by all the statements, A[i] * B[i] is shared until A is written
+  auto& stmts = body.As<Block>()->stmts;
+  ASSERT_EQ(stmts.size(), 6U);
+  ASSERT_TRUE(stmts[0].As<Let>());
+  ASSERT_TRUE(stmts[1].As<Let>());
+  EXPECT_TRUE(stmts[0].As<Let>()->body.As<Load>());
+  EXPECT_TRUE(LoadsTensor(stmts[1].As<Let>()->body, "A"));
+  EXPECT_FALSE(LoadsTensor(stmts[2], "A"));
+  EXPECT_FALSE(LoadsTensor(stmts[3], "A"));
+  EXPECT_TRUE(LoadsTensor(stmts[5], "A"));
+  EXPECT_FALSE(LoadsTensor(stmts[5], "B"));
+}
+
+TEST(EliminateCommonSubexpression, select_branches) {
+  Placeholder<float> A("A", std::vector<int>{{10}});
+  Placeholder<float> C("C", std::vector<int>{{10}});
+  Var i("i");
+
+  // the branch of the select is only evaluated if the condition holds
+  Expr a     = Load::Make(ir::Tensor(A), {Expr(i) - 1});
+  Expr value = Select::Make(Expr(i) > 0, a * 2.f, Expr(0.f)) + Load::Make(ir::Tensor(A), {Expr(i) - 1}) * 2.f;
+  Expr body  = Block::Make({Store::Make(ir::Tensor(C), value, {Expr(i)})});
+  EliminateCommonSubexpression(&body);
+  LOG(INFO) << "After CSE:\n" << body;
+
+  EXPECT_EQ(body.As<Block>()->stmts.size(), 1U);
+}
+
+}  // namespace optim
+}  // namespace cinn
@@ -0,0 +1,80 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/optim/count_float_ops.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "cinn/ir/ir_mutator.h"
+
+namespace cinn::optim {
+
+namespace {
+struct FloatOpsCounter : public ir::IRMutator<const Expr*> {
+  using ir::IRMutator<const Expr*>::Visit;
+
+  void Visit(const ir::For* expr, const Expr* op) override {
+    extents.push_back(expr->extent.is_constant() ? std::max(expr->extent.get_constant(), 1.0) : 1.0);
+    Visit(&expr->body, &expr->body);
+    extents.pop_back();
+  }
+
+  void Visit(const ir::ScheduleBlockRealize* expr, const Expr* op) override {
+    auto* block = expr->schedule_block.As<ir::ScheduleBlock>();
+    CHECK(block) << "The schedule_block of ScheduleBlockRealize should be a ScheduleBlock";
+    // the buffer regions of the block are not executed
+    Visit(&block->body, &block->body);
+  }
+
+  void Visit(const ir::Store* expr, const Expr* op) override { Visit(&expr->value, &expr->value); }
+
+  void Visit(const ir::Load* expr, const Expr* op) override {}
+
+#define __(op__)                                              \
+  void Visit(const ir::op__* expr, const Expr* op) override { \
+    AddOp(expr->type());                                      \
+    IRMutator::Visit(expr, op);                               \
+  }
+  __(Add)
+  __(Sub)
+  __(Mul)
+  __(Div)
+  __(Mod)
+  __(Min)
+  __(Max)
+  __(Minus)
+#undef __
+
+  void AddOp(const common::Type& type) {
+    if (!type.is_float()) return;
+    double iterations = 1.0;
+    for (double extent : extents) {
+      iterations *= extent;
+    }
+    float_ops += iterations * std::max(type.lanes(), 1);
+  }
+
+  std::vector<double> extents;
+  double float_ops{0.0};
+};
+}  // namespace
+
+double CountFloatOps(const Expr& expr) {
+  FloatOpsCounter counter;
+  counter.Visit(&expr, &expr);
+  return counter.float_ops;
+}
+
+}  // namespace cinn::optim
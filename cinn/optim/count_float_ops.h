@@ -0,0 +1,30 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "cinn/ir/ir.h"
+
+namespace cinn::optim {
+
+/**
+ * Count the float arithmetic operations executed by an expr, used to estimate the FLOPs of a kernel.
+ *
+ * Each operation is weighted by the iterations of the loops around it and the lanes of its type, the loops of a
+ * non-constant extent count once. Only the values of the stores are counted, as the index arithmetic is usually
+ * simplified by the compiler.
+ */
+double CountFloatOps(const Expr& expr);
+
+}  // namespace cinn::optim
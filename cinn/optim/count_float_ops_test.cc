@@ -0,0 +1,44 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/optim/count_float_ops.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/lang/lower.h"
+
+namespace cinn {
+namespace optim {
+
+TEST(CountFloatOps, elementwise) {
+  Expr M(100);
+  Expr N(4);
+
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+
+  // the index arithmetic is not counted
+  Tensor C = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) * B(i, j) + A(i, j); }, "C");
+
+  auto stages = CreateStages({C});
+
+  Target target = common::DefaultHostTarget();
+  auto func     = cinn::lang::LowerVec("test_count_float_ops", stages, {A, B, C}, {}, {}, nullptr, target, true);
+  EXPECT_EQ(CountFloatOps(func[0]->body), 2 * 100 * 4);
+}
+
+}  // namespace optim
+}  // namespace cinn
@@ -192,8 +192,17 @@ struct IRCopyVisitor : public ir::IRVisitorBase<Expr> {
     auto min    = Visit(&op->min);
     auto body   = Visit(&op->body);
 
-    return ir::For::Make(
-        op->loop_var, min, extent, op->for_type(), op->device_api, body, op->vectorize_info(), op->bind_info());
+    auto copied = ir::For::Make(op->loop_var,
+                                min,
+                                extent,
+                                op->for_type(),
+                                op->device_api,
+                                body,
+                                op->vectorize_info(),
+                                op->bind_info(),
+                                op->parallel_info());
+    copied.As<ir::For>()->metadata = op->metadata;
+    return copied;
   }
 
   Expr Visit(const ir::PolyFor* op) override {
@@ -250,6 +259,8 @@ struct IRCopyVisitor : public ir::IRVisitorBase<Expr> {
 
     func->cuda_axis_info = op->cuda_axis_info;
 
+    func->distinct_buffer_args = op->distinct_buffer_args;
+
     std::vector<Expr> alloc_output_buffer_exprs;
     std::vector<Expr> dealloc_output_buffer_exprs;
     std::vector<Expr> buffer_data_cast_exprs;
@@ -0,0 +1,224 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/optim/loop_invariant_code_motion.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/context.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_mutator.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/optim/common_subexpression_elimination.h"
+
+namespace cinn {
+namespace optim {
+
+namespace {
+
+// splice the nested blocks into the statements
+void FlattenBlocks(const std::vector<Expr>& stmts, std::vector<Expr>* res) {
+  for (auto& stmt : stmts) {
+    if (auto* block = stmt.As<ir::Block>()) {
+      FlattenBlocks(block->stmts, res);
+    } else {
+      res->push_back(stmt);
+    }
+  }
+}
+
+// Hoist the invariant computations of the body of a loop
+class LoopBodyHoister {
+ public:
+  explicit LoopBodyHoister(const ir::For* loop) {
+    variant_vars_.insert(loop->loop_var->name);
+    auto* extent = loop->extent.As<ir::IntImm>();
+    speculative_ = extent && extent->value > 0;
+    ir::CollectIRNodesWithoutTensor(loop->body, [&](const Expr* x) {
+      if (auto* inner = x->As<ir::For>()) {
+        variant_vars_.insert(inner->loop_var->name);
+      } else if (auto* let = x->As<ir::Let>()) {
+        variant_vars_.insert(let->symbol.as_var()->name);
+      } else if (auto* block = x->As<ir::ScheduleBlock>()) {
+        for (auto& var : block->iter_vars) {
+          variant_vars_.insert(var->name);
+        }
+      } else if (auto* store = x->As<ir::Store>()) {
+        written_.insert(GetMemoryName(store->tensor));
+        // a store to an address variable may alias any tensor
+        if (store->is_addr_scalar()) {
+          variant_vars_.insert(GetMemoryName(store->tensor));
+          impure_ = true;
+        }
+      } else if (auto* call = x->As<ir::Call>()) {
+        impure_ |= !IsPureCall(call);
+      }
+      return false;
+    });
+  }
+
+  // Hoist the invariant computations of the body, returns the Lets to put before the loop
+  std::vector<Expr> operator()(Expr* body) {
+    std::vector<Expr> stmts;
+    FlattenBlocks({*body}, &stmts);
+    std::vector<Expr> kept;
+    for (auto& stmt : stmts) {
+      auto* let = stmt.As<ir::Let>();
+      if (let && let->body.defined()) {
+        auto& name     = let->symbol.as_var()->name;
+        bool invariant = Check(&let->body, true);
+        // a variable stored later is not a constant of the loop
+        if (invariant && !written_.count(name)) {
+          VLOG(4) << "Hoist " << stmt;
+          lets_.push_back(stmt);
+          variant_vars_.erase(name);
+          continue;
+        }
+        if (invariant) Share(&let->body);
+      } else if (auto* store = stmt.As<ir::Store>()) {
+        Hoist(&store->value);
+        for (auto& index : store->indices) {
+          Hoist(&index);
+        }
+      }
+      kept.push_back(stmt);
+    }
+    if (!lets_.empty()) {
+      *body = ir::Block::Make(kept);
+    }
+    return std::move(lets_);
+  }
+
+ private:
+  void Hoist(Expr* expr) {
+    if (Check(expr, true)) Share(expr);
+  }
+
+  // Tell whether an expression is invariant, the invariant operands of a variant one are hoisted if required
+  bool Check(Expr* expr, bool hoist) {
+    if (auto* var = expr->As<ir::_Var_>()) return !variant_vars_.count(var->name);
+    if (expr->is_constant()) return true;
+
+    std::vector<Expr*> operands;
+    bool invariant = true;
+    switch (expr->node_type()) {
+      case ir::IrNodeTy::Load:
+        for (auto& index : expr->As<ir::Load>()->indices) {
+          operands.push_back(&index);
+        }
+        invariant = speculative_ && !impure_ && !written_.count(GetMemoryName(expr->As<ir::Load>()->tensor));
+        break;
+      case ir::IrNodeTy::Select: {
+        // the branches are evaluated conditionally, they are only hoisted with the select
+        auto* select = expr->As<ir::Select>();
+        operands.push_back(&select->condition);
+        invariant = Check(&select->true_value, false) && Check(&select->false_value, false);
+        break;
+      }
+      case ir::IrNodeTy::Call:
+        operands  = (*expr)->expr_fields();
+        invariant = IsPureCall(expr->As<ir::Call>());
+        break;
+      case ir::IrNodeTy::Div:
+      case ir::IrNodeTy::Mod:
+        operands  = (*expr)->expr_fields();
+        invariant = speculative_;
+        break;
+      case ir::IrNodeTy::Add:
+      case ir::IrNodeTy::Sub:
+      case ir::IrNodeTy::Mul:
+      case ir::IrNodeTy::EQ:
+      case ir::IrNodeTy::NE:
+      case ir::IrNodeTy::LT:
+      case ir::IrNodeTy::LE:
+      case ir::IrNodeTy::GT:
+      case ir::IrNodeTy::GE:
+      case ir::IrNodeTy::And:
+      case ir::IrNodeTy::Or:
+      case ir::IrNodeTy::Min:
+      case ir::IrNodeTy::Max:
+      case ir::IrNodeTy::Minus:
+      case ir::IrNodeTy::Not:
+      case ir::IrNodeTy::Cast:
+        operands = (*expr)->expr_fields();
+        break;
+      default:
+        // the other nodes, such as the ramps of the vectorized loads, are not hoisted as a whole
+        operands  = (*expr)->expr_fields();
+        invariant = false;
+    }
+
+    std::vector<bool> invariant_operands;
+    for (auto* operand : operands) {
+      invariant_operands.push_back(Check(operand, hoist));
+      invariant &= invariant_operands.back();
+    }
+    if (!invariant && hoist) {
+      for (int i = 0; i < operands.size(); ++i) {
+        if (invariant_operands[i]) Share(operands[i]);
+      }
+    }
+    return invariant;
+  }
+
+  // replace an invariant expression by a Let before the loop, the equal ones share the same Let
+  void Share(Expr* expr) {
+    if (expr->is_constant() || expr->is_var()) return;
+    int id = table_.GetId(*expr);
+    if (id < 0) return;
+    auto it = id2var_.find(id);
+    if (it == id2var_.end()) {
+      Var tmp(common::UniqName("licm"), expr->type());
+      VLOG(4) << "Hoist " << *expr << " as " << tmp;
+      lets_.push_back(ir::Let::Make(tmp, *expr));
+      it = id2var_.emplace(id, tmp).first;
+    }
+    *expr = it->second;
+  }
+
+  std::unordered_set<std::string> variant_vars_;
+  std::unordered_set<std::string> written_;
+  bool impure_{false};
+  bool speculative_{false};
+  ExprHashCons table_;
+  std::unordered_map<int, Var> id2var_;
+  std::vector<Expr> lets_;
+};
+
+struct LoopInvariantCodeMotion : public ir::IRMutator<Expr*> {
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+ private:
+  void Visit(const ir::For* op, Expr* expr) override {
+    if (op->is_vectorized() || op->is_unrolled()) return;
+    ir::IRMutator<>::Visit(op, expr);
+    if (op->is_parallel() || op->is_binded()) return;
+
+    auto* node = expr->As<ir::For>();
+    auto lets  = LoopBodyHoister(node)(&node->body);
+    if (lets.empty()) return;
+    lets.push_back(*expr);
+    *expr = ir::Block::Make(lets);
+  }
+};
+
+}  // namespace
+
+void HoistLoopInvariants(Expr* expr) { LoopInvariantCodeMotion()(expr); }
+
+}  // namespace optim
+}  // namespace cinn
@@ -0,0 +1,36 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include "cinn/ir/ir.h"
+
+namespace cinn {
+namespace optim {
+
+/**
+ * Hoist the loop-invariant computations out of the serial loops into Lets before them.
+ *
+ * An invariant expression only uses the variables defined outside the loop, and loads the memory not written
+ * by the loop. The largest invariant pure scalar subexpressions of the unconditional statements of a loop
+ * body are hoisted, and the equal ones share a Let, the invariant Lets of the body are moved out too. The
+ * loads and the divisions are only hoisted from the loops with a constant positive extent, so they are not
+ * evaluated by a loop never run.
+ *
+ * The inner loops are processed first, so the hoisted computations move out as far as they are invariant.
+ * The parallel and the GPU bound loops keep their bodies, and the vectorized and unrolled loops are skipped.
+ */
+void HoistLoopInvariants(Expr* expr);
+
+}  // namespace optim
+}  // namespace cinn
@@ -0,0 +1,101 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/optim/loop_invariant_code_motion.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/common/ir_util.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_operators.h"
+
+namespace cinn {
+namespace optim {
+
+using namespace ir;  // NOLINT
+
+bool LoadsTensor(Expr expr, const std::string& name) {
+  return !CollectIRNodes(expr, [&](const Expr* x) { return x->As<Load>() && x->As<Load>()->name() == name; }).empty();
+}
+
+Expr MakeFor(Var loop_var, Expr extent, Expr body) {
+  return For::Make(loop_var,
+                   common::make_const(0),
+                   extent,
+                   ForType::Serial,
+                   DeviceAPI::Host,
+                   body.As<Block>() ? body : Block::Make({body}));
+}
+
+TEST(HoistLoopInvariants, nested_loops) {
+  Placeholder<float> A("A", std::vector<int>{{8}});
+  Placeholder<float> B("B", std::vector<int>{{16}});
+  Placeholder<float> C("C", std::vector<int>{{128}});
+  Placeholder<float> D("D", std::vector<int>{{1}});
+  Var i("i");
+  Var j("j");
+
+  Expr value = Load::Make(ir::Tensor(A), {Expr(i)}) * Load::Make(ir::Tensor(B), {Expr(j)}) +
+               Load::Make(ir::Tensor(D), {Expr(0)});
+  Expr store = Store::Make(ir::Tensor(C), value, {Expr(i) * 16 + Expr(j)});
+  Expr expr  = MakeFor(i, Expr(8), MakeFor(j, Expr(16), store));
+  HoistLoopInvariants(&expr);
+  LOG(INFO) << "After LICM:\n" << expr;
+
+  // D[0] is hoisted out of both the loops, A[i] and i * 16 are hoisted out of the inner loop
+  auto* outer_block = expr.As<Block>();
+  ASSERT_TRUE(outer_block);
+  ASSERT_EQ(outer_block->stmts.size(), 2U);
+  ASSERT_TRUE(outer_block->stmts[0].As<Let>());
+  EXPECT_TRUE(LoadsTensor(outer_block->stmts[0], "D"));
+
+  auto* outer_loop = outer_block->stmts[1].As<For>();
+  ASSERT_TRUE(outer_loop);
+  auto& outer_body = outer_loop->body.As<Block>()->stmts;
+  ASSERT_EQ(outer_body.size(), 3U);
+  EXPECT_TRUE(outer_body[0].As<Let>());
+  EXPECT_TRUE(outer_body[1].As<Let>());
+  auto* inner_loop = outer_body[2].As<For>();
+  ASSERT_TRUE(inner_loop);
+  EXPECT_FALSE(LoadsTensor(inner_loop->body, "A"));
+  EXPECT_FALSE(LoadsTensor(inner_loop->body, "D"));
+  EXPECT_TRUE(LoadsTensor(inner_loop->body, "B"));
+}
+
+TEST(HoistLoopInvariants, written_and_unknown_extent) {
+  Placeholder<float> A("A", std::vector<int>{{16}});
+  Placeholder<float> B("B", std::vector<int>{{16}});
+  Var j("j");
+  Var n("n");
+
+  // A is written by the loop, only B[0] is hoisted
+  Expr value = Load::Make(ir::Tensor(A), {Expr(0)}) + Load::Make(ir::Tensor(B), {Expr(0)});
+  Expr expr  = MakeFor(j, Expr(16), Store::Make(ir::Tensor(A), value, {Expr(j)}));
+  HoistLoopInvariants(&expr);
+  LOG(INFO) << "After LICM:\n" << expr;
+  ASSERT_TRUE(expr.As<Block>());
+  ASSERT_EQ(expr.As<Block>()->stmts.size(), 2U);
+  EXPECT_TRUE(LoadsTensor(expr.As<Block>()->stmts[0], "B"));
+  EXPECT_TRUE(LoadsTensor(expr.As<Block>()->stmts[1], "A"));
+
+  // the loop may not run, so the loads are kept in it
+  value = Load::Make(ir::Tensor(B), {Expr(0)}) * 2.f;
+  expr  = MakeFor(j, Expr(n), Store::Make(ir::Tensor(A), value, {Expr(j)}));
+  HoistLoopInvariants(&expr);
+  EXPECT_TRUE(expr.As<For>());
+}
+
+}  // namespace optim
+}  // namespace cinn
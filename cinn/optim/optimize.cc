@@ -19,6 +19,7 @@
 #include "cinn/optim/call_arg_list_to_pod_value.h"
 #include "cinn/optim/cast_bool_to_int8.h"
 #include "cinn/optim/cast_simplify.h"
+#include "cinn/optim/common_subexpression_elimination.h"
 #include "cinn/optim/eliminate_broadcast_in_forloop.h"
 #include "cinn/optim/extern_call_process.h"
 #include "cinn/optim/fold_cinn_call_arguments.h"
@@ -26,6 +27,7 @@
 #include "cinn/optim/insert_debug_log_callee.h"
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
+#include "cinn/optim/loop_invariant_code_motion.h"
 #include "cinn/optim/lower_function_call_bind_vars.h"
 #include "cinn/optim/lower_intrin.h"
 #include "cinn/optim/map_extern_call.h"
@@ -38,6 +40,7 @@
 #include "cinn/optim/vectorize_loops.h"
 
 DECLARE_bool(cinn_ir_schedule);
+DECLARE_bool(cinn_use_ir_cse_licm);
 
 namespace cinn {
 namespace optim {
@@ -68,6 +71,12 @@ Expr Optimize(Expr e, Target target, bool runtime_debug_info) {
   Simplify(&copied);
   IfSimplify(&copied);
 
+  // the expressions are canonicalized by Simplify, so the equal ones are found structurally
+  if (FLAGS_cinn_use_ir_cse_licm) {
+    EliminateCommonSubexpression(&copied);
+    HoistLoopInvariants(&copied);
+  }
+
   if (runtime_debug_info) {
     LOG(WARNING) << "Turn on runtime debug information output";
     InsertDebugLogCallee(&copied);
@@ -649,7 +649,8 @@ struct VectorizeLoops_ : public IRMutator<Expr *> {
       }
 
       if (extent_min || extent_max || !vectorizable_) {
-        // not vectorize if has tail blocks, for llvm to optimize
+        // not vectorize if has tail blocks, for llvm to optimize with the factor as a hint
+        node->metadata.vectorize_width = forloop->vectorize_info().factor;
         node->reset_vectorize_info();
         var_intervals.erase(forloop->loop_var->name);
         return;
@@ -62,12 +62,16 @@ void BindTarget(py::module *m) {
       .def_readwrite("arch", &Target::arch)
       .def_readwrite("bits", &Target::bits)
       .def_readwrite("features", &Target::features)
+      .def_readwrite("cpu_features", &Target::cpu_features)
       .def(py::init<>())
       .def(py::init<Target::OS, Target::Arch, Target::Bit, const std::vector<Target::Feature> &>())
       .def("defined", &Target::defined)
-      .def("runtime_arch", &Target::runtime_arch);
+      .def("runtime_arch", &Target::runtime_arch)
+      .def("isa_str", &Target::isa_str)
+      .def("same_cpu_features", &Target::same_cpu_features);
 
   m->def("DefaultHostTarget", &common::DefaultHostTarget).def("DefaultNVGPUTarget", &common::DefaultNVGPUTarget);
+  m->def("HostCpuFeatures", &common::HostCpuFeatures).def("CpuFeaturesOfIsa", &common::CpuFeaturesOfIsa);
 
   py::enum_<Target::OS> os(target, "OS");
   os.value("Unk", Target::OS::Unk).value("Linux", Target::OS::Linux).value("Windows", Target::OS::Windows);
@@ -142,6 +146,7 @@ void BindType(py::module *m) {
       .def("Int", &common::Int, py::arg("bits"), py::arg("lanes") = 1)
       .def("UInt", &common::UInt, py::arg("bits"), py::arg("lanes") = 1)
       .def("Float", &common::Float, py::arg("bits"), py::arg("lanes") = 1)
+      .def("BFloat16", &common::BFloat16, py::arg("lanes") = 1)
       .def("Bool", &common::Bool, py::arg("lanes") = 1)
       .def("String", &common::String);
 
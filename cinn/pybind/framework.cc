@@ -30,6 +30,14 @@ namespace cinn::pybind {
 
 namespace py = pybind11;
 using namespace cinn::hlir::framework;  // NOLINT
+
+namespace {
+// numpy has no bfloat16, so the bfloat16 tensors are exchanged as the uint16 of their bits.
+py::dtype NumpyDtype(const common::Type &type) {
+  return type.is_bfloat16() ? py::dtype::of<uint16_t>() : py::dtype(common::Type2Str(type));
+}
+}  // namespace
+
 void BindFramework(pybind11::module *m) {
   py::class_<Operator>(*m, "Operator")
       .def("get_op_attrs", [](const std::string &key) { return Operator::GetAttrs<StrategyFunction>(key); })
@@ -96,7 +104,7 @@ void BindFramework(pybind11::module *m) {
       .def("get_tensor",
            [](Scope &self, const std::string &name, const Target &target) {
              auto t = self.GetTensor(name);
-             py::dtype dt(common::Type2Str(t->type()));
+             py::dtype dt = NumpyDtype(t->type());
              py::array::ShapeContainer shape(t->shape().data().begin(), t->shape().data().end());
              py::array array(std::move(dt), std::move(shape));
              auto *mutable_data = array.mutable_data();
@@ -125,7 +133,7 @@ void BindFramework(pybind11::module *m) {
       .def("set_type", [](hlir::framework::Tensor &self, Type type) { self->set_type(type); })
       .def("numpy",
            [](hlir::framework::Tensor &self, const common::Target &target) {
-             py::dtype dt(common::Type2Str(self->type()));
+             py::dtype dt = NumpyDtype(self->type());
              py::array::ShapeContainer shape(self->shape().data().begin(), self->shape().data().end());
              py::array array(std::move(dt), std::move(shape));
              void *array_data = array.mutable_data();
@@ -146,19 +154,32 @@ void BindFramework(pybind11::module *m) {
              return array;
            })
       .def("from_numpy", [](hlir::framework::Tensor &self, py::array array, const common::Target &target) {
-        CHECK(array.dtype().is(py::dtype(common::Type2Str(self->type()))))
-            << "currently only support float32 data type as input";
         hlir::framework::shape_t shape;
         std::copy_n(array.shape(), array.ndim(), std::back_inserter(shape));
         CHECK_EQ(std::accumulate(shape.begin(), shape.end(), 1, [](int32_t a, int32_t b) { return a * b; }),
                  self->shape().numel());
+        const void *src = array.data();
+        // a float32 array is rounded to the 16-bit float tensor
+        std::vector<uint16_t> converted;
+        if (self->type().is_float(16) && array.dtype().is(py::dtype::of<float>())) {
+          auto *values = static_cast<const float *>(array.data());
+          converted.resize(self->shape().numel());
+          for (size_t i = 0; i < converted.size(); ++i) {
+            converted[i] = self->type().is_bfloat16() ? common::FloatToBFloat16Bits(values[i])
+                                                      : common::FloatToHalfBits(values[i]);
+          }
+          src = converted.data();
+        } else {
+          CHECK(array.dtype().is(NumpyDtype(self->type())))
+              << "the dtype of the array doesn't match the tensor type " << self->type();
+        }
         auto *data = self->mutable_data(target, self->type());
         if (target.arch == Target::Arch::X86) {
-          std::memcpy(data, array.data(), (self->shape().numel() * self->type().bits() + 7) / 8);
+          std::memcpy(data, src, (self->shape().numel() * self->type().bits() + 7) / 8);
         } else if (target.arch == Target::Arch::NVGPU) {
 #ifdef CINN_WITH_CUDA
           CUDA_CALL(cudaMemcpy(reinterpret_cast<void *>(data),
-                               reinterpret_cast<const void *>(array.data()),
+                               src,
                                (self->shape().numel() * self->type().bits() + 7) / 8,
                                cudaMemcpyHostToDevice));
 #else
@@ -506,6 +506,7 @@ void BindFrontend(pybind11::module *m) {
            py::arg("scale")            = 1.0f,
            py::arg("bias")             = 0.0f,
            py::arg("bias_after_scale") = true)
+      .def("cast", &NetBuilder::Cast, py::arg("a"), py::arg("dtype"))
       .def("softmax", &NetBuilder::Softmax, py::arg("a"), py::arg("axis") = -1, py::arg("data_format") = "AnyLayout")
       .def("dropout_infer",
            &NetBuilder::DropoutInfer,
@@ -24,6 +24,7 @@
 #include "cinn/pybind/bind.h"
 #include "cinn/runtime/cinn_runtime.h"
 #include "cinn/runtime/flags.h"
+#include "cinn/utils/profiler.h"
 
 namespace py = pybind11;
 namespace cinn::pybind {
@@ -128,6 +129,7 @@ void BindCinnRuntime(py::module *m) {
       .value("cinn_type_uint", cinn_type_uint)
       .value("cinn_type_float", cinn_type_float)
       .value("cinn_type_handle", cinn_type_handle)
+      .value("cinn_type_bfloat", cinn_type_bfloat)
       .export_values();
 
   py::class_<cinn_type_t> cinn_type(*m, "cinn_type_t");
@@ -267,6 +269,29 @@ void BindCinnRuntime(py::module *m) {
       .def("cinn_pod_value_to_buffer_p", &cinn_pod_value_to_buffer_p);
 
   m->def("set_cinn_cudnn_deterministic", &cinn::runtime::SetCinnCudnnDeterministic, py::arg("state") = true);
+
+  py::class_<utils::HostEventStat>(*m, "HostEventStat")
+      .def_readonly("name", &utils::HostEventStat::name)
+      .def_property_readonly("kind",
+                             [](const utils::HostEventStat &self) {
+                               return self.kind == utils::HostEvent::Kind::kInstruction ? "instruction" : "kernel";
+                             })
+      .def_readonly("count", &utils::HostEventStat::count)
+      .def_readonly("total_ns", &utils::HostEventStat::total_ns)
+      .def_readonly("max_ns", &utils::HostEventStat::max_ns)
+      .def_readonly("bytes", &utils::HostEventStat::bytes)
+      .def_readonly("flops", &utils::HostEventStat::flops);
+
+  m->def(
+       "enable_host_profiler",
+       [](size_t capacity) { utils::HostProfiler::Global().Enable(capacity); },
+       py::arg("capacity") = utils::HostProfiler::kDefaultCapacity)
+      .def("disable_host_profiler", [] { utils::HostProfiler::Global().Disable(); })
+      .def("clear_host_profiler", [] { utils::HostProfiler::Global().Clear(); })
+      .def("host_profiler_stats", [] { return utils::HostProfiler::Global().Aggregate(); })
+      .def("host_profiler_summary", [] { return utils::HostProfiler::Global().Summary(); })
+      .def("export_host_profiler_chrome_trace",
+           [](const std::string &path) { utils::HostProfiler::Global().ExportChromeTrace(path); });
 }
 }  // namespace
 
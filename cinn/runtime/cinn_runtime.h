@@ -45,13 +45,17 @@ typedef enum cinn_type_code_t {
   cinn_type_int    = 0,   //! signed int
   cinn_type_uint   = 1,   //! unsigned int
   cinn_type_float  = 2,   //! floating point
-  cinn_type_handle = 3    //! void*
+  cinn_type_handle = 3,   //! void*
+  cinn_type_bfloat = 4    //! bfloat16, the high 16 bits of float
 } cinn_type_code_t;
 
 #ifndef CINN_ATTRIBUTE_ALIGN
 #define CINN_ATTRIBUTE_ALIGN(n) __attribute__((aligned(n)))
 #endif
 
+//! The minimum alignment in bytes of the host buffers allocated by CINN, a cache line.
+#define CINN_HOST_BUFFER_ALIGNMENT 64
+
 /**
  * A tuntime tag for type in CINN system.
  */
@@ -92,6 +96,8 @@ extern cinn_type_t cinn_int32_t(int num_asterisks = 0);
 extern cinn_type_t cinn_int64_t(int num_asterisks = 0);
 extern cinn_type_t cinn_uint32_t(int num_asterisks = 0);
 extern cinn_type_t cinn_uint64_t(int num_asterisks = 0);
+extern cinn_type_t cinn_float16_t(int num_asterisks = 0);
+extern cinn_type_t cinn_bfloat16_t(int num_asterisks = 0);
 extern cinn_type_t cinn_float32_t(int num_asterisks = 0);
 extern cinn_type_t cinn_float64_t(int num_asterisks = 0);
 // @}
@@ -164,6 +170,11 @@ extern void* cinn_buffer_get_data_const_handle(const struct cinn_buffer_t* buf);
 //! Create a new default cinn_buffer.
 extern cinn_buffer_t* cinn_buffer_new_default(int target, uint64_t memory_size, int align = 32);
 
+//! The version of the program file exported by Program::Export and loaded by the tiny runtime.
+#define CINN_PROGRAM_FILE_VERSION 1
+//! The persistent buffers in the program file are aligned to pages, so they can be mapped from the file.
+#define CINN_PROGRAM_FILE_PAGE_SIZE 4096
+
 //! The raw representation of a buffer,used in the generated code/lib.
 #define CINN_BUFFER_MAX_DIMS 8
 typedef struct cinn_buffer_t {
@@ -32,11 +32,13 @@ int cinn_x86_malloc(void* context, cinn_buffer_t* buf) {
     if (buf->memory) {
       free(buf->memory);
     }
-    if (buf->align == 0) {
-      buf->memory = (unsigned char*)malloc(memory_size);
-    } else {
-      buf->memory = (unsigned char*)aligned_alloc(buf->align, memory_size);
+    // the host kernels assume the buffers aligned to CINN_HOST_BUFFER_ALIGNMENT at least
+    size_t align = buf->align > CINN_HOST_BUFFER_ALIGNMENT ? buf->align : CINN_HOST_BUFFER_ALIGNMENT;
+    void* memory = NULL;
+    if (posix_memalign(&memory, align, memory_size) != 0) {
+      memory = NULL;
     }
+    buf->memory = (unsigned char*)memory;
     buf->memory_size = memory_size;
     CINN_LOG("buf.memory size is %ld\n", buf->memory_size);
   }
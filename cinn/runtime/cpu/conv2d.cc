@@ -0,0 +1,630 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/conv2d.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/common/cas.h"
+#include "cinn/runtime/cpu/gemm.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+namespace {
+
+// clang-format off
+// The transform matrices of F(m x m, 3 x 3) in row-major, from "Fast Algorithms for Convolutional Neural Networks".
+const float kBT2[] = {1,  0, -1,  0,
+                      0,  1,  1,  0,
+                      0, -1,  1,  0,
+                      0,  1,  0, -1};
+const float kG2[]  = {1.f,   0.f,  0.f,
+                      0.5f,  0.5f, 0.5f,
+                      0.5f, -0.5f, 0.5f,
+                      0.f,   0.f,  1.f};
+const float kAT2[] = {1, 1,  1,  0,
+                      0, 1, -1, -1};
+
+const float kBT4[] = {4,  0, -5,  0, 1, 0,
+                      0, -4, -4,  1, 1, 0,
+                      0,  4, -4, -1, 1, 0,
+                      0, -2, -1,  2, 1, 0,
+                      0,  2, -1, -2, 1, 0,
+                      0,  4,  0, -5, 0, 1};
+const float kG4[]  = { 1.f / 4,   0.f,       0.f,
+                      -1.f / 6,  -1.f / 6,  -1.f / 6,
+                      -1.f / 6,   1.f / 6,  -1.f / 6,
+                       1.f / 24,  1.f / 12,  1.f / 6,
+                       1.f / 24, -1.f / 12,  1.f / 6,
+                       0.f,       0.f,       1.f};
+const float kAT4[] = {1, 1,  1, 1,  1, 0,
+                      0, 1, -1, 2, -2, 0,
+                      0, 1,  1, 4,  4, 0,
+                      0, 1, -1, 8, -8, 1};
+// clang-format on
+
+// The matrices of F(TileSize x TileSize, 3 x 3): B^T of [alpha, alpha], G of [alpha, 3] and A^T of [TileSize, alpha].
+template <int TileSize>
+struct Winograd;
+
+template <>
+struct Winograd<2> {
+  static const float* BT() { return kBT2; }
+  static const float* G() { return kG2; }
+  static const float* AT() { return kAT2; }
+};
+
+template <>
+struct Winograd<4> {
+  static const float* BT() { return kBT4; }
+  static const float* G() { return kG4; }
+  static const float* AT() { return kAT4; }
+};
+
+// out[Rows, Cols] = lhs[Rows, Depth] * rhs[Depth, Cols], the sizes are constant so the transforms are unrolled
+template <int Rows, int Depth, int Cols>
+inline void SmallMatmul(const float* lhs, const float* rhs, float* out) {
+  for (int i = 0; i < Rows; ++i) {
+    for (int j = 0; j < Cols; ++j) {
+      float sum = 0.f;
+      for (int k = 0; k < Depth; ++k) sum += lhs[i * Depth + k] * rhs[k * Cols + j];
+      out[i * Cols + j] = sum;
+    }
+  }
+}
+
+// out[Rows, Cols] = lhs[Rows, Depth] * rhs[Cols, Depth]^T
+template <int Rows, int Depth, int Cols>
+inline void SmallMatmulTransB(const float* lhs, const float* rhs, float* out) {
+  for (int i = 0; i < Rows; ++i) {
+    for (int j = 0; j < Cols; ++j) {
+      float sum = 0.f;
+      for (int k = 0; k < Depth; ++k) sum += lhs[i * Depth + k] * rhs[j * Depth + k];
+      out[i * Cols + j] = sum;
+    }
+  }
+}
+
+// Run body(i) for every i in [0, n) by the tasks of the built-in thread pool.
+template <typename F>
+void ParallelFor(int n, const F& body) {
+  const int num_task = std::min(n, max_concurrency());
+  if (num_task <= 1) {
+    for (int i = 0; i < n; ++i) body(i);
+    return;
+  }
+  std::pair<int, const F*> closure(n, &body);
+  auto task = [](int task_id, int num_task, void* datas) -> int {
+    auto* closure = reinterpret_cast<std::pair<int, const F*>*>(datas);
+    for (int i = task_id; i < closure->first; i += num_task) (*closure->second)(i);
+    return 0;
+  };
+  cinn_backend_parallel_launch(task, &closure, num_task);
+}
+
+template <int TileSize>
+void WinogradWeightTransformImpl(int c_out, int c_in, const float* weights, float* transformed) {
+  constexpr int alpha = TileSize + 2;
+  const int64_t plane = static_cast<int64_t>(c_out) * c_in;
+  ParallelFor(c_out, [&](int k) {
+    float tmp[alpha * 3];
+    float u[alpha * alpha];
+    for (int c = 0; c < c_in; ++c) {
+      const float* g = weights + (static_cast<int64_t>(k) * c_in + c) * 9;
+      // U = G * g * G^T
+      SmallMatmul<alpha, 3, 3>(Winograd<TileSize>::G(), g, tmp);
+      SmallMatmulTransB<alpha, 3, alpha>(tmp, Winograd<TileSize>::G(), u);
+      for (int xi = 0; xi < alpha * alpha; ++xi) {
+        transformed[xi * plane + static_cast<int64_t>(k) * c_in + c] = u[xi];
+      }
+    }
+  });
+}
+
+template <int TileSize>
+void WinogradConv2dImpl(int batch_size,
+                        int c_in,
+                        int input_h,
+                        int input_w,
+                        int c_out,
+                        int pad_h,
+                        int pad_w,
+                        const float* inputs,
+                        const float* transformed_weights,
+                        float* out) {
+  constexpr int m     = TileSize;
+  constexpr int alpha = TileSize + 2;
+  const int out_h     = input_h + 2 * pad_h - 2;
+  const int out_w     = input_w + 2 * pad_w - 2;
+  CHECK(out_h > 0 && out_w > 0) << "The input of the Winograd convolution is smaller than the 3x3 filter";
+  const int tiles_h = (out_h + m - 1) / m;
+  const int tiles_w = (out_w + m - 1) / m;
+  const int tiles   = batch_size * tiles_h * tiles_w;
+
+  // the transformed input tiles V of [alpha * alpha, c_in, tiles] and their products M of [alpha * alpha, c_out, tiles]
+  thread_local std::vector<float> data_pack;
+  thread_local std::vector<float> products;
+  data_pack.resize(static_cast<size_t>(alpha) * alpha * c_in * tiles);
+  products.resize(static_cast<size_t>(alpha) * alpha * c_out * tiles);
+  float* V = data_pack.data();
+  float* M = products.data();
+
+  ParallelFor(c_in, [&](int c) {
+    float d[alpha * alpha];
+    float tmp[alpha * alpha];
+    float v[alpha * alpha];
+    for (int n = 0; n < batch_size; ++n) {
+      const float* plane = inputs + (static_cast<int64_t>(n) * c_in + c) * input_h * input_w;
+      for (int th = 0; th < tiles_h; ++th) {
+        for (int tw = 0; tw < tiles_w; ++tw) {
+          const int y0 = th * m - pad_h;
+          const int x0 = tw * m - pad_w;
+          for (int i = 0; i < alpha; ++i) {
+            const int y = y0 + i;
+            for (int j = 0; j < alpha; ++j) {
+              const int x      = x0 + j;
+              d[i * alpha + j] = y >= 0 && y < input_h && x >= 0 && x < input_w ? plane[y * input_w + x] : 0.f;
+            }
+          }
+          // V = B^T * d * B
+          SmallMatmul<alpha, alpha, alpha>(Winograd<TileSize>::BT(), d, tmp);
+          SmallMatmulTransB<alpha, alpha, alpha>(tmp, Winograd<TileSize>::BT(), v);
+          const int tile = (n * tiles_h + th) * tiles_w + tw;
+          for (int xi = 0; xi < alpha * alpha; ++xi) {
+            V[(static_cast<int64_t>(xi) * c_in + c) * tiles + tile] = v[xi];
+          }
+        }
+      }
+    }
+  });
+
+  for (int xi = 0; xi < alpha * alpha; ++xi) {
+    Gemm(false,
+         false,
+         c_out,
+         tiles,
+         c_in,
+         1.f,
+         transformed_weights + static_cast<int64_t>(xi) * c_out * c_in,
+         c_in,
+         V + static_cast<int64_t>(xi) * c_in * tiles,
+         tiles,
+         0.f,
+         M + static_cast<int64_t>(xi) * c_out * tiles,
+         tiles);
+  }
+
+  ParallelFor(c_out, [&](int k) {
+    float prod[alpha * alpha];
+    float tmp[m * alpha];
+    float y[m * m];
+    for (int n = 0; n < batch_size; ++n) {
+      float* plane = out + (static_cast<int64_t>(n) * c_out + k) * out_h * out_w;
+      for (int th = 0; th < tiles_h; ++th) {
+        for (int tw = 0; tw < tiles_w; ++tw) {
+          const int tile = (n * tiles_h + th) * tiles_w + tw;
+          for (int xi = 0; xi < alpha * alpha; ++xi) {
+            prod[xi] = M[(static_cast<int64_t>(xi) * c_out + k) * tiles + tile];
+          }
+          // Y = A^T * M * A
+          SmallMatmul<m, alpha, alpha>(Winograd<TileSize>::AT(), prod, tmp);
+          SmallMatmulTransB<m, alpha, m>(tmp, Winograd<TileSize>::AT(), y);
+          const int rows = out_h - th * m < m ? out_h - th * m : m;
+          const int cols = out_w - tw * m < m ? out_w - tw * m : m;
+          for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+              plane[(th * m + i) * out_w + tw * m + j] = y[i * m + j];
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
+}  // namespace
+
+void WinogradWeightTransform(int tile_size, int c_out, int c_in, const float* weights, float* transformed) {
+  CHECK(tile_size == 2 || tile_size == 4) << "The tile size of the Winograd convolution should be 2 or 4, but got "
+                                          << tile_size;
+  if (tile_size == 2) {
+    WinogradWeightTransformImpl<2>(c_out, c_in, weights, transformed);
+  } else {
+    WinogradWeightTransformImpl<4>(c_out, c_in, weights, transformed);
+  }
+}
+
+void WinogradConv2d(int tile_size,
+                    int batch_size,
+                    int c_in,
+                    int input_h,
+                    int input_w,
+                    int c_out,
+                    int pad_h,
+                    int pad_w,
+                    const float* inputs,
+                    const float* transformed_weights,
+                    float* out) {
+  CHECK(tile_size == 2 || tile_size == 4) << "The tile size of the Winograd convolution should be 2 or 4, but got "
+                                          << tile_size;
+  auto impl = tile_size == 2 ? &WinogradConv2dImpl<2> : &WinogradConv2dImpl<4>;
+  impl(batch_size, c_in, input_h, input_w, c_out, pad_h, pad_w, inputs, transformed_weights, out);
+}
+
+void Im2colConv2d(int batch_size,
+                  int c_in,
+                  int input_h,
+                  int input_w,
+                  int c_out,
+                  int filter_h,
+                  int filter_w,
+                  int pad_h,
+                  int pad_w,
+                  int stride_h,
+                  int stride_w,
+                  int dilation_h,
+                  int dilation_w,
+                  const float* inputs,
+                  const float* weights,
+                  float* out) {
+  const int out_h   = (input_h - ((filter_h - 1) * dilation_h + 1) + 2 * pad_h) / stride_h + 1;
+  const int out_w   = (input_w - ((filter_w - 1) * dilation_w + 1) + 2 * pad_w) / stride_w + 1;
+  const int depth   = c_in * filter_h * filter_w;
+  const int spatial = out_h * out_w;
+  // the 1x1 convolution without the stride and the padding is a GEMM on the input directly
+  const bool direct = filter_h == 1 && filter_w == 1 && stride_h == 1 && stride_w == 1 && pad_h == 0 && pad_w == 0;
+
+  thread_local std::vector<float> columns;
+  if (!direct) {
+    columns.resize(static_cast<size_t>(depth) * spatial);
+  }
+  for (int n = 0; n < batch_size; ++n) {
+    const float* image = inputs + static_cast<int64_t>(n) * c_in * input_h * input_w;
+    if (!direct) {
+      // the row (c, ky, kx) of the columns is the input pixels multiplied with the weight (c, ky, kx)
+      float* cols = columns.data();
+      ParallelFor(c_in, [&](int c) {
+        const float* plane = image + static_cast<int64_t>(c) * input_h * input_w;
+        for (int ky = 0; ky < filter_h; ++ky) {
+          for (int kx = 0; kx < filter_w; ++kx) {
+            float* row = cols + (static_cast<int64_t>(c * filter_h + ky) * filter_w + kx) * spatial;
+            for (int oy = 0; oy < out_h; ++oy) {
+              const int y = oy * stride_h - pad_h + ky * dilation_h;
+              for (int ox = 0; ox < out_w; ++ox) {
+                const int x          = ox * stride_w - pad_w + kx * dilation_w;
+                row[oy * out_w + ox] = y >= 0 && y < input_h && x >= 0 && x < input_w ? plane[y * input_w + x] : 0.f;
+              }
+            }
+          }
+        }
+      });
+    }
+    Gemm(false,
+         false,
+         c_out,
+         spatial,
+         depth,
+         1.f,
+         weights,
+         depth,
+         direct ? image : columns.data(),
+         spatial,
+         0.f,
+         out + static_cast<int64_t>(n) * c_out * spatial,
+         spatial);
+  }
+}
+
+void Im2colConv2dS8(int batch_size,
+                    int c_in,
+                    int input_h,
+                    int input_w,
+                    int c_out,
+                    int filter_h,
+                    int filter_w,
+                    int pad_h,
+                    int pad_w,
+                    int stride_h,
+                    int stride_w,
+                    int dilation_h,
+                    int dilation_w,
+                    float a_scale,
+                    const int8_t* inputs,
+                    const int8_t* packed_weights,
+                    void* out,
+                    const GemmS8Epilogue& epilogue) {
+  const int out_h   = (input_h - ((filter_h - 1) * dilation_h + 1) + 2 * pad_h) / stride_h + 1;
+  const int out_w   = (input_w - ((filter_w - 1) * dilation_w + 1) + 2 * pad_w) / stride_w + 1;
+  const int depth   = c_in * filter_h * filter_w;
+  const int spatial = out_h * out_w;
+  const bool direct = filter_h == 1 && filter_w == 1 && stride_h == 1 && stride_w == 1 && pad_h == 0 && pad_w == 0;
+  // the bytes of the elements of the output, which is int8 if it's requantized
+  const int64_t out_bytes = epilogue.out_scale > 0.f ? sizeof(int8_t) : sizeof(float);
+
+  thread_local std::vector<int8_t> columns;
+  if (!direct) {
+    columns.resize(static_cast<size_t>(depth) * spatial);
+  }
+  for (int n = 0; n < batch_size; ++n) {
+    const int8_t* image = inputs + static_cast<int64_t>(n) * c_in * input_h * input_w;
+    if (!direct) {
+      int8_t* cols = columns.data();
+      ParallelFor(c_in, [&](int c) {
+        const int8_t* plane = image + static_cast<int64_t>(c) * input_h * input_w;
+        for (int ky = 0; ky < filter_h; ++ky) {
+          for (int kx = 0; kx < filter_w; ++kx) {
+            int8_t* row = cols + (static_cast<int64_t>(c * filter_h + ky) * filter_w + kx) * spatial;
+            for (int oy = 0; oy < out_h; ++oy) {
+              const int y = oy * stride_h - pad_h + ky * dilation_h;
+              for (int ox = 0; ox < out_w; ++ox) {
+                const int x          = ox * stride_w - pad_w + kx * dilation_w;
+                row[oy * out_w + ox] = y >= 0 && y < input_h && x >= 0 && x < input_w ? plane[y * input_w + x] : 0;
+              }
+            }
+          }
+        }
+      });
+    }
+    // the rows of the GEMM are the output pixels and the columns are the output channels, so the columns are read
+    // transposed and the output is stored transposed into NCHW
+    GemmS8(true,
+           spatial,
+           c_out,
+           depth,
+           a_scale,
+           direct ? image : columns.data(),
+           spatial,
+           packed_weights,
+           reinterpret_cast<char*>(out) + static_cast<int64_t>(n) * c_out * spatial * out_bytes,
+           1,
+           spatial,
+           epilogue);
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+void cinn_cpu_winograd_weight_transform_fp32(
+    int tile_size, int c_out, int c_in, cinn_buffer_t* weights, cinn_buffer_t* transformed) {
+  cinn::runtime::cpu::WinogradWeightTransform(tile_size,
+                                              c_out,
+                                              c_in,
+                                              reinterpret_cast<const float*>(weights->memory),
+                                              reinterpret_cast<float*>(transformed->memory));
+}
+
+void cinn_cpu_winograd_conv2d_nchw_fp32(int tile_size,
+                                        int batch_size,
+                                        int c_in,
+                                        int input_h,
+                                        int input_w,
+                                        int c_out,
+                                        int pad_h,
+                                        int pad_w,
+                                        cinn_buffer_t* inputs,
+                                        cinn_buffer_t* transformed_weights,
+                                        cinn_buffer_t* out) {
+  cinn::runtime::cpu::WinogradConv2d(tile_size,
+                                     batch_size,
+                                     c_in,
+                                     input_h,
+                                     input_w,
+                                     c_out,
+                                     pad_h,
+                                     pad_w,
+                                     reinterpret_cast<const float*>(inputs->memory),
+                                     reinterpret_cast<const float*>(transformed_weights->memory),
+                                     reinterpret_cast<float*>(out->memory));
+}
+
+void cinn_cpu_im2col_conv2d_nchw_fp32(int batch_size,
+                                      int c_in,
+                                      int input_h,
+                                      int input_w,
+                                      int c_out,
+                                      int filter_h,
+                                      int filter_w,
+                                      int pad_h,
+                                      int pad_w,
+                                      int stride_h,
+                                      int stride_w,
+                                      int dilation_h,
+                                      int dilation_w,
+                                      cinn_buffer_t* inputs,
+                                      cinn_buffer_t* weights,
+                                      cinn_buffer_t* out) {
+  cinn::runtime::cpu::Im2colConv2d(batch_size,
+                                   c_in,
+                                   input_h,
+                                   input_w,
+                                   c_out,
+                                   filter_h,
+                                   filter_w,
+                                   pad_h,
+                                   pad_w,
+                                   stride_h,
+                                   stride_w,
+                                   dilation_h,
+                                   dilation_w,
+                                   reinterpret_cast<const float*>(inputs->memory),
+                                   reinterpret_cast<const float*>(weights->memory),
+                                   reinterpret_cast<float*>(out->memory));
+}
+
+void cinn_cpu_im2col_conv2d_nchw_s8(int batch_size,
+                                    int c_in,
+                                    int input_h,
+                                    int input_w,
+                                    int c_out,
+                                    int filter_h,
+                                    int filter_w,
+                                    int pad_h,
+                                    int pad_w,
+                                    int stride_h,
+                                    int stride_w,
+                                    int dilation_h,
+                                    int dilation_w,
+                                    float a_scale,
+                                    float out_scale,
+                                    cinn_buffer_t* inputs,
+                                    cinn_buffer_t* packed_weights,
+                                    cinn_buffer_t* out) {
+  cinn::runtime::cpu::GemmS8Epilogue epilogue;
+  epilogue.out_scale = out_scale;
+  cinn::runtime::cpu::Im2colConv2dS8(batch_size,
+                                     c_in,
+                                     input_h,
+                                     input_w,
+                                     c_out,
+                                     filter_h,
+                                     filter_w,
+                                     pad_h,
+                                     pad_w,
+                                     stride_h,
+                                     stride_w,
+                                     dilation_h,
+                                     dilation_w,
+                                     a_scale,
+                                     reinterpret_cast<const int8_t*>(inputs->memory),
+                                     reinterpret_cast<const int8_t*>(packed_weights->memory),
+                                     out->memory,
+                                     epilogue);
+}
+
+CINN_REGISTER_HELPER(cinn_cpu_conv2d) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+  FunctionProto::shape_inference_t inference_shape_weight_transform = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK_EQ(args.size(), 4UL) << "Wrong number of arguments passed in";
+    int alpha = runtime::cpu::WinogradAlpha(common::AutoSimplify(args[0]).as_int32());
+    return std::vector<Expr>{Expr(alpha * alpha), common::AutoSimplify(args[1]), common::AutoSimplify(args[2])};
+  };
+
+  FunctionProto::shape_inference_t inference_shape_winograd = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK_EQ(args.size(), 10UL) << "Wrong number of arguments passed in";
+    int input_h = common::AutoSimplify(args[3]).as_int32();
+    int input_w = common::AutoSimplify(args[4]).as_int32();
+    int pad_h   = common::AutoSimplify(args[6]).as_int32();
+    int pad_w   = common::AutoSimplify(args[7]).as_int32();
+    return std::vector<Expr>{common::AutoSimplify(args[1]),
+                             common::AutoSimplify(args[5]),
+                             Expr(input_h + 2 * pad_h - 2),
+                             Expr(input_w + 2 * pad_w - 2)};
+  };
+
+  // the int8 convolution has the scales of the input and the output after the dilation
+  FunctionProto::shape_inference_t inference_shape_im2col = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK(args.size() == 15UL || args.size() == 17UL) << "Wrong number of arguments passed in";
+    int input_h    = common::AutoSimplify(args[2]).as_int32();
+    int input_w    = common::AutoSimplify(args[3]).as_int32();
+    int filter_h   = common::AutoSimplify(args[5]).as_int32();
+    int filter_w   = common::AutoSimplify(args[6]).as_int32();
+    int pad_h      = common::AutoSimplify(args[7]).as_int32();
+    int pad_w      = common::AutoSimplify(args[8]).as_int32();
+    int stride_h   = common::AutoSimplify(args[9]).as_int32();
+    int stride_w   = common::AutoSimplify(args[10]).as_int32();
+    int dilation_h = common::AutoSimplify(args[11]).as_int32();
+    int dilation_w = common::AutoSimplify(args[12]).as_int32();
+    int out_h      = (input_h - ((filter_h - 1) * dilation_h + 1) + 2 * pad_h) / stride_h + 1;
+    int out_w      = (input_w - ((filter_w - 1) * dilation_w + 1) + 2 * pad_w) / stride_w + 1;
+    return std::vector<Expr>{
+        common::AutoSimplify(args[0]), common::AutoSimplify(args[4]), Expr(out_h), Expr(out_w)};
+  };
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_winograd_weight_transform_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<int>()              // tile_size
+      .AddInputType<int>()              // c_out
+      .AddInputType<int>()              // c_in
+      .AddInputType<cinn_buffer_t*>()   // weights
+      .AddOutputType<cinn_buffer_t*>()  // transformed
+      .SetShapeInference(inference_shape_weight_transform)
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_winograd_conv2d_nchw_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<int>()              // tile_size
+      .AddInputType<int>()              // batch_size
+      .AddInputType<int>()              // c_in
+      .AddInputType<int>()              // input_h
+      .AddInputType<int>()              // input_w
+      .AddInputType<int>()              // c_out
+      .AddInputType<int>()              // pad_h
+      .AddInputType<int>()              // pad_w
+      .AddInputType<cinn_buffer_t*>()   // inputs
+      .AddInputType<cinn_buffer_t*>()   // transformed_weights
+      .AddOutputType<cinn_buffer_t*>()  // out
+      .SetShapeInference(inference_shape_winograd)
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_im2col_conv2d_nchw_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<int>()              // batch_size
+      .AddInputType<int>()              // c_in
+      .AddInputType<int>()              // input_h
+      .AddInputType<int>()              // input_w
+      .AddInputType<int>()              // c_out
+      .AddInputType<int>()              // filter_h
+      .AddInputType<int>()              // filter_w
+      .AddInputType<int>()              // pad_h
+      .AddInputType<int>()              // pad_w
+      .AddInputType<int>()              // stride_h
+      .AddInputType<int>()              // stride_w
+      .AddInputType<int>()              // dilation_h
+      .AddInputType<int>()              // dilation_w
+      .AddInputType<cinn_buffer_t*>()   // inputs
+      .AddInputType<cinn_buffer_t*>()   // weights
+      .AddOutputType<cinn_buffer_t*>()  // out
+      .SetShapeInference(inference_shape_im2col)
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_im2col_conv2d_nchw_s8, host_target)
+      .SetRetType<void>()
+      .AddInputType<int>()              // batch_size
+      .AddInputType<int>()              // c_in
+      .AddInputType<int>()              // input_h
+      .AddInputType<int>()              // input_w
+      .AddInputType<int>()              // c_out
+      .AddInputType<int>()              // filter_h
+      .AddInputType<int>()              // filter_w
+      .AddInputType<int>()              // pad_h
+      .AddInputType<int>()              // pad_w
+      .AddInputType<int>()              // stride_h
+      .AddInputType<int>()              // stride_w
+      .AddInputType<int>()              // dilation_h
+      .AddInputType<int>()              // dilation_w
+      .AddInputType<float>()            // a_scale
+      .AddInputType<float>()            // out_scale
+      .AddInputType<cinn_buffer_t*>()   // inputs
+      .AddInputType<cinn_buffer_t*>()   // packed_weights
+      .AddOutputType<cinn_buffer_t*>()  // out
+      .SetShapeInference(inference_shape_im2col)
+      .End();
+
+  return true;
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+//! \file This file defines the convolutions of the host runtime built on the native packed GEMM.
+
+#include <cstdint>
+
+#include "cinn/runtime/cinn_runtime.h"
+#include "cinn/runtime/cpu/gemm_int8.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+//! The size of the transformed tiles of the Winograd convolution F(m x m, 3 x 3), m + 3 - 1.
+inline int WinogradAlpha(int tile_size) { return tile_size + 2; }
+
+/**
+ * \brief Transform the 3x3 weights of a Winograd convolution F(m x m, 3 x 3), U = G * g * G^T.
+ * @param tile_size The size m of the output tiles, 2 or 4.
+ * @param weights The weights of the shape [c_out, c_in, 3, 3].
+ * @param transformed The transformed weights of the shape [alpha * alpha, c_out, c_in], alpha = m + 2.
+ */
+void WinogradWeightTransform(int tile_size, int c_out, int c_in, const float* weights, float* transformed);
+
+/**
+ * \brief Compute the NCHW convolution of the stride 1 and the dilation 1 with the transformed 3x3 weights.
+ *
+ * The input tiles are transformed to V = B^T * d * B, every element of the tiles is a GEMM of U and V over the
+ * channels, and the products are transformed back to the output tiles by A^T * M * A.
+ */
+void WinogradConv2d(int tile_size,
+                    int batch_size,
+                    int c_in,
+                    int input_h,
+                    int input_w,
+                    int c_out,
+                    int pad_h,
+                    int pad_w,
+                    const float* inputs,
+                    const float* transformed_weights,
+                    float* out);
+
+/**
+ * \brief Compute the NCHW convolution of a single group by lowering the input patches to a matrix, which is
+ * multiplied with the weights of the shape [c_out, c_in * filter_h * filter_w]. The lowering is skipped for the 1x1
+ * convolutions without the stride and the padding.
+ */
+void Im2colConv2d(int batch_size,
+                  int c_in,
+                  int input_h,
+                  int input_w,
+                  int c_out,
+                  int filter_h,
+                  int filter_w,
+                  int pad_h,
+                  int pad_w,
+                  int stride_h,
+                  int stride_w,
+                  int dilation_h,
+                  int dilation_w,
+                  const float* inputs,
+                  const float* weights,
+                  float* out);
+
+/**
+ * \brief Compute the INT8 NCHW convolution of a single group by im2col and the INT8 GEMM.
+ *
+ * The inputs are int8 quantized by a_scale, the weights of the shape [c_out, c_in * filter_h * filter_w] are packed by
+ * PackWeightsS8 with tb. The output is float, or int8 if the epilogue requantizes it, and the bias of kRow is added
+ * per output channel.
+ */
+void Im2colConv2dS8(int batch_size,
+                    int c_in,
+                    int input_h,
+                    int input_w,
+                    int c_out,
+                    int filter_h,
+                    int filter_w,
+                    int pad_h,
+                    int pad_w,
+                    int stride_h,
+                    int stride_w,
+                    int dilation_h,
+                    int dilation_w,
+                    float a_scale,
+                    const int8_t* inputs,
+                    const int8_t* packed_weights,
+                    void* out,
+                    const GemmS8Epilogue& epilogue = GemmS8Epilogue());
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+extern "C" {
+
+/**
+ * \brief Transform the 3x3 weights of the Winograd convolution, it is run once before the execution when the weights
+ * are constant.
+ */
+void cinn_cpu_winograd_weight_transform_fp32(
+    int tile_size, int c_out, int c_in, cinn_buffer_t* weights, cinn_buffer_t* transformed);
+
+/**
+ * \brief Compute the Winograd convolution F(m x m, 3 x 3) with the weights transformed by
+ * cinn_cpu_winograd_weight_transform_fp32.
+ */
+void cinn_cpu_winograd_conv2d_nchw_fp32(int tile_size,
+                                        int batch_size,
+                                        int c_in,
+                                        int input_h,
+                                        int input_w,
+                                        int c_out,
+                                        int pad_h,
+                                        int pad_w,
+                                        cinn_buffer_t* inputs,
+                                        cinn_buffer_t* transformed_weights,
+                                        cinn_buffer_t* out);
+
+/**
+ * \brief Compute the convolution by im2col and the native packed GEMM, it has the same arguments as
+ * cinn_cpu_mkldnn_conv2d_nchw_fp32 except the group, which should be 1.
+ */
+void cinn_cpu_im2col_conv2d_nchw_fp32(int batch_size,
+                                      int c_in,
+                                      int input_h,
+                                      int input_w,
+                                      int c_out,
+                                      int filter_h,
+                                      int filter_w,
+                                      int pad_h,
+                                      int pad_w,
+                                      int stride_h,
+                                      int stride_w,
+                                      int dilation_h,
+                                      int dilation_w,
+                                      cinn_buffer_t* inputs,
+                                      cinn_buffer_t* weights,
+                                      cinn_buffer_t* out);
+
+/**
+ * \brief Compute the INT8 convolution by im2col and the INT8 GEMM with the weights packed by
+ * cinn_cpu_pack_weights_s8, the output is float, or int8 if out_scale is positive.
+ */
+void cinn_cpu_im2col_conv2d_nchw_s8(int batch_size,
+                                    int c_in,
+                                    int input_h,
+                                    int input_w,
+                                    int c_out,
+                                    int filter_h,
+                                    int filter_w,
+                                    int pad_h,
+                                    int pad_w,
+                                    int stride_h,
+                                    int stride_w,
+                                    int dilation_h,
+                                    int dilation_w,
+                                    float a_scale,
+                                    float out_scale,
+                                    cinn_buffer_t* inputs,
+                                    cinn_buffer_t* packed_weights,
+                                    cinn_buffer_t* out);
+
+}  // extern "C"
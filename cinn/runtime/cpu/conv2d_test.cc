@@ -0,0 +1,195 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/conv2d.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+// the reference of the NCHW convolution computed in double
+std::vector<float> NaiveConv2d(const std::vector<float>& inputs,
+                               const std::vector<float>& weights,
+                               int batch_size,
+                               int c_in,
+                               int input_h,
+                               int input_w,
+                               int c_out,
+                               int filter_h,
+                               int filter_w,
+                               int pad,
+                               int stride,
+                               int dilation) {
+  int out_h = (input_h - ((filter_h - 1) * dilation + 1) + 2 * pad) / stride + 1;
+  int out_w = (input_w - ((filter_w - 1) * dilation + 1) + 2 * pad) / stride + 1;
+  std::vector<float> out(batch_size * c_out * out_h * out_w);
+  for (int n = 0; n < batch_size; ++n) {
+    for (int k = 0; k < c_out; ++k) {
+      for (int oy = 0; oy < out_h; ++oy) {
+        for (int ox = 0; ox < out_w; ++ox) {
+          double sum = 0;
+          for (int c = 0; c < c_in; ++c) {
+            for (int ky = 0; ky < filter_h; ++ky) {
+              for (int kx = 0; kx < filter_w; ++kx) {
+                int y = oy * stride - pad + ky * dilation;
+                int x = ox * stride - pad + kx * dilation;
+                if (y < 0 || y >= input_h || x < 0 || x >= input_w) continue;
+                sum += static_cast<double>(inputs[((n * c_in + c) * input_h + y) * input_w + x]) *
+                       weights[((k * c_in + c) * filter_h + ky) * filter_w + kx];
+              }
+            }
+          }
+          out[((n * c_out + k) * out_h + oy) * out_w + ox] = sum;
+        }
+      }
+    }
+  }
+  return out;
+}
+
+std::vector<float> RandomVector(int size, std::mt19937* rng) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> res(size);
+  for (auto& v : res) v = dist(*rng);
+  return res;
+}
+
+TEST(CpuConv2d, Winograd) {
+  std::mt19937 rng(0);
+  // the odd sizes leave the partial tiles on the borders
+  for (int tile_size : {2, 4}) {
+    for (int size : {7, 14}) {
+      for (int pad : {0, 1}) {
+        int batch_size = 2, c_in = 5, c_out = 6;
+        auto inputs    = RandomVector(batch_size * c_in * size * size, &rng);
+        auto weights   = RandomVector(c_out * c_in * 9, &rng);
+        auto expected  = NaiveConv2d(inputs, weights, batch_size, c_in, size, size, c_out, 3, 3, pad, 1, 1);
+
+        int alpha = WinogradAlpha(tile_size);
+        std::vector<float> transformed(alpha * alpha * c_out * c_in);
+        WinogradWeightTransform(tile_size, c_out, c_in, weights.data(), transformed.data());
+        std::vector<float> out(expected.size());
+        WinogradConv2d(
+            tile_size, batch_size, c_in, size, size, c_out, pad, pad, inputs.data(), transformed.data(), out.data());
+        for (size_t i = 0; i < out.size(); ++i) {
+          ASSERT_NEAR(out[i], expected[i], 1e-3) << "tile size " << tile_size << " input size " << size << " pad "
+                                                 << pad << " at " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(CpuConv2d, Im2col) {
+  std::mt19937 rng(0);
+  struct Param {
+    int filter;
+    int pad;
+    int stride;
+    int dilation;
+  };
+  // the first one multiplies the input directly without im2col
+  std::vector<Param> params = {{1, 0, 1, 1}, {1, 0, 2, 1}, {3, 1, 1, 1}, {3, 1, 2, 1}, {3, 2, 1, 2}, {7, 3, 2, 1}};
+  for (auto& param : params) {
+    int batch_size = 2, c_in = 3, c_out = 8, size = 15;
+    auto inputs    = RandomVector(batch_size * c_in * size * size, &rng);
+    auto weights   = RandomVector(c_out * c_in * param.filter * param.filter, &rng);
+    auto expected  = NaiveConv2d(inputs,
+                                weights,
+                                batch_size,
+                                c_in,
+                                size,
+                                size,
+                                c_out,
+                                param.filter,
+                                param.filter,
+                                param.pad,
+                                param.stride,
+                                param.dilation);
+    std::vector<float> out(expected.size());
+    Im2colConv2d(batch_size,
+                 c_in,
+                 size,
+                 size,
+                 c_out,
+                 param.filter,
+                 param.filter,
+                 param.pad,
+                 param.pad,
+                 param.stride,
+                 param.stride,
+                 param.dilation,
+                 param.dilation,
+                 inputs.data(),
+                 weights.data(),
+                 out.data());
+    for (size_t i = 0; i < out.size(); ++i) {
+      ASSERT_NEAR(out[i], expected[i], 1e-4) << "filter " << param.filter << " stride " << param.stride << " at " << i;
+    }
+  }
+}
+
+TEST(CpuConv2d, Im2colS8) {
+  std::mt19937 rng(0);
+  // the 1x1 convolution multiplies the input directly, the others lower the int8 input by im2col
+  for (int filter : {1, 3}) {
+    for (int stride : {1, 2}) {
+      int batch_size = 2, c_in = 5, c_out = 40, size = 11, pad = filter / 2;
+      int depth      = c_in * filter * filter;
+      auto inputs    = RandomVector(batch_size * c_in * size * size, &rng);
+      auto weights   = RandomVector(c_out * depth, &rng);
+      std::vector<int8_t> inputs_s8(inputs.size());
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs_s8[i] = QuantizeS8(inputs[i], 127.f);
+        inputs[i]    = inputs_s8[i] / 127.f;
+      }
+      auto expected = NaiveConv2d(inputs, weights, batch_size, c_in, size, size, c_out, filter, filter, pad, stride, 1);
+
+      std::vector<int8_t> packed(PackedWeightsS8Bytes(depth, c_out));
+      PackWeightsS8(true, depth, c_out, weights.data(), depth, packed.data());
+      std::vector<float> out(expected.size());
+      Im2colConv2dS8(batch_size,
+                     c_in,
+                     size,
+                     size,
+                     c_out,
+                     filter,
+                     filter,
+                     pad,
+                     pad,
+                     stride,
+                     stride,
+                     1,
+                     1,
+                     1.f / 127.f,
+                     inputs_s8.data(),
+                     packed.data(),
+                     out.data());
+      // the error is the quantization of the weights, at most a half step of every product
+      for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_NEAR(out[i], expected[i], depth * 0.5f / 127.f) << "filter " << filter << " stride " << stride
+                                                               << " at " << i;
+      }
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,506 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/gemm.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/common/cas.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(_M_X64))
+#define CINN_GEMM_WITH_X86_KERNELS
+#endif
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+namespace {
+
+// the depth of the packed panels, a panel of B is kept in the L1 cache by the micro-kernel
+constexpr int kBlockK = 256;
+// the largest MR x NR tile of the micro-kernels
+constexpr int kMaxTileSize = 6 * 32;
+// the problems with fewer multiply-adds run on the calling thread
+constexpr int64_t kMinParallelWork = 64 * 64 * 64;
+
+/**
+ * Compute the MR x NR tile acc = a * b from the MR-wide packed panel a and the NR-wide packed panel b of depth kc,
+ * where NR = NV * VL. The accumulators are MR x NV vectors of VL floats, VL is the width of the vector registers of
+ * the instruction set of the function it is inlined into, so they stay in the registers.
+ */
+template <int MR, int NV, int VL>
+inline __attribute__((always_inline)) void MicroKernelImpl(int kc, const float* a, const float* b, float* acc) {
+  // the panels are not aligned to the vectors
+  typedef float Vec __attribute__((vector_size(VL * sizeof(float)), aligned(sizeof(float))));
+  constexpr int NR = NV * VL;
+  Vec c[MR][NV];
+  for (int i = 0; i < MR; ++i) {
+    for (int v = 0; v < NV; ++v) c[i][v] = Vec{};
+  }
+  for (int p = 0; p < kc; ++p) {
+    const Vec* b_p = reinterpret_cast<const Vec*>(b + p * NR);
+    for (int i = 0; i < MR; ++i) {
+      for (int v = 0; v < NV; ++v) c[i][v] += a[p * MR + i] * b_p[v];
+    }
+  }
+  for (int i = 0; i < MR; ++i) {
+    for (int v = 0; v < NV; ++v) reinterpret_cast<Vec*>(acc + i * NR)[v] = c[i][v];
+  }
+}
+
+typedef void (*MicroKernelFunc)(int kc, const float* a, const float* b, float* acc);
+
+struct MicroKernel {
+  int mr;
+  int nr;
+  MicroKernelFunc func;
+  const char* isa;
+};
+
+#ifdef CINN_GEMM_WITH_X86_KERNELS
+// 12 zmm accumulators of the 32 registers
+__attribute__((target("avx512f"))) void MicroKernelAvx512(int kc, const float* a, const float* b, float* acc) {
+  MicroKernelImpl<6, 2, 16>(kc, a, b, acc);
+}
+
+// 12 ymm accumulators, 2 for the row of B and 1 for the broadcast element of A
+__attribute__((target("avx2,fma"))) void MicroKernelAvx2(int kc, const float* a, const float* b, float* acc) {
+  MicroKernelImpl<6, 2, 8>(kc, a, b, acc);
+}
+#endif
+
+void MicroKernelGeneric(int kc, const float* a, const float* b, float* acc) { MicroKernelImpl<4, 2, 4>(kc, a, b, acc); }
+
+// the micro-kernel of the best instruction set the running cpu supports
+const MicroKernel& GetMicroKernel() {
+  static const MicroKernel kernel = []() {
+#ifdef CINN_GEMM_WITH_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return MicroKernel{6, 32, &MicroKernelAvx512, "avx512f"};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return MicroKernel{6, 16, &MicroKernelAvx2, "avx2"};
+    }
+#endif
+    return MicroKernel{4, 8, &MicroKernelGeneric, "generic"};
+  }();
+  return kernel;
+}
+
+inline int RoundUp(int x, int factor) { return (x + factor - 1) / factor * factor; }
+
+// Pack the mc x kc block of op(A) starting at (row, depth) into the MR-wide panels, the rows out of the block are
+// padded with zeros.
+void PackA(bool ta, const float* A, int lda, int row, int depth, int mc, int kc, int mr, float* packed) {
+  for (int ir = 0; ir < mc; ir += mr) {
+    int rows = std::min(mr, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      int k = depth + p;
+      for (int i = 0; i < rows; ++i) {
+        int r              = row + ir + i;
+        packed[p * mr + i] = ta ? A[k * lda + r] : A[r * lda + k];
+      }
+      for (int i = rows; i < mr; ++i) {
+        packed[p * mr + i] = 0.f;
+      }
+    }
+    packed += mr * kc;
+  }
+}
+
+// Pack the kc x nc block of op(B) starting at (depth, col) into the NR-wide panels, the columns out of the block are
+// padded with zeros.
+void PackB(bool tb, const float* B, int ldb, int depth, int col, int kc, int nc, int nr, float* packed) {
+  for (int jr = 0; jr < nc; jr += nr) {
+    int cols = std::min(nr, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      int k = depth + p;
+      for (int j = 0; j < cols; ++j) {
+        int c              = col + jr + j;
+        packed[p * nr + j] = tb ? B[c * ldb + k] : B[k * ldb + c];
+      }
+      for (int j = cols; j < nr; ++j) {
+        packed[p * nr + j] = 0.f;
+      }
+    }
+    packed += nr * kc;
+  }
+}
+
+// Add the bias to the cols elements of C starting at (row, col) and apply the activation on them.
+void ApplyEpilogue(float* c, int row, int col, int cols, int ldc, const GemmEpilogue& epilogue) {
+  if (epilogue.bias_mode == GemmBiasMode::kRow) {
+    const float* bias = epilogue.bias + col;
+    for (int j = 0; j < cols; ++j) c[j] += bias[j];
+  } else if (epilogue.bias_mode == GemmBiasMode::kFull) {
+    const float* bias = epilogue.bias + row * ldc + col;
+    for (int j = 0; j < cols; ++j) c[j] += bias[j];
+  }
+  switch (epilogue.activation) {
+    case GemmActivation::kNone:
+      break;
+    case GemmActivation::kRelu:
+      for (int j = 0; j < cols; ++j) c[j] = std::max(c[j], 0.f);
+      break;
+    case GemmActivation::kSigmoid:
+      for (int j = 0; j < cols; ++j) c[j] = 1.f / (1.f + std::exp(-c[j]));
+      break;
+    case GemmActivation::kTanh:
+      for (int j = 0; j < cols; ++j) c[j] = std::tanh(c[j]);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported activation " << static_cast<int>(epilogue.activation) << " of the cpu gemm";
+  }
+}
+
+// The arguments of a GEMM shared by its tasks.
+struct GemmArgs {
+  const MicroKernel* kernel;
+  bool ta;
+  bool tb;
+  int M;
+  int N;
+  int K;
+  float alpha;
+  const float* A;
+  int lda;
+  const float* B;
+  int ldb;
+  float beta;
+  float* C;
+  int ldc;
+  const GemmEpilogue* epilogue;
+  // the size of the macro tiles of C
+  int mc;
+  int nc;
+  int tiles_n;
+  int num_tiles;
+};
+
+// Compute the macro tile of C starting at (row, col), the product of a K-block is accumulated into C and the epilogue
+// is applied when the tile is stored for the last K-block.
+void ComputeMacroTile(const GemmArgs& args, int row, int col) {
+  thread_local std::vector<float> packed_a;
+  thread_local std::vector<float> packed_b;
+  const int mr = args.kernel->mr;
+  const int nr = args.kernel->nr;
+  const int mc = std::min(args.mc, args.M - row);
+  const int nc = std::min(args.nc, args.N - col);
+  packed_a.resize(RoundUp(mc, mr) * kBlockK);
+  packed_b.resize(RoundUp(nc, nr) * kBlockK);
+  alignas(64) float acc[kMaxTileSize];
+
+  for (int depth = 0; depth < args.K; depth += kBlockK) {
+    const int kc    = std::min(kBlockK, args.K - depth);
+    const bool last = depth + kc >= args.K;
+    PackB(args.tb, args.B, args.ldb, depth, col, kc, nc, nr, packed_b.data());
+    PackA(args.ta, args.A, args.lda, row, depth, mc, kc, mr, packed_a.data());
+    for (int jr = 0; jr < nc; jr += nr) {
+      const int cols = std::min(nr, nc - jr);
+      for (int ir = 0; ir < mc; ir += mr) {
+        args.kernel->func(kc, packed_a.data() + ir * kc, packed_b.data() + jr * kc, acc);
+        const int rows = std::min(mr, mc - ir);
+        for (int i = 0; i < rows; ++i) {
+          const float* a_row = acc + i * nr;
+          float* c_row       = args.C + (row + ir + i) * args.ldc + col + jr;
+          if (depth > 0) {
+            for (int j = 0; j < cols; ++j) c_row[j] += args.alpha * a_row[j];
+          } else if (args.beta != 0.f) {
+            for (int j = 0; j < cols; ++j) c_row[j] = args.alpha * a_row[j] + args.beta * c_row[j];
+          } else {
+            // C is not read when beta is 0, so it may be uninitialized
+            for (int j = 0; j < cols; ++j) c_row[j] = args.alpha * a_row[j];
+          }
+          if (last) {
+            ApplyEpilogue(c_row, row + ir + i, col + jr, cols, args.ldc, *args.epilogue);
+          }
+        }
+      }
+    }
+  }
+}
+
+int RunGemmTask(int task_id, int num_task, void* datas) {
+  auto* args = reinterpret_cast<const GemmArgs*>(datas);
+  for (int tile = task_id; tile < args->num_tiles; tile += num_task) {
+    ComputeMacroTile(*args, tile / args->tiles_n * args->mc, tile % args->tiles_n * args->nc);
+  }
+  return 0;
+}
+
+}  // namespace
+
+void Gemm(bool ta,
+          bool tb,
+          int M,
+          int N,
+          int K,
+          float alpha,
+          const float* A,
+          int lda,
+          const float* B,
+          int ldb,
+          float beta,
+          float* C,
+          int ldc,
+          const GemmEpilogue& epilogue) {
+  CHECK(epilogue.bias_mode == GemmBiasMode::kNone || epilogue.bias) << "The bias of the cpu gemm is null";
+  if (M <= 0 || N <= 0) return;
+  if (K <= 0) {
+    for (int i = 0; i < M; ++i) {
+      float* c_row = C + i * ldc;
+      for (int j = 0; j < N; ++j) c_row[j] = beta != 0.f ? beta * c_row[j] : 0.f;
+      ApplyEpilogue(c_row, i, 0, N, ldc, epilogue);
+    }
+    return;
+  }
+
+  const MicroKernel& kernel = GetMicroKernel();
+  VLOG(6) << "Run the cpu gemm of " << M << "x" << N << "x" << K << " by the " << kernel.isa << " micro-kernel";
+  GemmArgs args{&kernel, ta, tb, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, &epilogue};
+  // an mc x kc block of A stays in the L2 cache while it is multiplied with the panels of B
+  args.mc = std::min(RoundUp(M, kernel.mr), kernel.mr * 16);
+  args.nc = std::min(RoundUp(N, kernel.nr), kernel.nr * 16);
+
+  int num_threads = static_cast<int64_t>(M) * N * K < kMinParallelWork ? 1 : max_concurrency();
+  auto count_tiles = [&]() {
+    args.tiles_n   = (N + args.nc - 1) / args.nc;
+    args.num_tiles = (M + args.mc - 1) / args.mc * args.tiles_n;
+  };
+  count_tiles();
+  // split the tiles until every thread has one, the columns are split first as the rows of A are packed per tile
+  while (args.num_tiles < num_threads) {
+    if (args.nc > 2 * kernel.nr) {
+      args.nc = RoundUp(args.nc / 2, kernel.nr);
+    } else if (args.mc > kernel.mr) {
+      args.mc = RoundUp(args.mc / 2, kernel.mr);
+    } else {
+      break;
+    }
+    count_tiles();
+  }
+  cinn_backend_parallel_launch(&RunGemmTask, &args, std::min(args.num_tiles, num_threads));
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+void cinn_cpu_gemm_fp32(float alpha,
+                        int M,
+                        int N,
+                        int K,
+                        bool ta,
+                        bool tb,
+                        int lda,
+                        int ldb,
+                        int ldc,
+                        float beta,
+                        cinn_buffer_t* A,
+                        cinn_buffer_t* B,
+                        cinn_buffer_t* C) {
+  cinn::runtime::cpu::Gemm(ta,
+                           tb,
+                           M,
+                           N,
+                           K,
+                           alpha,
+                           reinterpret_cast<const float*>(A->memory),
+                           lda,
+                           reinterpret_cast<const float*>(B->memory),
+                           ldb,
+                           beta,
+                           reinterpret_cast<float*>(C->memory),
+                           ldc);
+}
+
+void cinn_cpu_gemm_batch_fp32(float alpha,
+                              int batch_size,
+                              int M,
+                              int N,
+                              int K,
+                              bool ta,
+                              bool tb,
+                              int lda,
+                              int ldb,
+                              int ldc,
+                              int a_stride,
+                              int b_stride,
+                              int c_stride,
+                              float beta,
+                              cinn_buffer_t* A,
+                              cinn_buffer_t* B,
+                              cinn_buffer_t* C) {
+  auto* a_data = reinterpret_cast<const float*>(A->memory);
+  auto* b_data = reinterpret_cast<const float*>(B->memory);
+  auto* c_data = reinterpret_cast<float*>(C->memory);
+  for (int i = 0; i < batch_size; ++i) {
+    cinn::runtime::cpu::Gemm(ta,
+                             tb,
+                             M,
+                             N,
+                             K,
+                             alpha,
+                             a_data + i * a_stride,
+                             lda,
+                             b_data + i * b_stride,
+                             ldb,
+                             beta,
+                             c_data + i * c_stride,
+                             ldc);
+  }
+}
+
+void cinn_cpu_gemm_bias_act_fp32(float alpha,
+                                 int M,
+                                 int N,
+                                 int K,
+                                 bool ta,
+                                 bool tb,
+                                 int lda,
+                                 int ldb,
+                                 int ldc,
+                                 int bias_mode,
+                                 int activation,
+                                 cinn_buffer_t* A,
+                                 cinn_buffer_t* B,
+                                 cinn_buffer_t* bias,
+                                 cinn_buffer_t* C) {
+  cinn::runtime::cpu::GemmEpilogue epilogue;
+  epilogue.bias_mode  = static_cast<cinn::runtime::cpu::GemmBiasMode>(bias_mode);
+  epilogue.bias       = reinterpret_cast<const float*>(bias->memory);
+  epilogue.activation = static_cast<cinn::runtime::cpu::GemmActivation>(activation);
+  cinn::runtime::cpu::Gemm(ta,
+                           tb,
+                           M,
+                           N,
+                           K,
+                           alpha,
+                           reinterpret_cast<const float*>(A->memory),
+                           lda,
+                           reinterpret_cast<const float*>(B->memory),
+                           ldb,
+                           0.f,
+                           reinterpret_cast<float*>(C->memory),
+                           ldc,
+                           epilogue);
+}
+
+CINN_REGISTER_HELPER(cinn_cpu_gemm) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+  FunctionProto::shape_inference_t inference_shape_gemm = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK_EQ(args.size(), 12UL) << "Wrong number of arguments passed in";
+    return std::vector<Expr>{common::AutoSimplify(args[1]), common::AutoSimplify(args[2])};
+  };
+
+  FunctionProto::shape_inference_t inference_shape_gemm_batch = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK_EQ(args.size(), 16UL) << "Wrong number of arguments passed in";
+    auto A_tensor = args[14].as_tensor();
+    CHECK(A_tensor);
+    int32_t batch_size = common::AutoSimplify(args[1]).as_int32();
+    std::vector<Expr> shape;
+    int total = 1;
+    for (auto& v : A_tensor->shape) {
+      auto val = common::AutoSimplify(v);
+      CHECK(val.is_constant());
+      shape.push_back(val);
+      total *= val.as_int32();
+      if (total >= batch_size) break;
+    }
+    shape.push_back(common::AutoSimplify(args[2]));
+    shape.push_back(common::AutoSimplify(args[3]));
+    return shape;
+  };
+
+  FunctionProto::shape_inference_t inference_shape_gemm_bias_act = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK_EQ(args.size(), 14UL) << "Wrong number of arguments passed in";
+    return std::vector<Expr>{common::AutoSimplify(args[1]), common::AutoSimplify(args[2])};
+  };
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_gemm_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<float>()            // alpha
+      .AddInputType<int>()              // M
+      .AddInputType<int>()              // N
+      .AddInputType<int>()              // K
+      .AddInputType<bool>()             // ta
+      .AddInputType<bool>()             // tb
+      .AddInputType<int>()              // lda
+      .AddInputType<int>()              // ldb
+      .AddInputType<int>()              // ldc
+      .AddInputType<float>()            // beta
+      .AddInputType<cinn_buffer_t*>()   // A
+      .AddInputType<cinn_buffer_t*>()   // B
+      .AddOutputType<cinn_buffer_t*>()  // C
+      .SetShapeInference(inference_shape_gemm)
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_gemm_batch_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<float>()            // alpha
+      .AddInputType<int>()              // batch
+      .AddInputType<int>()              // M
+      .AddInputType<int>()              // N
+      .AddInputType<int>()              // K
+      .AddInputType<bool>()             // ta
+      .AddInputType<bool>()             // tb
+      .AddInputType<int>()              // lda
+      .AddInputType<int>()              // ldb
+      .AddInputType<int>()              // ldc
+      .AddInputType<int>()              // a_stride
+      .AddInputType<int>()              // b_stride
+      .AddInputType<int>()              // c_stride
+      .AddInputType<float>()            // beta
+      .AddInputType<cinn_buffer_t*>()   // A
+      .AddInputType<cinn_buffer_t*>()   // B
+      .AddOutputType<cinn_buffer_t*>()  // C
+      .SetShapeInference(inference_shape_gemm_batch)
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_gemm_bias_act_fp32, host_target)
+      .SetRetType<void>()
+      .AddInputType<float>()            // alpha
+      .AddInputType<int>()              // M
+      .AddInputType<int>()              // N
+      .AddInputType<int>()              // K
+      .AddInputType<bool>()             // ta
+      .AddInputType<bool>()             // tb
+      .AddInputType<int>()              // lda
+      .AddInputType<int>()              // ldb
+      .AddInputType<int>()              // ldc
+      .AddInputType<int>()              // bias_mode
+      .AddInputType<int>()              // activation
+      .AddInputType<cinn_buffer_t*>()   // A
+      .AddInputType<cinn_buffer_t*>()   // B
+      .AddInputType<cinn_buffer_t*>()   // bias
+      .AddOutputType<cinn_buffer_t*>()  // C
+      .SetShapeInference(inference_shape_gemm_bias_act)
+      .End();
+
+  return true;
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+//! \file This file defines the native packed GEMM of the host runtime, it has no dependency on a BLAS library.
+
+#include "cinn/runtime/cinn_runtime.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+//! How the bias is added to the product in the epilogue of the GEMM.
+enum class GemmBiasMode : int {
+  kNone = 0,
+  //! A vector of N elements broadcast to every row of C.
+  kRow = 1,
+  //! A matrix of the same shape as C, its leading dimension is ldc.
+  kFull = 2,
+};
+
+//! The activation applied to every element of C in the epilogue of the GEMM, after the bias.
+enum class GemmActivation : int {
+  kNone    = 0,
+  kRelu    = 1,
+  kSigmoid = 2,
+  kTanh    = 3,
+};
+
+//! The elementwise computations fused into the store of the output tiles.
+struct GemmEpilogue {
+  GemmBiasMode bias_mode    = GemmBiasMode::kNone;
+  const float* bias         = nullptr;
+  GemmActivation activation = GemmActivation::kNone;
+};
+
+/**
+ * \brief Compute C = act(alpha * op(A) * op(B) + beta * C + bias) on row-major matrices.
+ *
+ * The blocks of op(A) and op(B) are packed into the panels of the micro-kernel, which keeps an MR x NR tile of C in
+ * registers. MR and NR are chosen by the instruction set of the running cpu. The macro tiles of C are computed by the
+ * tasks of the built-in thread pool.
+ */
+void Gemm(bool ta,
+          bool tb,
+          int M,
+          int N,
+          int K,
+          float alpha,
+          const float* A,
+          int lda,
+          const float* B,
+          int ldb,
+          float beta,
+          float* C,
+          int ldc,
+          const GemmEpilogue& epilogue = GemmEpilogue());
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+extern "C" {
+
+/**
+ * \brief Do GEMM on buffer A and B and write result to buffer C by the native packed GEMM, it has the same arguments
+ * as cinn_cpu_mkl_gemm_fp32.
+ */
+void cinn_cpu_gemm_fp32(float alpha,
+                        int M,
+                        int N,
+                        int K,
+                        bool ta,
+                        bool tb,
+                        int lda,
+                        int ldb,
+                        int ldc,
+                        float beta,
+                        cinn_buffer_t* A,
+                        cinn_buffer_t* B,
+                        cinn_buffer_t* C);
+
+/**
+ * \brief Do the batched GEMM by the native packed GEMM, it has the same arguments as cinn_cpu_mkl_gemm_batch_fp32.
+ */
+void cinn_cpu_gemm_batch_fp32(float alpha,
+                              int batch_size,
+                              int M,
+                              int N,
+                              int K,
+                              bool ta,
+                              bool tb,
+                              int lda,
+                              int ldb,
+                              int ldc,
+                              int a_stride,
+                              int b_stride,
+                              int c_stride,
+                              float beta,
+                              cinn_buffer_t* A,
+                              cinn_buffer_t* B,
+                              cinn_buffer_t* C);
+
+/**
+ * \brief Do GEMM with the bias and the activation fused into its epilogue, C = act(alpha * op(A) * op(B) + bias).
+ * @param bias_mode The value of cinn::runtime::cpu::GemmBiasMode, how the bias is broadcast to C.
+ * @param activation The value of cinn::runtime::cpu::GemmActivation.
+ * @param bias The bias, a vector of N elements or a matrix of the same shape as C.
+ * The other arguments are the same as cinn_cpu_gemm_fp32.
+ */
+void cinn_cpu_gemm_bias_act_fp32(float alpha,
+                                 int M,
+                                 int N,
+                                 int K,
+                                 bool ta,
+                                 bool tb,
+                                 int lda,
+                                 int ldb,
+                                 int ldc,
+                                 int bias_mode,
+                                 int activation,
+                                 cinn_buffer_t* A,
+                                 cinn_buffer_t* B,
+                                 cinn_buffer_t* bias,
+                                 cinn_buffer_t* C);
+
+}  // extern "C"
@@ -0,0 +1,443 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/gemm_int8.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "cinn/backends/extern_func_jit_register.h"
+#include "cinn/common/cas.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(_M_X64))
+#define CINN_GEMM_S8_WITH_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+namespace {
+
+// the width of the packed panels of B, every panel keeps the groups of 4 int8 elements along K of 32 columns
+constexpr int kPanelN = 32;
+// the largest MR of the micro-kernels
+constexpr int kMaxMR = 6;
+// the problems with fewer multiply-adds run on the calling thread
+constexpr int64_t kMinParallelWork = 64 * 64 * 64;
+
+inline int RoundUp(int x, int factor) { return (x + factor - 1) / factor * factor; }
+
+/**
+ * Compute the MR x kPanelN tile acc = a * b of int32 from the packed panels of the depth 4 * groups. The panel a keeps
+ * the unsigned activations of the MR rows in groups of 4, the panel b keeps the int8 weights of kPanelN columns in
+ * groups of 4. VL is the number of int32 lanes of the vector registers.
+ */
+template <int MR, int VL>
+inline __attribute__((always_inline)) void MicroKernelS8Impl(int groups,
+                                                             const uint8_t* a,
+                                                             const int8_t* b,
+                                                             int32_t* acc) {
+  typedef int32_t Vec __attribute__((vector_size(VL * sizeof(int32_t)), aligned(sizeof(int32_t))));
+  constexpr int NV = kPanelN / VL;
+  Vec c[MR][NV];
+  for (int i = 0; i < MR; ++i) {
+    for (int v = 0; v < NV; ++v) c[i][v] = Vec{};
+  }
+  // the groups of 4 of a column are spread to 4 rows of int32 to be multiplied by the vectors
+  alignas(64) int32_t b_rows[4][kPanelN];
+  for (int g = 0; g < groups; ++g) {
+    const int8_t* b_g = b + g * kPanelN * 4;
+    for (int j = 0; j < kPanelN; ++j) {
+      for (int t = 0; t < 4; ++t) b_rows[t][j] = b_g[j * 4 + t];
+    }
+    for (int t = 0; t < 4; ++t) {
+      const Vec* b_t = reinterpret_cast<const Vec*>(b_rows[t]);
+      for (int i = 0; i < MR; ++i) {
+        int32_t a_it = a[(g * MR + i) * 4 + t];
+        for (int v = 0; v < NV; ++v) c[i][v] += a_it * b_t[v];
+      }
+    }
+  }
+  for (int i = 0; i < MR; ++i) {
+    for (int v = 0; v < NV; ++v) reinterpret_cast<Vec*>(acc + i * kPanelN)[v] = c[i][v];
+  }
+}
+
+typedef void (*MicroKernelS8Func)(int groups, const uint8_t* a, const int8_t* b, int32_t* acc);
+
+struct MicroKernelS8 {
+  int mr;
+  MicroKernelS8Func func;
+  const char* isa;
+};
+
+#ifdef CINN_GEMM_S8_WITH_X86_KERNELS
+// vpdpbusd multiplies the groups of 4 unsigned and signed bytes and accumulates them into int32, 12 zmm accumulators
+__attribute__((target("avx512f,avx512vnni"))) void MicroKernelVnni(int groups,
+                                                                   const uint8_t* a,
+                                                                   const int8_t* b,
+                                                                   int32_t* acc) {
+  constexpr int MR = 6;
+  __m512i c[MR][2];
+  for (int i = 0; i < MR; ++i) {
+    c[i][0] = _mm512_setzero_si512();
+    c[i][1] = _mm512_setzero_si512();
+  }
+  for (int g = 0; g < groups; ++g) {
+    __m512i b0 = _mm512_loadu_si512(b + g * kPanelN * 4);
+    __m512i b1 = _mm512_loadu_si512(b + g * kPanelN * 4 + 64);
+    for (int i = 0; i < MR; ++i) {
+      int32_t a_i;
+      std::memcpy(&a_i, a + (g * MR + i) * 4, sizeof(a_i));
+      __m512i a_vec = _mm512_set1_epi32(a_i);
+      c[i][0]       = _mm512_dpbusd_epi32(c[i][0], a_vec, b0);
+      c[i][1]       = _mm512_dpbusd_epi32(c[i][1], a_vec, b1);
+    }
+  }
+  for (int i = 0; i < MR; ++i) {
+    _mm512_storeu_si512(acc + i * kPanelN, c[i][0]);
+    _mm512_storeu_si512(acc + i * kPanelN + 16, c[i][1]);
+  }
+}
+
+__attribute__((target("avx512f"))) void MicroKernelS8Avx512(int groups,
+                                                            const uint8_t* a,
+                                                            const int8_t* b,
+                                                            int32_t* acc) {
+  MicroKernelS8Impl<4, 16>(groups, a, b, acc);
+}
+
+__attribute__((target("avx2"))) void MicroKernelS8Avx2(int groups, const uint8_t* a, const int8_t* b, int32_t* acc) {
+  MicroKernelS8Impl<4, 8>(groups, a, b, acc);
+}
+#endif
+
+void MicroKernelS8Generic(int groups, const uint8_t* a, const int8_t* b, int32_t* acc) {
+  MicroKernelS8Impl<2, 4>(groups, a, b, acc);
+}
+
+// the INT8 micro-kernel of the best instruction set the running cpu supports
+const MicroKernelS8& GetMicroKernelS8() {
+  static const MicroKernelS8 kernel = []() {
+#ifdef CINN_GEMM_S8_WITH_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512vnni")) {
+      return MicroKernelS8{6, &MicroKernelVnni, "avx512vnni"};
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+      return MicroKernelS8{4, &MicroKernelS8Avx512, "avx512f"};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return MicroKernelS8{4, &MicroKernelS8Avx2, "avx2"};
+    }
+#endif
+    return MicroKernelS8{2, &MicroKernelS8Generic, "generic"};
+  }();
+  return kernel;
+}
+
+// Pack the mc rows of op(A) starting at row into the MR-wide panels of the unsigned activations, a + 128. The depth
+// is padded to the groups of 4, the padded elements are multiplied with the zeros of B.
+void PackAS8(bool ta, const int8_t* A, int lda, int row, int mc, int K, int mr, uint8_t* packed) {
+  const int K4 = RoundUp(K, 4);
+  for (int ir = 0; ir < mc; ir += mr) {
+    int rows = std::min(mr, mc - ir);
+    for (int k = 0; k < K4; ++k) {
+      uint8_t* dst = packed + (k / 4 * mr) * 4 + k % 4;
+      for (int i = 0; i < rows; ++i) {
+        int r        = row + ir + i;
+        int8_t value = k < K ? (ta ? A[k * lda + r] : A[r * lda + k]) : 0;
+        dst[i * 4]   = static_cast<uint8_t>(value + 128);
+      }
+      for (int i = rows; i < mr; ++i) dst[i * 4] = 128;
+    }
+    packed += mr * K4;
+  }
+}
+
+// The arguments of an INT8 GEMM shared by its tasks.
+struct GemmS8Args {
+  const MicroKernelS8* kernel;
+  bool ta;
+  int M;
+  int N;
+  int K;
+  float a_scale;
+  const int8_t* A;
+  int lda;
+  const int8_t* packed_b;
+  const float* b_scales;
+  const int32_t* b_compensation;
+  void* C;
+  int ldc_row;
+  int ldc_col;
+  const GemmS8Epilogue* epilogue;
+  // the size of the macro tiles of C
+  int mc;
+  int nc;
+  int tiles_n;
+  int num_tiles;
+};
+
+// Dequantize the int32 products of the cols elements of C starting at (row, col), apply the epilogue and store them.
+void StoreTile(const GemmS8Args& args, const int32_t* acc, int row, int col, int cols) {
+  const GemmS8Epilogue& epilogue = *args.epilogue;
+  float values[kPanelN];
+  for (int j = 0; j < cols; ++j) {
+    values[j] = static_cast<float>(acc[j] - args.b_compensation[col + j]) * (args.a_scale * args.b_scales[col + j]);
+  }
+  if (epilogue.bias_mode == GemmBiasMode::kRow) {
+    for (int j = 0; j < cols; ++j) values[j] += epilogue.bias[col + j];
+  } else if (epilogue.bias_mode == GemmBiasMode::kFull) {
+    for (int j = 0; j < cols; ++j) values[j] += epilogue.bias[row * args.N + col + j];
+  }
+  switch (epilogue.activation) {
+    case GemmActivation::kNone:
+      break;
+    case GemmActivation::kRelu:
+      for (int j = 0; j < cols; ++j) values[j] = std::max(values[j], 0.f);
+      break;
+    case GemmActivation::kSigmoid:
+      for (int j = 0; j < cols; ++j) values[j] = 1.f / (1.f + std::exp(-values[j]));
+      break;
+    case GemmActivation::kTanh:
+      for (int j = 0; j < cols; ++j) values[j] = std::tanh(values[j]);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported activation " << static_cast<int>(epilogue.activation) << " of the cpu int8 gemm";
+  }
+  int64_t offset = static_cast<int64_t>(row) * args.ldc_row + static_cast<int64_t>(col) * args.ldc_col;
+  if (epilogue.out_scale > 0.f) {
+    int8_t* c       = reinterpret_cast<int8_t*>(args.C) + offset;
+    float inv_scale = 1.f / epilogue.out_scale;
+    for (int j = 0; j < cols; ++j) c[j * args.ldc_col] = QuantizeS8(values[j], inv_scale);
+  } else {
+    float* c = reinterpret_cast<float*>(args.C) + offset;
+    for (int j = 0; j < cols; ++j) c[j * args.ldc_col] = values[j];
+  }
+}
+
+// Compute the macro tile of C starting at (row, col) over the whole depth.
+void ComputeMacroTileS8(const GemmS8Args& args, int row, int col) {
+  thread_local std::vector<uint8_t> packed_a;
+  const int mr     = args.kernel->mr;
+  const int mc     = std::min(args.mc, args.M - row);
+  const int nc     = std::min(args.nc, args.N - col);
+  const int groups = RoundUp(args.K, 4) / 4;
+  packed_a.resize(static_cast<size_t>(RoundUp(mc, mr)) * groups * 4);
+  alignas(64) int32_t acc[kMaxMR * kPanelN];
+
+  PackAS8(args.ta, args.A, args.lda, row, mc, args.K, mr, packed_a.data());
+  for (int jr = 0; jr < nc; jr += kPanelN) {
+    const int cols   = std::min(kPanelN, nc - jr);
+    const int8_t* bp = args.packed_b + static_cast<int64_t>(col + jr) * groups * 4;
+    for (int ir = 0; ir < mc; ir += mr) {
+      args.kernel->func(groups, packed_a.data() + ir * groups * 4, bp, acc);
+      const int rows = std::min(mr, mc - ir);
+      for (int i = 0; i < rows; ++i) {
+        StoreTile(args, acc + i * kPanelN, row + ir + i, col + jr, cols);
+      }
+    }
+  }
+}
+
+int RunGemmS8Task(int task_id, int num_task, void* datas) {
+  auto* args = reinterpret_cast<const GemmS8Args*>(datas);
+  for (int tile = task_id; tile < args->num_tiles; tile += num_task) {
+    ComputeMacroTileS8(*args, tile / args->tiles_n * args->mc, tile % args->tiles_n * args->nc);
+  }
+  return 0;
+}
+
+}  // namespace
+
+int64_t PackedWeightsS8Bytes(int K, int N) {
+  int64_t n_pad = RoundUp(N, kPanelN);
+  // the panels, then the scales and the compensations of the columns
+  return n_pad * RoundUp(K, 4) + n_pad * (sizeof(float) + sizeof(int32_t));
+}
+
+void PackWeightsS8(bool tb, int K, int N, const float* B, int ldb, int8_t* packed) {
+  const int K4    = RoundUp(K, 4);
+  const int n_pad = RoundUp(N, kPanelN);
+  auto* scales    = reinterpret_cast<float*>(packed + static_cast<int64_t>(n_pad) * K4);
+  auto* comps     = reinterpret_cast<int32_t*>(scales + n_pad);
+  auto get        = [&](int k, int n) { return tb ? B[n * ldb + k] : B[k * ldb + n]; };
+  for (int n = 0; n < n_pad; ++n) {
+    int8_t* panel = packed + static_cast<int64_t>(n / kPanelN) * kPanelN * K4 + (n % kPanelN) * 4;
+    if (n >= N) {
+      for (int k = 0; k < K4; ++k) panel[k / 4 * kPanelN * 4 + k % 4] = 0;
+      scales[n] = 0.f;
+      comps[n]  = 0;
+      continue;
+    }
+    float abs_max = 0.f;
+    for (int k = 0; k < K; ++k) abs_max = std::max(abs_max, std::abs(get(k, n)));
+    float scale     = abs_max / 127.f;
+    float inv_scale = abs_max > 0.f ? 1.f / scale : 0.f;
+    int32_t sum     = 0;
+    for (int k = 0; k < K4; ++k) {
+      int8_t* dst = panel + k / 4 * kPanelN * 4 + k % 4;
+      *dst        = k < K ? QuantizeS8(get(k, n), inv_scale) : 0;
+      sum += *dst;
+    }
+    scales[n] = scale;
+    // the activations are shifted by 128 to be unsigned, which adds 128 * sum(B) to the products
+    comps[n] = 128 * sum;
+  }
+}
+
+void GemmS8(bool ta,
+            int M,
+            int N,
+            int K,
+            float a_scale,
+            const int8_t* A,
+            int lda,
+            const int8_t* packed_b,
+            void* C,
+            int ldc_row,
+            int ldc_col,
+            const GemmS8Epilogue& epilogue) {
+  CHECK(epilogue.bias_mode == GemmBiasMode::kNone || epilogue.bias) << "The bias of the cpu int8 gemm is null";
+  if (M <= 0 || N <= 0) return;
+
+  const MicroKernelS8& kernel = GetMicroKernelS8();
+  VLOG(6) << "Run the cpu int8 gemm of " << M << "x" << N << "x" << K << " by the " << kernel.isa << " micro-kernel";
+  const int K4    = RoundUp(K, 4);
+  const int n_pad = RoundUp(N, kPanelN);
+  auto* scales    = reinterpret_cast<const float*>(packed_b + static_cast<int64_t>(n_pad) * K4);
+  auto* comps     = reinterpret_cast<const int32_t*>(scales + n_pad);
+  GemmS8Args args{&kernel, ta, M, N, K, a_scale, A, lda, packed_b, scales, comps, C, ldc_row, ldc_col, &epilogue};
+  args.mc = std::min(RoundUp(M, kernel.mr), kernel.mr * 16);
+  args.nc = std::min(n_pad, kPanelN * 8);
+
+  int num_threads  = static_cast<int64_t>(M) * N * K < kMinParallelWork ? 1 : max_concurrency();
+  auto count_tiles = [&]() {
+    args.tiles_n   = (N + args.nc - 1) / args.nc;
+    args.num_tiles = (M + args.mc - 1) / args.mc * args.tiles_n;
+  };
+  count_tiles();
+  // split the tiles until every thread has one, the rows are split first as B is packed ahead
+  while (args.num_tiles < num_threads) {
+    if (args.mc > kernel.mr) {
+      args.mc = RoundUp(args.mc / 2, kernel.mr);
+    } else if (args.nc > kPanelN) {
+      args.nc = RoundUp(args.nc / 2, kPanelN);
+    } else {
+      break;
+    }
+    count_tiles();
+  }
+  cinn_backend_parallel_launch(&RunGemmS8Task, &args, std::min(args.num_tiles, num_threads));
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+void cinn_cpu_pack_weights_s8(int K, int N, bool tb, cinn_buffer_t* B, cinn_buffer_t* packed) {
+  cinn::runtime::cpu::PackWeightsS8(tb,
+                                    K,
+                                    N,
+                                    reinterpret_cast<const float*>(B->memory),
+                                    tb ? K : N,
+                                    reinterpret_cast<int8_t*>(packed->memory));
+}
+
+void cinn_cpu_gemm_s8(int M,
+                      int N,
+                      int K,
+                      bool ta,
+                      float a_scale,
+                      float out_scale,
+                      int bias_mode,
+                      int activation,
+                      cinn_buffer_t* A,
+                      cinn_buffer_t* packed_b,
+                      cinn_buffer_t* bias,
+                      cinn_buffer_t* C) {
+  cinn::runtime::cpu::GemmS8Epilogue epilogue;
+  epilogue.bias_mode  = static_cast<cinn::runtime::cpu::GemmBiasMode>(bias_mode);
+  epilogue.bias       = reinterpret_cast<const float*>(bias->memory);
+  epilogue.activation = static_cast<cinn::runtime::cpu::GemmActivation>(activation);
+  epilogue.out_scale  = out_scale;
+  cinn::runtime::cpu::GemmS8(ta,
+                             M,
+                             N,
+                             K,
+                             a_scale,
+                             reinterpret_cast<const int8_t*>(A->memory),
+                             ta ? M : K,
+                             reinterpret_cast<const int8_t*>(packed_b->memory),
+                             C->memory,
+                             N,
+                             1,
+                             epilogue);
+}
+
+CINN_REGISTER_HELPER(cinn_cpu_gemm_int8) {
+  using namespace cinn;  // NOLINT
+  using backends::FunctionProto;
+  auto host_target = common::DefaultHostTarget();
+
+  FunctionProto::shape_inference_t inference_shape_pack = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK_EQ(args.size(), 4UL) << "Wrong number of arguments passed in";
+    int K = common::AutoSimplify(args[0]).as_int32();
+    int N = common::AutoSimplify(args[1]).as_int32();
+    return std::vector<Expr>{Expr(static_cast<int>(cinn::runtime::cpu::PackedWeightsS8Bytes(K, N)))};
+  };
+
+  FunctionProto::shape_inference_t inference_shape_gemm = [](const std::vector<Expr>& args, int offset) {
+    CHECK_EQ(offset, 0UL) << "Only one output";
+    CHECK_EQ(args.size(), 11UL) << "Wrong number of arguments passed in";
+    return std::vector<Expr>{common::AutoSimplify(args[0]), common::AutoSimplify(args[1])};
+  };
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_pack_weights_s8, host_target)
+      .SetRetType<void>()
+      .AddInputType<int>()              // K
+      .AddInputType<int>()              // N
+      .AddInputType<bool>()             // tb
+      .AddInputType<cinn_buffer_t*>()   // B
+      .AddOutputType<cinn_buffer_t*>()  // packed
+      .SetShapeInference(inference_shape_pack)
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_cpu_gemm_s8, host_target)
+      .SetRetType<void>()
+      .AddInputType<int>()              // M
+      .AddInputType<int>()              // N
+      .AddInputType<int>()              // K
+      .AddInputType<bool>()             // ta
+      .AddInputType<float>()            // a_scale
+      .AddInputType<float>()            // out_scale
+      .AddInputType<int>()              // bias_mode
+      .AddInputType<int>()              // activation
+      .AddInputType<cinn_buffer_t*>()   // A
+      .AddInputType<cinn_buffer_t*>()   // packed_b
+      .AddInputType<cinn_buffer_t*>()   // bias
+      .AddOutputType<cinn_buffer_t*>()  // C
+      .SetShapeInference(inference_shape_gemm)
+      .End();
+
+  return true;
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+//! \file This file defines the INT8 GEMM of the host runtime with the int32 accumulation and the fused requantization.
+
+#include <cstdint>
+
+#include "cinn/runtime/cinn_runtime.h"
+#include "cinn/runtime/cpu/gemm.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+//! The elementwise computations fused into the store of the INT8 GEMM.
+struct GemmS8Epilogue {
+  //! kRow is a vector of N elements, kFull is a matrix of M x N elements.
+  GemmBiasMode bias_mode    = GemmBiasMode::kNone;
+  const float* bias         = nullptr;
+  GemmActivation activation = GemmActivation::kNone;
+  //! The output is requantized to int8 by the scale if it's positive, or stored in float otherwise.
+  float out_scale = 0.f;
+};
+
+//! Quantize a float to int8 symmetrically, round(value / scale) clamped to [-127, 127].
+inline int8_t QuantizeS8(float value, float inv_scale) {
+  float q = value * inv_scale;
+  q       = q < -127.f ? -127.f : (q > 127.f ? 127.f : q);
+  return static_cast<int8_t>(q < 0 ? q - 0.5f : q + 0.5f);
+}
+
+//! The bytes of the weights of K x N packed by PackWeightsS8.
+int64_t PackedWeightsS8Bytes(int K, int N);
+
+/**
+ * \brief Quantize the float weights op(B) of K x N to int8 with a scale per column, and pack them into the panels of
+ * the INT8 micro-kernels.
+ *
+ * The panels keep every 4 consecutive elements of a column together, which is the layout of the int8 dot products of
+ * AVX512-VNNI. The scales and the compensation of the unsigned activations are stored after the panels.
+ */
+void PackWeightsS8(bool tb, int K, int N, const float* B, int ldb, int8_t* packed);
+
+/**
+ * \brief Compute C = act(a_scale * op(A) * dequant(B) + bias), A is int8 of M x K quantized by a_scale and B is packed
+ * by PackWeightsS8.
+ *
+ * The products are accumulated in int32 and dequantized by the scales of A and the columns of B in the epilogue. The
+ * element (i, j) of C is stored at C + i * ldc_row + j * ldc_col, so the transposed output can be stored directly.
+ * C is float, or int8 if the epilogue requantizes it.
+ */
+void GemmS8(bool ta,
+            int M,
+            int N,
+            int K,
+            float a_scale,
+            const int8_t* A,
+            int lda,
+            const int8_t* packed_b,
+            void* C,
+            int ldc_row,
+            int ldc_col,
+            const GemmS8Epilogue& epilogue = GemmS8Epilogue());
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+extern "C" {
+
+/**
+ * \brief Quantize and pack the float weights of K x N for cinn_cpu_gemm_s8, it is run once before the execution when
+ * the weights are constant.
+ */
+void cinn_cpu_pack_weights_s8(int K, int N, bool tb, cinn_buffer_t* B, cinn_buffer_t* packed);
+
+/**
+ * \brief Do the INT8 GEMM of the int8 A and the packed B, the output is float, or int8 if out_scale is positive.
+ */
+void cinn_cpu_gemm_s8(int M,
+                      int N,
+                      int K,
+                      bool ta,
+                      float a_scale,
+                      float out_scale,
+                      int bias_mode,
+                      int activation,
+                      cinn_buffer_t* A,
+                      cinn_buffer_t* packed_b,
+                      cinn_buffer_t* bias,
+                      cinn_buffer_t* C);
+
+}  // extern "C"
@@ -0,0 +1,138 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/gemm_int8.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+// the reference of GemmS8 computed in double with the weights quantized per column as PackWeightsS8 does
+std::vector<float> NaiveGemmS8(bool ta,
+                               int M,
+                               int N,
+                               int K,
+                               float a_scale,
+                               const std::vector<int8_t>& A,
+                               const std::vector<float>& B,
+                               const GemmS8Epilogue& epilogue) {
+  int lda = ta ? M : K;
+  std::vector<float> out(M * N);
+  for (int j = 0; j < N; ++j) {
+    float abs_max = 0.f;
+    for (int k = 0; k < K; ++k) abs_max = std::max(abs_max, std::abs(B[k * N + j]));
+    float b_scale = abs_max / 127.f;
+    for (int i = 0; i < M; ++i) {
+      double sum = 0;
+      for (int k = 0; k < K; ++k) {
+        int8_t b = abs_max > 0.f ? QuantizeS8(B[k * N + j], 1.f / b_scale) : 0;
+        sum += static_cast<double>(ta ? A[k * lda + i] : A[i * lda + k]) * b;
+      }
+      float v = sum * a_scale * b_scale;
+      if (epilogue.bias_mode == GemmBiasMode::kRow) v += epilogue.bias[j];
+      if (epilogue.bias_mode == GemmBiasMode::kFull) v += epilogue.bias[i * N + j];
+      if (epilogue.activation == GemmActivation::kRelu) v = std::max(v, 0.f);
+      out[i * N + j] = v;
+    }
+  }
+  return out;
+}
+
+std::vector<int8_t> RandomS8Vector(int size, std::mt19937* rng) {
+  std::uniform_int_distribution<int> dist(-127, 127);
+  std::vector<int8_t> res(size);
+  for (auto& v : res) v = dist(*rng);
+  return res;
+}
+
+TEST(CpuGemmS8, Transposes) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  // the shapes cover the partial micro tiles, the partial panels and the depths not divisible by 4
+  for (int M : {1, 7, 64, 131}) {
+    for (int N : {1, 9, 48, 257}) {
+      for (int K : {1, 33, 300}) {
+        auto A = RandomS8Vector(M * K, &rng);
+        std::vector<float> B(K * N), B_t(K * N);
+        for (auto& v : B) v = dist(rng);
+        for (int k = 0; k < K; ++k) {
+          for (int j = 0; j < N; ++j) B_t[j * K + k] = B[k * N + j];
+        }
+        std::vector<int8_t> packed(PackedWeightsS8Bytes(K, N));
+        for (int ta = 0; ta < 2; ++ta) {
+          for (int tb = 0; tb < 2; ++tb) {
+            auto expected = NaiveGemmS8(ta, M, N, K, 0.01f, A, B, GemmS8Epilogue());
+            PackWeightsS8(tb, K, N, tb ? B_t.data() : B.data(), tb ? K : N, packed.data());
+            std::vector<float> out(M * N);
+            GemmS8(ta, M, N, K, 0.01f, A.data(), ta ? M : K, packed.data(), out.data(), N, 1);
+            for (int i = 0; i < M * N; ++i) {
+              ASSERT_NEAR(out[i], expected[i], 1e-3) << "M " << M << " N " << N << " K " << K << " ta " << ta
+                                                     << " tb " << tb << " at " << i;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(CpuGemmS8, Epilogues) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  int M = 37, N = 70, K = 290;
+  auto A = RandomS8Vector(M * K, &rng);
+  std::vector<float> B(K * N), row_bias(N), full_bias(M * N);
+  for (auto& v : B) v = dist(rng);
+  for (auto& v : row_bias) v = dist(rng);
+  for (auto& v : full_bias) v = dist(rng);
+  std::vector<int8_t> packed(PackedWeightsS8Bytes(K, N));
+  PackWeightsS8(false, K, N, B.data(), N, packed.data());
+  for (auto bias_mode : {GemmBiasMode::kNone, GemmBiasMode::kRow, GemmBiasMode::kFull}) {
+    for (auto activation : {GemmActivation::kNone, GemmActivation::kRelu}) {
+      GemmS8Epilogue epilogue;
+      epilogue.bias_mode  = bias_mode;
+      epilogue.bias       = bias_mode == GemmBiasMode::kRow ? row_bias.data() : full_bias.data();
+      epilogue.activation = activation;
+      auto expected       = NaiveGemmS8(false, M, N, K, 0.01f, A, B, epilogue);
+      std::vector<float> out(M * N);
+      GemmS8(false, M, N, K, 0.01f, A.data(), K, packed.data(), out.data(), N, 1, epilogue);
+      for (int i = 0; i < M * N; ++i) {
+        ASSERT_NEAR(out[i], expected[i], 1e-3) << "bias mode " << static_cast<int>(bias_mode) << " activation "
+                                               << static_cast<int>(activation) << " at " << i;
+      }
+
+      // the requantized output stored transposed differs from the float output by the rounding
+      epilogue.out_scale = 0.1f;
+      std::vector<int8_t> out_s8(M * N);
+      GemmS8(false, M, N, K, 0.01f, A.data(), K, packed.data(), out_s8.data(), 1, M, epilogue);
+      for (int i = 0; i < M; ++i) {
+        for (int j = 0; j < N; ++j) {
+          float value = std::min(std::max(expected[i * N + j], -12.7f), 12.7f);
+          ASSERT_NEAR(out_s8[j * M + i] * 0.1f, value, 0.05f + 1e-3) << "at (" << i << ", " << j << ")";
+        }
+      }
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,119 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/gemm.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+// the reference of Gemm computed in double
+std::vector<float> NaiveGemm(bool ta,
+                             bool tb,
+                             int M,
+                             int N,
+                             int K,
+                             float alpha,
+                             const std::vector<float>& A,
+                             const std::vector<float>& B,
+                             float beta,
+                             const std::vector<float>& C,
+                             const GemmEpilogue& epilogue) {
+  int lda = ta ? M : K;
+  int ldb = tb ? K : N;
+  std::vector<float> out(M * N);
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      double sum = 0;
+      for (int k = 0; k < K; ++k) {
+        sum += static_cast<double>(ta ? A[k * lda + i] : A[i * lda + k]) * (tb ? B[j * ldb + k] : B[k * ldb + j]);
+      }
+      float v = alpha * sum + beta * C[i * N + j];
+      if (epilogue.bias_mode == GemmBiasMode::kRow) v += epilogue.bias[j];
+      if (epilogue.bias_mode == GemmBiasMode::kFull) v += epilogue.bias[i * N + j];
+      if (epilogue.activation == GemmActivation::kRelu) v = std::max(v, 0.f);
+      if (epilogue.activation == GemmActivation::kSigmoid) v = 1.f / (1.f + std::exp(-v));
+      if (epilogue.activation == GemmActivation::kTanh) v = std::tanh(v);
+      out[i * N + j] = v;
+    }
+  }
+  return out;
+}
+
+TEST(CpuGemm, Transposes) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  // the shapes cover the partial micro tiles and several blocks of K
+  for (int M : {1, 7, 64, 131}) {
+    for (int N : {1, 9, 48, 257}) {
+      for (int K : {1, 33, 300}) {
+        std::vector<float> A(M * K), B(K * N), C(M * N);
+        for (auto& v : A) v = dist(rng);
+        for (auto& v : B) v = dist(rng);
+        for (auto& v : C) v = dist(rng);
+        for (int ta = 0; ta < 2; ++ta) {
+          for (int tb = 0; tb < 2; ++tb) {
+            auto expected = NaiveGemm(ta, tb, M, N, K, 0.5f, A, B, 2.f, C, GemmEpilogue());
+            auto out      = C;
+            Gemm(ta, tb, M, N, K, 0.5f, A.data(), ta ? M : K, B.data(), tb ? K : N, 2.f, out.data(), N);
+            for (int i = 0; i < M * N; ++i) {
+              ASSERT_NEAR(out[i], expected[i], 1e-4) << "M " << M << " N " << N << " K " << K << " ta " << ta
+                                                     << " tb " << tb << " at " << i;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(CpuGemm, Epilogues) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  int M = 37, N = 70, K = 290;
+  std::vector<float> A(M * K), B(K * N), row_bias(N), full_bias(M * N);
+  for (auto& v : A) v = dist(rng);
+  for (auto& v : B) v = dist(rng);
+  for (auto& v : row_bias) v = dist(rng);
+  for (auto& v : full_bias) v = dist(rng);
+  std::vector<float> zeros(M * N, 0.f);
+  for (auto bias_mode : {GemmBiasMode::kNone, GemmBiasMode::kRow, GemmBiasMode::kFull}) {
+    for (auto activation :
+         {GemmActivation::kNone, GemmActivation::kRelu, GemmActivation::kSigmoid, GemmActivation::kTanh}) {
+      GemmEpilogue epilogue;
+      epilogue.bias_mode  = bias_mode;
+      epilogue.bias       = bias_mode == GemmBiasMode::kRow ? row_bias.data() : full_bias.data();
+      epilogue.activation = activation;
+      auto expected       = NaiveGemm(false, false, M, N, K, 1.f, A, B, 0.f, zeros, epilogue);
+      // C is not read when beta is 0
+      std::vector<float> out(M * N, NAN);
+      Gemm(false, false, M, N, K, 1.f, A.data(), K, B.data(), N, 0.f, out.data(), N, epilogue);
+      for (int i = 0; i < M * N; ++i) {
+        ASSERT_NEAR(out[i], expected[i], 1e-4) << "bias mode " << static_cast<int>(bias_mode) << " activation "
+                                               << static_cast<int>(activation) << " at " << i;
+      }
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -19,6 +19,8 @@
 
 #include "cinn/backends/extern_func_jit_register.h"
 #include "cinn/backends/function_prototype.h"
+#include "cinn/backends/llvm/runtime_symbol_registry.h"
+#include "cinn/common/float16.h"
 
 #ifdef CINN_WITH_MKL_CBLAS
 #include "cinn/runtime/cpu/mkl_math.h"
@@ -53,6 +55,10 @@ inline int cinn_host_find_float(const cinn_buffer_t* buf, int size, float num) {
 }
 
 #undef __cinn_host_find_kernel
+
+float cinn_host_half_to_float(uint16_t h) { return cinn::common::HalfBitsToFloat(h); }
+
+uint16_t cinn_host_float_to_half(float f) { return cinn::common::FloatToHalfBits(f); }
 }
 
 CINN_REGISTER_HELPER(host_intrinsics) {
@@ -86,5 +92,11 @@ CINN_REGISTER_HELPER(host_intrinsics) {
       .AddInputType<float>()
       .End();
 
+  // fpext and fptrunc of half are lowered to these libcalls if the cpu has no F16C
+  cinn::backends::RuntimeSymbolRegistry::Global().RegisterFn("__gnu_h2f_ieee",
+                                                             reinterpret_cast<void*>(&cinn_host_half_to_float));
+  cinn::backends::RuntimeSymbolRegistry::Global().RegisterFn("__gnu_f2h_ieee",
+                                                             reinterpret_cast<void*>(&cinn_host_float_to_half));
+
   return true;
 }
@@ -28,4 +28,10 @@ void __cinn_host_tanh_v(const cinn_buffer_t* x, cinn_buffer_t* out);
 inline int cinn_host_find_int(const cinn_buffer_t* buf, int size, int num);
 
 inline int cinn_host_find_float(const cinn_buffer_t* buf, int size, float num);
+
+//! The conversions of the IEEE half the JIT code calls without F16C, by the libcall names of LLVM.
+//@{
+float cinn_host_half_to_float(uint16_t h);
+uint16_t cinn_host_float_to_half(float f);
+//@}
 }
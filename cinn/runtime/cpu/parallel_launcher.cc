@@ -0,0 +1,190 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/parallel_launcher.h"
+
+#include <glog/logging.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+namespace {
+// the iterations a worker spins before parking, a pause takes about 10 cycles before Skylake and about 140 cycles
+// since, so it spins for about 50us to 1ms at 3GHz
+constexpr int kSpinCount      = 1 << 14;
+constexpr uint64_t kTeamBits = 16;
+constexpr uint64_t kTeamMask = (1ULL << kTeamBits) - 1;
+
+thread_local bool in_parallel_region = false;
+
+// the number of the live launchers whose workers are pinned, the launchers of different threads would pin their
+// workers onto the same cores, so only one of them pins
+std::atomic<int> num_bound_launchers{0};
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64)
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// The cores the process may run on, in order
+std::vector<int> AllowedCores() {
+  std::vector<int> cores;
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0) {
+    for (int i = 0; i < CPU_SETSIZE; ++i) {
+      if (CPU_ISSET(i, &cpuset)) cores.push_back(i);
+    }
+  }
+  return cores;
+}
+
+void BindCurrentThread(int core) {
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(core, &cpuset);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+    VLOG(3) << "Failed to bind the parallel worker to core " << core;
+  }
+}
+
+// Bind the workers only if CINN_BIND_THREADS is not 0
+bool BindThreadsFromEnv() {
+  const char* val = getenv("CINN_BIND_THREADS");
+  return val == nullptr || std::string(val) != "0";
+}
+}  // namespace
+
+ParallelLauncher::ParallelLauncher(int num_threads, bool bind_cores) {
+  CHECK(num_threads > 0 && num_threads <= kTeamMask) << "Invalid number of threads: " << num_threads;
+  // spinning only helps if every thread has a core, otherwise it takes the core of the thread being waited for
+  spin_count_ = num_threads <= std::thread::hardware_concurrency() ? kSpinCount : 0;
+  if (bind_cores) {
+    int expected = 0;
+    bound_       = num_bound_launchers.compare_exchange_strong(expected, 1);
+    if (!bound_) VLOG(3) << "Another parallel launcher pins its workers, skip pinning the workers";
+  }
+  std::vector<int> cores = bound_ ? AllowedCores() : std::vector<int>();
+  for (int i = 1; i < num_threads; ++i) {
+    // the calling thread keeps the first core
+    int core = cores.empty() ? -1 : cores[i % cores.size()];
+    workers_.emplace_back([this, i, core] {
+      if (core >= 0) BindCurrentThread(core);
+      WorkerLoop(i);
+    });
+  }
+}
+
+ParallelLauncher::~ParallelLauncher() {
+  stop_.store(true);
+  generation_.fetch_add(1ULL << kTeamBits);
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    cv_.notify_all();
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  if (bound_) num_bound_launchers.store(0);
+}
+
+ParallelLauncher* ParallelLauncher::ThreadLocal(int num_threads, bool bind_cores) {
+  thread_local std::unique_ptr<ParallelLauncher> launcher;
+  if (!launcher || launcher->NumThreads() != num_threads) {
+    launcher.reset();
+    launcher = std::make_unique<ParallelLauncher>(num_threads, bind_cores && BindThreadsFromEnv());
+  }
+  return launcher.get();
+}
+
+bool ParallelLauncher::InParallelRegion() { return in_parallel_region; }
+
+void ParallelLauncher::RunTasks(int member, int team_size) {
+  in_parallel_region = true;
+  for (int task_id = member; task_id < num_task_; task_id += team_size) {
+    (*flambda_)(task_id, num_task_, datas_);
+  }
+  in_parallel_region = false;
+}
+
+void ParallelLauncher::Launch(FCINNParallelLambda flambda, void* datas, int num_task) {
+  int team_size = std::max(std::min(num_task, NumThreads()), 1);
+  flambda_      = flambda;
+  datas_        = datas;
+  num_task_     = num_task;
+  if (team_size > 1) {
+    pending_.store(team_size - 1, std::memory_order_relaxed);
+    uint64_t gen = generation_.load(std::memory_order_relaxed) >> kTeamBits;
+    generation_.store(((gen + 1) << kTeamBits) | team_size);
+    if (num_parked_.load() > 0) {
+      std::lock_guard<std::mutex> lock(mtx_);
+      cv_.notify_all();
+    }
+  }
+
+  RunTasks(0, team_size);
+
+  for (int spin = 0; pending_.load(std::memory_order_acquire) > 0; ++spin) {
+    if (spin < spin_count_) {
+      CpuRelax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+uint64_t ParallelLauncher::WaitForJob(uint64_t seen) {
+  for (int spin = 0; spin < spin_count_; ++spin) {
+    uint64_t gen = generation_.load(std::memory_order_acquire);
+    if (gen != seen) return gen;
+    CpuRelax();
+  }
+  std::unique_lock<std::mutex> lock(mtx_);
+  ++num_parked_;
+  cv_.wait(lock, [&] { return generation_.load() != seen; });
+  --num_parked_;
+  return generation_.load(std::memory_order_acquire);
+}
+
+void ParallelLauncher::WorkerLoop(int worker_id) {
+  uint64_t seen = 0;
+  while (true) {
+    seen = WaitForJob(seen);
+    if (stop_.load()) return;
+    int team_size = static_cast<int>(seen & kTeamMask);
+    if (worker_id < team_size) {
+      RunTasks(worker_id, team_size);
+      pending_.fetch_sub(1, std::memory_order_release);
+    }
+  }
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,100 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cinn/runtime/cpu/thread_backend.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+/**
+ * A fork-join thread pool running the parallel loops of the kernels.
+ *
+ * The calling thread runs the task 0 and the workers run the others, the task ids are assigned statically
+ * so no queue is involved. Idle workers spin on a generation counter for a short while before parking on
+ * a condition variable, so the back-to-back launches of a kernel don't pay for waking the threads.
+ *
+ * Every launching thread owns its launcher, so the instructions run concurrently by the inter-op executor
+ * don't contend for one pool. A launch from inside a parallel task runs its tasks serially.
+ */
+class ParallelLauncher {
+ public:
+  /**
+   * Constructor.
+   * @param num_threads The number of threads running the tasks, including the calling thread.
+   * @param bind_cores Whether to pin the workers to different cores, it is ignored if the workers of another live
+   * launcher are pinned.
+   */
+  ParallelLauncher(int num_threads, bool bind_cores);
+
+  ~ParallelLauncher();
+
+  //! Run the tasks [0, num_task) and return after all of them finish.
+  void Launch(FCINNParallelLambda flambda, void* datas, int num_task);
+
+  int NumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  /**
+   * Return the launcher of the calling thread, it is recreated if the number of threads changes.
+   * @param num_threads The number of threads running the tasks, including the calling thread.
+   * @param bind_cores Whether to pin the workers, it is ignored if CINN_BIND_THREADS is 0.
+   */
+  static ParallelLauncher* ThreadLocal(int num_threads, bool bind_cores);
+
+  //! Whether the calling thread is running a parallel task.
+  static bool InParallelRegion();
+
+ private:
+  void WorkerLoop(int worker_id);
+
+  // Wait until the generation differs from the seen one, returns the new value
+  uint64_t WaitForJob(uint64_t seen);
+
+  // Run the tasks assigned to a member of a team, the member i runs i, i + team_size, ...
+  void RunTasks(int member, int team_size);
+
+  std::vector<std::thread> workers_;
+  // the iterations to spin before parking or yielding
+  int spin_count_;
+  // whether the workers are pinned to the cores
+  bool bound_ = false;
+
+  // the job of the current launch, written before the generation is bumped
+  FCINNParallelLambda flambda_ = nullptr;
+  void* datas_                 = nullptr;
+  int num_task_                = 0;
+
+  // the number of launches in the high bits and the team size in the low 16 bits
+  alignas(64) std::atomic<uint64_t> generation_{0};
+  // the number of team workers not finished
+  alignas(64) std::atomic<int> pending_{0};
+
+  std::atomic<int> num_parked_{0};
+  std::atomic<bool> stop_{false};
+  std::mutex mtx_;
+  std::condition_variable cv_;
+};
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
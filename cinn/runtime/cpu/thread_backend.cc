@@ -20,9 +20,17 @@
 #include "cinn/backends/extern_func_jit_register.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/common/cas.h"
+#include "cinn/runtime/cpu/parallel_launcher.h"
 #include "cinn/runtime/intrinsic.h"
 
-int max_concurrency() {
+// the number of threads a parallel loop launched from the current thread may use,
+// it is set by the inter-op scheduler to split the cores between concurrent kernels
+static thread_local int intra_op_concurrency = 0;
+
+void cinn_backend_set_intra_op_concurrency(int num_threads) { intra_op_concurrency = std::max(num_threads, 0); }
+
+// the default concurrency decided by the environment variables and the hardware
+static int DefaultConcurrency() {
   int max_concurrency = 1;
   const char* val     = getenv("CINN_NUM_THREADS");
   if (val == nullptr) {
@@ -39,7 +47,32 @@ int max_concurrency() {
   return std::max(max_concurrency, 1);
 }
 
+int max_concurrency() {
+  if (intra_op_concurrency > 0) {
+    return intra_op_concurrency;
+  }
+  // the environment is only read once
+  static const int default_concurrency = DefaultConcurrency();
+  return default_concurrency;
+}
+
 int cinn_backend_parallel_launch(FCINNParallelLambda flambda, void* datas, int num_task) {
+  int num_workers = max_concurrency();
+  if (num_task == 0) num_task = num_workers;
+  if (num_task == 1 || num_workers == 1 || cinn::runtime::cpu::ParallelLauncher::InParallelRegion()) {
+    // a nested parallel loop runs serially in the task of its outer loop
+    for (int task_id = 0; task_id < num_task; ++task_id) {
+      (*flambda)(task_id, num_task, datas);
+    }
+    return 0;
+  }
+  // the launchers of the concurrent kernels split the cores, so only the one using all the cores is pinned
+  bool bind_cores = intra_op_concurrency == 0;
+  cinn::runtime::cpu::ParallelLauncher::ThreadLocal(num_workers, bind_cores)->Launch(flambda, datas, num_task);
+  return 0;
+}
+
+int cinn_backend_parallel_launch_omp(FCINNParallelLambda flambda, void* datas, int num_task) {
   int num_workers = max_concurrency();
   if (num_task == 0) num_task = num_workers;
   omp_set_num_threads(num_task);
@@ -51,11 +84,36 @@ int cinn_backend_parallel_launch(FCINNParallelLambda flambda, void* datas, int n
   return 0;
 }
 
+int cinn_backend_parallel_next_chunk(int64_t* counter, int extent, int num_task, int chunk_size, int guided, int* end) {
+  int64_t begin = 0;
+  int64_t chunk = chunk_size;
+  if (guided) {
+    // take half of the even share of the remaining iterations, so the last chunks are small enough to balance
+    begin = __atomic_load_n(counter, __ATOMIC_RELAXED);
+    while (begin < extent) {
+      chunk = std::max<int64_t>(chunk_size, (extent - begin) / (2 * std::max(num_task, 1)));
+      if (__atomic_compare_exchange_n(counter, &begin, begin + chunk, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        break;
+      }
+    }
+  } else {
+    begin = __atomic_fetch_add(counter, chunk, __ATOMIC_RELAXED);
+  }
+  if (begin >= extent) {
+    *end = extent;
+    return extent;
+  }
+  *end = static_cast<int>(std::min<int64_t>(begin + chunk, extent));
+  return static_cast<int>(begin);
+}
+
 CINN_REGISTER_HELPER(cinn_backend_parallel) {
   using namespace cinn;  // NOLINT
   using backends::FunctionProto;
   auto host_target = common::DefaultHostTarget();
   backends::RuntimeSymbolRegistry::Global().RegisterFn(runtime::intrinsic::parallel_launch,
                                                        reinterpret_cast<void*>(&cinn_backend_parallel_launch));
+  backends::RuntimeSymbolRegistry::Global().RegisterFn(runtime::intrinsic::parallel_next_chunk,
+                                                       reinterpret_cast<void*>(&cinn_backend_parallel_next_chunk));
   return true;
 }
@@ -23,6 +23,12 @@ extern "C" {
 
 int max_concurrency();
 
+/**
+ * @brief Limit the number of threads used by the parallel loops launched from the calling thread.
+ * @param num_threads The number of threads, 0 means restoring the default of max_concurrency().
+ */
+void cinn_backend_set_intra_op_concurrency(int num_threads);
+
 /**
  * @brief The callback function to execute a parallel lambda
  * @param task_id the task id of the function.
@@ -33,7 +39,8 @@ int max_concurrency();
 typedef int (*FCINNParallelLambda)(int task_id, int num_task, void* datas);
 
 /**
- * @brief Backend function for running parallel jobs.
+ * @brief Backend function for running parallel jobs on the built-in thread pool of the calling thread.
+ * The tasks run serially if it is called from inside a parallel task.
  *
  * @param flambda The parallel function to be launched.
  * @param datas The closure datas.
@@ -44,4 +51,25 @@ typedef int (*FCINNParallelLambda)(int task_id, int num_task, void* datas);
  */
 int cinn_backend_parallel_launch(FCINNParallelLambda flambda, void* datas, int num_task);
 
+/**
+ * @brief Run the parallel jobs in an OpenMP parallel region, it has the same arguments as
+ * cinn_backend_parallel_launch and is kept as the reference to compare with.
+ */
+int cinn_backend_parallel_launch_omp(FCINNParallelLambda flambda, void* datas, int num_task);
+
+/**
+ * @brief Take the next chunk of iterations of a parallel loop with the dynamic or guided schedule.
+ *
+ * @param counter The number of iterations taken so far, it is shared by the tasks of the loop and set to 0
+ *           before the launch.
+ * @param extent The number of iterations of the loop.
+ * @param num_task The number of tasks running the loop.
+ * @param chunk_size The number of iterations in a chunk, it is the minimum one with the guided schedule.
+ * @param guided Whether the chunks shrink with the remaining iterations.
+ * @param end The end of the chunk taken.
+ *
+ * @return The begin of the chunk taken, it is the extent when all the iterations are taken.
+ */
+int cinn_backend_parallel_next_chunk(int64_t* counter, int extent, int num_task, int chunk_size, int guided, int* end);
+
 }  // extern "C"
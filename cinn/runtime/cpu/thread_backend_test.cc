@@ -0,0 +1,193 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/runtime/cpu/thread_backend.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cinn/runtime/cpu/parallel_launcher.h"
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+struct TaskCounter {
+  std::vector<std::atomic<int>> counts;
+  std::atomic<int> wrong_num_task{0};
+  int expected_num_task;
+
+  explicit TaskCounter(int num_task) : counts(num_task), expected_num_task(num_task) {}
+
+  static int Count(int task_id, int num_task, void* datas) {
+    auto* counter = reinterpret_cast<TaskCounter*>(datas);
+    if (num_task != counter->expected_num_task) ++counter->wrong_num_task;
+    ++counter->counts[task_id];
+    return 0;
+  }
+};
+
+TEST(ThreadBackend, AllTasksRunOnce) {
+  int num_threads = max_concurrency();
+  for (int num_task : {1, 2, 3, num_threads, num_threads + 1, 3 * num_threads + 1}) {
+    for (int repeat = 0; repeat < 100; ++repeat) {
+      TaskCounter counter(num_task);
+      cinn_backend_parallel_launch(&TaskCounter::Count, &counter, num_task);
+      ASSERT_EQ(counter.wrong_num_task.load(), 0);
+      for (int i = 0; i < num_task; ++i) {
+        ASSERT_EQ(counter.counts[i].load(), 1) << "task " << i << " of " << num_task;
+      }
+    }
+  }
+  // 0 means launching a task per thread
+  TaskCounter counter(num_threads);
+  cinn_backend_parallel_launch(&TaskCounter::Count, &counter, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    ASSERT_EQ(counter.counts[i].load(), 1);
+  }
+}
+
+TEST(ThreadBackend, NestedLaunch) {
+  constexpr int kOuter = 4;
+  constexpr int kInner = 8;
+  std::vector<std::unique_ptr<TaskCounter>> inner_counters;
+  for (int i = 0; i < kOuter; ++i) {
+    inner_counters.emplace_back(new TaskCounter(kInner));
+  }
+  auto outer = [](int task_id, int num_task, void* datas) {
+    auto* counters = reinterpret_cast<std::vector<std::unique_ptr<TaskCounter>>*>(datas);
+    EXPECT_TRUE(ParallelLauncher::InParallelRegion());
+    return cinn_backend_parallel_launch(&TaskCounter::Count, counters->at(task_id).get(), kInner);
+  };
+  cinn_backend_parallel_launch(outer, &inner_counters, kOuter);
+  EXPECT_FALSE(ParallelLauncher::InParallelRegion());
+  for (auto& counter : inner_counters) {
+    for (int i = 0; i < kInner; ++i) {
+      ASSERT_EQ(counter->counts[i].load(), 1);
+    }
+  }
+}
+
+TEST(ThreadBackend, ConcurrentLaunchers) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumTask    = 8;
+  std::vector<int> passed(kNumThreads, 1);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t] {
+      // each thread launches on its own launcher of 2 threads
+      cinn_backend_set_intra_op_concurrency(2);
+      for (int repeat = 0; repeat < 200; ++repeat) {
+        TaskCounter counter(kNumTask);
+        cinn_backend_parallel_launch(&TaskCounter::Count, &counter, kNumTask);
+        for (int i = 0; i < kNumTask; ++i) {
+          if (counter.counts[i].load() != 1) passed[t] = 0;
+        }
+      }
+      cinn_backend_set_intra_op_concurrency(0);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < kNumThreads; ++t) {
+    EXPECT_TRUE(passed[t]) << "The launches of thread " << t << " missed some tasks";
+  }
+}
+
+TEST(ThreadBackend, NextChunk) {
+  constexpr int kExtent  = 1000;
+  constexpr int kNumTask = 4;
+  for (int guided : {0, 1}) {
+    int64_t counter = 0;
+    std::vector<int> chunk_sizes;
+    int end   = 0;
+    int begin = cinn_backend_parallel_next_chunk(&counter, kExtent, kNumTask, 7, guided, &end);
+    int next  = 0;
+    while (begin < kExtent) {
+      // the chunks are taken in order without gaps when there is a single thread
+      ASSERT_EQ(begin, next);
+      ASSERT_GT(end, begin);
+      ASSERT_LE(end, kExtent);
+      chunk_sizes.push_back(end - begin);
+      next  = end;
+      begin = cinn_backend_parallel_next_chunk(&counter, kExtent, kNumTask, 7, guided, &end);
+    }
+    ASSERT_EQ(next, kExtent);
+    ASSERT_EQ(begin, kExtent);
+    ASSERT_EQ(end, kExtent);
+    if (guided) {
+      // the first chunk is half of the even share, and the chunks shrink down to the minimum
+      EXPECT_EQ(chunk_sizes.front(), kExtent / (2 * kNumTask));
+      EXPECT_EQ(chunk_sizes[chunk_sizes.size() - 2], 7);
+      EXPECT_TRUE(std::is_sorted(chunk_sizes.rbegin(), chunk_sizes.rend()));
+    } else {
+      EXPECT_EQ(chunk_sizes.size(), (kExtent + 6) / 7);
+    }
+  }
+}
+
+TEST(ThreadBackend, ConcurrentNextChunk) {
+  constexpr int kExtent = 100000;
+  for (int guided : {0, 1}) {
+    struct Loop {
+      explicit Loop(int guided) : guided(guided), visits(kExtent) {}
+      int64_t counter = 0;
+      int guided;
+      std::vector<std::atomic<int>> visits;
+    } loop(guided);
+    auto run = [](int task_id, int num_task, void* datas) {
+      auto* loop = reinterpret_cast<Loop*>(datas);
+      int end    = 0;
+      int begin  = 0;
+      while ((begin = cinn_backend_parallel_next_chunk(&loop->counter, kExtent, num_task, 16, loop->guided, &end)) <
+             kExtent) {
+        for (int i = begin; i < end; ++i) ++loop->visits[i];
+      }
+      return 0;
+    };
+    cinn_backend_parallel_launch(run, &loop, 0);
+    for (int i = 0; i < kExtent; ++i) {
+      ASSERT_EQ(loop.visits[i].load(), 1) << "iteration " << i << (guided ? " of guided loop" : " of dynamic loop");
+    }
+  }
+}
+
+// A micro-benchmark of the launch latency of an empty parallel loop, compared with the OpenMP backend
+TEST(ThreadBackend, LaunchLatency) {
+  constexpr int kRepeat = 10000;
+  auto empty_fn         = [](int task_id, int num_task, void* datas) { return 0; };
+  auto measure          = [&](int (*launch)(FCINNParallelLambda, void*, int)) {
+    // warm up the threads
+    for (int i = 0; i < 100; ++i) launch(empty_fn, nullptr, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRepeat; ++i) launch(empty_fn, nullptr, 0);
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kRepeat;
+  };
+  double pool_latency = measure(&cinn_backend_parallel_launch);
+  double omp_latency  = measure(&cinn_backend_parallel_launch_omp);
+  LOG(INFO) << "Launch latency with " << max_concurrency() << " threads: thread pool " << pool_latency
+            << "us, OpenMP " << omp_latency << "us";
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
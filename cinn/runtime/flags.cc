@@ -26,6 +26,7 @@ DEFINE_bool(cinn_cudnn_deterministic,
 #endif
 
 using ::GFLAGS_NAMESPACE::BoolFromEnv;
+using ::GFLAGS_NAMESPACE::Int32FromEnv;
 using ::GFLAGS_NAMESPACE::StringFromEnv;
 
 // FLAGS to switch optimization status
@@ -37,19 +38,110 @@ DEFINE_bool(cinn_use_fill_constant_folding,
             BoolFromEnv("FLAGS_cinn_use_fill_constant_folding", false),
             "Whether use the FillConstantFolding pass.");
 
+DEFINE_bool(cinn_use_graph_cse,
+            BoolFromEnv("FLAGS_cinn_use_graph_cse", true),
+            "Whether use the CommonSubexpressionElimination graph pass.");
+
+DEFINE_bool(cinn_use_uniform_constant_folding,
+            BoolFromEnv("FLAGS_cinn_use_uniform_constant_folding", false),
+            "Whether use the UniformConstantFolding graph pass.");
+
+DEFINE_bool(cinn_use_ir_cse_licm,
+            BoolFromEnv("FLAGS_cinn_use_ir_cse_licm", false),
+            "Whether eliminate the common subexpressions and hoist the loop invariants in the lowered functions.");
+
+DEFINE_bool(cinn_use_cpu_reduce_schedule,
+            BoolFromEnv("FLAGS_cinn_use_cpu_reduce_schedule", false),
+            "Whether use the vectorized and parallel schedules for the reductions on x86.");
+
+DEFINE_bool(cinn_use_cpu_gemm,
+            BoolFromEnv("FLAGS_cinn_use_cpu_gemm", false),
+            "Whether compute the matmul and mul on x86 by the native packed gemm of the runtime instead of MKL or the "
+            "generic compute, and fuse the bias and the activation following a matmul into the epilogue of the gemm.");
+
 DEFINE_bool(cinn_use_cuda_vectorize,
             BoolFromEnv("FLAGS_cinn_use_cuda_vectorize", false),
             "Whether use cuda vectroize on schedule config");
 
+DEFINE_bool(cinn_share_group_kernels,
+            BoolFromEnv("FLAGS_cinn_share_group_kernels", false),
+            "Whether lower and compile the structurally identical fusion groups only once and share the kernel.");
+
 DEFINE_bool(cinn_ir_schedule,
             BoolFromEnv("FLAGS_cinn_ir_schedule", false),
             "Whether use reconstructed schedule primitives.");
 
+DEFINE_bool(cinn_memory_planning,
+            BoolFromEnv("FLAGS_cinn_memory_planning", false),
+            "Whether pack the intermediate variables into one arena by their lifetimes at compile-time, "
+            "the contents of the variables not fetched are invalid after running.");
+
+// FLAGS to control the runtime execution
+DEFINE_bool(cinn_host_memory_pool,
+            BoolFromEnv("FLAGS_cinn_host_memory_pool", false),
+            "Whether cache the freed host buffers for the later allocations of the same size class instead of "
+            "returning them to the system. It is read when the memory manager is created.");
+
+DEFINE_bool(cinn_parallel_execute,
+            BoolFromEnv("FLAGS_cinn_parallel_execute", false),
+            "Whether run the independent instructions of a program concurrently on host.");
+
+DEFINE_int32(cinn_inter_op_threads,
+             Int32FromEnv("FLAGS_cinn_inter_op_threads", 0),
+             "The number of threads running instructions concurrently when cinn_parallel_execute is enabled, "
+             "the rest cores are shared by the parallel loops inside each instruction. 0 means deciding it by "
+             "the width of the instruction graph.");
+
+// FLAGS to control the compilation
+DEFINE_int32(cinn_compile_threads,
+             Int32FromEnv("FLAGS_cinn_compile_threads", 1),
+             "The number of threads to lower and compile the fusion groups of a graph on host, "
+             "0 means using all the hardware threads.");
+
+DEFINE_int32(cinn_host_buffer_alignment,
+             Int32FromEnv("FLAGS_cinn_host_buffer_alignment", 64),
+             "The alignment in bytes the host kernels assume for the memory of their arguments, 0 assumes nothing. "
+             "The host buffers allocated by CINN are aligned to 64 bytes, so it can't be larger, and the external "
+             "memory bound to a Program less aligned is staged. Set it to 0 if the kernels are fed with external "
+             "memory in other ways.");
+
+DEFINE_string(cinn_x86_conv2d_algo,
+              StringFromEnv("FLAGS_cinn_x86_conv2d_algo", ""),
+              "The algorithm of the NCHW conv2d on x86, empty keeps the NCHWc conv2d. auto selects between Winograd "
+              "and im2col for every conv2d by the measured cost table, while winograd or im2col limits the "
+              "candidates, and nchwc or mkldnn selects the algorithm without a measured cost directly.");
+
+DEFINE_string(cinn_compile_cache_dir,
+              StringFromEnv("FLAGS_cinn_compile_cache_dir", ""),
+              "Specify the directory of the persistent compiled-object cache on host, empty means disabled.");
+
+DEFINE_int32(cinn_compile_cache_capacity_mb,
+             Int32FromEnv("FLAGS_cinn_compile_cache_capacity_mb", 1024),
+             "The maximum size in MB of the persistent compiled-object cache, 0 means unlimited.");
+
+DEFINE_string(cinn_x86_isa_variants,
+              StringFromEnv("FLAGS_cinn_x86_isa_variants", ""),
+              "The comma-separated x86 instruction set levels the host modules may be compiled for, such as "
+              "avx2,avx512. Every module is linked for the best one the running cpu supports, and an exported package "
+              "holds the kernels of every level, the best one is chosen by the cpu loading it. The objects are keyed "
+              "by the level in the compile cache instead of the host cpu, so the nodes of the same level share the "
+              "cached objects. Empty means compiling for the host cpu.");
+
+DEFINE_string(cinn_aot_linker,
+              StringFromEnv("FLAGS_cinn_aot_linker", "cc"),
+              "The compiler driver used to link the compiled host objects into the shared library of an AOT package, or "
+              "into one relocatable object.");
+
 // FLAGS for performance analysis and accuracy debug
 DEFINE_bool(cinn_sync_run,
             BoolFromEnv("FLAGS_cinn_sync_run", false),
             "Whether sync all devices after each instruction run, which is used for debug.");
 
+DEFINE_bool(cinn_host_profiler,
+            BoolFromEnv("FLAGS_cinn_host_profiler", false),
+            "Whether record the time of the instructions and the kernels on host from the start, which are reported by "
+            "the HostProfiler.");
+
 DEFINE_bool(cinn_self_check_accuracy,
             BoolFromEnv("FLAGS_cinn_self_check_accuracy", false),
             "Whether self-check accuracy after each instruction run, which is used for debug.");
@@ -84,6 +84,8 @@ static const char* cuda_sync_threads = "__syncthreads";
 
 static const char* parallel_launch = "cinn_backend_parallel_launch";
 
+static const char* parallel_next_chunk = "cinn_backend_parallel_next_chunk";
+
 }  // namespace intrinsic
 
 /**
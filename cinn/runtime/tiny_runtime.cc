@@ -12,12 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <omp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <map>
 #include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -25,45 +35,68 @@
 
 extern "C" {
 int max_num_workers = std::thread::hardware_concurrency();
+typedef void (*func_t)(cinn_pod_value_t *, int);
 // move to standlone file
 struct param_context_t {
   int major_v;
   int minor_v;
-  std::vector<uint8_t> buf;
-  std::vector<std::vector<uint8_t>> temporary;
+  // the program file mapped privately, the persistent buffers are read from it directly, the pages not
+  // written by the loader or the kernels are shared by all the processes loading the same file
+  uint8_t *mapped{nullptr};
+  size_t mapped_size{0};
+  // the shared library of the kernels, or nullptr if they are linked into the process
+  void *library{nullptr};
+  // the buffers of the non-persistent variables, allocated aligned as the host buffers
+  std::vector<void *> temporary;
   std::map<std::string, cinn_pod_value_t> name2podvalue;
   std::vector<std::string> instructions;
+  // the kernels of the instructions, resolved once on loading
+  std::vector<func_t> funcs;
   std::vector<int> inst_argc;
   std::vector<cinn_pod_value_t *> inst_argv;
-};
 
-void *load_program(const char *paramfile) {
-  FILE *f = fopen(paramfile, "r");
-  fseek(f, 0, SEEK_END);
-  int fsize = ftell(f);
-  rewind(f);
-  if (fsize < 32) {
-    fclose(f);
-    return nullptr;
+  ~param_context_t() {
+    if (mapped) munmap(mapped, mapped_size);
+    if (library) dlclose(library);
+    for (void *tbuf : temporary) free(tbuf);
   }
+};
 
+// Load a program file, the kernels are looked up in the library, or in the process if it is RTLD_DEFAULT.
+static param_context_t *load_program_from(const char *paramfile, void *library) {
   std::unique_ptr<param_context_t> ctx(new param_context_t{});
-  int alignment = std::max(alignof(cinn_pod_value_t), alignof(cinn_buffer_t));
-  ctx->buf.resize(fsize + alignment);
-  uint8_t *buf = ctx->buf.data();
-  if ((uintptr_t)buf % alignment) {
-    buf = buf + alignment - ((uintptr_t)buf % alignment);
+  int fd = open(paramfile, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "Failed to open the program file %s\n", paramfile);
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 32) {
+    close(fd);
+    return nullptr;
+  }
+  size_t fsize = st.st_size;
+  // the loader patches the pointers in the buffers and the arguments, which only copies the pages holding them
+  void *mapped = mmap(nullptr, fsize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    fprintf(stderr, "Failed to map the program file %s\n", paramfile);
+    return nullptr;
   }
-  fread(buf, 1, fsize, f);
-  fclose(f);
+  ctx->mapped      = static_cast<uint8_t *>(mapped);
+  ctx->mapped_size = fsize;
+  uint8_t *buf     = ctx->mapped;
 
   if (std::string(buf, buf + 4) != "CINN") {
-    // TODO LOG fatal
+    fprintf(stderr, "%s is not a CINN program file\n", paramfile);
     return nullptr;
   }
-  // TODO check param file version
   ctx->major_v = *(int *)(buf + 4);
   ctx->minor_v = *(int *)(buf + 8);
+  if (ctx->major_v > CINN_PROGRAM_FILE_VERSION) {
+    fprintf(stderr, "The version %d of the program file %s is not supported\n", ctx->major_v, paramfile);
+    return nullptr;
+  }
 
   int *namelist_pos   = (int *)(buf + 16);
   int *podvalue_pos   = (int *)(buf + *namelist_pos);
@@ -88,22 +121,26 @@ void *load_program(const char *paramfile) {
     if (cb[i].memory) {
       cb[i].memory = buf + (uintptr_t)cb[i].memory;
     } else {
-      int alignment = cb[i].align;
-      if (alignment == 0) {
-        alignment = 4;
+      int alignment = std::max<int>(cb[i].align, CINN_HOST_BUFFER_ALIGNMENT);
+      void *tbuf    = nullptr;
+      if (posix_memalign(&tbuf, alignment, std::max<uint64_t>(cb[i].memory_size, 1))) {
+        fprintf(stderr, "Failed to allocate %llu bytes for %s\n", (unsigned long long)cb[i].memory_size, namev[i]);
+        return nullptr;
       }
-      ctx->temporary.emplace_back(alignment + cb[i].memory_size);
-      uint8_t *tbuf = ctx->temporary.back().data();
-      if ((uintptr_t)tbuf % alignment) {
-        tbuf = tbuf + alignment - ((uintptr_t)tbuf % alignment);
-      }
-      cb[i].memory = tbuf;
+      ctx->temporary.push_back(tbuf);
+      cb[i].memory = (uint8_t *)tbuf;
     }
     ctx->name2podvalue[namev[i]] = cinn_pod_value_t(cb + i);
   }
   for (int i = 0; i < inst_pos[1]; i++) {
     const char *inst = (const char *)(buf + inst_pos[2 + i * 3 + 0]);
+    void *func       = dlsym(library, inst);
+    if (!func) {
+      fprintf(stderr, "The kernel %s of the program file %s is not found\n", inst, paramfile);
+      return nullptr;
+    }
     ctx->instructions.push_back(inst);
+    ctx->funcs.push_back((func_t)func);
     int instargc = inst_pos[2 + i * 3 + 1];
     ctx->inst_argc.push_back(instargc);
     cinn_pod_value_t *argv = (cinn_pod_value_t *)(buf + inst_pos[2 + i * 3 + 2]);
@@ -118,20 +155,74 @@ void *load_program(const char *paramfile) {
   return ctx.release();
 }
 
+void *load_program(const char *paramfile) { return load_program_from(paramfile, RTLD_DEFAULT); }
+
+// Whether the running cpu supports an x86 instruction set level of FLAGS_cinn_x86_isa_variants, the levels need the
+// same features as common::CpuFeaturesOfIsa.
+static bool cpu_supports_isa(const std::string &isa) {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  bool sse42  = __builtin_cpu_supports("sse4.2");
+  bool avx2   = sse42 && __builtin_cpu_supports("avx") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  bool avx512 = avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+  bool avx512_vnni = avx512 && __builtin_cpu_supports("avx512vnni");
+  if (isa == "sse4.2") return sse42;
+  if (isa == "avx2") return avx2;
+  if (isa == "avx512") return avx512;
+  if (isa == "avx512_vnni") return avx512_vnni;
+  if (isa == "amx" && avx512_vnni) {
+    // the older compilers don't know the amx features, read them and the saved tile state directly
+    unsigned eax, ebx, ecx, edx, xcr0_lo, xcr0_hi;
+    __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    bool amx = (xcr0_lo & 0x60000) == 0x60000 && (edx & (1 << 22)) && (edx & (1 << 24)) && (edx & (1 << 25));
+    if (eax < 1) return false;
+    __cpuid_count(7, 1, eax, ebx, ecx, edx);
+    return amx && (eax & (1 << 5));
+  }
+#endif
+  return false;
+}
+
+void *load_package(const char *package_dir) {
+  std::string dir(package_dir);
+  // the kernels compiled for the best instruction set level the cpu supports, or for the exporting host
+  std::string kernels = dir + "/kernels.so";
+  for (const char *isa : {"amx", "avx512_vnni", "avx512", "avx2", "sse4.2"}) {
+    std::string path = dir + "/kernels." + isa + ".so";
+    if (access(path.c_str(), R_OK) == 0 && cpu_supports_isa(isa)) {
+      kernels = path;
+      break;
+    }
+  }
+  // the runtime functions called by the kernels are resolved in the process, which should export them
+  void *library = dlopen(kernels.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!library) {
+    fprintf(stderr, "Failed to load the kernels of the package %s: %s\n", package_dir, dlerror());
+    return nullptr;
+  }
+  param_context_t *ctx = load_program_from((dir + "/program.cinn").c_str(), library);
+  if (!ctx) {
+    dlclose(library);
+    return nullptr;
+  }
+  ctx->library = library;
+  return ctx;
+}
+
+void destroy_program(void *ctx) { delete (param_context_t *)ctx; }
+
 int set_maxconcurrency(int c) {
   int old_c       = max_num_workers;
   max_num_workers = c;
   return old_c;
 }
 
-typedef void (*func_t)(cinn_pod_value_t *, int);
 void run_program(void *ctx) {
   param_context_t *pc = (param_context_t *)ctx;
-  for (int i = 0; i < pc->instructions.size(); i++) {
-    const char *sym = pc->instructions[i].c_str();
-    void *p         = dlsym(RTLD_DEFAULT, sym);
-    func_t f        = (func_t)p;
-    f(pc->inst_argv[i], pc->inst_argc[i]);
+  for (int i = 0; i < pc->funcs.size(); i++) {
+    pc->funcs[i](pc->inst_argv[i], pc->inst_argc[i]);
   }
 }
 
@@ -155,4 +246,26 @@ int cinn_backend_parallel_launch(FCINNParallelLambda flambda, void *datas, int n
   }
   return 0;
 }
+
+int cinn_backend_parallel_next_chunk(int64_t *counter, int extent, int num_task, int chunk_size, int guided, int *end) {
+  int64_t begin = 0;
+  int64_t chunk = chunk_size;
+  if (guided) {
+    begin = __atomic_load_n(counter, __ATOMIC_RELAXED);
+    while (begin < extent) {
+      chunk = std::max<int64_t>(chunk_size, (extent - begin) / (2 * std::max(num_task, 1)));
+      if (__atomic_compare_exchange_n(counter, &begin, begin + chunk, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        break;
+      }
+    }
+  } else {
+    begin = __atomic_fetch_add(counter, chunk, __ATOMIC_RELAXED);
+  }
+  if (begin >= extent) {
+    *end = extent;
+    return extent;
+  }
+  *end = static_cast<int>(std::min<int64_t>(begin + chunk, extent));
+  return static_cast<int>(begin);
+}
 }
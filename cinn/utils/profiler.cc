@@ -14,6 +14,15 @@
 
 #include "cinn/utils/profiler.h"
 
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
 #ifdef CINN_WITH_NVTX
 #include <nvToolsExt.h>
 #endif
@@ -24,9 +33,197 @@
 #include "cinn/backends/cuda_util.h"
 #endif
 
+DECLARE_bool(cinn_host_profiler);
+
 namespace cinn {
 namespace utils {
 
+namespace {
+uint32_t CurrentThreadId() {
+  static std::atomic<uint32_t> num_threads{0};
+  thread_local uint32_t thread_id = num_threads++;
+  return thread_id;
+}
+
+const char* KindName(HostEvent::Kind kind) { return kind == HostEvent::Kind::kInstruction ? "instruction" : "kernel"; }
+
+// escape a name for a JSON string, the names are identifiers so only the quotes and the backslashes matter
+std::string EscapeJSON(const std::string& str) {
+  std::string res;
+  for (char c : str) {
+    if (c == '"' || c == '\\') res.push_back('\\');
+    res.push_back(c);
+  }
+  return res;
+}
+}  // namespace
+
+HostProfiler& HostProfiler::Global() {
+  static HostProfiler profiler;
+  return profiler;
+}
+
+HostProfiler::HostProfiler() {
+  if (FLAGS_cinn_host_profiler) {
+    Enable();
+  }
+}
+
+void HostProfiler::Enable(size_t capacity) {
+  CHECK_GT(capacity, 0) << "The capacity of the host profiler should be positive";
+  if (capacity != capacity_) {
+    slots_.reset(new Slot[capacity]);
+    capacity_ = capacity;
+  }
+  Clear();
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+int HostProfiler::RegisterName(const std::string& name) {
+  std::lock_guard<std::mutex> lock(names_mtx_);
+  auto it = name2id_.find(name);
+  if (it != name2id_.end()) return it->second;
+  int id = names_.size();
+  names_.push_back(name);
+  flops_.push_back(0);
+  name2id_[name] = id;
+  return id;
+}
+
+void HostProfiler::SetFlops(const std::string& name, double flops) {
+  int id = RegisterName(name);
+  std::lock_guard<std::mutex> lock(names_mtx_);
+  flops_[id] = flops;
+}
+
+void HostProfiler::Record(HostEvent::Kind kind, int name_id, int64_t start_ns, int64_t end_ns, uint64_t bytes) {
+  uint64_t idx = next_.fetch_add(1, std::memory_order_relaxed);
+  // the buffer is full, the slots are not reused so that no two writers share a slot
+  if (idx >= capacity_) return;
+  slots_[idx].event = HostEvent{kind, name_id, CurrentThreadId(), start_ns, end_ns - start_ns, bytes};
+  slots_[idx].seq.store(idx + 1, std::memory_order_release);
+}
+
+int64_t HostProfiler::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::vector<HostEvent> HostProfiler::Events() const {
+  uint64_t end = std::min<uint64_t>(next_.load(std::memory_order_relaxed), capacity_);
+  std::vector<HostEvent> events;
+  events.reserve(end);
+  for (uint64_t i = 0; i < end; ++i) {
+    // the slot is claimed but not written yet
+    if (slots_[i].seq.load(std::memory_order_acquire) != i + 1) continue;
+    events.push_back(slots_[i].event);
+  }
+  return events;
+}
+
+uint64_t HostProfiler::num_dropped() const {
+  uint64_t next = next_.load(std::memory_order_relaxed);
+  return next > capacity_ ? next - capacity_ : 0;
+}
+
+void HostProfiler::Clear() {
+  for (size_t i = 0; i < capacity_; ++i) {
+    slots_[i].seq.store(0, std::memory_order_relaxed);
+  }
+  next_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<HostEventStat> HostProfiler::Aggregate() const {
+  std::vector<HostEventStat> stats;
+  // indexed by the name id and the kind
+  std::unordered_map<int64_t, size_t> index;
+  std::lock_guard<std::mutex> lock(names_mtx_);
+  for (auto& event : Events()) {
+    int64_t key = event.name_id * 2 + static_cast<int64_t>(event.kind);
+    auto it     = index.find(key);
+    if (it == index.end()) {
+      it = index.emplace(key, stats.size()).first;
+      stats.emplace_back();
+      stats.back().name  = names_[event.name_id];
+      stats.back().kind  = event.kind;
+      stats.back().flops = flops_[event.name_id];
+    }
+    auto& stat = stats[it->second];
+    stat.count += 1;
+    stat.total_ns += event.duration_ns;
+    stat.max_ns = std::max(stat.max_ns, event.duration_ns);
+    stat.bytes  = event.bytes;
+  }
+  std::sort(stats.begin(), stats.end(), [](const HostEventStat& a, const HostEventStat& b) {
+    return a.total_ns > b.total_ns;
+  });
+  return stats;
+}
+
+std::string HostProfiler::Summary() const {
+  auto stats       = Aggregate();
+  int64_t total_ns = 0;
+  for (auto& stat : stats) {
+    if (stat.kind == HostEvent::Kind::kKernel) total_ns += stat.total_ns;
+  }
+  std::stringstream ss;
+  ss << std::left << std::setw(12) << "Kind" << std::setw(8) << "Calls" << std::setw(12) << "Total(ms)" << std::setw(12)
+     << "Avg(us)" << std::setw(12) << "Max(us)" << std::setw(10) << "Ratio" << std::setw(10) << "GB/s" << std::setw(10)
+     << "GFLOP/s"
+     << "Name\n";
+  ss << std::fixed << std::setprecision(3);
+  for (auto& stat : stats) {
+    double avg_ns = static_cast<double>(stat.total_ns) / stat.count;
+    ss << std::setw(12) << KindName(stat.kind) << std::setw(8) << stat.count << std::setw(12) << stat.total_ns / 1e6
+       << std::setw(12) << avg_ns / 1e3 << std::setw(12) << stat.max_ns / 1e3 << std::setw(10);
+    // the ratio of the kernels to the total time of the kernels
+    if (stat.kind == HostEvent::Kind::kKernel && total_ns > 0) {
+      ss << static_cast<double>(stat.total_ns) / total_ns;
+    } else {
+      ss << "-";
+    }
+    ss << std::setw(10) << (avg_ns > 0 ? stat.bytes / avg_ns : 0.0) << std::setw(10)
+       << (avg_ns > 0 ? stat.flops / avg_ns : 0.0) << stat.name << "\n";
+  }
+  if (uint64_t dropped = num_dropped()) {
+    ss << dropped << " events are dropped since the buffer is full\n";
+  }
+  return ss.str();
+}
+
+std::string HostProfiler::ChromeTrace() const {
+  auto events = Events();
+  std::vector<std::string> names;
+  std::vector<double> flops;
+  {
+    std::lock_guard<std::mutex> lock(names_mtx_);
+    names = names_;
+    flops = flops_;
+  }
+  int64_t origin_ns = events.empty() ? 0 : events[0].start_ns;
+  for (auto& event : events) {
+    origin_ns = std::min(origin_ns, event.start_ns);
+  }
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    auto& event = events[i];
+    ss << (i > 0 ? ",\n" : "\n") << "{\"name\":\"" << EscapeJSON(names[event.name_id]) << "\",\"cat\":\""
+       << KindName(event.kind) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread_id
+       << ",\"ts\":" << (event.start_ns - origin_ns) / 1e3 << ",\"dur\":" << event.duration_ns / 1e3
+       << ",\"args\":{\"bytes\":" << event.bytes << ",\"flops\":" << flops[event.name_id] << "}}";
+  }
+  ss << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return ss.str();
+}
+
+void HostProfiler::ExportChromeTrace(const std::string& path) const {
+  std::ofstream ofs(path);
+  CHECK(ofs.is_open()) << "Failed to open " << path << " to export the chrome trace";
+  ofs << ChromeTrace();
+}
+
 void SynchronizeAllDevice() {
 #ifdef CINN_WITH_CUDA
   int current_device_id;
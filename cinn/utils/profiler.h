@@ -14,7 +14,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #ifdef CINN_WITH_NVTX
 #include <nvToolsExt.h>
@@ -37,6 +43,120 @@ class RecordEvent {
   }
 };
 
+// An event recorded by the HostProfiler
+struct HostEvent {
+  enum class Kind : int32_t { kInstruction, kKernel };
+  Kind kind;
+  // the id of the name registered in the profiler
+  int32_t name_id;
+  uint32_t thread_id;
+  int64_t start_ns;
+  int64_t duration_ns;
+  // the bytes of the buffers of the arguments
+  uint64_t bytes;
+};
+
+// The aggregated events of a name
+struct HostEventStat {
+  std::string name;
+  HostEvent::Kind kind;
+  int64_t count{0};
+  int64_t total_ns{0};
+  int64_t max_ns{0};
+  uint64_t bytes{0};
+  // the estimated float operations of a call, 0 if unknown
+  double flops{0};
+};
+
+/**
+ * HostProfiler records the wall time of the instructions and their kernels on host. The events are written into a
+ * fixed-size buffer without locks, each slot is written once, so the events after it is full are dropped and counted.
+ * It is disabled by default, enabled by FLAGS_cinn_host_profiler or Enable, and costs a relaxed atomic load per
+ * instruction when disabled.
+ *
+ * The readers of the events skip the slots still being written, while Enable and Clear should not run concurrently
+ * with the recording.
+ */
+class HostProfiler {
+ public:
+  static HostProfiler& Global();
+
+  //! Start recording into a cleared buffer of \p capacity events.
+  void Enable(size_t capacity = kDefaultCapacity);
+  void Disable() { enabled_.store(false, std::memory_order_relaxed); }
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  //! Return the id of \p name to record events with, the names are registered once and kept.
+  int RegisterName(const std::string& name);
+  //! Set the estimated float operations of a call of the kernel \p name.
+  void SetFlops(const std::string& name, double flops);
+
+  //! Record an event, it is thread-safe and lock-free.
+  void Record(HostEvent::Kind kind, int name_id, int64_t start_ns, int64_t end_ns, uint64_t bytes = 0);
+
+  static int64_t NowNs();
+
+  //! Return the recorded events from the oldest.
+  std::vector<HostEvent> Events() const;
+  //! Return the number of the events dropped since the buffer is full.
+  uint64_t num_dropped() const;
+  void Clear();
+
+  //! Aggregate the events by name, sorted by the total time.
+  std::vector<HostEventStat> Aggregate() const;
+  //! Return a table of the aggregated events.
+  std::string Summary() const;
+  //! Return the events in the Trace Event Format of chrome://tracing.
+  std::string ChromeTrace() const;
+  void ExportChromeTrace(const std::string& path) const;
+
+  static constexpr size_t kDefaultCapacity = 1 << 16;
+
+ private:
+  HostProfiler();
+
+  // an event with the sequence number of the recording, which is set after the event is written
+  struct Slot {
+    HostEvent event;
+    std::atomic<uint64_t> seq{0};
+  };
+
+  std::atomic<bool> enabled_{false};
+  std::unique_ptr<Slot[]> slots_;
+  size_t capacity_{0};
+  std::atomic<uint64_t> next_{0};
+
+  mutable std::mutex names_mtx_;
+  std::vector<std::string> names_;
+  std::vector<double> flops_;
+  std::unordered_map<std::string, int> name2id_;
+};
+
+/**
+ * Record the event of an instruction or a kernel on host from the construction to the destruction if the
+ * HostProfiler is enabled.
+ */
+class HostRecordEvent {
+ public:
+  HostRecordEvent(HostEvent::Kind kind,
+                  int name_id,
+                  uint64_t bytes = 0,
+                  bool active    = HostProfiler::Global().enabled())
+      : active_(active), kind_(kind), name_id_(name_id), bytes_(bytes) {
+    if (active_) start_ns_ = HostProfiler::NowNs();
+  }
+  ~HostRecordEvent() {
+    if (active_) HostProfiler::Global().Record(kind_, name_id_, start_ns_, HostProfiler::NowNs(), bytes_);
+  }
+
+ private:
+  bool active_;
+  HostEvent::Kind kind_;
+  int name_id_;
+  uint64_t bytes_;
+  int64_t start_ns_{0};
+};
+
 void SynchronizeAllDevice();
 
 void ProfilerStart();
@@ -0,0 +1,89 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/utils/profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace cinn {
+namespace utils {
+
+TEST(HostProfiler, RecordAndAggregate) {
+  auto& profiler = HostProfiler::Global();
+  profiler.Enable(64);
+  int instr_id  = profiler.RegisterName("instr");
+  int kernel_id = profiler.RegisterName("kernel");
+  EXPECT_EQ(profiler.RegisterName("kernel"), kernel_id);
+  profiler.SetFlops("kernel", 2000);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 4; ++i) {
+        HostRecordEvent record_instr(HostEvent::Kind::kInstruction, instr_id);
+        HostRecordEvent record_kernel(HostEvent::Kind::kKernel, kernel_id, 1024);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  profiler.Disable();
+  // not recorded when disabled
+  { HostRecordEvent record_kernel(HostEvent::Kind::kKernel, kernel_id); }
+
+  ASSERT_EQ(profiler.Events().size(), 32UL);
+  auto stats = profiler.Aggregate();
+  ASSERT_EQ(stats.size(), 2UL);
+  for (auto& stat : stats) {
+    EXPECT_EQ(stat.count, 16);
+    EXPECT_GE(stat.total_ns, stat.max_ns);
+    if (stat.kind == HostEvent::Kind::kKernel) {
+      EXPECT_EQ(stat.name, "kernel");
+      EXPECT_EQ(stat.bytes, 1024UL);
+      EXPECT_EQ(stat.flops, 2000);
+    } else {
+      EXPECT_EQ(stat.name, "instr");
+    }
+  }
+  EXPECT_NE(profiler.Summary().find("kernel"), std::string::npos);
+  auto trace = profiler.ChromeTrace();
+  EXPECT_EQ(trace.find("{\"traceEvents\":["), 0UL);
+  EXPECT_NE(trace.find("\"name\":\"kernel\",\"cat\":\"kernel\",\"ph\":\"X\""), std::string::npos);
+}
+
+TEST(HostProfiler, DropEventsWhenFull) {
+  auto& profiler = HostProfiler::Global();
+  profiler.Enable(8);
+  int kernel_id = profiler.RegisterName("kernel");
+  for (int i = 0; i < 20; ++i) {
+    profiler.Record(HostEvent::Kind::kKernel, kernel_id, i, i + 1);
+  }
+  auto events = profiler.Events();
+  ASSERT_EQ(events.size(), 8UL);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(events[i].start_ns, i);
+  }
+  EXPECT_EQ(profiler.num_dropped(), 12UL);
+  profiler.Clear();
+  EXPECT_TRUE(profiler.Events().empty());
+  EXPECT_EQ(profiler.num_dropped(), 0UL);
+  profiler.Disable();
+}
+
+}  // namespace utils
+}  // namespace cinn
@@ -0,0 +1,138 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/utils/thread_pool.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+namespace cinn {
+namespace utils {
+
+namespace {
+// the pool and index of the worker running on the current thread
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local int tls_worker_id          = -1;
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads) {
+  num_threads = std::max(num_threads, 1);
+  for (int i = 0; i < num_threads; ++i) {
+    queues_.emplace_back(new WorkQueue);
+  }
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+  VLOG(3) << "ThreadPool started with " << num_threads << " workers";
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+  task_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+int ThreadPool::CurrentWorkerId() { return tls_worker_id; }
+
+void ThreadPool::Submit(Task task) {
+  int queue_id = tls_pool == this ? tls_worker_id : static_cast<int>(next_queue_++ % queues_.size());
+  num_pending_++;
+  {
+    auto& queue = *queues_[queue_id];
+    std::lock_guard<std::mutex> lock(queue.mtx);
+    queue.tasks.emplace_back(std::move(task));
+  }
+  {
+    // increase under the lock to avoid a lost wakeup of a worker going to sleep
+    std::lock_guard<std::mutex> lock(mtx_);
+    num_queued_++;
+  }
+  task_cv_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  CHECK(tls_pool != this) << "ThreadPool::Wait can't be called from a worker of the same pool";
+  std::unique_lock<std::mutex> lock(mtx_);
+  done_cv_.wait(lock, [this] { return num_pending_.load() == 0; });
+}
+
+bool ThreadPool::PopLocal(int worker_id, Task* task) {
+  auto& queue = *queues_[worker_id];
+  std::lock_guard<std::mutex> lock(queue.mtx);
+  if (queue.tasks.empty()) return false;
+  *task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::Steal(int worker_id, Task* task) {
+  int num_queues = static_cast<int>(queues_.size());
+  for (int i = 1; i < num_queues; ++i) {
+    auto& queue = *queues_[(worker_id + i) % num_queues];
+    std::lock_guard<std::mutex> lock(queue.mtx);
+    if (queue.tasks.empty()) continue;
+    *task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(int worker_id) {
+  tls_pool      = this;
+  tls_worker_id = worker_id;
+  while (true) {
+    Task task;
+    if (PopLocal(worker_id, &task) || Steal(worker_id, &task)) {
+      num_queued_--;
+      task();
+      if (--num_pending_ == 0) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        done_cv_.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    task_cv_.wait(lock, [this] { return stop_ || num_queued_.load() > 0; });
+    if (stop_ && num_queued_.load() == 0) break;
+  }
+  tls_pool      = nullptr;
+  tls_worker_id = -1;
+}
+
+void ParallelFor(int begin, int end, const std::function<void(int)>& fn, int num_threads) {
+  num_threads = std::min(num_threads, end - begin);
+  if (num_threads <= 1) {
+    for (int i = begin; i < end; ++i) {
+      fn(i);
+    }
+    return;
+  }
+  ThreadPool pool(num_threads);
+  for (int i = begin; i < end; ++i) {
+    pool.Submit([&fn, i] { fn(i); });
+  }
+  pool.Wait();
+}
+
+}  // namespace utils
+}  // namespace cinn
@@ -0,0 +1,92 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinn {
+namespace utils {
+
+/**
+ * A work-stealing thread pool.
+ *
+ * Every worker owns a task deque. A task submitted from inside a worker is pushed to the back of that
+ * worker's deque and popped LIFO by its owner, which keeps a chain of dependent tasks on the same core.
+ * Tasks submitted from outside the pool are distributed round-robin. An idle worker steals from the
+ * front of the other workers' deques before going to sleep.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  /**
+   * Constructor.
+   * @param num_threads The number of worker threads, it will be clamped to at least 1.
+   */
+  explicit ThreadPool(int num_threads);
+
+  ~ThreadPool();
+
+  //! Enqueue a task, it never blocks.
+  void Submit(Task task);
+
+  //! Block until all the submitted tasks are finished.
+  void Wait();
+
+  int NumThreads() const { return static_cast<int>(workers_.size()); }
+
+  //! Return the index of the calling worker in its pool, or -1 if the caller is not a pool worker.
+  static int CurrentWorkerId();
+
+ private:
+  struct WorkQueue {
+    std::mutex mtx;
+    std::deque<Task> tasks;
+  };
+
+  void WorkerLoop(int worker_id);
+  bool PopLocal(int worker_id, Task* task);
+  bool Steal(int worker_id, Task* task);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  // guards the sleeping of idle workers and the waiting of Wait()
+  std::mutex mtx_;
+  std::condition_variable task_cv_;
+  std::condition_variable done_cv_;
+  // number of tasks that are enqueued but not taken by any worker
+  std::atomic<int> num_queued_{0};
+  // number of tasks that are submitted but not finished
+  std::atomic<int> num_pending_{0};
+  std::atomic<unsigned> next_queue_{0};
+  bool stop_{false};
+};
+
+/**
+ * Run fn(i) for each i in [begin, end) with at most \p num_threads threads, and return after all of them
+ * finished. It runs on the calling thread if \p num_threads <= 1.
+ */
+void ParallelFor(int begin, int end, const std::function<void(int)>& fn, int num_threads);
+
+}  // namespace utils
+}  // namespace cinn
@@ -0,0 +1,69 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/utils/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+namespace cinn {
+namespace utils {
+
+TEST(ThreadPool, RunAllTasks) {
+  ThreadPool pool(4);
+  ASSERT_EQ(pool.NumThreads(), 4);
+  std::atomic<int> sum{0};
+  for (int i = 1; i <= 100; ++i) {
+    pool.Submit([&sum, i] { sum += i; });
+  }
+  pool.Wait();
+  EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(ThreadPool, SubmitFromWorker) {
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> visited(64);
+  std::function<void(int)> visit = [&](int idx) {
+    EXPECT_GE(ThreadPool::CurrentWorkerId(), 0);
+    visited[idx]++;
+    // a binary tree of tasks, children are submitted from inside the workers
+    for (int child : {2 * idx + 1, 2 * idx + 2}) {
+      if (child < visited.size()) {
+        pool.Submit([&visit, child] { visit(child); });
+      }
+    }
+  };
+  pool.Submit([&visit] { visit(0); });
+  pool.Wait();
+  EXPECT_EQ(ThreadPool::CurrentWorkerId(), -1);
+  for (auto& v : visited) {
+    EXPECT_EQ(v.load(), 1);
+  }
+}
+
+TEST(ThreadPool, ParallelFor) {
+  for (int num_threads : {1, 4}) {
+    std::vector<int> squares(50, 0);
+    ParallelFor(
+        0, squares.size(), [&squares](int i) { squares[i] = i * i; }, num_threads);
+    for (int i = 0; i < squares.size(); ++i) {
+      EXPECT_EQ(squares[i], i * i);
+    }
+  }
+}
+
+}  // namespace utils
+}  // namespace cinn
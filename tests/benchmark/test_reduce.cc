@@ -0,0 +1,60 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/cinn.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/runtime/cpu/use_extern_funcs.h"
+#include "tests/benchmark/test_utils.h"
+
+DECLARE_bool(cinn_use_cpu_reduce_schedule);
+
+namespace cinn {
+namespace tests {
+
+// run reduce_sum with the default schedule and with the CPU reduce schedule
+void TestReduceSum(const std::string &test_name, const std::vector<int> &shape, const std::vector<int> &dim) {
+  hlir::framework::NodeAttr attrs;
+  attrs.attr_store["dim"]      = dim;
+  attrs.attr_store["keep_dim"] = false;
+  std::vector<Type> input_types{Float(32)};
+  std::vector<Type> output_types{Float(32)};
+
+  FLAGS_cinn_use_cpu_reduce_schedule = false;
+  OpBenchmarkTester default_tester("reduce_sum", {shape});
+  auto input_tensors = default_tester.CreateInputTensors<float>();
+  default_tester.TestOp(test_name + "_default", input_tensors, attrs, input_types, output_types);
+
+  FLAGS_cinn_use_cpu_reduce_schedule = true;
+  OpBenchmarkTester cpu_tester("reduce_sum", {shape});
+  input_tensors = cpu_tester.CreateInputTensors<float>();
+  cpu_tester.TestOp(test_name + "_cpu_schedule", input_tensors, attrs, input_types, output_types);
+  FLAGS_cinn_use_cpu_reduce_schedule = false;
+}
+
+TEST(test_reduce_sum, last_axis) { TestReduceSum("reduce_sum_last_axis", {128, 4096}, {1}); }
+
+TEST(test_reduce_sum, all_axes) { TestReduceSum("reduce_sum_all_axes", {1024, 1024}, {0, 1}); }
+
+TEST(test_reduce_sum, first_axis) { TestReduceSum("reduce_sum_first_axis", {4096, 128}, {0}); }
+
+TEST(test_reduce_sum, middle_axis) { TestReduceSum("reduce_sum_middle_axis", {32, 256, 128}, {1}); }
+
+}  // namespace tests
+}  // namespace cinn
@@ -0,0 +1,117 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
+#include "cinn/backends/llvm/codegen_x86.h"
+#include "cinn/backends/llvm/llvm_optimizer.h"
+#include "cinn/backends/llvm/llvm_util.h"
+#include "cinn/cinn.h"
+
+namespace cinn {
+namespace tests {
+
+// The widest vector in bits that LLVM emits for the loads, stores and arithmetics of a kernel, 0 if not vectorized.
+int CompileAndGetSimdWidth(const std::string& name, poly::StageMap stages, const std::vector<ir::Tensor>& args) {
+  auto target = common::DefaultHostTarget();
+  auto func   = Lower(name, stages, args);
+  // the graph compiler assumes the host tensors allocated by CINN are 64-byte aligned
+  for (auto& arg : func->args) {
+    if (arg.is_buffer()) arg.buffer_arg()->data_alignment = 64;
+  }
+  Module::Builder builder("module_" + name, target);
+  builder.AddFunction(func);
+
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+  llvm::SMDiagnostic error;
+  auto ctx = std::make_unique<llvm::LLVMContext>();
+  auto m   = llvm::parseAssemblyString(backends::AsStringRef(backends::kRuntimeLlvmIr), error, *ctx);
+  CHECK(m) << "Failed to parse the runtime IR";
+  auto b = std::make_unique<llvm::IRBuilder<>>(*ctx);
+  backends::CodeGenX86 codegen(m.get(), b.get());
+  codegen.Compile(builder.Build());
+  CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid module found";
+
+  // optimize as the execution engine does
+  auto machine = llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine());
+  backends::LLVMModuleOptimizer optimize(machine.get(), 3, {});
+  optimize(m.get());
+
+  auto* fn = m->getFunction(name);
+  CHECK(fn) << "The function " << name << " is not found";
+  int width = 0;
+  for (auto& inst : llvm::instructions(*fn)) {
+    bool is_memory = llvm::isa<llvm::LoadInst>(inst) || llvm::isa<llvm::StoreInst>(inst);
+    if (!is_memory && !llvm::isa<llvm::BinaryOperator>(inst)) continue;
+    llvm::Type* type = llvm::isa<llvm::StoreInst>(inst) ? inst.getOperand(0)->getType() : inst.getType();
+    if (type->isVectorTy()) {
+      width = std::max<int>(width, type->getPrimitiveSizeInBits().getFixedSize());
+    }
+  }
+  LOG(INFO) << "The SIMD width of " << name << " is " << width << " bits on " << machine->getTargetCPU().str();
+  return width;
+}
+
+TEST(SimdWidth, elementwise_add) {
+  Expr M(1024), N(512);
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + B(i, j); }, "C");
+  auto stages = CreateStages({C});
+  int width   = CompileAndGetSimdWidth("simd_elementwise_add", stages, {A, B, C});
+#ifdef __x86_64__
+  // every x86-64 cpu has SSE2, the innermost loop is expected to be vectorized without runtime checks
+  EXPECT_GE(width, 128);
+#endif
+}
+
+TEST(SimdWidth, reduce_sum) {
+  Expr M(1024), N(512);
+  Placeholder<float> A("A", {M, N});
+  Var k(N.as_int32(), "k0");
+  auto C = Compute(
+      {M}, [&](Var i) { return lang::ReduceSum(A(i, k), {k}); }, "C");
+  auto stages = CreateStages({C});
+  // the float reduction is only vectorized with reassociation allowed, the width is recorded to track it
+  CompileAndGetSimdWidth("simd_reduce_sum", stages, {A, C});
+}
+
+TEST(SimdWidth, matmul) {
+  Expr M(256), N(256), K(256);
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(K.as_int32(), "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+  auto stages = CreateStages({C});
+  // the default schedule reduces k innermost over the strided columns of B, the width is recorded to track it
+  CompileAndGetSimdWidth("simd_matmul", stages, {A, B, C});
+}
+
+}  // namespace tests
+}  // namespace cinn